@@ -0,0 +1,181 @@
+/*
+ * This file is part of nmealib.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file
+ * Info board
+ *
+ * An info board is a POSIX shared memory segment that holds the info
+ * structures of a fixed number of devices, so that one writer process can
+ * share them with any number of reader processes.
+ *
+ * The segment starts with a header (see NmeaBoardHeader), followed by one
+ * record per device. Every record is an info publisher (see publisher.h),
+ * so readers get consistent copies of the info structures without locking
+ * and without blocking the writer.
+ *
+ * The layout of the segment depends on the layout of NmeaInfo, so the
+ * header carries a layout version and the sizes of the records. Readers
+ * refuse to open a board with a different layout.
+ */
+
+#ifndef __NMEALIB_BOARD_H__
+#define __NMEALIB_BOARD_H__
+
+#include <nmealib/info.h>
+#include <nmealib/publisher.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef  __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/** The magic number of an info board: 'NMEB' */
+#define NMEALIB_BOARD_MAGIC (0x424d454eu)
+
+/** The layout version of an info board */
+#define NMEALIB_BOARD_VERSION (1u)
+
+/** The size of the header of an info board, records are aligned to it too */
+#define NMEALIB_BOARD_ALIGNMENT (64u)
+
+/**
+ * Info board header, at the start of the shared memory segment
+ */
+typedef struct _NmeaBoardHeader {
+    uint32_t magic;      /**< NMEALIB_BOARD_MAGIC, set when the board is initialised */
+    uint32_t version;    /**< the layout version, NMEALIB_BOARD_VERSION              */
+    uint32_t headerSize; /**< the size of the header (the offset of the records)     */
+    uint32_t recordSize; /**< the size of a record (a padded NmeaInfoPublisher)      */
+    uint32_t infoSize;   /**< the size of the info structure in a record             */
+    uint32_t reserved;   /**< reserved, zero                                         */
+    uint64_t devices;    /**< the number of records                                  */
+} NmeaBoardHeader;
+
+/* Forward declaration */
+typedef struct _NmeaBoard NmeaBoard;
+
+/**
+ * Create an info board (for the writer)
+ *
+ * Creates the shared memory segment, in which all records hold a cleared
+ * info structure.
+ *
+ * When the shared memory segment already exists (for example after a
+ * restart of the writer) and it is a board with the same layout, then it is
+ * reused: its records are left as they are, so that readers keep seeing the
+ * last published info structures. A board with fewer devices is grown, only
+ * its new records are initialised; readers that opened it before only see
+ * the records that existed then. A board with more devices is never shrunk,
+ * nor is a shared memory segment that is not a board (for example one that
+ * a writer left behind halfway through its creation) overwritten: remove it
+ * with nmeaBoardUnlink first.
+ *
+ * @param name The name of the shared memory segment, see shm_open
+ * @param devices The number of devices (records)
+ * @return The board, or NULL on failure
+ */
+NmeaBoard *nmeaBoardCreate(const char *name, size_t devices);
+
+/**
+ * Open an existing info board (for readers)
+ *
+ * The shared memory segment is mapped read-only.
+ *
+ * @param name The name of the shared memory segment, see shm_open
+ * @return The board, or NULL on failure or when the layout of the board
+ * differs
+ */
+NmeaBoard *nmeaBoardOpen(const char *name);
+
+/**
+ * Close an info board
+ *
+ * Unmaps the shared memory segment and frees the board. The shared memory
+ * segment itself remains, see nmeaBoardUnlink.
+ *
+ * @param board The board
+ */
+void nmeaBoardClose(NmeaBoard *board);
+
+/**
+ * Remove the shared memory segment of an info board
+ *
+ * Boards that are open remain usable until they are closed.
+ *
+ * @param name The name of the shared memory segment, see shm_open
+ * @return True on success
+ */
+bool nmeaBoardUnlink(const char *name);
+
+/**
+ * Get the number of devices (records) of an info board
+ *
+ * This is the number of devices when the board was mapped by this process.
+ *
+ * @param board The board
+ * @return The number of devices, 0 when board is NULL
+ */
+size_t nmeaBoardDevices(const NmeaBoard *board);
+
+/**
+ * Publish the info structure of a device
+ *
+ * Must only be called from one thread (of one process) at a time per
+ * device, on a board that was created with nmeaBoardCreate.
+ *
+ * @param board The board
+ * @param device The device
+ * @param info The info structure to publish (copied)
+ * @return True on success
+ */
+bool nmeaBoardPublish(NmeaBoard *board, size_t device, const NmeaInfo *info);
+
+/**
+ * Get a consistent copy of the info structure of a device
+ *
+ * Retries while the writer is publishing the info structure of the device,
+ * but gives up after a bounded number of attempts (see
+ * nmeaInfoPublisherTrySnapshot), so that a reader does not spin forever
+ * when the writer process died halfway through a publish.
+ *
+ * @param board The board
+ * @param device The device
+ * @param info The info structure in which to store the copy
+ * @param sequence Where to store the sequence counter of the copy (see
+ * nmeaInfoPublisherSnapshot), can be NULL
+ * @return True on success, false when no consistent copy could be made
+ */
+bool nmeaBoardSnapshot(const NmeaBoard *board, size_t device, NmeaInfo *info, uint32_t *sequence);
+
+/**
+ * Get the sequence counter of the info structure of a device
+ *
+ * @param board The board
+ * @param device The device
+ * @return The sequence counter (see nmeaInfoPublisherSequence), 0 when
+ * board is NULL or device is out of range
+ */
+uint32_t nmeaBoardSequence(const NmeaBoard *board, size_t device);
+
+#ifdef  __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __NMEALIB_BOARD_H__ */
@@ -0,0 +1,219 @@
+/*
+ * This file is part of nmealib.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file
+ * Compact info structure
+ *
+ * A NmeaInfo is large (it embeds room for NMEALIB_MAX_SATELLITES satellites
+ * in use and in view) and mostly empty. A NmeaInfoCompact holds the same
+ * information in narrower types, for keeping the state of many receivers in
+ * memory:
+ * - the frequently used scalar fields are in the first 64 bytes (one cache
+ *   line),
+ * - all fields except the latitude and longitude are stored in single
+ *   precision (about 7 significant digits) or in small integer types,
+ * - up to NMEALIB_INFO_COMPACT_SATELLITES satellites in use and in view are
+ *   stored inline, more satellites are stored out of line.
+ *
+ * Use nmeaInfoToCompact and nmeaInfoFromCompact to convert between the two
+ * representations, and nmeaInfoCompactSatellitesInUse and
+ * nmeaInfoCompactSatellitesInView to access the satellites.
+ *
+ * A NmeaInfoCompact can't be copied by assignment when it stores its
+ * satellites out of line, use nmeaInfoCompactCopy instead.
+ */
+
+#ifndef __NMEALIB_COMPACT_H__
+#define __NMEALIB_COMPACT_H__
+
+#include <nmealib/info.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef  __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/** The number of satellites in use and in view that are stored inline */
+#define NMEALIB_INFO_COMPACT_SATELLITES (16u)
+
+/**
+ * Compact date and time data
+ */
+typedef struct _NmeaTimeCompact {
+  uint16_t year; /**< Years                    - [1900, 2089]                 */
+  uint8_t  mon;  /**< Months                   - [   1,   12]                 */
+  uint8_t  day;  /**< Day of the month         - [   1,   31]                 */
+  uint8_t  hour; /**< Hours since midnight     - [   0,   23]                 */
+  uint8_t  min;  /**< Minutes after the hour   - [   0,   59]                 */
+  uint8_t  sec;  /**< Seconds after the minute - [   0,   60] (1 leap second) */
+  uint8_t  hsec; /**< Hundredth part of second - [   0,   99]                 */
+} NmeaTimeCompact;
+
+/**
+ * Compact information about a satellite
+ *
+ * The elevation is signed since receivers can report satellites below the
+ * horizon.
+ */
+typedef struct _NmeaSatelliteCompact {
+  uint16_t prn;       /**< Satellite PRN number             - [1, 65535] */
+  uint16_t azimuth;   /**< Azimuth, degrees from true north - [0,   359] */
+  int8_t   elevation; /**< Elevation, in degrees            - [0,    90] */
+  uint8_t  snr;       /**< Signal-to-Noise-Ratio            - [0,    99] */
+} NmeaSatelliteCompact;
+
+/**
+ * Out of line storage for the satellites of a compact info structure
+ */
+typedef struct _NmeaSatellitesCompact {
+  uint16_t             inUse[NMEALIB_MAX_SATELLITES];  /**< The PRNs of satellites in use */
+  NmeaSatelliteCompact inView[NMEALIB_MAX_SATELLITES]; /**< Satellites information (in view) */
+} NmeaSatellitesCompact;
+
+/**
+ * Compact GPS information from all supported sentences, see NmeaInfo for
+ * the meaning of the fields
+ *
+ * The satellites are stored without empty entries (with PRN zero), which is
+ * why the number of stored satellites can differ from the number of
+ * satellites that the receiver reported.
+ */
+typedef struct _NmeaInfoCompact {
+  /* first cache line */
+  uint32_t               present;                                 /**< Bit-mask specifying which fields are present                    */
+  uint32_t               smask;                                   /**< Bit-mask specifying from which sentences data has been obtained */
+  double                 latitude;                                /**< Latitude,  in NDEG: +/-[degree][min].[sec/60]                   */
+  double                 longitude;                               /**< Longitude, in NDEG: +/-[degree][min].[sec/60]                   */
+  NmeaTimeCompact        utc;                                     /**< UTC of the position data                                        */
+  float                  elevation;                               /**< Elevation above/below mean sea level (geoid), in meters         */
+  float                  speed;                                   /**< Speed over the ground in kph                                    */
+  float                  track;                                   /**< Track angle in degrees true north                               */
+  float                  hdop;                                    /**< Horizontal Dilution Of Precision                                */
+  int8_t                 sig;                                     /**< Signal quality, see NMEALIB_SIG_* signals                       */
+  int8_t                 fix;                                     /**< Operating mode, see NMEALIB_FIX_* fixes                         */
+  uint8_t                inUseCount;                              /**< The number of satellites in use (not those in view)             */
+  uint8_t                inViewCount;                             /**< The number of satellites in view                                */
+  float                  pdop;                                    /**< Position Dilution Of Precision                                  */
+  float                  vdop;                                    /**< Vertical Dilution Of Precision                                  */
+  float                  height;                                  /**< Height of geoid (elevation) above WGS84 ellipsoid, in meters    */
+
+  /* the rest */
+  float                  mtrack;                                  /**< Magnetic Track angle in degrees true north                      */
+  float                  magvar;                                  /**< Magnetic variation in degrees                                   */
+  float                  dgpsAge;                                 /**< Time since last DGPS update, in seconds                         */
+  uint16_t               dgpsSid;                                 /**< DGPS station ID number                                          */
+  bool                   gpgsvInProgress;                         /**< true when gpgsv is in progress                                  */
+  bool                   metric;                                  /**< When true then units are metric                                 */
+  uint8_t                inUseStored;                             /**< The number of stored PRNs of satellites in use                  */
+  uint8_t                inViewStored;                            /**< The number of stored satellites in view                         */
+  NmeaSatellitesCompact *satellites;                              /**< The out of line satellites, NULL when they are stored inline    */
+  uint16_t               inUse[NMEALIB_INFO_COMPACT_SATELLITES];  /**< The PRNs of satellites in use, when stored inline               */
+  NmeaSatelliteCompact   inView[NMEALIB_INFO_COMPACT_SATELLITES]; /**< Satellites information (in view), when stored inline           */
+} NmeaInfoCompact;
+
+/**
+ * Get the PRNs of the satellites in use of a compact info structure
+ *
+ * @param info The compact info structure
+ * @return The PRNs of the satellites in use (inUseStored entries)
+ */
+static INLINE const uint16_t *nmeaInfoCompactSatellitesInUse(const NmeaInfoCompact *info) {
+  return info->satellites ?
+      info->satellites->inUse :
+      info->inUse;
+}
+
+/**
+ * Get the satellites in view of a compact info structure
+ *
+ * @param info The compact info structure
+ * @return The satellites in view (inViewStored entries)
+ */
+static INLINE const NmeaSatelliteCompact *nmeaInfoCompactSatellitesInView(const NmeaInfoCompact *info) {
+  return info->satellites ?
+      info->satellites->inView :
+      info->inView;
+}
+
+/**
+ * Clear a compact info structure, like nmeaInfoClear does
+ *
+ * Frees the out of line satellites. The structure must either be zeroed or
+ * have been cleared before.
+ *
+ * @param info The compact info structure
+ */
+void nmeaInfoCompactClear(NmeaInfoCompact *info);
+
+/**
+ * Free the out of line satellites of a compact info structure
+ *
+ * The stored satellite counts are reset when satellites were stored out of
+ * line.
+ *
+ * @param info The compact info structure
+ */
+void nmeaInfoCompactDestroy(NmeaInfoCompact *info);
+
+/**
+ * Copy a compact info structure
+ *
+ * Allocates memory for the out of line satellites when needed and frees
+ * those of the destination that are no longer needed. The destination must
+ * either be zeroed or have been cleared before.
+ *
+ * @param dst The destination compact info structure
+ * @param src The source compact info structure
+ * @return True on success
+ */
+bool nmeaInfoCompactCopy(NmeaInfoCompact *dst, const NmeaInfoCompact *src);
+
+/**
+ * Convert an info structure into a compact info structure
+ *
+ * Allocates memory for the out of line satellites when there are more than
+ * NMEALIB_INFO_COMPACT_SATELLITES (non-empty) satellites in use or in view,
+ * and frees them when they are no longer needed. The compact info structure
+ * must either be zeroed or have been cleared before.
+ *
+ * Values that don't fit the narrower types are clamped.
+ *
+ * @param info The info structure
+ * @param compact The compact info structure
+ * @return True on success
+ */
+bool nmeaInfoToCompact(const NmeaInfo *info, NmeaInfoCompact *compact);
+
+/**
+ * Convert a compact info structure into an info structure
+ *
+ * The stored satellites end up at the start of the satellite arrays of the
+ * info structure.
+ *
+ * @param compact The compact info structure
+ * @param info The info structure
+ */
+void nmeaInfoFromCompact(const NmeaInfoCompact *compact, NmeaInfo *info);
+
+#ifdef  __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __NMEALIB_COMPACT_H__ */
@@ -0,0 +1,175 @@
+/*
+ * This file is part of nmealib.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file
+ * Epoch assembler
+ *
+ * A receiver emits a burst of sentences (GGA, GSA, GSV, RMC, VTG, ...) for
+ * every epoch. The epoch assembler sits on top of the parser and groups the
+ * sentences of a burst into one consolidated info structure, which is
+ * handed to a handler function once the epoch is over.
+ *
+ * An epoch is over when:
+ * - a sentence with a different UTC time than the epoch arrives (that
+ *   sentence starts the next epoch),
+ * - the configured terminating sentence arrives,
+ * - no sentence arrived during the configured timeout, or
+ * - the assembler is flushed.
+ *
+ * Every epoch starts from a cleared info structure, so the info structure
+ * of an epoch only contains the information of the sentences of that epoch.
+ */
+
+#ifndef __NMEALIB_EPOCH_H__
+#define __NMEALIB_EPOCH_H__
+
+#include <nmealib/info.h>
+#include <nmealib/parser.h>
+#include <nmealib/sentence.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <time.h>
+
+#ifdef  __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * The reason why an epoch is over
+ */
+typedef enum _NmeaEpochEnd {
+  NMEALIB_EPOCH_END_UTC,        /**< a sentence with a different UTC time arrived */
+  NMEALIB_EPOCH_END_TERMINATOR, /**< the terminating sentence arrived             */
+  NMEALIB_EPOCH_END_TIMEOUT,    /**< no sentence arrived during the timeout       */
+  NMEALIB_EPOCH_END_FLUSH       /**< the assembler was flushed                    */
+} NmeaEpochEnd;
+
+/**
+ * Epoch: the consolidated information of the sentences of one epoch
+ */
+typedef struct _NmeaEpoch {
+    NmeaInfo     info;      /**< the consolidated info of the sentences of the epoch  */
+    size_t       sentences; /**< the number of sentences of the epoch                 */
+    bool         complete;  /**< true when the epoch satisfies the completeness policy */
+    NmeaEpochEnd end;       /**< the reason why the epoch is over                     */
+} NmeaEpoch;
+
+/**
+ * Epoch handler function definition
+ *
+ * @param user The user pointer of the assembler configuration
+ * @param epoch The epoch, only valid during the call
+ */
+typedef void (*NmeaEpochHandler)(void *user, const NmeaEpoch *epoch);
+
+/**
+ * Epoch assembler configuration
+ *
+ * An epoch is complete when all sentences in 'required' and all fields in
+ * 'requiredPresent' were received.
+ */
+typedef struct _NmeaEpochConfig {
+    NmeaSentence     terminator;      /**< the sentences that terminate an epoch, zero to only use UTC changes */
+    NmeaSentence     required;        /**< the sentences that a complete epoch must contain                    */
+    uint32_t         requiredPresent; /**< the NmeaPresence fields that a complete epoch must contain          */
+    bool             emitIncomplete;  /**< true to also hand incomplete epochs to the handler                  */
+    unsigned int     timeout;         /**< the epoch timeout in milliseconds, zero for no timeout              */
+    NmeaEpochHandler handler;         /**< the epoch handler                                                   */
+    void            *user;            /**< the user pointer that is passed to the handler                      */
+} NmeaEpochConfig;
+
+/**
+ * Epoch assembler
+ */
+typedef struct _NmeaEpochAssembler {
+    NmeaEpochConfig config;  /**< the configuration                          */
+    NmeaParser      parser;  /**< the parser                                 */
+    NmeaEpoch       epoch;   /**< the epoch that is being assembled          */
+    struct timespec last;    /**< the (monotonic) time of the last sentence  */
+} NmeaEpochAssembler;
+
+/**
+ * Initialise the epoch assembler
+ *
+ * Allocates memory for the parse buffer of its parser.
+ *
+ * @param assembler The assembler
+ * @param config The assembler configuration (copied)
+ * @return True on success
+ */
+bool nmeaEpochAssemblerInit(NmeaEpochAssembler *assembler, const NmeaEpochConfig *config);
+
+/**
+ * Destroy the epoch assembler
+ *
+ * Frees memory of the parse buffer of its parser. A pending epoch is
+ * discarded, use nmeaEpochAssemblerFlush first to get it.
+ *
+ * @param assembler The assembler
+ */
+void nmeaEpochAssemblerDestroy(NmeaEpochAssembler *assembler);
+
+/**
+ * Add a (complete) NMEA sentence to the epoch that is being assembled
+ *
+ * Use this function when the sentences were already split up, otherwise
+ * use nmeaEpochAssemblerParse.
+ *
+ * @param assembler The assembler
+ * @param s The sentence
+ * @param sz The length of the sentence
+ * @return The number of epochs that were handed to the handler
+ */
+size_t nmeaEpochAssemblerSentence(NmeaEpochAssembler *assembler, const char *s, size_t sz);
+
+/**
+ * Parse NMEA sentences from a (string) buffer and add them to the epoch
+ * that is being assembled
+ *
+ * @param assembler The assembler
+ * @param s The (string) buffer
+ * @param sz The length of the string in the buffer
+ * @return The number of epochs that were handed to the handler
+ */
+size_t nmeaEpochAssemblerParse(NmeaEpochAssembler *assembler, const char *s, size_t sz);
+
+/**
+ * End the epoch that is being assembled when its timeout expired
+ *
+ * Call this function periodically when the input can stall, so that the
+ * last epoch before the stall is not delayed until the next input.
+ *
+ * @param assembler The assembler
+ * @return The number of epochs that were handed to the handler
+ */
+size_t nmeaEpochAssemblerPoll(NmeaEpochAssembler *assembler);
+
+/**
+ * End the epoch that is being assembled
+ *
+ * @param assembler The assembler
+ * @return The number of epochs that were handed to the handler
+ */
+size_t nmeaEpochAssemblerFlush(NmeaEpochAssembler *assembler);
+
+#ifdef  __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __NMEALIB_EPOCH_H__ */
@@ -0,0 +1,157 @@
+/*
+ * This file is part of nmealib.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file
+ * Fleet simulator
+ *
+ * Simulates many receivers ('vehicles') on a pool of worker threads. Every
+ * worker thread owns a contiguous range of vehicles, a generator chain and
+ * a private (seeded) random number generator, see nmeaRandomSeedThread.
+ *
+ * Every epoch a worker thread invokes its generator chain on all its
+ * vehicles at once (see nmeaGeneratorInvokeBatch) and then generates the
+ * configured sentences of every vehicle, which are either handed to a
+ * callback or written to a file descriptor (a file, a pipe or a socket).
+ * Writes to the file descriptor only contain complete sentences, so the
+ * streams of the vehicles interleave on sentence boundaries.
+ */
+
+#ifndef __NMEALIB_FLEET_H__
+#define __NMEALIB_FLEET_H__
+
+#include <nmealib/generator.h>
+#include <nmealib/info.h>
+#include <nmealib/sentence.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef  __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/* Forward declaration */
+typedef struct _NmeaFleet NmeaFleet;
+
+/**
+ * Fleet vehicle initialiser function definition
+ *
+ * Called once for every vehicle, after its info structure has been
+ * initialised by the generator chain, for example to set up the starting
+ * position.
+ *
+ * @param user The user pointer of the fleet configuration
+ * @param vehicle The index of the vehicle
+ * @param info The info structure of the vehicle
+ */
+typedef void (*NmeaFleetInit)(void *user, size_t vehicle, NmeaInfo *info);
+
+/**
+ * Fleet output function definition
+ *
+ * Called from the worker threads, concurrently.
+ *
+ * @param user The user pointer of the fleet configuration
+ * @param vehicle The index of the vehicle
+ * @param s The generated sentences of one epoch of the vehicle
+ * @param sz The length of the generated sentences
+ */
+typedef void (*NmeaFleetOutput)(void *user, size_t vehicle, const char *s, size_t sz);
+
+/**
+ * Fleet configuration
+ */
+typedef struct _NmeaFleetConfig {
+    size_t            vehicles; /**< the number of vehicles                                        */
+    size_t            threads;  /**< the number of worker threads (capped to the vehicles)         */
+    NmeaGeneratorType type;     /**< the type of the generator chains                              */
+    NmeaSentence      mask;     /**< the sentences to generate every epoch                         */
+    double            rate;     /**< epochs per second per vehicle, zero for as fast as possible   */
+    uint64_t          epochs;   /**< epochs per vehicle, zero to run until stopped                 */
+    uint64_t          seed;     /**< the seed of the random number generators of the workers       */
+    int               fd;       /**< the file descriptor to write to (when there is no output)     */
+    NmeaFleetInit     init;     /**< the vehicle initialiser, can be NULL                          */
+    NmeaFleetOutput   output;   /**< the output function, can be NULL to write to fd instead       */
+    void             *user;     /**< the user pointer that is passed to init and output            */
+} NmeaFleetConfig;
+
+/**
+ * Create a fleet: an info structure for every vehicle and a generator
+ * chain for every worker thread
+ *
+ * Allocates memory for the fleet. The fleet is not started.
+ *
+ * @param config The fleet configuration (copied)
+ * @return The fleet, or NULL on failure
+ */
+NmeaFleet *nmeaFleetCreate(const NmeaFleetConfig *config);
+
+/**
+ * Destroy the fleet
+ *
+ * Stops the fleet and waits for it first when it is running. Frees the
+ * allocated fleet memory too.
+ *
+ * @param fleet The fleet
+ */
+void nmeaFleetDestroy(NmeaFleet *fleet);
+
+/**
+ * Start the worker threads of the fleet
+ *
+ * @param fleet The fleet
+ * @return True on success
+ */
+bool nmeaFleetStart(NmeaFleet *fleet);
+
+/**
+ * Request the worker threads of the fleet to stop (after their current
+ * epoch)
+ *
+ * Does not wait for the worker threads, use nmeaFleetJoin for that. Can be
+ * called from any thread.
+ *
+ * @param fleet The fleet
+ */
+void nmeaFleetStop(NmeaFleet *fleet);
+
+/**
+ * Wait for the worker threads of the fleet to finish: after the configured
+ * number of epochs, or after the fleet was stopped
+ *
+ * @param fleet The fleet
+ * @return True when no worker failed
+ */
+bool nmeaFleetJoin(NmeaFleet *fleet);
+
+/**
+ * Get the statistics of the fleet
+ *
+ * Can be called while the fleet is running.
+ *
+ * @param fleet The fleet
+ * @param epochs Where to store the total number of generated vehicle epochs, can be NULL
+ * @param bytes Where to store the total number of generated bytes, can be NULL
+ */
+void nmeaFleetStatistics(const NmeaFleet *fleet, uint64_t *epochs, uint64_t *bytes);
+
+#ifdef  __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __NMEALIB_FLEET_H__ */
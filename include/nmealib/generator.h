@@ -22,6 +22,7 @@
 #include <nmealib/sentence.h>
 #include <stdbool.h>
 #include <stddef.h>
+#include <sys/time.h>
 
 #ifdef  __cplusplus
 extern "C" {
@@ -41,7 +42,8 @@ typedef enum _NmeaGeneratorType {
   NMEALIB_GENERATOR_SAT_STATIC   = 3u,
   NMEALIB_GENERATOR_SAT_ROTATE   = 4u,
   NMEALIB_GENERATOR_POS_RANDMOVE = 5u,
-  NMEALIB_GENERATOR_LAST         = NMEALIB_GENERATOR_POS_RANDMOVE
+  NMEALIB_GENERATOR_REPLAY       = 6u,
+  NMEALIB_GENERATOR_LAST         = NMEALIB_GENERATOR_REPLAY
 } NmeaGeneratorType;
 
 /**
@@ -62,6 +64,16 @@ typedef bool (*NmeaGeneratorInit)(NmeaGenerator *gen, NmeaInfo *info);
  */
 typedef bool (*NmeaGeneratorInvoke)(NmeaGenerator *gen, NmeaInfo *info);
 
+/**
+ * Generator batch invoke function definition
+ *
+ * @param gen The generator
+ * @param infos The info structures to use during generation
+ * @param n The number of info structures
+ * @return True on success
+ */
+typedef bool (*NmeaGeneratorInvokeBatch)(NmeaGenerator *gen, NmeaInfo *infos, size_t n);
+
 /**
  * Generator reset function definition
  *
@@ -75,23 +87,89 @@ typedef bool (*NmeaGeneratorReset)(NmeaGenerator *gen, NmeaInfo *info);
  * Generator structure
  */
 typedef struct _NmeaGenerator {
-    NmeaGeneratorInit     init;   /**< initialiser function */
-    NmeaGeneratorInvoke   invoke; /**< invoke function      */
-    NmeaGeneratorReset    reset;  /**< reset function       */
-    NmeaGenerator        *next;   /**< the next generator   */
+    NmeaGeneratorInit         init;        /**< initialiser function                 */
+    NmeaGeneratorInvoke       invoke;      /**< invoke function                      */
+    NmeaGeneratorInvokeBatch  invokeBatch; /**< batch invoke function, can be NULL   */
+    NmeaGeneratorReset        reset;       /**< reset function                       */
+    NmeaGenerator            *next;        /**< the next generator                   */
 } NmeaGenerator;
 
+/**
+ * REPLAY generator configuration
+ */
+typedef struct _NmeaGeneratorReplayConfig {
+    double         speed;  /**< the playback speed: 1.0 for real time, N for N times faster, 0.0 for as fast as possible */
+    double         jitter; /**< the maximum random deviation of the playback of an epoch, in (real time) seconds        */
+    bool           loop;   /**< restart at the first epoch after the last epoch                                         */
+    struct timeval start;  /**< the utc of the first epoch, zero to use the time of the first invoke                     */
+} NmeaGeneratorReplayConfig;
+
 /**
  * Create a generator and initialise it
  *
  * Allocates memory for the generator.
  *
+ * A NMEALIB_GENERATOR_REPLAY generator can't be created with this function
+ * since it needs recorded epochs, use nmeaGeneratorCreateReplay or
+ * nmeaGeneratorCreateReplayLog instead.
+ *
  * @param type The type of the generator to create
  * @param info The info structure to use during generation
  * @return The generator, or NULL on failure
  */
 NmeaGenerator *nmeaGeneratorCreate(NmeaGeneratorType type, NmeaInfo *info);
 
+/**
+ * Create a REPLAY generator and initialise it
+ *
+ * Allocates memory for the generator and copies the epochs into it.
+ *
+ * Every invoke replaces info by the next recorded epoch and re-stamps its
+ * utc (through nmeaTimeSet) to the start time plus the offset of the epoch
+ * from the first recorded epoch, divided by the playback speed. When the
+ * speed is non-zero then the invoke sleeps until the (jittered) playback
+ * time of the epoch, so that the epochs are played back at the recorded
+ * pace (or N times faster). Epochs without utc time are played back
+ * together with the preceding epoch.
+ *
+ * The invoke fails after the last epoch, unless looping is configured. A
+ * reset restarts the playback at the first epoch.
+ *
+ * Since every invoke replaces info, this generator must be the first one of
+ * a generator chain.
+ *
+ * @param epochs The recorded epochs
+ * @param count The number of recorded epochs
+ * @param config The playback configuration (copied), NULL for real time
+ * playback without jitter and looping
+ * @param info The info structure to use during generation
+ * @return The generator, or NULL on failure
+ */
+NmeaGenerator *nmeaGeneratorCreateReplay(const NmeaInfo *epochs, size_t count, const NmeaGeneratorReplayConfig *config,
+    NmeaInfo *info);
+
+/**
+ * Create a REPLAY generator from a recorded NMEA log and initialise it
+ *
+ * Parses the log into epochs: a new epoch is started by every sentence that
+ * changes the utc time. The parsed information accumulates over the log,
+ * every epoch holds the information as it was after the last sentence of
+ * the epoch. Sentences before the first sentence with a utc time don't
+ * start an epoch, their information is carried into the first epoch.
+ *
+ * See nmeaGeneratorCreateReplay for the playback.
+ *
+ * @param s The (string) buffer with the recorded NMEA log
+ * @param sz The length of the string in the buffer
+ * @param config The playback configuration (copied), NULL for real time
+ * playback without jitter and looping
+ * @param info The info structure to use during generation
+ * @return The generator, or NULL on failure (also when the log has no
+ * epochs)
+ */
+NmeaGenerator *nmeaGeneratorCreateReplayLog(const char *s, size_t sz, const NmeaGeneratorReplayConfig *config,
+    NmeaInfo *info);
+
 /**
  * Destroy the generator
  *
@@ -119,6 +197,27 @@ bool nmeaGeneratorInit(NmeaGenerator *gen, NmeaInfo *info);
  */
 bool nmeaGeneratorInvoke(NmeaGenerator *gen, NmeaInfo *info);
 
+/**
+ * Invoke the generator on an array of info structures
+ *
+ * Every generator of the chain is invoked on all info structures before
+ * the next generator of the chain is invoked. Generators that have a batch
+ * invoke function process the whole array in one go, the others are
+ * invoked for every info structure in turn.
+ *
+ * The result is the same as invoking the generator on every info structure
+ * in turn, except that the generators that set the utc time use the same
+ * time for all info structures, and that random numbers are drawn in a
+ * different order.
+ *
+ * @param gen The generator
+ * @param infos The info structures to use during generation
+ * @param n The number of info structures
+ * @return True on success, false when a generator failed (the remaining
+ * generators of the chain are then not invoked)
+ */
+bool nmeaGeneratorInvokeBatch(NmeaGenerator *gen, NmeaInfo *infos, size_t n);
+
 /**
  * Reset the generator
  *
@@ -0,0 +1,180 @@
+/*
+ * This file is part of nmealib.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file
+ * Geofences
+ *
+ * A geofence set holds circles and polygons ('fences') and tracks for every
+ * device which fences it is in. Every fix of a device is tested against the
+ * fences, and entering or leaving a fence is reported to a handler function.
+ *
+ * The fences are indexed with a uniform grid of latitude/longitude cells:
+ * every cell lists the fences whose bounding box overlaps it, so a fix is
+ * only tested against the fences of its cell. The index is (re)built on the
+ * first fix after fences were added.
+ *
+ * Circles with a radius up to 10 km are tested in the tangent plane of the
+ * WGS84 ellipsoid (see nmeaMathDistanceTangentPlane, an error of at most
+ * 4 cm at the boundary), larger circles with the WGS84 geodesic (see
+ * nmeaGeodesicInverse). Polygons are tested in the latitude/longitude
+ * plane (edges are straight lines in that plane), they must span less than
+ * 180 degrees of longitude and must not contain a pole.
+ *
+ * A geofence set is not thread safe.
+ */
+
+#ifndef __NMEALIB_GEOFENCE_H__
+#define __NMEALIB_GEOFENCE_H__
+
+#include <nmealib/info.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef  __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/** The default size of the cells of the index, in degrees */
+#define NMEALIB_GEOFENCE_CELL_SIZE_DEFAULT (0.1)
+
+/* Forward declaration */
+typedef struct _NmeaGeofences NmeaGeofences;
+
+/**
+ * Geofence event
+ */
+typedef enum _NmeaGeofenceEvent {
+  NMEALIB_GEOFENCE_ENTER, /**< the device entered the fence */
+  NMEALIB_GEOFENCE_EXIT   /**< the device left the fence    */
+} NmeaGeofenceEvent;
+
+/**
+ * Geofence event handler function definition
+ *
+ * The handler must not update the geofence set.
+ *
+ * @param user The user pointer of the geofence configuration
+ * @param device The index of the device
+ * @param id The identifier of the fence
+ * @param event The event
+ */
+typedef void (*NmeaGeofenceHandler)(void *user, size_t device, uint32_t id, NmeaGeofenceEvent event);
+
+/**
+ * Geofence configuration
+ */
+typedef struct _NmeaGeofenceConfig {
+    size_t              devices;  /**< the number of devices                                            */
+    double              cellSize; /**< the size of the cells of the index in degrees, zero for the default */
+    NmeaGeofenceHandler handler;  /**< the event handler, can be NULL                                   */
+    void               *user;     /**< the user pointer that is passed to the handler                   */
+} NmeaGeofenceConfig;
+
+/**
+ * Create a geofence set without fences
+ *
+ * Allocates memory for the geofence set.
+ *
+ * @param config The geofence configuration (copied)
+ * @return The geofence set, or NULL on failure
+ */
+NmeaGeofences *nmeaGeofencesCreate(const NmeaGeofenceConfig *config);
+
+/**
+ * Destroy the geofence set
+ *
+ * Frees the allocated geofence set memory.
+ *
+ * @param geofences The geofence set
+ */
+void nmeaGeofencesDestroy(NmeaGeofences *geofences);
+
+/**
+ * Get the number of fences of the geofence set
+ *
+ * @param geofences The geofence set
+ * @return The number of fences
+ */
+size_t nmeaGeofencesCount(const NmeaGeofences *geofences);
+
+/**
+ * Add a circle to the geofence set
+ *
+ * @param geofences The geofence set
+ * @param id The identifier of the fence, passed to the handler
+ * @param centre The centre of the circle (in radians)
+ * @param radius The radius of the circle (in meters)
+ * @return True on success
+ */
+bool nmeaGeofencesAddCircle(NmeaGeofences *geofences, uint32_t id, const NmeaPosition *centre, double radius);
+
+/**
+ * Add a polygon to the geofence set
+ *
+ * The polygon is closed implicitly: the last vertex connects to the first.
+ *
+ * @param geofences The geofence set
+ * @param id The identifier of the fence, passed to the handler
+ * @param vertices The vertices of the polygon (in radians)
+ * @param count The number of vertices, at least 3
+ * @return True on success
+ */
+bool nmeaGeofencesAddPolygon(NmeaGeofences *geofences, uint32_t id, const NmeaPosition *vertices, size_t count);
+
+/**
+ * Test a fix of a device against the fences, and hand the enter and exit
+ * events of the device to the handler
+ *
+ * The exit events are handed to the handler before the enter events.
+ *
+ * @param geofences The geofence set
+ * @param device The index of the device
+ * @param pos The position of the fix (in radians)
+ * @return The number of events
+ */
+size_t nmeaGeofencesUpdate(NmeaGeofences *geofences, size_t device, const NmeaPosition *pos);
+
+/**
+ * Test a fix of a device against the fences, and hand the enter and exit
+ * events of the device to the handler
+ *
+ * Fixes without latitude or longitude are ignored.
+ *
+ * @param geofences The geofence set
+ * @param device The index of the device
+ * @param info The info structure of the fix
+ * @return The number of events
+ */
+size_t nmeaGeofencesUpdateInfo(NmeaGeofences *geofences, size_t device, const NmeaInfo *info);
+
+/**
+ * Determine whether a device is in a fence, according to its last fix
+ *
+ * @param geofences The geofence set
+ * @param device The index of the device
+ * @param id The identifier of the fence
+ * @return True when the device is in a fence with the identifier
+ */
+bool nmeaGeofencesInside(const NmeaGeofences *geofences, size_t device, uint32_t id);
+
+#ifdef  __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __NMEALIB_GEOFENCE_H__ */
@@ -35,6 +35,24 @@ extern "C" {
 /** The NMEA prefix */
 #define NMEALIB_GPGGA_PREFIX "GPGGA"
 
+/**
+ * The maximum length of a generated GPGGA sentence (excluding the
+ * null-terminator), for any NmeaGPGGA structure
+ */
+#define NMEALIB_GPGGA_GENERATE_LENGTH_MAX ( \
+    (sizeof("$" NMEALIB_GPGGA_PREFIX) - 1UL) + \
+    (2UL + (4UL * NMEALIB_GENERATE_UINT_LENGTH_MAX)) /* time */ + \
+    (3UL + NMEALIB_GENERATE_DOUBLE_LENGTH_MAX(4UL)) /* latitude, ns */ + \
+    (3UL + NMEALIB_GENERATE_DOUBLE_LENGTH_MAX(4UL)) /* longitude, ew */ + \
+    (1UL + NMEALIB_GENERATE_INT_LENGTH_MAX) /* signal */ + \
+    (1UL + NMEALIB_GENERATE_UINT_LENGTH_MAX) /* satellites */ + \
+    (1UL + NMEALIB_GENERATE_DOUBLE_LENGTH_MAX(1UL)) /* hdop */ + \
+    (3UL + NMEALIB_GENERATE_DOUBLE_LENGTH_MAX(1UL)) /* elv, elv unit */ + \
+    (3UL + NMEALIB_GENERATE_DOUBLE_LENGTH_MAX(1UL)) /* height, height unit */ + \
+    (1UL + NMEALIB_GENERATE_DOUBLE_LENGTH_MAX(1UL)) /* dgps age */ + \
+    (1UL + NMEALIB_GENERATE_UINT_LENGTH_MAX) /* dgps id */ + \
+    NMEALIB_GENERATE_CHECKSUM_LENGTH)
+
 /**
  * GPGGA packet information structure (Global Positioning System Fix Data)
  *
@@ -113,8 +131,10 @@ bool nmeaGPGGAParse(const char *s, const size_t sz, NmeaGPGGA *pack);
  *
  * @param pack The GPGGA packet structure
  * @param info The unsanitised NmeaInfo structure
+ * @return The NmeaPresence bits of the fields of the NmeaInfo structure
+ * that changed: that were not present before, or of which the value differs
  */
-void nmeaGPGGAToInfo(const NmeaGPGGA *pack, NmeaInfo *info);
+uint32_t nmeaGPGGAToInfo(const NmeaGPGGA *pack, NmeaInfo *info);
 
 /**
  * Convert a sanitised NmeaInfo structure into a NmeaGPGGA structure
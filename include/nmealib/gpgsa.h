@@ -38,6 +38,18 @@ extern "C" {
 /** The number of satellite PRNs in the sentence */
 #define NMEALIB_GPGSA_SATS_IN_SENTENCE (12)
 
+/**
+ * The maximum length of a generated GPGSA sentence (excluding the
+ * null-terminator), for any NmeaGPGSA structure
+ */
+#define NMEALIB_GPGSA_GENERATE_LENGTH_MAX ( \
+    (sizeof("$" NMEALIB_GPGSA_PREFIX) - 1UL) + \
+    2UL /* sig */ + \
+    (1UL + NMEALIB_GENERATE_INT_LENGTH_MAX) /* fix */ + \
+    (NMEALIB_GPGSA_SATS_IN_SENTENCE * (1UL + NMEALIB_GENERATE_INT_LENGTH_MAX)) /* prns */ + \
+    (3UL * (1UL + NMEALIB_GENERATE_DOUBLE_LENGTH_MAX(1UL))) /* pdop, hdop, vdop */ + \
+    NMEALIB_GENERATE_CHECKSUM_LENGTH)
+
 /**
  * GPGSA packet information structure (Satellite status)
  *
@@ -113,8 +125,10 @@ bool nmeaGPGSAParse(const char *s, const size_t sz, NmeaGPGSA *pack);
  *
  * @param pack The GPGSA packet structure
  * @param info The unsanitised NmeaInfo structure
+ * @return The NmeaPresence bits of the fields of the NmeaInfo structure
+ * that changed: that were not present before, or of which the value differs
  */
-void nmeaGPGSAToInfo(const NmeaGPGSA *pack, NmeaInfo *info);
+uint32_t nmeaGPGSAToInfo(const NmeaGPGSA *pack, NmeaInfo *info);
 
 /**
  * Convert a sanitised NmeaInfo structure into a NmeaGPGSA structure
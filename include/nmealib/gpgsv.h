@@ -47,6 +47,17 @@ extern "C" {
 /** The maximum number of GPGSV sentences (depends on the maximum number of satellites tracked) */
 #define NMEALIB_GPGSV_MAX_SENTENCES (NMEALIB_MAX_SATELLITES >> NMEALIB_GPGSV_MAX_SATS_PER_SENTENCE_SHIFT)
 
+/**
+ * The maximum length of a single generated GPGSV sentence (excluding the
+ * null-terminator), for any NmeaGPGSV structure
+ */
+#define NMEALIB_GPGSV_GENERATE_LENGTH_MAX ( \
+    (sizeof("$" NMEALIB_GPGSV_PREFIX) - 1UL) + \
+    (3UL * (1UL + NMEALIB_GENERATE_UINT_LENGTH_MAX)) /* sentences, sentence, satellites */ + \
+    (NMEALIB_GPGSV_MAX_SATS_PER_SENTENCE * \
+        (4UL + (3UL * NMEALIB_GENERATE_UINT_LENGTH_MAX) + NMEALIB_GENERATE_INT_LENGTH_MAX)) /* satellites */ + \
+    NMEALIB_GENERATE_CHECKSUM_LENGTH)
+
 /**
  * GPGSV packet information structure (Satellites in view)
  *
@@ -122,6 +133,18 @@ typedef struct _NmeaGPGSV {
  */
 size_t nmeaGPGSVsatellitesToSentencesCount(const size_t satellites);
 
+/**
+ * The satellites of a GPGSV sequence that is in progress
+ *
+ * Kept outside of the NmeaInfo structure (by the parser, for example) so
+ * that it is not part of the published information.
+ */
+typedef struct _NmeaGPGSVStaging {
+  bool          inViewCountPresent;             /**< true when the sequence has a satellite count */
+  unsigned int  inViewCount;                    /**< the number of satellites in view             */
+  NmeaSatellite inView[NMEALIB_MAX_SATELLITES]; /**< the satellites (in view) of the sequence     */
+} NmeaGPGSVStaging;
+
 /**
  * Parse a GPGSV sentence
  *
@@ -135,10 +158,22 @@ bool nmeaGPGSVParse(const char *s, const size_t sz, NmeaGPGSV *pack);
 /**
  * Update an unsanitised NmeaInfo structure from a GPGSV packet structure
  *
+ * With a staging structure, the satellites of a GPGSV sequence are collected
+ * in the staging structure and are only published into the satellites in
+ * view of the NmeaInfo structure when the last sentence of the sequence is
+ * converted, so that readers only see complete sequences. Without a staging
+ * structure, every sentence is published as it is converted. A sentence
+ * that does not continue the sequence in progress drops the sequence.
+ *
+ * A staging structure must only be used with one NmeaInfo structure.
+ *
  * @param pack The GPGSV packet structure
  * @param info The unsanitised NmeaInfo structure
+ * @param staging The staging structure, can be NULL
+ * @return The NmeaPresence bits of the fields of the NmeaInfo structure
+ * that changed: that were not present before, or of which the value differs
  */
-void nmeaGPGSVToInfo(const NmeaGPGSV *pack, NmeaInfo *info);
+uint32_t nmeaGPGSVToInfo(const NmeaGPGSV *pack, NmeaInfo *info, NmeaGPGSVStaging *staging);
 
 /**
  * Convert a sanitised NmeaInfo structure into a NmeaGPGSV structure
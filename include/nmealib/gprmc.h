@@ -35,6 +35,23 @@ extern "C" {
 /** The NMEA prefix */
 #define NMEALIB_GPRMC_PREFIX "GPRMC"
 
+/**
+ * The maximum length of a generated GPRMC sentence (excluding the
+ * null-terminator), for any NmeaGPRMC structure
+ */
+#define NMEALIB_GPRMC_GENERATE_LENGTH_MAX ( \
+    (sizeof("$" NMEALIB_GPRMC_PREFIX) - 1UL) + \
+    (2UL + (4UL * NMEALIB_GENERATE_UINT_LENGTH_MAX)) /* time */ + \
+    2UL /* sigSelection */ + \
+    (3UL + NMEALIB_GENERATE_DOUBLE_LENGTH_MAX(4UL)) /* latitude, ns */ + \
+    (3UL + NMEALIB_GENERATE_DOUBLE_LENGTH_MAX(4UL)) /* longitude, ew */ + \
+    (1UL + NMEALIB_GENERATE_DOUBLE_LENGTH_MAX(1UL)) /* speed */ + \
+    (1UL + NMEALIB_GENERATE_DOUBLE_LENGTH_MAX(1UL)) /* track */ + \
+    (1UL + (3UL * NMEALIB_GENERATE_UINT_LENGTH_MAX)) /* date */ + \
+    (3UL + NMEALIB_GENERATE_DOUBLE_LENGTH_MAX(1UL)) /* magvar, magvar ew */ + \
+    2UL /* sig */ + \
+    NMEALIB_GENERATE_CHECKSUM_LENGTH)
+
 /**
  * GPRMC -packet information structure (Recommended Minimum sentence C)
  *
@@ -103,8 +120,10 @@ bool nmeaGPRMCParse(const char *s, const size_t sz, NmeaGPRMC *pack);
  *
  * @param pack The GPRMC packet structure
  * @param info The unsanitised NmeaInfo structure
+ * @return The NmeaPresence bits of the fields of the NmeaInfo structure
+ * that changed: that were not present before, or of which the value differs
  */
-void nmeaGPRMCToInfo(const NmeaGPRMC *pack, NmeaInfo *info);
+uint32_t nmeaGPRMCToInfo(const NmeaGPRMC *pack, NmeaInfo *info);
 
 /**
  * Convert a sanitised NmeaInfo structure into a NmeaGPRMC structure
@@ -35,6 +35,15 @@ extern "C" {
 /** The NMEA prefix */
 #define NMEALIB_GPVTG_PREFIX "GPVTG"
 
+/**
+ * The maximum length of a generated GPVTG sentence (excluding the
+ * null-terminator), for any NmeaGPVTG structure
+ */
+#define NMEALIB_GPVTG_GENERATE_LENGTH_MAX ( \
+    (sizeof("$" NMEALIB_GPVTG_PREFIX) - 1UL) + \
+    (4UL * (3UL + NMEALIB_GENERATE_DOUBLE_LENGTH_MAX(1UL))) /* track, mtrack, spn, spk (with units) */ + \
+    NMEALIB_GENERATE_CHECKSUM_LENGTH)
+
 /**
  * GPVTG packet information structure (Track made good and ground speed)
  *
@@ -93,8 +102,10 @@ bool nmeaGPVTGParse(const char *s, const size_t sz, NmeaGPVTG *pack);
  *
  * @param pack The GPVTG packet structure
  * @param info The unsanitised NmeaInfo structure
+ * @return The NmeaPresence bits of the fields of the NmeaInfo structure
+ * that changed: that were not present before, or of which the value differs
  */
-void nmeaGPVTGToInfo(const NmeaGPVTG *pack, NmeaInfo *info);
+uint32_t nmeaGPVTGToInfo(const NmeaGPVTG *pack, NmeaInfo *info);
 
 /**
  * Convert a sanitised NmeaInfo structure into a NmeaGPVTG structure
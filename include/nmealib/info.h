@@ -20,6 +20,7 @@
 
 #include <nmealib/util.h>
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 #include <sys/time.h>
 
@@ -190,6 +191,83 @@ bool nmeaTimeParseTime(const char *s, NmeaTime *ntime);
  */
 bool nmeaTimeParseDate(const char *s, NmeaTime *date);
 
+/**
+ * Expand a 2-digit year like nmeaTimeParseDate does: years above 90 are in
+ * the 1900s, other years in the 2000s
+ *
+ * @param year The year, years from 100 are returned unchanged
+ * @return The (4-digit) year
+ */
+unsigned int nmeaTimeYearExpand(unsigned int year);
+
+/**
+ * Convert a time into seconds since the epoch (1970-01-01 00:00:00 UTC)
+ *
+ * Uses integer calendar arithmetic, without calling the c-library. A
+ * 2-digit year is expanded by nmeaTimeYearExpand. Leap seconds are not
+ * counted, like in POSIX time. The hundredths of a second are ignored.
+ * Every (unsigned) year fits.
+ *
+ * @param utc The time, the date must be valid
+ * @return The seconds since the epoch, 0 when utc is NULL
+ */
+int64_t nmeaTimeToEpochSeconds(const NmeaTime *utc);
+
+/**
+ * Convert a time into nanoseconds since the epoch, see
+ * nmeaTimeToEpochSeconds
+ *
+ * Nanoseconds since the epoch only fit in an int64_t from 1677-09-21 to
+ * 2262-04-11: earlier times return INT64_MIN, later times INT64_MAX. Use
+ * nmeaTimeToEpochSeconds for times outside that range.
+ *
+ * @param utc The time, the date must be valid
+ * @return The nanoseconds since the epoch, 0 when utc is NULL
+ */
+int64_t nmeaTimeToEpochNs(const NmeaTime *utc);
+
+/**
+ * Convert a time into microseconds since the epoch, see
+ * nmeaTimeToEpochSeconds
+ *
+ * Microseconds since the epoch fit in an int64_t for about 292000 years
+ * around the epoch: later times return INT64_MAX.
+ *
+ * @param utc The time, the date must be valid
+ * @return The microseconds since the epoch, 0 when utc is NULL
+ */
+int64_t nmeaTimeToEpochUs(const NmeaTime *utc);
+
+/**
+ * Convert seconds since the epoch and hundredths of a second into a time
+ *
+ * Uses integer calendar arithmetic, without calling the c-library.
+ *
+ * @param seconds The seconds since the epoch, not before the year 0
+ * @param hsec The hundredths of a second, [0 - 99]
+ * @param utc The time
+ */
+void nmeaTimeFromEpochSeconds(int64_t seconds, unsigned int hsec, NmeaTime *utc);
+
+/**
+ * Convert nanoseconds since the epoch into a time
+ *
+ * Uses integer calendar arithmetic, without calling the c-library. The
+ * time is truncated to hundredths of a second.
+ *
+ * @param ns The nanoseconds since the epoch, not before the year 0
+ * @param utc The time
+ */
+void nmeaTimeFromEpochNs(int64_t ns, NmeaTime *utc);
+
+/**
+ * Convert microseconds since the epoch into a time, see nmeaTimeFromEpochNs
+ *
+ * @param us The microseconds since the epoch, not before the year 0
+ * @param utc The time
+ */
+void nmeaTimeFromEpochUs(int64_t us, NmeaTime *utc);
+
 /**
  * Position data in decimal degrees or radians
  */
@@ -220,9 +298,15 @@ typedef struct _NmeaSatellites {
 
 /**
  * Information about progress on non-atomic sentences
+ *
+ * The satellites of a gpgsv sequence are collected outside of the info
+ * structure (see NmeaGPGSVStaging) and are published into its satellites
+ * in view under gpgsvSequence, see nmeaInfoSatellitesInViewSnapshot.
  */
 typedef struct _NmeaProgress {
-  bool gpgsvInProgress; /**< true when gpgsv is in progress */
+  bool         gpgsvInProgress; /**< true when gpgsv is in progress                      */
+  unsigned int gpgsvSentence;   /**< the last received sentence of the gpgsv sequence    */
+  uint32_t     gpgsvSequence;   /**< publication counter of inView, odd while publishing */
 } NmeaProgress;
 
 /**
@@ -421,6 +505,42 @@ static INLINE void nmeaInfoUnsetPresent(uint32_t *present, NmeaPresence fieldNam
   }
 }
 
+/**
+ * Determine whether setting a field of an info structure changes it
+ *
+ * @param present The 'present' field of the info structure (before the
+ * field is set)
+ * @param fieldName The field that is set
+ * @param differs True when the new value of the field differs from its
+ * current value
+ * @return fieldName when the field was not present or when its value
+ * differs, 0 otherwise
+ */
+static INLINE uint32_t nmeaInfoChanged(uint32_t present, NmeaPresence fieldName, bool differs) {
+  return (differs || !nmeaInfoIsPresentAll(present, fieldName)) ?
+      (uint32_t) fieldName :
+      0;
+}
+
+/**
+ * Clock function definition
+ *
+ * @param tv Where to store the current time
+ */
+typedef void (*NmeaTimeClockFunction)(struct timeval *tv);
+
+/**
+ * Set the clock that nmeaTimeSet uses when no time is provided to it
+ *
+ * Also affects nmeaInfoSanitise, which uses nmeaTimeSet for a missing date
+ * or time.
+ *
+ * @param clockFunction The clock, NULL to use the 'gettimeofday' c-library
+ * function
+ * @return The previous clock
+ */
+NmeaTimeClockFunction nmeaTimeSetClock(NmeaTimeClockFunction clockFunction);
+
 /**
  * Reset the time to now
  *
@@ -428,7 +548,7 @@ static INLINE void nmeaInfoUnsetPresent(uint32_t *present, NmeaPresence fieldNam
  * @param present The 'present' field (when non-NULL then the UTCDATE and
  * UTCTIME flags are set in it)
  * @param timeval If non-NULL then use this provided time, otherwise the
- * 'gettimeofday' c-library function is used to obtain it
+ * clock (see nmeaTimeSetClock) is used to obtain it
  */
 void nmeaTimeSet(NmeaTime *utc, uint32_t *present, struct timeval *timeval);
 
@@ -479,6 +599,79 @@ void nmeaInfoClear(NmeaInfo *info);
  */
 void nmeaInfoSanitise(NmeaInfo *info);
 
+/**
+ * Sanitise only the changed fields of an NmeaInfo structure
+ *
+ * Does the same as nmeaInfoSanitise, but only for the fields in 'changed'
+ * (and the fields that are sanitised together with them: UTCDATE and
+ * UTCTIME, LAT and LON, SPEED and TRACK and MTRACK). Use this after every
+ * sentence with the changed fields that nmeaParserParse reports, instead of
+ * sanitising the whole structure. Fields whose 'present' bit was unset
+ * since the last sanitise must be included in 'changed' too.
+ *
+ * @param info The NMEA info structure to sanitise
+ * @param changed The NmeaPresence bits of the fields that changed since
+ * the last sanitise
+ */
+void nmeaInfoSanitiseChanged(NmeaInfo *info, uint32_t changed);
+
+/**
+ * Sanitise an array of NmeaInfo structures
+ *
+ * Does the same as nmeaInfoSanitise for every info structure, but processes
+ * the DOPs, position, speed, tracks, magvar and dgpsAge of blocks of info
+ * structures column by column, in loops without branches that the compiler
+ * can vectorise. Use this for bulk (re)processing of stored fixes.
+ *
+ * @param infos The NMEA info structures to sanitise
+ * @param count The number of info structures
+ */
+void nmeaInfoSanitiseBatch(NmeaInfo *infos, size_t count);
+
+/**
+ * Publish satellites in view (and their count) into an info structure
+ *
+ * The functions that update the satellites in view and their count of an
+ * existing info structure (the sentence conversions, nmeaParserParse,
+ * sanitising, nmeaInfoFromCompact, the satellite store and the generators)
+ * use this function, so that nmeaInfoSatellitesInViewSnapshot never copies
+ * a partially written table. Functions that (re)initialise a whole info
+ * structure, such as nmeaInfoClear, nmeaRecordToInfo and the REPLAY
+ * generator, don't. The publication counter only changes when the
+ * satellites in view or their count change. Does not touch the 'present'
+ * bit-mask.
+ *
+ * @param info The info structure
+ * @param inView The satellites in view (NMEALIB_MAX_SATELLITES satellites),
+ * NULL to clear them
+ * @param inViewCount The number of satellites in view
+ * @return True when the satellites in view or their count changed
+ */
+bool nmeaInfoSatellitesInViewPublish(NmeaInfo *info, const NmeaSatellite *inView, unsigned int inViewCount);
+
+/**
+ * Get a consistent copy of the satellites in view (and their count) of an
+ * info structure
+ *
+ * The satellites in view are published as a whole when the last sentence
+ * of a gpgsv sequence is converted into the info structure, or when they
+ * are sanitised or cleared, see nmeaInfoSatellitesInViewPublish. This
+ * function can be called from a thread other than the one that writes the
+ * info structure, without locking: it retries the copy until it did not
+ * overlap with a publication. Functions that (re)initialise the whole
+ * info structure (see nmeaInfoSatellitesInViewPublish) must not overlap
+ * with this function.
+ *
+ * @param info The info structure
+ * @param inView The array (of NMEALIB_MAX_SATELLITES satellites) in which
+ * to store the satellites in view
+ * @param inViewCount Where to store the number of satellites in view that
+ * belongs to the copied satellites, can be NULL
+ * @return The publication counter of the copied satellites in view, which
+ * changes on every publication
+ */
+uint32_t nmeaInfoSatellitesInViewSnapshot(const NmeaInfo *info, NmeaSatellite *inView, unsigned int *inViewCount);
+
 /**
  * Converts the position fields to degrees and DOP fields to meters so that
  * all fields use normal metric units or original units.
@@ -492,6 +685,17 @@ void nmeaInfoSanitise(NmeaInfo *info);
  */
 void nmeaInfoUnitConversion(NmeaInfo *info, bool toMetric);
 
+/**
+ * Does the same as nmeaInfoUnitConversion for every info structure of an
+ * array, column by column (see nmeaInfoSanitiseBatch)
+ *
+ * @param infos The NmeaInfo structures
+ * @param count The number of info structures
+ * @param toMetric Convert to metric units (from original units) when true,
+ * convert to original units (from metric units) when false
+ */
+void nmeaInfoUnitConversionBatch(NmeaInfo *infos, size_t count, bool toMetric);
+
 /**
  * Compare 2 satellite PRNs and put zeroes last
  *
@@ -20,6 +20,7 @@
 
 #include <nmealib/info.h>
 #include <stdbool.h>
+#include <stddef.h>
 
 #ifdef  __cplusplus
 extern "C" {
@@ -143,6 +144,28 @@ void nmeaMathInfoToPosition(const NmeaInfo *info, NmeaPosition *pos);
  */
 void nmeaMathPositionToInfo(const NmeaPosition *pos, NmeaInfo *info);
 
+/**
+ * A radians position with the trigonometric terms that the distance and move
+ * functions need, so that they are calculated only once for a position that is
+ * used more than once (a depot, the centre of a geofence, the previous fix)
+ */
+typedef struct _NmeaPositionPrepared {
+    NmeaPosition pos;    /**< the position (in radians)                              */
+    double       sinLat; /**< the sine of the latitude                               */
+    double       cosLat; /**< the cosine of the latitude                             */
+    double       tanU;   /**< the tangent of the reduced latitude (1 - f) tan(lat)   */
+    double       sinU;   /**< the sine of the reduced latitude                       */
+    double       cosU;   /**< the cosine of the reduced latitude                     */
+} NmeaPositionPrepared;
+
+/**
+ * Prepare a radians position for repeated distance and move calculations
+ *
+ * @param pos The radians position
+ * @param prepared The prepared position
+ */
+void nmeaMathPositionPrepare(const NmeaPosition *pos, NmeaPositionPrepared *prepared);
+
 /**
  * Calculate the distance between two points
  *
@@ -152,6 +175,17 @@ void nmeaMathPositionToInfo(const NmeaPosition *pos, NmeaInfo *info);
  */
 double nmeaMathDistance(const NmeaPosition *from, const NmeaPosition *to);
 
+/**
+ * Calculate the distance between two prepared points
+ *
+ * The same as nmeaMathDistance, with the prepared trigonometric terms.
+ *
+ * @param from The 'from' position
+ * @param to The 'to' position
+ * @return Distance in meters
+ */
+double nmeaMathDistancePrepared(const NmeaPositionPrepared *from, const NmeaPositionPrepared *to);
+
 /**
  * Calculate the distance between two points
  *
@@ -159,6 +193,10 @@ double nmeaMathDistance(const NmeaPosition *from, const NmeaPosition *to);
  * The algorithm is described here:
  *   http://www.ngs.noaa.gov/PUBS_LIB/inverse.pdf
  *
+ * The iteration does not converge for (nearly) antipodal points, and the
+ * distance is only correct for arcs of up to a quarter great circle, use
+ * nmeaGeodesicInverse for longer distances.
+ *
  * @param from The 'from' position (in radians)
  * @param to The 'to' position (in radians)
  * @param fromAzimuth The azimuth at 'from' position (in radians)
@@ -168,6 +206,171 @@ double nmeaMathDistance(const NmeaPosition *from, const NmeaPosition *to);
 double nmeaMathDistanceEllipsoid(const NmeaPosition *from, const NmeaPosition *to, double *fromAzimuth,
     double *toAzimuth);
 
+/**
+ * Calculate the distance between two prepared points
+ *
+ * The same as nmeaMathDistanceEllipsoid, with the prepared reduced
+ * latitudes.
+ *
+ * @param from The 'from' position
+ * @param to The 'to' position
+ * @param fromAzimuth The azimuth at 'from' position (in radians)
+ * @param toAzimuth The azimuth at 'to' position (in radians)
+ * @return Distance in meters
+ */
+double nmeaMathDistanceEllipsoidPrepared(const NmeaPositionPrepared *from, const NmeaPositionPrepared *to,
+    double *fromAzimuth, double *toAzimuth);
+
+/**
+ * Calculate the distances between many pairs of points
+ *
+ * This function uses the same algorithm as nmeaMathDistanceEllipsoid and
+ * gives the same results, but iterates blocks of pairs in lockstep: the
+ * pairs of a block are independent of each other, so their iterations
+ * overlap, and pairs that converged are dropped from the iteration of their
+ * block.
+ *
+ * @param from The 'from' positions (in radians)
+ * @param to The 'to' positions (in radians)
+ * @param count The number of pairs of positions
+ * @param distances The distances in meters, 'count' entries
+ * @param fromAzimuths The azimuths at the 'from' positions (in radians), can be NULL
+ * @param toAzimuths The azimuths at the 'to' positions (in radians), can be NULL
+ */
+void nmeaMathDistanceEllipsoidBatch(const NmeaPosition *from, const NmeaPosition *to, size_t count,
+    double *distances, double *fromAzimuths, double *toAzimuths);
+
+/*
+ * Distance approximations
+ */
+
+/**
+ * Distance calculation modes, ordered by cost
+ *
+ * The maximum relative errors of the modes versus the WGS84 geodesic
+ * (nmeaGeodesicInverse), for distances up to a range and latitudes up to
+ * 80 degrees:
+ *
+ * <pre>
+ * distance up to   equirectangular  tangent plane  haversine  great circle  ellipsoid
+ *   100 m          0.6%             0.000002%      0.6%       100%          0.34%
+ *     1 km         0.6%             0.000004%      0.6%       100%          0.34%
+ *    10 km         0.6%             0.0004%        0.6%       100%          0.34%
+ *   100 km         0.6%             0.04%          0.6%       100%          0.34%
+ *  1000 km         2.6%             3%             0.6%       100%          0.34%
+ * </pre>
+ *
+ * The sphere of equirectangular and haversine causes the constant 0.6%. The
+ * great circle distance (nmeaMathDistance) loses all precision for short
+ * distances. nmeaMathDistanceEllipsoid uses NMEALIB_EARTH_SEMIMAJORAXIS_M
+ * (which is the semi-minor axis) as its semi-major axis, so its distances
+ * are 0.34% short. Consecutive fixes of a receiver are only meters apart,
+ * where the tangent plane is as good as nmeaGeodesicInverse at a fraction
+ * of its cost.
+ */
+typedef enum _NmeaMathDistanceMode {
+  NMEALIB_MATH_DISTANCE_EQUIRECTANGULAR, /**< nmeaMathDistanceEquirectangular */
+  NMEALIB_MATH_DISTANCE_TANGENTPLANE,    /**< nmeaMathDistanceTangentPlane    */
+  NMEALIB_MATH_DISTANCE_HAVERSINE,       /**< nmeaMathDistanceHaversine       */
+  NMEALIB_MATH_DISTANCE_GREATCIRCLE,     /**< nmeaMathDistance                */
+  NMEALIB_MATH_DISTANCE_ELLIPSOID,       /**< nmeaMathDistanceEllipsoid       */
+  NMEALIB_MATH_DISTANCE_GEODESIC,        /**< nmeaGeodesicInverse             */
+  NMEALIB_MATH_DISTANCE_MODE_COUNT       /**< the number of modes             */
+} NmeaMathDistanceMode;
+
+/**
+ * Calculate the (approximate) distance between two points with the
+ * equirectangular projection
+ *
+ * Uses a sphere with the mean radius of the WGS84 ellipsoid and the mean
+ * latitude of the points. Costs one cosine and one square root. The maximum
+ * error is 0.6% up to 100 km and 2.6% up to 1000 km, see
+ * NmeaMathDistanceMode.
+ *
+ * @param from The 'from' position (in radians)
+ * @param to The 'to' position (in radians)
+ * @return Distance in meters
+ */
+double nmeaMathDistanceEquirectangular(const NmeaPosition *from, const NmeaPosition *to);
+
+/**
+ * Calculate the (approximate) distance between two points with the haversine
+ * formula
+ *
+ * Uses a sphere with the mean radius of the WGS84 ellipsoid. Unlike
+ * nmeaMathDistance it is precise for short distances too. The maximum error
+ * is 0.6% up to 1000 km, see NmeaMathDistanceMode.
+ *
+ * @param from The 'from' position (in radians)
+ * @param to The 'to' position (in radians)
+ * @return Distance in meters
+ */
+double nmeaMathDistanceHaversine(const NmeaPosition *from, const NmeaPosition *to);
+
+/**
+ * Calculate the (approximate) distance between two points with the haversine
+ * formula, with cached cosines of the latitudes
+ *
+ * The same as nmeaMathDistanceHaversine, but without calculating the cosines
+ * of the latitudes, which is useful when a point is used more than once.
+ *
+ * @param from The 'from' position (in radians)
+ * @param cosFromLat The cosine of the latitude of the 'from' position
+ * @param to The 'to' position (in radians)
+ * @param cosToLat The cosine of the latitude of the 'to' position
+ * @return Distance in meters
+ */
+double nmeaMathDistanceHaversineCached(const NmeaPosition *from, double cosFromLat, const NmeaPosition *to,
+    double cosToLat);
+
+/**
+ * Calculate the (approximate) distance between two prepared points with the
+ * haversine formula
+ *
+ * The same as nmeaMathDistanceHaversine, with the prepared cosines of the
+ * latitudes.
+ *
+ * @param from The 'from' position
+ * @param to The 'to' position
+ * @return Distance in meters
+ */
+double nmeaMathDistanceHaversinePrepared(const NmeaPositionPrepared *from, const NmeaPositionPrepared *to);
+
+/**
+ * Calculate the (approximate) distance between two points in the local
+ * tangent plane
+ *
+ * Uses the radii of curvature of the WGS84 ellipsoid at the mean latitude of
+ * the points. The maximum error is 0.0004% up to 10 km, 0.04% up to 100 km
+ * and 3% up to 1000 km, see NmeaMathDistanceMode.
+ *
+ * @param from The 'from' position (in radians)
+ * @param to The 'to' position (in radians)
+ * @return Distance in meters
+ */
+double nmeaMathDistanceTangentPlane(const NmeaPosition *from, const NmeaPosition *to);
+
+/**
+ * Calculate the distance between two points with a distance calculation mode
+ *
+ * @param from The 'from' position (in radians)
+ * @param to The 'to' position (in radians)
+ * @param mode The distance calculation mode
+ * @return Distance in meters
+ */
+double nmeaMathDistanceWithMode(const NmeaPosition *from, const NmeaPosition *to, NmeaMathDistanceMode mode);
+
+/**
+ * Select the cheapest distance calculation mode for an expected distance
+ *
+ * @param range The maximum expected distance in meters
+ * @param maxError The maximum acceptable relative error versus
+ * nmeaGeodesicInverse (for example 0.001 for 0.1%)
+ * @return The cheapest mode that has a maximum error of at most maxError for
+ * distances up to range, NMEALIB_MATH_DISTANCE_GEODESIC when no mode does
+ */
+NmeaMathDistanceMode nmeaMathDistanceModeSelect(double range, double maxError);
+
 /**
  * Perform a flat (horizontal) move.
  *
@@ -179,6 +382,19 @@ double nmeaMathDistanceEllipsoid(const NmeaPosition *from, const NmeaPosition *t
  */
 bool nmeaMathMoveFlat(const NmeaPosition *from, NmeaPosition *to, double azimuth, double distance);
 
+/**
+ * Perform a flat (horizontal) move from a prepared position.
+ *
+ * The same as nmeaMathMoveFlat, with the prepared trigonometric terms.
+ *
+ * @param from The 'from' position
+ * @param to The 'to' position (in radians)
+ * @param azimuth Azimuth (in degrees, [0, 359])
+ * @param distance The distance (in km)
+ * @return True on success
+ */
+bool nmeaMathMoveFlatPrepared(const NmeaPositionPrepared *from, NmeaPosition *to, double azimuth, double distance);
+
 /**
  * Perform a flat (horizontal) move against the ellipsoid.
  *
@@ -196,6 +412,22 @@ bool nmeaMathMoveFlat(const NmeaPosition *from, NmeaPosition *to, double azimuth
 bool nmeaMathMoveFlatEllipsoid(const NmeaPosition *from, NmeaPosition *to, double azimuth, double distance,
     double *toAzimuth);
 
+/**
+ * Perform a flat (horizontal) move against the ellipsoid from a prepared
+ * position.
+ *
+ * The same as nmeaMathMoveFlatEllipsoid, with the prepared reduced latitude.
+ *
+ * @param from The 'from' position
+ * @param to The 'to' position (in radians)
+ * @param azimuth Azimuth (in radians)
+ * @param distance The distance (in km)
+ * @param toAzimuth Azimuth at end position (in radians)
+ * @return True on success
+ */
+bool nmeaMathMoveFlatEllipsoidPrepared(const NmeaPositionPrepared *from, NmeaPosition *to, double azimuth,
+    double distance, double *toAzimuth);
+
 #ifdef  __cplusplus
 }
 #endif /* __cplusplus */
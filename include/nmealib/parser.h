@@ -18,9 +18,11 @@
 #ifndef __NMEALIB_PARSER_H__
 #define __NMEALIB_PARSER_H__
 
+#include <nmealib/gpgsv.h>
 #include <nmealib/info.h>
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 
 #ifdef  __cplusplus
 extern "C" {
@@ -64,6 +66,7 @@ typedef struct _NmeaParser {
     size_t bufferLength;
     char *buffer;
     size_t bufferSize;
+    NmeaGPGSVStaging gpgsv; /**< the GPGSV sequence in progress */
 } NmeaParser;
 
 /**
@@ -88,17 +91,40 @@ bool nmeaParserInit(NmeaParser *parser, size_t sz);
  */
 bool nmeaParserDestroy(NmeaParser *parser);
 
+/**
+ * Process a single character of a sentence
+ *
+ * This is the building block of nmeaParserParse, for code of the library
+ * that has to handle the sentences itself (such as the epoch assembler and
+ * the time index). When it returns true then the sentence is in
+ * parser->buffer (without its end-of-line characters) and is
+ * parser->bufferLength characters long.
+ *
+ * @param parser The parser
+ * @param c The character
+ * @return True when the character completed a sentence with a valid checksum
+ * (or without checksum)
+ */
+bool nmeaParserProcessCharacter(NmeaParser *parser, const char *c);
+
 /**
  * Parse NMEA sentences from a (string) buffer and store the results in the
  * info structure
  *
+ * The satellites of a GPGSV sequence are staged in the parser until the
+ * sequence is complete (see nmeaGPGSVToInfo), so a parser must only be used
+ * with one info structure.
+ *
  * @param parser The parser
  * @param s The (string) buffer
  * @param sz The length of the string in the buffer
  * @param info The info structure in which to store the information
+ * @param changed When non-NULL then the NmeaPresence bits of the fields of
+ * the info structure that changed while parsing the sentences (see
+ * nmeaSentenceToInfo) are stored in it
  * @return The number of sentences that were parsed
  */
-size_t nmeaParserParse(NmeaParser *parser, const char *s, size_t sz, NmeaInfo *info);
+size_t nmeaParserParse(NmeaParser *parser, const char *s, size_t sz, NmeaInfo *info, uint32_t *changed);
 
 #ifdef  __cplusplus
 }
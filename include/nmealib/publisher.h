@@ -0,0 +1,121 @@
+/*
+ * This file is part of nmealib.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file
+ * Info publisher
+ *
+ * Publishes an info structure from one writer thread (for example the
+ * thread that parses the sentences) to any number of reader threads,
+ * without locking.
+ *
+ * The publisher is a sequence lock: the writer increments the sequence
+ * counter before and after it copies the info structure into the
+ * publisher, so the counter is odd while a copy is in progress. A reader
+ * copies the info structure out of the publisher and retries when the
+ * counter was odd or changed during its copy. The writer is never blocked
+ * by readers, and readers never block each other.
+ *
+ * The publisher contains no pointers, so it can also be placed in memory
+ * that is shared between processes.
+ */
+
+#ifndef __NMEALIB_PUBLISHER_H__
+#define __NMEALIB_PUBLISHER_H__
+
+#include <nmealib/info.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef  __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * Info publisher
+ */
+typedef struct _NmeaInfoPublisher {
+    uint32_t sequence; /**< the sequence counter, odd while the info is being published */
+    NmeaInfo info;     /**< the published info                                          */
+} NmeaInfoPublisher;
+
+/**
+ * Initialise the publisher: publish a cleared info structure
+ *
+ * Must be called before any reader uses the publisher.
+ *
+ * @param publisher The publisher
+ */
+void nmeaInfoPublisherInit(NmeaInfoPublisher *publisher);
+
+/**
+ * Publish an info structure
+ *
+ * Must only be called from one thread at a time.
+ *
+ * @param publisher The publisher
+ * @param info The info structure to publish (copied)
+ */
+void nmeaInfoPublisherPublish(NmeaInfoPublisher *publisher, const NmeaInfo *info);
+
+/**
+ * Get the sequence counter of the publisher
+ *
+ * Cheap enough to poll: the published info structure only changed when
+ * the counter changed.
+ *
+ * @param publisher The publisher
+ * @return The sequence counter, 0 when publisher is NULL
+ */
+uint32_t nmeaInfoPublisherSequence(const NmeaInfoPublisher *publisher);
+
+/**
+ * Get a consistent copy of the published info structure
+ *
+ * Can be called from any number of threads concurrently.
+ *
+ * @param publisher The publisher
+ * @param info The info structure in which to store the copy
+ * @return The (even) sequence counter of the copy, 0 when publisher or
+ * info is NULL
+ */
+uint32_t nmeaInfoPublisherSnapshot(const NmeaInfoPublisher *publisher, NmeaInfo *info);
+
+/**
+ * Get a consistent copy of the published info structure, giving up after a
+ * number of attempts
+ *
+ * Unlike nmeaInfoPublisherSnapshot this does not spin forever when the
+ * writer stopped halfway through a publish, for example because the
+ * process that shares the publisher died.
+ *
+ * @param publisher The publisher
+ * @param info The info structure in which to store the copy
+ * @param attempts The maximum number of attempts
+ * @param sequence Where to store the (even) sequence counter of the copy,
+ * can be NULL
+ * @return True when a consistent copy was made within attempts, false
+ * otherwise (the content of info is undefined then)
+ */
+bool nmeaInfoPublisherTrySnapshot(const NmeaInfoPublisher *publisher, NmeaInfo *info, unsigned int attempts,
+    uint32_t *sequence);
+
+#ifdef  __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __NMEALIB_PUBLISHER_H__ */
@@ -0,0 +1,228 @@
+/*
+ * This file is part of nmealib.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file
+ * Binary record files
+ *
+ * A record file stores decoded fixes as fixed-size binary records, so that
+ * historical data can be queried without parsing NMEA text again: record
+ * 'i' is at offset 'headerSize + (i * recordSize)' and a reader maps the
+ * file and decodes records by index.
+ *
+ * The file starts with a header:
+ *
+ * | Offset | Size | Field                            |
+ * | :----: | :--: | :------------------------------- |
+ * |   0    |  4   | magic (NMEALIB_RECORD_MAGIC)     |
+ * |   4    |  2   | version (NMEALIB_RECORD_VERSION) |
+ * |   6    |  2   | header size                      |
+ * |   8    |  2   | record size                      |
+ * |  10    |  6   | reserved (zero)                  |
+ *
+ * followed by the records, of which the layout is that of NmeaRecord
+ * (without padding). All integers are little-endian, independent of the
+ * host. The number of records follows from the file size, a partially
+ * written record at the end of the file is ignored.
+ */
+
+#ifndef __NMEALIB_RECORD_H__
+#define __NMEALIB_RECORD_H__
+
+#include <nmealib/compact.h>
+#include <nmealib/epoch.h>
+#include <nmealib/info.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef  __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/** The magic number of a record file ("NMER") */
+#define NMEALIB_RECORD_MAGIC (0x524d454eu)
+
+/** The version of the record file layout */
+#define NMEALIB_RECORD_VERSION (1u)
+
+/** The size of the header of a record file */
+#define NMEALIB_RECORD_HEADER_SIZE (16u)
+
+/** The size of a record in a record file */
+#define NMEALIB_RECORD_SIZE (56u)
+
+/**
+ * Record: a fix with fixed-point fields
+ *
+ * The present and smask fields are those of the info structure, a field
+ * that is not present is zero. Values that don't fit are clamped.
+ */
+typedef struct _NmeaRecord {
+    NmeaTimeCompact utc;         /**< UTC of the position data                    */
+    uint32_t        present;     /**< the NmeaPresence bits of the fix            */
+    uint32_t        smask;       /**< the mask of the sentences of the fix        */
+    int32_t         latitude;    /**< latitude, in 1e-7 degrees                   */
+    int32_t         longitude;   /**< longitude, in 1e-7 degrees                  */
+    int32_t         elevation;   /**< elevation above mean sea level, in mm       */
+    int32_t         height;      /**< height of the geoid above WGS84, in mm      */
+    uint32_t        speed;       /**< speed over the ground, in 0.001 kph         */
+    uint16_t        track;       /**< track angle, in 0.01 degrees true           */
+    uint16_t        mtrack;      /**< magnetic track angle, in 0.01 degrees       */
+    uint16_t        magvar;      /**< magnetic variation, in 0.01 degrees         */
+    uint16_t        pdop;        /**< position DOP, in 0.01                       */
+    uint16_t        hdop;        /**< horizontal DOP, in 0.01                     */
+    uint16_t        vdop;        /**< vertical DOP, in 0.01                       */
+    uint16_t        dgpsAge;     /**< time since the last DGPS update, in 0.1 s   */
+    uint16_t        dgpsSid;     /**< DGPS station ID number                      */
+    uint8_t         sig;         /**< signal quality, see NmeaSignal              */
+    uint8_t         fix;         /**< operating mode, see NmeaFix                 */
+    uint8_t         inUseCount;  /**< the number of satellites in use             */
+    uint8_t         inViewCount; /**< the number of satellites in view            */
+} NmeaRecord;
+
+/* Forward declarations */
+typedef struct _NmeaRecordWriter NmeaRecordWriter;
+typedef struct _NmeaRecordFile NmeaRecordFile;
+
+/**
+ * Convert an info structure into a record
+ *
+ * Both metric and non-metric info structures are accepted.
+ *
+ * @param info The info structure
+ * @param record The record
+ */
+void nmeaRecordFromInfo(const NmeaInfo *info, NmeaRecord *record);
+
+/**
+ * Convert a record into a (non-metric) info structure
+ *
+ * The satellites of the info structure are cleared.
+ *
+ * @param record The record
+ * @param info The info structure
+ */
+void nmeaRecordToInfo(const NmeaRecord *record, NmeaInfo *info);
+
+/**
+ * Encode a record into its (little-endian) file layout
+ *
+ * @param record The record
+ * @param buf The buffer of (at least) NMEALIB_RECORD_SIZE bytes
+ */
+void nmeaRecordEncode(const NmeaRecord *record, uint8_t *buf);
+
+/**
+ * Decode a record from its (little-endian) file layout
+ *
+ * @param buf The buffer of (at least) NMEALIB_RECORD_SIZE bytes
+ * @param record The record
+ */
+void nmeaRecordDecode(const uint8_t *buf, NmeaRecord *record);
+
+/**
+ * Create a record file, or append to an existing record file
+ *
+ * Allocates memory for the writer.
+ *
+ * @param path The path of the file
+ * @return The writer, or NULL on failure
+ */
+NmeaRecordWriter *nmeaRecordWriterOpen(const char *path);
+
+/**
+ * Append a fix to a record file
+ *
+ * The record is buffered, use nmeaRecordWriterFlush to write the buffered
+ * records to the file.
+ *
+ * @param writer The writer
+ * @param info The fix
+ * @return True on success
+ */
+bool nmeaRecordWriterAppend(NmeaRecordWriter *writer, const NmeaInfo *info);
+
+/**
+ * Epoch handler that appends the info of every epoch to a record file
+ *
+ * @param user The writer
+ * @param epoch The epoch
+ */
+void nmeaRecordWriterEpochHandler(void *user, const NmeaEpoch *epoch);
+
+/**
+ * Write the buffered records of a writer to its record file
+ *
+ * @param writer The writer
+ * @return True on success
+ */
+bool nmeaRecordWriterFlush(NmeaRecordWriter *writer);
+
+/**
+ * Flush and close a record file
+ *
+ * Frees the memory of the writer.
+ *
+ * @param writer The writer
+ * @return True when all records were written
+ */
+bool nmeaRecordWriterClose(NmeaRecordWriter *writer);
+
+/**
+ * Open a record file for reading, by mapping it into memory
+ *
+ * Records that are appended after the file was opened are not visible.
+ * Allocates memory for the reader.
+ *
+ * @param path The path of the file
+ * @return The reader, or NULL on failure
+ */
+NmeaRecordFile *nmeaRecordFileOpen(const char *path);
+
+/**
+ * Close a record file
+ *
+ * Frees the memory of the reader.
+ *
+ * @param file The reader
+ */
+void nmeaRecordFileClose(NmeaRecordFile *file);
+
+/**
+ * Get the number of records in a record file
+ *
+ * @param file The reader
+ * @return The number of records
+ */
+size_t nmeaRecordFileCount(const NmeaRecordFile *file);
+
+/**
+ * Get a record of a record file
+ *
+ * @param file The reader
+ * @param index The index of the record
+ * @param record The record
+ * @return True on success
+ */
+bool nmeaRecordFileGet(const NmeaRecordFile *file, size_t index, NmeaRecord *record);
+
+#ifdef  __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __NMEALIB_RECORD_H__ */
@@ -0,0 +1,235 @@
+/*
+ * This file is part of nmealib.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file
+ * Satellite store
+ *
+ * A satellite store keeps satellites indexed by (constellation, PRN), with
+ * a presence bitmap per constellation. Inserting, looking up and removing a
+ * satellite are O(1), and iterating over the satellites visits them in
+ * (constellation, PRN) order without sorting.
+ *
+ * The satellites in an NmeaInfo structure are identified by their NMEA PRN,
+ * which is mapped onto a constellation and a PRN within that constellation
+ * as follows:
+ *
+ * | NMEA PRN  | Constellation | PRN     |
+ * | :-------: | :------------ | :-----: |
+ * |   1 -  32 | GPS           | 1 - 32  |
+ * |  33 -  64 | SBAS          | 1 - 32  |
+ * |  65 -  96 | GLONASS       | 1 - 32  |
+ * | 193 - 202 | QZSS          | 1 - 10  |
+ * | 301 - 364 | Galileo       | 1 - 64  |
+ * | 401 - 464 | BeiDou        | 1 - 64  |
+ *
+ * The constellations are ordered such that the (constellation, PRN) order
+ * is the NMEA PRN order.
+ *
+ * The sentence conversions (nmeaGPGSAToInfo and nmeaGPGSVToInfo) do NOT
+ * merge through the store: they still merge into the satellite arrays of
+ * NmeaInfo, which remain the representation of the library. Merging through
+ * the store would publish the satellites in view in PRN order instead of
+ * in sentence order, and would drop satellites with an NMEA PRN outside
+ * the ranges above, so it is not done yet. Until then, applications that
+ * look up satellites by PRN convert with nmeaSatelliteStoreFromInfo (and
+ * back with nmeaSatelliteStoreToInfo).
+ */
+
+#ifndef __NMEALIB_SATELLITE_H__
+#define __NMEALIB_SATELLITE_H__
+
+#include <nmealib/info.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef  __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * Enumeration for the constellations
+ */
+typedef enum _NmeaConstellation {
+  NMEALIB_CONSTELLATION_GPS = 0u,
+  NMEALIB_CONSTELLATION_FIRST = NMEALIB_CONSTELLATION_GPS,
+  NMEALIB_CONSTELLATION_SBAS = 1u,
+  NMEALIB_CONSTELLATION_GLONASS = 2u,
+  NMEALIB_CONSTELLATION_QZSS = 3u,
+  NMEALIB_CONSTELLATION_GALILEO = 4u,
+  NMEALIB_CONSTELLATION_BEIDOU = 5u,
+  NMEALIB_CONSTELLATION_LAST = NMEALIB_CONSTELLATION_BEIDOU
+} NmeaConstellation;
+
+/** The number of constellations */
+#define NMEALIB_CONSTELLATIONS (NMEALIB_CONSTELLATION_LAST + 1u)
+
+/** The maximum PRN within a constellation, PRNs are in the range [1, NMEALIB_SATELLITE_STORE_PRNS] */
+#define NMEALIB_SATELLITE_STORE_PRNS (64u)
+
+/**
+ * Satellite store
+ *
+ * The satellite of PRN 'prn' of constellation 'c' is at
+ * satellites[c][prn - 1], and is present when bit (prn - 1) of present[c]
+ * is set.
+ */
+typedef struct _NmeaSatelliteStore {
+    uint64_t      present[NMEALIB_CONSTELLATIONS];                                 /**< the satellites that are present */
+    uint64_t      inUse[NMEALIB_CONSTELLATIONS];                                   /**< the satellites that are in use  */
+    NmeaSatellite satellites[NMEALIB_CONSTELLATIONS][NMEALIB_SATELLITE_STORE_PRNS]; /**< the satellites (in view)        */
+} NmeaSatelliteStore;
+
+/**
+ * Map an NMEA PRN onto a constellation and a PRN within that constellation
+ *
+ * @param nmeaPrn The NMEA PRN
+ * @param constellation Where to store the constellation
+ * @param prn Where to store the PRN within the constellation
+ * @return True when the NMEA PRN could be mapped
+ */
+bool nmeaSatelliteFromNmeaPrn(unsigned int nmeaPrn, NmeaConstellation *constellation, unsigned int *prn);
+
+/**
+ * Map a constellation and a PRN within that constellation onto an NMEA PRN
+ *
+ * @param constellation The constellation
+ * @param prn The PRN within the constellation
+ * @return The NMEA PRN, or 0 when it could not be mapped
+ */
+unsigned int nmeaSatelliteToNmeaPrn(NmeaConstellation constellation, unsigned int prn);
+
+/**
+ * Clear the satellite store
+ *
+ * @param store The satellite store
+ */
+void nmeaSatelliteStoreClear(NmeaSatelliteStore *store);
+
+/**
+ * Insert or update a satellite
+ *
+ * The PRN of the stored satellite is set to 'prn'.
+ *
+ * @param store The satellite store
+ * @param constellation The constellation
+ * @param prn The PRN within the constellation
+ * @param satellite The satellite (its elevation, azimuth and SNR are copied)
+ * @return True on success
+ */
+bool nmeaSatelliteStoreSet(NmeaSatelliteStore *store, NmeaConstellation constellation, unsigned int prn,
+    const NmeaSatellite *satellite);
+
+/**
+ * Look up a satellite
+ *
+ * @param store The satellite store
+ * @param constellation The constellation
+ * @param prn The PRN within the constellation
+ * @return The satellite, or NULL when it is not present
+ */
+const NmeaSatellite *nmeaSatelliteStoreGet(const NmeaSatelliteStore *store, NmeaConstellation constellation,
+    unsigned int prn);
+
+/**
+ * Remove a satellite
+ *
+ * @param store The satellite store
+ * @param constellation The constellation
+ * @param prn The PRN within the constellation
+ * @return True when the satellite was present
+ */
+bool nmeaSatelliteStoreRemove(NmeaSatelliteStore *store, NmeaConstellation constellation, unsigned int prn);
+
+/**
+ * Mark a satellite as (not) in use
+ *
+ * @param store The satellite store
+ * @param constellation The constellation
+ * @param prn The PRN within the constellation
+ * @param inUse True to mark the satellite as in use
+ * @return True on success
+ */
+bool nmeaSatelliteStoreSetInUse(NmeaSatelliteStore *store, NmeaConstellation constellation, unsigned int prn,
+    bool inUse);
+
+/**
+ * Determine whether a satellite is in use
+ *
+ * @param store The satellite store
+ * @param constellation The constellation
+ * @param prn The PRN within the constellation
+ * @return True when the satellite is in use
+ */
+bool nmeaSatelliteStoreIsInUse(const NmeaSatelliteStore *store, NmeaConstellation constellation, unsigned int prn);
+
+/**
+ * Get the number of satellites in the satellite store
+ *
+ * @param store The satellite store
+ * @return The number of satellites
+ */
+size_t nmeaSatelliteStoreCount(const NmeaSatelliteStore *store);
+
+/**
+ * Find the next satellite in (constellation, PRN) order
+ *
+ * Start with constellation NMEALIB_CONSTELLATION_FIRST and PRN 0.
+ *
+ * @param store The satellite store
+ * @param constellation The constellation of the previous satellite, is
+ * updated to the constellation of the next satellite
+ * @param prn The PRN of the previous satellite, is updated to the PRN of
+ * the next satellite
+ * @return The next satellite, or NULL when there are no more satellites
+ */
+const NmeaSatellite *nmeaSatelliteStoreNext(const NmeaSatelliteStore *store, NmeaConstellation *constellation,
+    unsigned int *prn);
+
+/**
+ * Fill the satellite store from the satellites of an info structure
+ *
+ * The store is cleared first. Satellites in view are inserted when
+ * SATINVIEW is present, satellites in use are marked when SATINUSE is
+ * present. Satellites with an NMEA PRN that can't be mapped are skipped.
+ *
+ * @param store The satellite store
+ * @param info The info structure
+ * @return The number of satellites that were skipped
+ */
+size_t nmeaSatelliteStoreFromInfo(NmeaSatelliteStore *store, const NmeaInfo *info);
+
+/**
+ * Store the satellites of the satellite store in an info structure
+ *
+ * The satellites in view and the satellites in use are written sorted on
+ * their NMEA PRN (with the NMEA PRNs in their 'prn' fields) and SATINVIEW
+ * and SATINUSE are set present. The satellites in view are published with
+ * nmeaInfoSatellitesInViewPublish. The satellite counts are not changed.
+ * Satellites that don't fit are dropped.
+ *
+ * @param store The satellite store
+ * @param info The info structure
+ */
+void nmeaSatelliteStoreToInfo(const NmeaSatelliteStore *store, NmeaInfo *info);
+
+#ifdef  __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __NMEALIB_SATELLITE_H__ */
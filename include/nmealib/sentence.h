@@ -63,6 +63,7 @@
 #include <nmealib/gpgsv.h>
 #include <nmealib/gprmc.h>
 #include <nmealib/gpvtg.h>
+#include <sys/uio.h>
 
 #ifdef  __cplusplus
 extern "C" {
@@ -184,20 +185,93 @@ static INLINE const char *nmeaSentenceToPrefix(NmeaSentence sentence) {
  */
 NmeaSentence nmeaSentenceFromPrefix(const char *s, const size_t sz);
 
+/**
+ * A parsed NMEA sentence of any of the supported sentence types
+ */
+typedef struct _NmeaSentencePack {
+    NmeaSentence sentence;   /**< the sentence type, GPNON when nothing was parsed */
+    union {
+        NmeaGPGGA gpgga;     /**< the parsed sentence when sentence is GPGGA       */
+        NmeaGPGSA gpgsa;     /**< the parsed sentence when sentence is GPGSA       */
+        NmeaGPGSV gpgsv;     /**< the parsed sentence when sentence is GPGSV       */
+        NmeaGPRMC gprmc;     /**< the parsed sentence when sentence is GPRMC       */
+        NmeaGPVTG gpvtg;     /**< the parsed sentence when sentence is GPVTG       */
+    } pack;                  /**< the parsed sentence                              */
+} NmeaSentencePack;
+
+/**
+ * Parse a NMEA sentence of any of the supported sentence types
+ *
+ * Code that has to look at a sentence before it is converted into an info
+ * structure (for example at its UTC time, see nmeaSentencePackUtc) parses
+ * it with this function and converts it with nmeaSentencePackToInfo.
+ *
+ * @param s The NMEA sentence
+ * @param sz The length of the NMEA sentence
+ * @param pack The pack in which to store the parsed sentence
+ * @return True when successful, pack->sentence is GPNON otherwise
+ */
+bool nmeaSentenceParse(const char *s, const size_t sz, NmeaSentencePack *pack);
+
+/**
+ * Get the UTC time of a parsed NMEA sentence
+ *
+ * @param pack The parsed sentence
+ * @param utc The NmeaTime in which to store the UTC time (and date)
+ * @param dated When non-NULL then it is set to true when the sentence also
+ * has a date
+ * @return True when the sentence has a UTC time
+ */
+bool nmeaSentencePackUtc(const NmeaSentencePack *pack, NmeaTime *utc, bool *dated);
+
+/**
+ * Convert a parsed NMEA sentence into an unsanitised NmeaInfo structure
+ *
+ * @param pack The parsed sentence
+ * @param info The unsanitised NmeaInfo structure in which to stored the information
+ * @param gpgsv The staging structure for GPGSV sequences, can be NULL (see
+ * nmeaGPGSVToInfo)
+ * @return The NmeaPresence bits of the fields of the NmeaInfo structure
+ * that changed (see nmeaGPGGAToInfo and friends)
+ */
+uint32_t nmeaSentencePackToInfo(const NmeaSentencePack *pack, NmeaInfo *info, NmeaGPGSVStaging *gpgsv);
+
 /**
  * Parse a NMEA sentence into an unsanitised NmeaInfo structure
  *
+ * GPGSV sentences are converted without a staging structure.
+ *
  * @param s The NMEA sentence
  * @param sz The length of the NMEA sentence
  * @param info The unsanitised NmeaInfo structure in which to stored the information
+ * @param changed When non-NULL then the NmeaPresence bits of the fields of
+ * the NmeaInfo structure that changed (see nmeaGPGGAToInfo and friends) are
+ * stored in it, 0 when the sentence could not be parsed
  * @return True when successful
  */
-bool nmeaSentenceToInfo(const char *s, const size_t sz, NmeaInfo *info);
+bool nmeaSentenceToInfo(const char *s, const size_t sz, NmeaInfo *info, uint32_t *changed);
+
+/**
+ * Determine the maximum total length of the NMEA sentences that are
+ * generated from a NmeaInfo structure.
+ *
+ * The length only depends on the sentences in the mask and (for GPGSV) on
+ * the number of satellites in view, not on the values of the other fields,
+ * which makes it an upper bound that holds for any NmeaInfo structure.
+ *
+ * @param info The NmeaInfo structure
+ * @param mask The bit-mask of sentences to generate
+ * @return The maximum total length of the generated sentences (excluding the
+ * null-terminator)
+ */
+size_t nmeaSentenceFromInfoLengthMax(const NmeaInfo *info, const NmeaSentence mask);
 
 /**
  * Generate NMEA sentences from a sanitised NmeaInfo structure.
  *
- * Allocates memory as needed.
+ * Reserves (allocates) the memory needed for the sentences up front, as
+ * determined by nmeaSentenceFromInfoLengthMax, after which every sentence is
+ * generated exactly once.
  *
  * @param buf The allocated buffer (do read the comments of NmeaMallocedBuffer)
  * @param info The sanitised NmeaInfo structure
@@ -206,6 +280,49 @@ bool nmeaSentenceToInfo(const char *s, const size_t sz, NmeaInfo *info);
  */
 size_t nmeaSentenceFromInfo(NmeaMallocedBuffer *buf, const NmeaInfo *info, const NmeaSentence mask);
 
+/**
+ * Generate NMEA sentences from a sanitised NmeaInfo structure into a fixed
+ * buffer.
+ *
+ * Never allocates memory. Sentences that do not completely fit in the buffer
+ * (including the null-terminator) are not generated, and neither are the
+ * sentences after them: the buffer always contains complete sentences.
+ * All sentences are guaranteed to fit when the size of the buffer is larger
+ * than the length reported by nmeaSentenceFromInfoLengthMax.
+ *
+ * @param s The buffer
+ * @param sz The size of the buffer
+ * @param info The sanitised NmeaInfo structure
+ * @param mask The bit-mask of sentences to generate
+ * @return The total length of the generated sentences
+ */
+size_t nmeaSentenceFromInfoFixed(char *s, const size_t sz, const NmeaInfo *info, const NmeaSentence mask);
+
+/**
+ * Generate NMEA sentences from a sanitised NmeaInfo structure into a fixed
+ * buffer and describe every generated sentence by its own entry in a vector.
+ *
+ * Behaves like nmeaSentenceFromInfoFixed, but additionally fills one iovec
+ * entry per generated sentence (GPGSV can generate several sentences) so
+ * that the sentences can be handed to writev, sendmsg or sendmmsg directly.
+ * Sentences for which no vector entry is left are not generated, and
+ * neither are the sentences after them.
+ *
+ * The entries point into the buffer: the iov_len of an entry does not
+ * include a null-terminator.
+ *
+ * @param s The buffer
+ * @param sz The size of the buffer
+ * @param iov The vector
+ * @param iovCount The number of entries in the vector
+ * @param info The sanitised NmeaInfo structure
+ * @param mask The bit-mask of sentences to generate
+ * @return The number of generated sentences, which is the number of used
+ * vector entries
+ */
+size_t nmeaSentenceFromInfoVector(char *s, const size_t sz, struct iovec *iov, const size_t iovCount,
+    const NmeaInfo *info, const NmeaSentence mask);
+
 #ifdef  __cplusplus
 }
 #endif /* __cplusplus */
@@ -0,0 +1,166 @@
+/*
+ * This file is part of nmealib.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file
+ * Time index of NMEA logs
+ *
+ * A time index maps every UTC second of an NMEA log to the byte offset of
+ * the first sentence of that second: the first GPGGA or GPRMC sentence
+ * with that UTC time, which is also where the epoch assembler starts the
+ * epoch. The date of a second is taken from the GPRMC sentences, seconds
+ * before the first GPRMC sentence with a date get the first date (or the
+ * day before it, when they are before midnight).
+ *
+ * An index is built by scanning a log once and can be stored next to the
+ * log in a sidecar file, after which nmeaParserSeekTime positions the log
+ * at the start of any second with a binary search instead of parsing the
+ * log from its start.
+ *
+ * The sidecar file starts with a header:
+ *
+ * | Offset | Size | Field                                |
+ * | :----: | :--: | :----------------------------------- |
+ * |   0    |  4   | magic (NMEALIB_TIMEINDEX_MAGIC)      |
+ * |   4    |  2   | version (NMEALIB_TIMEINDEX_VERSION)  |
+ * |   6    |  2   | header size                          |
+ * |   8    |  2   | entry size                           |
+ * |  10    |  6   | reserved (zero)                      |
+ *
+ * followed by the entries, each an 8 byte (signed) time and an 8 byte
+ * offset. All integers are little-endian.
+ */
+
+#ifndef __NMEALIB_TIMEINDEX_H__
+#define __NMEALIB_TIMEINDEX_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#ifdef  __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/** The magic number of a time index file ("NMEI") */
+#define NMEALIB_TIMEINDEX_MAGIC (0x49454d4eu)
+
+/** The version of the time index file layout */
+#define NMEALIB_TIMEINDEX_VERSION (1u)
+
+/** The size of the header of a time index file */
+#define NMEALIB_TIMEINDEX_HEADER_SIZE (16u)
+
+/** The size of an entry in a time index file */
+#define NMEALIB_TIMEINDEX_ENTRY_SIZE (16u)
+
+/**
+ * Time index entry
+ */
+typedef struct _NmeaTimeIndexEntry {
+    int64_t  time;   /**< the UTC second, in seconds since the epoch (since midnight for a log without dates) */
+    uint64_t offset; /**< the byte offset of the first sentence of the second                                 */
+} NmeaTimeIndexEntry;
+
+/**
+ * Time index, the entries are sorted on time (and then on offset)
+ */
+typedef struct _NmeaTimeIndex {
+    size_t              count;    /**< the number of entries            */
+    size_t              capacity; /**< the number of allocated entries  */
+    NmeaTimeIndexEntry *entries;  /**< the entries                      */
+} NmeaTimeIndex;
+
+/**
+ * Initialise an (empty) time index
+ *
+ * @param index The index
+ */
+void nmeaTimeIndexInit(NmeaTimeIndex *index);
+
+/**
+ * Destroy a time index
+ *
+ * Frees the memory of the entries.
+ *
+ * @param index The index
+ */
+void nmeaTimeIndexDestroy(NmeaTimeIndex *index);
+
+/**
+ * Build the time index of an NMEA log
+ *
+ * Scans the whole log, from its start, and replaces the entries of the
+ * index. Only sentences with a valid checksum (or without one) are used.
+ *
+ * @param index The index
+ * @param file The log, opened for (binary) reading
+ * @return True on success
+ */
+bool nmeaTimeIndexBuild(NmeaTimeIndex *index, FILE *file);
+
+/**
+ * Write a time index to a sidecar file
+ *
+ * @param index The index
+ * @param path The path of the sidecar file, overwritten when it exists
+ * @return True on success
+ */
+bool nmeaTimeIndexWrite(const NmeaTimeIndex *index, const char *path);
+
+/**
+ * Read a time index from a sidecar file
+ *
+ * Replaces the entries of the index.
+ *
+ * @param index The index
+ * @param path The path of the sidecar file
+ * @return True on success
+ */
+bool nmeaTimeIndexRead(NmeaTimeIndex *index, const char *path);
+
+/**
+ * Find the first entry of a time index at or after a time
+ *
+ * @param index The index
+ * @param t The time, in seconds since the epoch
+ * @return The index of the entry, the number of entries when there is no
+ * such entry
+ */
+size_t nmeaTimeIndexFind(const NmeaTimeIndex *index, int64_t t);
+
+/**
+ * Position an NMEA log at the first sentence of the first indexed second at
+ * or after a time
+ *
+ * A parser that then parses the log resets itself on the first sentence,
+ * so it does not have to be reset.
+ *
+ * @param file The log
+ * @param index The index of the log
+ * @param t The time, in seconds since the epoch
+ * @return True on success, false when there is no such second or seeking
+ * failed
+ */
+bool nmeaParserSeekTime(FILE *file, const NmeaTimeIndex *index, int64_t t);
+
+#ifdef  __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __NMEALIB_TIMEINDEX_H__ */
@@ -0,0 +1,166 @@
+/*
+ * This file is part of nmealib.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file
+ * Track: columns of fixes
+ *
+ * A track stores fixes in columns (structure of arrays) instead of as an
+ * array of NmeaInfo structures: one contiguous array per field, which is
+ * what analysis code that runs over whole columns wants.
+ *
+ * Positions are stored in radians, so that a position can be handed to the
+ * nmath functions (see nmeaTrackPosition and nmeaTrackDistances). Fields
+ * that are not present in a fix are stored as NaN (or as NMEALIB_SIG_INVALID
+ * and NMEALIB_FIX_BAD for sig and fix), the present column holds the
+ * NmeaPresence bits of every fix.
+ *
+ * Fixes are appended with amortised growth: the capacity doubles whenever
+ * it is exhausted. To fill a track from an epoch assembler, configure
+ * nmeaTrackEpochHandler as its handler with the track as its user pointer.
+ */
+
+#ifndef __NMEALIB_TRACK_H__
+#define __NMEALIB_TRACK_H__
+
+#include <nmealib/epoch.h>
+#include <nmealib/info.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef  __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * Track
+ *
+ * The columns have 'capacity' entries, of which the first 'count' are in
+ * use. The column pointers change when the track grows.
+ */
+typedef struct _NmeaTrack {
+    size_t      count;      /**< the number of fixes                                                  */
+    size_t      capacity;   /**< the number of fixes that fit in the columns                          */
+    uint32_t   *present;    /**< the NmeaPresence bits of the fixes                                   */
+    int64_t    *time;       /**< nanoseconds since the epoch, or since midnight when there is no date */
+    double     *lat;        /**< latitude, in radians                                                 */
+    double     *lon;        /**< longitude, in radians                                                */
+    double     *elevation;  /**< elevation above mean sea level, in meters                            */
+    double     *speed;      /**< speed over the ground, in kph                                        */
+    double     *track;      /**< track angle, in degrees true                                         */
+    double     *hdop;       /**< horizontal dilution of position (DOP, not meters)                    */
+    NmeaSignal *sig;        /**< signal quality                                                       */
+    NmeaFix    *fix;        /**< operating mode                                                       */
+} NmeaTrack;
+
+/**
+ * Initialise a track
+ *
+ * Allocates memory for the columns when capacity is non-zero.
+ *
+ * @param track The track
+ * @param capacity The initial capacity, in fixes
+ * @return True on success
+ */
+bool nmeaTrackInit(NmeaTrack *track, size_t capacity);
+
+/**
+ * Destroy a track
+ *
+ * Frees the memory of the columns.
+ *
+ * @param track The track
+ */
+void nmeaTrackDestroy(NmeaTrack *track);
+
+/**
+ * Remove all fixes from a track, keeping its capacity
+ *
+ * @param track The track
+ */
+void nmeaTrackClear(NmeaTrack *track);
+
+/**
+ * Make sure that a track has room for a number of fixes
+ *
+ * @param track The track
+ * @param capacity The number of fixes
+ * @return True on success
+ */
+bool nmeaTrackReserve(NmeaTrack *track, size_t capacity);
+
+/**
+ * Append a fix to a track
+ *
+ * Both metric and non-metric info structures are accepted.
+ *
+ * @param track The track
+ * @param info The fix
+ * @return True on success
+ */
+bool nmeaTrackAppend(NmeaTrack *track, const NmeaInfo *info);
+
+/**
+ * Append fixes to a track
+ *
+ * Grows the track only once for all fixes.
+ *
+ * @param track The track
+ * @param infos The fixes
+ * @param count The number of fixes
+ * @return True on success, on failure no fix was appended
+ */
+bool nmeaTrackAppendInfos(NmeaTrack *track, const NmeaInfo *infos, size_t count);
+
+/**
+ * Epoch handler that appends the info of every epoch to a track
+ *
+ * @param user The track
+ * @param epoch The epoch
+ */
+void nmeaTrackEpochHandler(void *user, const NmeaEpoch *epoch);
+
+/**
+ * Get the position of a fix of a track
+ *
+ * @param track The track
+ * @param index The index of the fix
+ * @param pos The position (in radians)
+ * @return True on success
+ */
+bool nmeaTrackPosition(const NmeaTrack *track, size_t index, NmeaPosition *pos);
+
+/**
+ * Calculate the (great circle) distances between consecutive fixes of a
+ * track, see nmeaMathDistance
+ *
+ * distances[0] is zero, distances[i] is the distance between fix i - 1 and
+ * fix i. The distance from or to a fix without a position is NaN.
+ *
+ * @param track The track
+ * @param distances The array (of track->count entries) in which to store
+ * the distances, in meters
+ * @return The total distance in meters, skipping NaN distances
+ */
+double nmeaTrackDistances(const NmeaTrack *track, double *distances);
+
+#ifdef  __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __NMEALIB_TRACK_H__ */
@@ -0,0 +1,122 @@
+/*
+ * This file is part of nmealib.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file
+ * Track codec: compression of sequences of records
+ *
+ * Consecutive fixes of a track differ little, so the codec stores every
+ * record (see record.h) as the difference with what the previous records
+ * predict, in zigzag varints (small positive and negative numbers take few
+ * bytes):
+ * - the time (in hundredths of a second), the latitude and the longitude
+ *   are predicted to continue at the rate of the previous record,
+ * - the elevation and the speed are predicted to be those of the previous
+ *   record,
+ * - all other fields are only stored when they changed, flagged in the
+ *   first byte of the encoded record.
+ *
+ * The codec is lossless: decoding returns the encoded records exactly.
+ *
+ * The records are divided into blocks of a configurable number of records.
+ * The first record of a block is not predicted from earlier records, so
+ * decoding can start at any block: store the byte offset of every block
+ * while encoding (see nmeaTrackCodecIsBlockStart) and to decode record
+ * 'i', reset the decoder, start decoding at the offset of block
+ * 'i / blockSize' and decode 'i % blockSize' records before record 'i'.
+ */
+
+#ifndef __NMEALIB_TRACKCODEC_H__
+#define __NMEALIB_TRACKCODEC_H__
+
+#include <nmealib/record.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef  __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/** The maximum length of an encoded record */
+#define NMEALIB_TRACKCODEC_RECORD_MAX (128u)
+
+/**
+ * Track codec state, of an encoder or of a decoder
+ */
+typedef struct _NmeaTrackCodec {
+    size_t     blockSize;  /**< the number of records in a block, zero for a single block      */
+    size_t     index;      /**< the index of the next record in its block                      */
+    NmeaRecord previous;   /**< the previous record                                            */
+    int64_t    time;       /**< the time of the previous record, in hundredths of a second     */
+    int64_t    timeRate;   /**< the change of the time with the record before it               */
+    int64_t    latRate;    /**< the change of the latitude with the record before it           */
+    int64_t    lonRate;    /**< the change of the longitude with the record before it          */
+} NmeaTrackCodec;
+
+/**
+ * Initialise a track codec, for encoding or for decoding
+ *
+ * @param codec The codec
+ * @param blockSize The number of records in a block, zero for a single
+ * block
+ */
+void nmeaTrackCodecInit(NmeaTrackCodec *codec, size_t blockSize);
+
+/**
+ * Reset a track codec to the start of a block
+ *
+ * @param codec The codec
+ */
+void nmeaTrackCodecReset(NmeaTrackCodec *codec);
+
+/**
+ * Determine whether the next record that is encoded or decoded starts a
+ * block
+ *
+ * @param codec The codec
+ * @return True when the next record starts a block
+ */
+bool nmeaTrackCodecIsBlockStart(const NmeaTrackCodec *codec);
+
+/**
+ * Encode a record
+ *
+ * @param codec The codec
+ * @param record The record
+ * @param buf The buffer of (at least) NMEALIB_TRACKCODEC_RECORD_MAX bytes
+ * @return The length of the encoded record, 0 on invalid inputs
+ */
+size_t nmeaTrackCodecEncode(NmeaTrackCodec *codec, const NmeaRecord *record, uint8_t *buf);
+
+/**
+ * Decode a record
+ *
+ * @param codec The codec
+ * @param buf The buffer
+ * @param sz The length of the data in the buffer
+ * @param record The record
+ * @return The length of the encoded record that was decoded, 0 on invalid
+ * inputs or when the buffer does not contain a complete encoded record
+ */
+size_t nmeaTrackCodecDecode(NmeaTrackCodec *codec, const uint8_t *buf, size_t sz, NmeaRecord *record);
+
+#ifdef  __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __NMEALIB_TRACKCODEC_H__ */
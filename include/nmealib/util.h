@@ -18,8 +18,10 @@
 #ifndef __NMEALIB_TOK_H__
 #define __NMEALIB_TOK_H__
 
+#include <float.h>
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 #include <stdlib.h>
 
 #ifdef  __cplusplus
@@ -41,6 +43,22 @@ extern "C" {
 /** The power-of-2 chunk size of a buffer allocation */
 #define NMEALIB_BUFFER_CHUNK_SIZE (4096UL)
 
+/** The maximum number of characters generated for an unsigned int (%u) */
+#define NMEALIB_GENERATE_UINT_LENGTH_MAX (10UL)
+
+/** The maximum number of characters generated for an int (%d) */
+#define NMEALIB_GENERATE_INT_LENGTH_MAX (11UL)
+
+/**
+ * The maximum number of characters generated for a double with the
+ * specified number of decimals (%.Nf): sign, integer digits, decimal point
+ * and decimals
+ */
+#define NMEALIB_GENERATE_DOUBLE_LENGTH_MAX(decimals) (DBL_MAX_10_EXP + 3UL + (decimals))
+
+/** The length of the checksum that is appended to a sentence: *XX\r\n */
+#define NMEALIB_GENERATE_CHECKSUM_LENGTH (5UL)
+
 /** NaN that is a double (and not a float) */
 #define NaN strtod("NAN()", NULL)
 
@@ -52,6 +70,17 @@ extern "C" {
  */
 void nmeaRandomInit(void);
 
+/**
+ * Seed the random number generation of the calling thread
+ *
+ * Once seeded, nmeaRandom uses a fast pseudo random number generator that
+ * is private to the calling thread instead of reading from /dev/urandom,
+ * which makes the generated numbers reproducible per thread.
+ *
+ * @param seed The seed, zero reverts the calling thread to /dev/urandom
+ */
+void nmeaRandomSeedThread(uint64_t seed);
+
 /**
  * Generate a random number
  *
@@ -0,0 +1,78 @@
+/*
+ * This file is part of nmealib.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <nmealib/fleet.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/*
+ * Usage: fleet [vehicles [threads [rate [epochs]]]]
+ *
+ * Writes the generated sentences of all vehicles to stdout and the
+ * statistics to stderr.
+ */
+int main(int argc, char *argv[]) {
+  NmeaFleetConfig config;
+  NmeaFleet *fleet;
+  uint64_t epochs;
+  uint64_t bytes;
+  bool r;
+
+  memset(&config, 0, sizeof(config));
+  config.vehicles = (argc > 1) ?
+      strtoul(argv[1], NULL, 10) :
+      1000;
+  config.threads = (argc > 2) ?
+      strtoul(argv[2], NULL, 10) :
+      4;
+  config.rate = (argc > 3) ?
+      strtod(argv[3], NULL) :
+      1.0;
+  config.epochs = (argc > 4) ?
+      strtoull(argv[4], NULL, 10) :
+      10;
+  config.type = NMEALIB_GENERATOR_ROTATE;
+  config.mask = NMEALIB_SENTENCE_GPGGA //
+      | NMEALIB_SENTENCE_GPGSA //
+      | NMEALIB_SENTENCE_GPGSV //
+      | NMEALIB_SENTENCE_GPRMC //
+      | NMEALIB_SENTENCE_GPVTG;
+  config.fd = STDOUT_FILENO;
+
+  fleet = nmeaFleetCreate(&config);
+  if (!fleet) {
+    return -1;
+  }
+
+  if (!nmeaFleetStart(fleet)) {
+    nmeaFleetDestroy(fleet);
+    return -1;
+  }
+
+  r = nmeaFleetJoin(fleet);
+
+  nmeaFleetStatistics(fleet, &epochs, &bytes);
+  fprintf(stderr, "%llu vehicle epochs, %llu bytes\n", (unsigned long long) epochs, (unsigned long long) bytes);
+
+  nmeaFleetDestroy(fleet);
+
+  return r ?
+      0 :
+      -1;
+}
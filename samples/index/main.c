@@ -0,0 +1,105 @@
+/*
+ * This file is part of nmealib.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <nmealib/timeindex.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Usage: index log [from [to]]
+ *
+ * Builds the time index of the log and writes it to the sidecar file
+ * 'log.idx', unless that file exists already. When 'from' is given (in
+ * seconds since the epoch) then the sentences of the log from that second
+ * up to (but not including) the second 'to' are written to stdout.
+ */
+int main(int argc, char *argv[]) {
+  char indexPath[2048];
+  char buf[4096];
+  NmeaTimeIndex index;
+  FILE *file;
+  uint64_t remaining = UINT64_MAX;
+  int r = -1;
+
+  if (argc < 2) {
+    fprintf(stderr, "Usage: %s log [from [to]]\n", argv[0]);
+    return -1;
+  }
+
+  file = fopen(argv[1], "rb");
+  if (!file) {
+    fprintf(stderr, "Could not open file %s\n", argv[1]);
+    return -1;
+  }
+
+  snprintf(indexPath, sizeof(indexPath), "%s.idx", argv[1]);
+  nmeaTimeIndexInit(&index);
+
+  if (!nmeaTimeIndexRead(&index, indexPath)) {
+    if (!nmeaTimeIndexBuild(&index, file) //
+        || !nmeaTimeIndexWrite(&index, indexPath)) {
+      fprintf(stderr, "Could not index file %s\n", argv[1]);
+      goto out;
+    }
+
+    fprintf(stderr, "Indexed %lu seconds into %s\n", (unsigned long) index.count, indexPath);
+  }
+
+  if (argc < 3) {
+    r = 0;
+    goto out;
+  }
+
+  if (!nmeaParserSeekTime(file, &index, strtoll(argv[2], NULL, 10))) {
+    fprintf(stderr, "No data at or after %s\n", argv[2]);
+    goto out;
+  }
+
+  if (argc > 3) {
+    size_t from = nmeaTimeIndexFind(&index, strtoll(argv[2], NULL, 10));
+    size_t to = nmeaTimeIndexFind(&index, strtoll(argv[3], NULL, 10));
+
+    if (to < index.count) {
+      /* the seconds of an out of order log are not contiguous */
+      remaining = (index.entries[to].offset > index.entries[from].offset) ?
+          (index.entries[to].offset - index.entries[from].offset) :
+          0;
+    }
+  }
+
+  while (remaining) {
+    size_t want = (remaining < sizeof(buf)) ?
+        (size_t) remaining :
+        sizeof(buf);
+    size_t got = fread(buf, 1, want, file);
+
+    if (!got) {
+      break;
+    }
+
+    fwrite(buf, 1, got, stdout);
+    remaining -= got;
+  }
+
+  r = 0;
+
+out:
+  nmeaTimeIndexDestroy(&index);
+  fclose(file);
+  return r;
+}
@@ -42,7 +42,7 @@ int main(int argc __attribute__((unused)), char *argv[] __attribute__((unused)))
   for (it = 0; it < NUM_POINTS; it++) {
     NmeaInfo info;
     nmeaInfoClear(&info);
-    (void) nmeaParserParse(&parser, buf[it], strlen(buf[it]), &info);
+    (void) nmeaParserParse(&parser, buf[it], strlen(buf[it]), &info, NULL);
     nmeaMathInfoToPosition(&info, &pos[it]);
   }
 
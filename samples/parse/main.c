@@ -40,7 +40,7 @@ int main(int argc __attribute__((unused)), char *argv[] __attribute__((unused)))
   nmeaParserInit(&parser, 0);
 
   for (it = 0; it < 7; it++) {
-    nmeaParserParse(&parser, buf[it], strlen(buf[it]), &info);
+    nmeaParserParse(&parser, buf[it], strlen(buf[it]), &info, NULL);
 
     nmeaMathInfoToPosition(&info, &dpos);
     printf("%03d, Lat: %f, Lon: %f, Sig: %d, Fix: %d\n", it, dpos.lat, dpos.lon, info.sig, info.fix);
@@ -77,7 +77,7 @@ int main(int argc __attribute__((unused)), char *argv[] __attribute__((unused)))
   while (!feof(file)) {
     size_t size = fread(&buff[0], 1, 100, file);
 
-    nmeaParserParse(&parser, &buff[0], size, &info);
+    nmeaParserParse(&parser, &buff[0], size, &info, NULL);
     nmeaMathInfoToPosition(&info, &dpos);
 
     printf("*** %03lu, Lat: %f, Lon: %f, Sig: %d, Fix: %d\n", (unsigned long) it++, dpos.lat, dpos.lon, info.sig,
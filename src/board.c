@@ -0,0 +1,404 @@
+/*
+ * This file is part of nmealib.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <nmealib/board.h>
+
+#include <nmealib/context.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/** The size of a record of an info board */
+#define NMEALIB_BOARD_RECORD_SIZE \
+  ((sizeof(NmeaInfoPublisher) + NMEALIB_BOARD_ALIGNMENT - 1) & ~((size_t) NMEALIB_BOARD_ALIGNMENT - 1))
+
+/** The number of attempts of a snapshot before it gives up on a record that is being published */
+#define NMEALIB_BOARD_SNAPSHOT_ATTEMPTS (1000000u)
+
+/**
+ * Info board
+ */
+struct _NmeaBoard {
+    NmeaBoardHeader *header;   /**< the header (the start of the mapping)     */
+    size_t           size;     /**< the size of the mapping                   */
+    size_t           devices;  /**< the number of records inside the mapping  */
+    bool             writable; /**< true when the board can be written        */
+};
+
+/**
+ * Get the record of a device
+ *
+ * @param board The board
+ * @param device The device
+ * @return The record, or NULL when device is out of range
+ */
+static NmeaInfoPublisher *nmeaBoardRecord(const NmeaBoard *board, size_t device) {
+  if (device >= board->devices) {
+    return NULL;
+  }
+
+  return (NmeaInfoPublisher *) (void *) ((uint8_t *) board->header + NMEALIB_BOARD_ALIGNMENT
+      + (device * NMEALIB_BOARD_RECORD_SIZE));
+}
+
+/**
+ * Map a shared memory segment into a board
+ *
+ * @param fd The file descriptor of the shared memory segment (left open)
+ * @param size The size of the mapping
+ * @param writable True to map the shared memory segment writable
+ * @return The board, or NULL on failure
+ */
+static NmeaBoard *nmeaBoardMap(int fd, size_t size, bool writable) {
+  NmeaBoard *board;
+  void *mapping;
+
+  mapping = mmap(NULL, size, writable ?
+      (PROT_READ | PROT_WRITE) :
+      PROT_READ, MAP_SHARED, fd, 0);
+
+  if (mapping == MAP_FAILED) {
+    nmeaContextError("%s error: could not map %lu bytes: %s", __FUNCTION__, (unsigned long) size, strerror(errno));
+    return NULL;
+  }
+
+  board = calloc(1, sizeof(*board));
+  if (!board) {
+    /* can't be covered in a test */
+    munmap(mapping, size);
+    return NULL;
+  }
+
+  board->header = (NmeaBoardHeader *) mapping;
+  board->size = size;
+  board->devices = 0;
+  board->writable = writable;
+
+  return board;
+}
+
+/**
+ * Map an existing shared memory segment into a board and validate its layout
+ *
+ * @param name The name of the shared memory segment (for error messages)
+ * @param fd The file descriptor of the shared memory segment (left open)
+ * @param writable True to map the shared memory segment writable
+ * @return The board, or NULL on failure or when the layout of the board
+ * differs
+ */
+static NmeaBoard *nmeaBoardMapExisting(const char *name, int fd, bool writable) {
+  const NmeaBoardHeader *header;
+  NmeaBoard *board;
+  struct stat st;
+  uint64_t devices;
+  size_t size;
+
+  if (fstat(fd, &st) //
+      || (st.st_size < (off_t) NMEALIB_BOARD_ALIGNMENT)) {
+    nmeaContextError("%s error: %s is not a board", __FUNCTION__, name);
+    return NULL;
+  }
+
+  size = (size_t) st.st_size;
+
+  board = nmeaBoardMap(fd, size, writable);
+  if (!board) {
+    return NULL;
+  }
+
+  header = board->header;
+  if ((__atomic_load_n(&header->magic, __ATOMIC_ACQUIRE) != NMEALIB_BOARD_MAGIC) //
+      || (header->version != NMEALIB_BOARD_VERSION) //
+      || (header->headerSize != NMEALIB_BOARD_ALIGNMENT) //
+      || (header->recordSize != NMEALIB_BOARD_RECORD_SIZE) //
+      || (header->infoSize != sizeof(NmeaInfo))) {
+    nmeaContextError("%s error: %s is not a board with layout version %u", __FUNCTION__, name, NMEALIB_BOARD_VERSION);
+    nmeaBoardClose(board);
+    return NULL;
+  }
+
+  devices = __atomic_load_n(&header->devices, __ATOMIC_ACQUIRE);
+  if (!devices //
+      || (devices > ((size - NMEALIB_BOARD_ALIGNMENT) / NMEALIB_BOARD_RECORD_SIZE))) {
+    nmeaContextError("%s error: %s is not a board with layout version %u", __FUNCTION__, name, NMEALIB_BOARD_VERSION);
+    nmeaBoardClose(board);
+    return NULL;
+  }
+
+  board->devices = (size_t) devices;
+
+  return board;
+}
+
+/**
+ * Complete a publish that a previous writer did not finish
+ *
+ * A writer that died halfway through a publish leaves the sequence counter
+ * of the record odd, which readers refuse, and which would invert its
+ * parity for all later publishes. The publish is completed with a cleared
+ * info structure, because the info structure in the record can be torn.
+ *
+ * @param record The record
+ */
+static void nmeaBoardRecover(NmeaInfoPublisher *record) {
+  uint32_t sequence = __atomic_load_n(&record->sequence, __ATOMIC_RELAXED);
+
+  if (!(sequence & 1)) {
+    return;
+  }
+
+  nmeaInfoClear(&record->info);
+  __atomic_store_n(&record->sequence, sequence + 1, __ATOMIC_RELEASE);
+}
+
+/**
+ * Reuse an existing info board (for the writer)
+ *
+ * The records of the board are left alone, except for records of which a
+ * previous writer did not finish a publish (see nmeaBoardRecover). A board
+ * with fewer devices is grown: the segment is extended and only the new
+ * records are initialised.
+ *
+ * @param name The name of the shared memory segment
+ * @param devices The number of devices (records)
+ * @param size The size of the shared memory segment for devices
+ * @return The board, or NULL on failure, when the layout of the board
+ * differs or when the board has more devices
+ */
+static NmeaBoard *nmeaBoardReuse(const char *name, size_t devices, size_t size) {
+  NmeaBoard *board;
+  size_t existing;
+  size_t mapped;
+  size_t i;
+  int fd;
+
+  fd = shm_open(name, O_RDWR, 0);
+  if (fd < 0) {
+    nmeaContextError("%s error: could not open %s: %s", __FUNCTION__, name, strerror(errno));
+    return NULL;
+  }
+
+  board = nmeaBoardMapExisting(name, fd, true);
+  if (!board) {
+    close(fd);
+    return NULL;
+  }
+
+  existing = board->devices;
+  if (devices < existing) {
+    nmeaContextError("%s error: %s has %lu devices, refusing to shrink it to %lu devices", __FUNCTION__, name,
+        (unsigned long) existing, (unsigned long) devices);
+    nmeaBoardClose(board);
+    close(fd);
+    return NULL;
+  }
+
+  for (i = 0; i < existing; i++) {
+    nmeaBoardRecover(nmeaBoardRecord(board, i));
+  }
+
+  if (devices == existing) {
+    close(fd);
+    return board;
+  }
+
+  /* grow: readers that mapped the board before keep using their records */
+  mapped = board->size;
+  nmeaBoardClose(board);
+
+  if ((size > mapped) //
+      && ftruncate(fd, (off_t) size)) {
+    nmeaContextError("%s error: could not resize %s: %s", __FUNCTION__, name, strerror(errno));
+    close(fd);
+    return NULL;
+  }
+
+  board = nmeaBoardMap(fd, size, true);
+  close(fd);
+  if (!board) {
+    return NULL;
+  }
+
+  board->devices = devices;
+  for (i = existing; i < devices; i++) {
+    nmeaInfoPublisherInit(nmeaBoardRecord(board, i));
+  }
+
+  __atomic_store_n(&board->header->devices, (uint64_t) devices, __ATOMIC_RELEASE);
+
+  return board;
+}
+
+NmeaBoard *nmeaBoardCreate(const char *name, size_t devices) {
+  NmeaBoardHeader *header;
+  NmeaBoard *board;
+  size_t size;
+  size_t i;
+  int fd;
+
+  if (!name //
+      || !devices //
+      || (devices > ((SIZE_MAX - NMEALIB_BOARD_ALIGNMENT) / NMEALIB_BOARD_RECORD_SIZE))) {
+    return NULL;
+  }
+
+  size = NMEALIB_BOARD_ALIGNMENT + (devices * NMEALIB_BOARD_RECORD_SIZE);
+
+  fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0644);
+  if ((fd < 0) //
+      && (errno == EEXIST)) {
+    return nmeaBoardReuse(name, devices, size);
+  }
+
+  if (fd < 0) {
+    nmeaContextError("%s error: could not create %s: %s", __FUNCTION__, name, strerror(errno));
+    return NULL;
+  }
+
+  if (ftruncate(fd, (off_t) size)) {
+    nmeaContextError("%s error: could not resize %s: %s", __FUNCTION__, name, strerror(errno));
+    close(fd);
+    shm_unlink(name);
+    return NULL;
+  }
+
+  board = nmeaBoardMap(fd, size, true);
+  close(fd);
+  if (!board) {
+    shm_unlink(name);
+    return NULL;
+  }
+
+  /* the segment is new, readers refuse it until the magic number is set */
+  header = board->header;
+  header->version = NMEALIB_BOARD_VERSION;
+  header->headerSize = NMEALIB_BOARD_ALIGNMENT;
+  header->recordSize = (uint32_t) NMEALIB_BOARD_RECORD_SIZE;
+  header->infoSize = (uint32_t) sizeof(NmeaInfo);
+  header->reserved = 0;
+  header->devices = devices;
+
+  board->devices = devices;
+  for (i = 0; i < devices; i++) {
+    nmeaInfoPublisherInit(nmeaBoardRecord(board, i));
+  }
+
+  __atomic_store_n(&header->magic, NMEALIB_BOARD_MAGIC, __ATOMIC_RELEASE);
+
+  return board;
+}
+
+NmeaBoard *nmeaBoardOpen(const char *name) {
+  NmeaBoard *board;
+  int fd;
+
+  if (!name) {
+    return NULL;
+  }
+
+  fd = shm_open(name, O_RDONLY, 0);
+  if (fd < 0) {
+    nmeaContextError("%s error: could not open %s: %s", __FUNCTION__, name, strerror(errno));
+    return NULL;
+  }
+
+  board = nmeaBoardMapExisting(name, fd, false);
+  close(fd);
+
+  return board;
+}
+
+void nmeaBoardClose(NmeaBoard *board) {
+  if (!board) {
+    return;
+  }
+
+  munmap(board->header, board->size);
+  free(board);
+}
+
+bool nmeaBoardUnlink(const char *name) {
+  if (!name) {
+    return false;
+  }
+
+  return !shm_unlink(name);
+}
+
+size_t nmeaBoardDevices(const NmeaBoard *board) {
+  if (!board) {
+    return 0;
+  }
+
+  return board->devices;
+}
+
+bool nmeaBoardPublish(NmeaBoard *board, size_t device, const NmeaInfo *info) {
+  NmeaInfoPublisher *record;
+
+  if (!board //
+      || !board->writable //
+      || !info) {
+    return false;
+  }
+
+  record = nmeaBoardRecord(board, device);
+  if (!record) {
+    return false;
+  }
+
+  nmeaInfoPublisherPublish(record, info);
+
+  return true;
+}
+
+bool nmeaBoardSnapshot(const NmeaBoard *board, size_t device, NmeaInfo *info, uint32_t *sequence) {
+  const NmeaInfoPublisher *record;
+  uint32_t s;
+
+  if (!board //
+      || !info) {
+    return false;
+  }
+
+  record = nmeaBoardRecord(board, device);
+  if (!record) {
+    return false;
+  }
+
+  if (!nmeaInfoPublisherTrySnapshot(record, info, NMEALIB_BOARD_SNAPSHOT_ATTEMPTS, &s)) {
+    return false;
+  }
+
+  if (sequence) {
+    *sequence = s;
+  }
+
+  return true;
+}
+
+uint32_t nmeaBoardSequence(const NmeaBoard *board, size_t device) {
+  if (!board) {
+    return 0;
+  }
+
+  return nmeaInfoPublisherSequence(nmeaBoardRecord(board, device));
+}
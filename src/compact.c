@@ -0,0 +1,286 @@
+/*
+ * This file is part of nmealib.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <nmealib/compact.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * Clamp an unsigned integer into a range
+ *
+ * @param v The value
+ * @param max The maximum value
+ * @return The clamped value
+ */
+static INLINE unsigned int nmeaInfoCompactClampUnsigned(unsigned int v, unsigned int max) {
+  return (v > max) ?
+      max :
+      v;
+}
+
+/**
+ * Clamp a signed integer into a range
+ *
+ * @param v The value
+ * @param min The minimum value
+ * @param max The maximum value
+ * @return The clamped value
+ */
+static INLINE int nmeaInfoCompactClampSigned(int v, int min, int max) {
+  if (v < min) {
+    return min;
+  }
+
+  if (v > max) {
+    return max;
+  }
+
+  return v;
+}
+
+/**
+ * Make sure that the satellites of a compact info structure are stored
+ * inline or out of line as needed
+ *
+ * @param info The compact info structure
+ * @param outOfLine True when the satellites must be stored out of line
+ * @return True on success
+ */
+static bool nmeaInfoCompactSatellitesStorage(NmeaInfoCompact *info, bool outOfLine) {
+  if (!outOfLine) {
+    free(info->satellites);
+    info->satellites = NULL;
+    return true;
+  }
+
+  if (!info->satellites) {
+    info->satellites = malloc(sizeof(*info->satellites));
+    if (!info->satellites) {
+      /* can't be covered in a test */
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void nmeaInfoCompactClear(NmeaInfoCompact *info) {
+  if (!info) {
+    return;
+  }
+
+  free(info->satellites);
+  memset(info, 0, sizeof(*info));
+
+  info->sig = NMEALIB_SIG_INVALID;
+  nmeaInfoSetPresent(&info->present, NMEALIB_PRESENT_SIG);
+
+  info->fix = NMEALIB_FIX_BAD;
+  nmeaInfoSetPresent(&info->present, NMEALIB_PRESENT_FIX);
+}
+
+void nmeaInfoCompactDestroy(NmeaInfoCompact *info) {
+  if (!info //
+      || !info->satellites) {
+    return;
+  }
+
+  free(info->satellites);
+  info->satellites = NULL;
+  info->inUseStored = 0;
+  info->inViewStored = 0;
+}
+
+bool nmeaInfoCompactCopy(NmeaInfoCompact *dst, const NmeaInfoCompact *src) {
+  NmeaSatellitesCompact *satellites;
+
+  if (!dst //
+      || !src) {
+    return false;
+  }
+
+  if (dst == src) {
+    return true;
+  }
+
+  if (!nmeaInfoCompactSatellitesStorage(dst, !!src->satellites)) {
+    /* can't be covered in a test */
+    return false;
+  }
+
+  satellites = dst->satellites;
+  *dst = *src;
+  dst->satellites = satellites;
+
+  if (satellites) {
+    *satellites = *src->satellites;
+  }
+
+  return true;
+}
+
+bool nmeaInfoToCompact(const NmeaInfo *info, NmeaInfoCompact *compact) {
+  uint16_t *inUse;
+  NmeaSatelliteCompact *inView;
+  size_t inUseStored = 0;
+  size_t inViewStored = 0;
+  size_t i;
+
+  if (!info //
+      || !compact) {
+    return false;
+  }
+
+  for (i = 0; i < NMEALIB_MAX_SATELLITES; i++) {
+    if (info->satellites.inUse[i]) {
+      inUseStored++;
+    }
+    if (info->satellites.inView[i].prn) {
+      inViewStored++;
+    }
+  }
+
+  if (!nmeaInfoCompactSatellitesStorage(compact, //
+      (inUseStored > NMEALIB_INFO_COMPACT_SATELLITES) //
+      || (inViewStored > NMEALIB_INFO_COMPACT_SATELLITES))) {
+    /* can't be covered in a test */
+    return false;
+  }
+
+  compact->present = info->present;
+  compact->smask = info->smask;
+  compact->latitude = info->latitude;
+  compact->longitude = info->longitude;
+  compact->utc.year = (uint16_t) nmeaInfoCompactClampUnsigned(info->utc.year, UINT16_MAX);
+  compact->utc.mon = (uint8_t) nmeaInfoCompactClampUnsigned(info->utc.mon, UINT8_MAX);
+  compact->utc.day = (uint8_t) nmeaInfoCompactClampUnsigned(info->utc.day, UINT8_MAX);
+  compact->utc.hour = (uint8_t) nmeaInfoCompactClampUnsigned(info->utc.hour, UINT8_MAX);
+  compact->utc.min = (uint8_t) nmeaInfoCompactClampUnsigned(info->utc.min, UINT8_MAX);
+  compact->utc.sec = (uint8_t) nmeaInfoCompactClampUnsigned(info->utc.sec, UINT8_MAX);
+  compact->utc.hsec = (uint8_t) nmeaInfoCompactClampUnsigned(info->utc.hsec, UINT8_MAX);
+  compact->elevation = (float) info->elevation;
+  compact->speed = (float) info->speed;
+  compact->track = (float) info->track;
+  compact->hdop = (float) info->hdop;
+  compact->sig = (int8_t) nmeaInfoCompactClampSigned(info->sig, INT8_MIN, INT8_MAX);
+  compact->fix = (int8_t) nmeaInfoCompactClampSigned(info->fix, INT8_MIN, INT8_MAX);
+  compact->inUseCount = (uint8_t) nmeaInfoCompactClampUnsigned(info->satellites.inUseCount, UINT8_MAX);
+  compact->inViewCount = (uint8_t) nmeaInfoCompactClampUnsigned(info->satellites.inViewCount, UINT8_MAX);
+  compact->pdop = (float) info->pdop;
+  compact->vdop = (float) info->vdop;
+  compact->height = (float) info->height;
+
+  compact->mtrack = (float) info->mtrack;
+  compact->magvar = (float) info->magvar;
+  compact->dgpsAge = (float) info->dgpsAge;
+  compact->dgpsSid = (uint16_t) nmeaInfoCompactClampUnsigned(info->dgpsSid, UINT16_MAX);
+  compact->gpgsvInProgress = info->progress.gpgsvInProgress;
+  compact->metric = info->metric;
+  compact->inUseStored = (uint8_t) inUseStored;
+  compact->inViewStored = (uint8_t) inViewStored;
+
+  inUse = compact->satellites ?
+      compact->satellites->inUse :
+      compact->inUse;
+  inView = compact->satellites ?
+      compact->satellites->inView :
+      compact->inView;
+
+  inUseStored = 0;
+  inViewStored = 0;
+
+  for (i = 0; i < NMEALIB_MAX_SATELLITES; i++) {
+    const NmeaSatellite *sat = &info->satellites.inView[i];
+
+    if (info->satellites.inUse[i]) {
+      inUse[inUseStored++] = (uint16_t) nmeaInfoCompactClampUnsigned(info->satellites.inUse[i], UINT16_MAX);
+    }
+
+    if (sat->prn) {
+      NmeaSatelliteCompact *dst = &inView[inViewStored++];
+
+      dst->prn = (uint16_t) nmeaInfoCompactClampUnsigned(sat->prn, UINT16_MAX);
+      dst->azimuth = (uint16_t) nmeaInfoCompactClampUnsigned(sat->azimuth, UINT16_MAX);
+      dst->elevation = (int8_t) nmeaInfoCompactClampSigned(sat->elevation, INT8_MIN, INT8_MAX);
+      dst->snr = (uint8_t) nmeaInfoCompactClampUnsigned(sat->snr, UINT8_MAX);
+    }
+  }
+
+  return true;
+}
+
+void nmeaInfoFromCompact(const NmeaInfoCompact *compact, NmeaInfo *info) {
+  NmeaSatellite satellites[NMEALIB_MAX_SATELLITES];
+  const uint16_t *inUse;
+  const NmeaSatelliteCompact *inView;
+  size_t i;
+
+  if (!compact //
+      || !info) {
+    return;
+  }
+
+  info->present = compact->present;
+  info->smask = compact->smask;
+  info->utc.year = compact->utc.year;
+  info->utc.mon = compact->utc.mon;
+  info->utc.day = compact->utc.day;
+  info->utc.hour = compact->utc.hour;
+  info->utc.min = compact->utc.min;
+  info->utc.sec = compact->utc.sec;
+  info->utc.hsec = compact->utc.hsec;
+  info->sig = compact->sig;
+  info->fix = compact->fix;
+  info->pdop = compact->pdop;
+  info->hdop = compact->hdop;
+  info->vdop = compact->vdop;
+  info->latitude = compact->latitude;
+  info->longitude = compact->longitude;
+  info->elevation = compact->elevation;
+  info->height = compact->height;
+  info->speed = compact->speed;
+  info->track = compact->track;
+  info->mtrack = compact->mtrack;
+  info->magvar = compact->magvar;
+  info->dgpsAge = compact->dgpsAge;
+  info->dgpsSid = compact->dgpsSid;
+  info->progress.gpgsvInProgress = compact->gpgsvInProgress;
+  info->metric = compact->metric;
+
+  info->satellites.inUseCount = compact->inUseCount;
+
+  inUse = nmeaInfoCompactSatellitesInUse(compact);
+  inView = nmeaInfoCompactSatellitesInView(compact);
+
+  for (i = 0; i < compact->inUseStored; i++) {
+    info->satellites.inUse[i] = inUse[i];
+  }
+  memset(&info->satellites.inUse[i], 0, (NMEALIB_MAX_SATELLITES - i) * sizeof(info->satellites.inUse[0]));
+
+  for (i = 0; i < compact->inViewStored; i++) {
+    NmeaSatellite *sat = &satellites[i];
+
+    sat->prn = inView[i].prn;
+    sat->elevation = inView[i].elevation;
+    sat->azimuth = inView[i].azimuth;
+    sat->snr = inView[i].snr;
+  }
+  memset(&satellites[i], 0, (NMEALIB_MAX_SATELLITES - i) * sizeof(satellites[0]));
+
+  (void) nmeaInfoSatellitesInViewPublish(info, satellites, compact->inViewCount);
+}
@@ -0,0 +1,198 @@
+/*
+ * This file is part of nmealib.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <nmealib/epoch.h>
+
+#include <nmealib/sentence.h>
+#include <string.h>
+
+/**
+ * Start a new epoch
+ *
+ * @param epoch The epoch
+ */
+static void nmeaEpochStart(NmeaEpoch *epoch) {
+  nmeaInfoClear(&epoch->info);
+  epoch->sentences = 0;
+  epoch->complete = false;
+  epoch->end = NMEALIB_EPOCH_END_FLUSH;
+}
+
+/**
+ * End the epoch that is being assembled, hand it to the handler when the
+ * completeness policy allows that, and start a new epoch
+ *
+ * @param assembler The assembler
+ * @param end The reason why the epoch is over
+ * @return The number of epochs that were handed to the handler
+ */
+static size_t nmeaEpochAssemblerEnd(NmeaEpochAssembler *assembler, NmeaEpochEnd end) {
+  const NmeaEpochConfig *config = &assembler->config;
+  NmeaEpoch *epoch = &assembler->epoch;
+  size_t r = 0;
+
+  if (!epoch->sentences) {
+    return 0;
+  }
+
+  epoch->complete = ((epoch->info.smask & config->required) == config->required) //
+      && ((epoch->info.present & config->requiredPresent) == config->requiredPresent);
+  epoch->end = end;
+
+  if (config->handler //
+      && (epoch->complete || config->emitIncomplete)) {
+    config->handler(config->user, epoch);
+    r = 1;
+  }
+
+  nmeaEpochStart(epoch);
+
+  return r;
+}
+
+/**
+ * End the epoch that is being assembled when a sentence with a different
+ * UTC time arrives
+ *
+ * @param assembler The assembler
+ * @param utc The UTC time of the sentence
+ * @return The number of epochs that were handed to the handler
+ */
+static size_t nmeaEpochAssemblerUtc(NmeaEpochAssembler *assembler, const NmeaTime *utc) {
+  const NmeaInfo *info = &assembler->epoch.info;
+
+  if (!nmeaInfoIsPresentAll(info->present, NMEALIB_PRESENT_UTCTIME) //
+      || ((info->utc.hour == utc->hour) //
+          && (info->utc.min == utc->min) //
+          && (info->utc.sec == utc->sec) //
+          && (info->utc.hsec == utc->hsec))) {
+    return 0;
+  }
+
+  return nmeaEpochAssemblerEnd(assembler, NMEALIB_EPOCH_END_UTC);
+}
+
+bool nmeaEpochAssemblerInit(NmeaEpochAssembler *assembler, const NmeaEpochConfig *config) {
+  if (!assembler //
+      || !config) {
+    return false;
+  }
+
+  memset(assembler, 0, sizeof(*assembler));
+  assembler->config = *config;
+
+  if (!nmeaParserInit(&assembler->parser, 0)) {
+    /* can't be covered in a test */
+    return false;
+  }
+
+  nmeaEpochStart(&assembler->epoch);
+  clock_gettime(CLOCK_MONOTONIC, &assembler->last);
+
+  return true;
+}
+
+void nmeaEpochAssemblerDestroy(NmeaEpochAssembler *assembler) {
+  if (!assembler) {
+    return;
+  }
+
+  nmeaParserDestroy(&assembler->parser);
+  nmeaEpochStart(&assembler->epoch);
+}
+
+size_t nmeaEpochAssemblerSentence(NmeaEpochAssembler *assembler, const char *s, size_t sz) {
+  NmeaSentencePack pack;
+  NmeaTime utc;
+  size_t r;
+
+  if (!assembler //
+      || !s //
+      || !sz) {
+    return 0;
+  }
+
+  /* the sentence arrived after the timeout of the previous epoch */
+  r = nmeaEpochAssemblerPoll(assembler);
+
+  if (!nmeaSentenceParse(s, sz, &pack)) {
+    return r;
+  }
+
+  if (nmeaSentencePackUtc(&pack, &utc, NULL)) {
+    r += nmeaEpochAssemblerUtc(assembler, &utc);
+  }
+
+  (void) nmeaSentencePackToInfo(&pack, &assembler->epoch.info, &assembler->parser.gpgsv);
+
+  assembler->epoch.sentences++;
+  clock_gettime(CLOCK_MONOTONIC, &assembler->last);
+
+  if (pack.sentence & assembler->config.terminator) {
+    r += nmeaEpochAssemblerEnd(assembler, NMEALIB_EPOCH_END_TERMINATOR);
+  }
+
+  return r;
+}
+
+size_t nmeaEpochAssemblerParse(NmeaEpochAssembler *assembler, const char *s, size_t sz) {
+  size_t r = 0;
+  size_t i;
+
+  if (!assembler //
+      || !s //
+      || !sz) {
+    return 0;
+  }
+
+  for (i = 0; i < sz; i++) {
+    if (nmeaParserProcessCharacter(&assembler->parser, &s[i])) {
+      r += nmeaEpochAssemblerSentence(assembler, assembler->parser.buffer, assembler->parser.bufferLength);
+    }
+  }
+
+  return r;
+}
+
+size_t nmeaEpochAssemblerPoll(NmeaEpochAssembler *assembler) {
+  struct timespec now;
+  long long elapsed;
+
+  if (!assembler //
+      || !assembler->config.timeout //
+      || !assembler->epoch.sentences) {
+    return 0;
+  }
+
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  elapsed = ((long long) (now.tv_sec - assembler->last.tv_sec) * 1000LL) //
+      + ((long long) (now.tv_nsec - assembler->last.tv_nsec) / 1000000LL);
+
+  if (elapsed < (long long) assembler->config.timeout) {
+    return 0;
+  }
+
+  return nmeaEpochAssemblerEnd(assembler, NMEALIB_EPOCH_END_TIMEOUT);
+}
+
+size_t nmeaEpochAssemblerFlush(NmeaEpochAssembler *assembler) {
+  if (!assembler) {
+    return 0;
+  }
+
+  return nmeaEpochAssemblerEnd(assembler, NMEALIB_EPOCH_END_FLUSH);
+}
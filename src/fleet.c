@@ -0,0 +1,421 @@
+/*
+ * This file is part of nmealib.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <nmealib/fleet.h>
+
+#include <nmealib/context.h>
+#include <nmealib/util.h>
+#include <errno.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/** The minimum size of the output buffer of a worker */
+#define NMEALIB_FLEET_OUTPUT_SIZE (16 * NMEALIB_BUFFER_CHUNK_SIZE)
+
+/**
+ * Fleet worker
+ */
+typedef struct _NmeaFleetWorker {
+    NmeaFleet     *fleet;     /**< the fleet                                   */
+    NmeaGenerator *generator; /**< the generator chain of the vehicles         */
+    pthread_t      thread;    /**< the worker thread                           */
+    bool           started;   /**< true when the worker thread was started     */
+    size_t         index;     /**< the index of the worker                     */
+    size_t         first;     /**< the index of the first vehicle              */
+    size_t         count;     /**< the number of vehicles                      */
+    uint64_t       epochs;    /**< the number of generated vehicle epochs      */
+    uint64_t       bytes;     /**< the number of generated bytes               */
+    bool           failed;    /**< true when writing the output failed         */
+} NmeaFleetWorker;
+
+/**
+ * Fleet
+ */
+struct _NmeaFleet {
+    NmeaFleetConfig   config;      /**< the configuration                              */
+    NmeaInfo         *infos;       /**< the info structures of the vehicles            */
+    NmeaFleetWorker  *workers;     /**< the workers                                    */
+    size_t            threads;     /**< the number of workers                          */
+    size_t            vehicleSize; /**< the maximum output length of a vehicle epoch   */
+    pthread_mutex_t   fdLock;      /**< serialises the writes to the file descriptor   */
+    bool              stop;        /**< true when the workers must stop                */
+    bool              running;     /**< true when the workers were started             */
+};
+
+/**
+ * Write a buffer completely to a file descriptor
+ *
+ * @param fd The file descriptor
+ * @param s The buffer
+ * @param sz The length of the buffer
+ * @return True on success
+ */
+static bool nmeaFleetWrite(int fd, const char *s, size_t sz) {
+  while (sz) {
+    ssize_t written = write(fd, s, sz);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+
+      return false;
+    }
+
+    s += written;
+    sz -= (size_t) written;
+  }
+
+  return true;
+}
+
+/**
+ * Flush the output buffer of a worker to the file descriptor of the fleet
+ *
+ * @param worker The worker
+ * @param s The output buffer
+ * @param sz The length of the output in the buffer
+ * @return True on success
+ */
+static bool nmeaFleetFlush(NmeaFleetWorker *worker, const char *s, size_t sz) {
+  NmeaFleet *fleet = worker->fleet;
+  bool r;
+
+  if (!sz) {
+    return true;
+  }
+
+  pthread_mutex_lock(&fleet->fdLock);
+  r = nmeaFleetWrite(fleet->config.fd, s, sz);
+  pthread_mutex_unlock(&fleet->fdLock);
+
+  if (!r) {
+    nmeaContextError("%s error: could not write to fd %d: %s", __FUNCTION__, fleet->config.fd, strerror(errno));
+    worker->failed = true;
+  }
+
+  return r;
+}
+
+/**
+ * Advance a time by a number of nanoseconds
+ *
+ * @param t The time
+ * @param ns The number of nanoseconds
+ */
+static void nmeaFleetTimeAdd(struct timespec *t, long long ns) {
+  long long nsec = (long long) t->tv_nsec + ns;
+
+  t->tv_sec += (time_t) (nsec / 1000000000LL);
+  t->tv_nsec = (long) (nsec % 1000000000LL);
+}
+
+/**
+ * The worker thread function
+ *
+ * @param arg The worker
+ * @return NULL
+ */
+static void *nmeaFleetWorkerRun(void *arg) {
+  NmeaFleetWorker *worker = (NmeaFleetWorker *) arg;
+  NmeaFleet *fleet = worker->fleet;
+  const NmeaFleetConfig *config = &fleet->config;
+  long long interval = 0;
+  struct timespec next;
+  char *buf;
+  size_t bufSize;
+  size_t chars = 0;
+  uint64_t epoch;
+
+  nmeaRandomSeedThread(config->seed + worker->index + 1);
+
+  bufSize = MAX(NMEALIB_FLEET_OUTPUT_SIZE, fleet->vehicleSize + 1);
+  buf = malloc(bufSize);
+  if (!buf) {
+    /* can't be covered in a test */
+    worker->failed = true;
+    return NULL;
+  }
+
+  if (config->rate > 0.0) {
+    interval = (long long) (1000000000.0 / config->rate);
+    clock_gettime(CLOCK_MONOTONIC, &next);
+
+    /* spread the workers over the interval */
+    nmeaFleetTimeAdd(&next, (interval / (long long) fleet->threads) * (long long) worker->index);
+  }
+
+  for (epoch = 0; !config->epochs || (epoch < config->epochs); epoch++) {
+    size_t i;
+
+    if (__atomic_load_n(&fleet->stop, __ATOMIC_RELAXED)) {
+      break;
+    }
+
+    if (interval) {
+      while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, NULL) == EINTR) {
+        /* retry */
+      }
+      nmeaFleetTimeAdd(&next, interval);
+
+      /* a stop may have arrived while sleeping */
+      if (__atomic_load_n(&fleet->stop, __ATOMIC_RELAXED)) {
+        break;
+      }
+    }
+
+    nmeaGeneratorInvokeBatch(worker->generator, &fleet->infos[worker->first], worker->count);
+
+    for (i = worker->first; i < (worker->first + worker->count); i++) {
+      const NmeaInfo *info = &fleet->infos[i];
+      size_t len;
+
+      if (config->output) {
+        len = nmeaSentenceFromInfoFixed(buf, bufSize, info, config->mask);
+        config->output(config->user, i, buf, len);
+      } else {
+        if ((bufSize - chars) <= fleet->vehicleSize) {
+          if (!nmeaFleetFlush(worker, buf, chars)) {
+            goto out;
+          }
+          chars = 0;
+        }
+
+        len = nmeaSentenceFromInfoFixed(&buf[chars], bufSize - chars, info, config->mask);
+        chars += len;
+      }
+
+      __atomic_add_fetch(&worker->epochs, 1, __ATOMIC_RELAXED);
+      __atomic_add_fetch(&worker->bytes, len, __ATOMIC_RELAXED);
+    }
+
+    /* flush every epoch so that rate limited streams are not delayed */
+    if (!config->output) {
+      if (!nmeaFleetFlush(worker, buf, chars)) {
+        goto out;
+      }
+      chars = 0;
+    }
+  }
+
+out:
+  free(buf);
+  return NULL;
+}
+
+NmeaFleet *nmeaFleetCreate(const NmeaFleetConfig *config) {
+  NmeaFleet *fleet;
+  NmeaInfo info;
+  size_t vehiclesPerThread;
+  size_t vehiclesRemainder;
+  size_t first;
+  size_t i;
+  size_t j;
+
+  if (!config //
+      || !config->vehicles //
+      || !config->threads //
+      || !(config->mask & NMEALIB_SENTENCE_MASK) //
+      || (config->rate < 0.0) //
+      || (!config->output && (config->fd < 0))) {
+    return NULL;
+  }
+
+  fleet = calloc(1, sizeof(*fleet));
+  if (!fleet) {
+    /* can't be covered in a test */
+    return NULL;
+  }
+
+  fleet->config = *config;
+  fleet->threads = MIN(config->threads, config->vehicles);
+
+  /* the maximum output length of a vehicle epoch: all satellites in view */
+  memset(&info, 0, sizeof(info));
+  info.satellites.inViewCount = NMEALIB_MAX_SATELLITES;
+  nmeaInfoSetPresent(&info.present, NMEALIB_PRESENT_SATINVIEWCOUNT);
+  fleet->vehicleSize = nmeaSentenceFromInfoLengthMax(&info, config->mask);
+
+  if (pthread_mutex_init(&fleet->fdLock, NULL)) {
+    /* can't be covered in a test */
+    free(fleet);
+    return NULL;
+  }
+
+  fleet->infos = calloc(config->vehicles, sizeof(fleet->infos[0]));
+  fleet->workers = calloc(fleet->threads, sizeof(fleet->workers[0]));
+  if (!fleet->infos //
+      || !fleet->workers) {
+    /* can't be covered in a test */
+    goto err;
+  }
+
+  vehiclesPerThread = config->vehicles / fleet->threads;
+  vehiclesRemainder = config->vehicles % fleet->threads;
+  first = 0;
+
+  for (i = 0; i < fleet->threads; i++) {
+    NmeaFleetWorker *worker = &fleet->workers[i];
+
+    worker->fleet = fleet;
+    worker->index = i;
+    worker->first = first;
+    worker->count = vehiclesPerThread + ((i < vehiclesRemainder) ?
+        1 :
+        0);
+
+    first += worker->count;
+
+    /* one generator chain per worker, invoked on all its vehicles at once */
+    for (j = worker->first; j < (worker->first + worker->count); j++) {
+      NmeaInfo *vehicleInfo = &fleet->infos[j];
+
+      nmeaInfoClear(vehicleInfo);
+      nmeaTimeSet(&vehicleInfo->utc, &vehicleInfo->present, NULL);
+
+      if (!worker->generator) {
+        worker->generator = nmeaGeneratorCreate(config->type, vehicleInfo);
+        if (!worker->generator) {
+          goto err;
+        }
+      } else {
+        nmeaGeneratorInit(worker->generator, vehicleInfo);
+      }
+
+      if (config->init) {
+        config->init(config->user, j, vehicleInfo);
+      }
+    }
+  }
+
+  return fleet;
+
+err:
+  nmeaFleetDestroy(fleet);
+  return NULL;
+}
+
+void nmeaFleetDestroy(NmeaFleet *fleet) {
+  size_t i;
+
+  if (!fleet) {
+    return;
+  }
+
+  nmeaFleetStop(fleet);
+  nmeaFleetJoin(fleet);
+
+  if (fleet->workers) {
+    for (i = 0; i < fleet->threads; i++) {
+      nmeaGeneratorDestroy(fleet->workers[i].generator);
+    }
+  }
+
+  pthread_mutex_destroy(&fleet->fdLock);
+
+  free(fleet->workers);
+  free(fleet->infos);
+  free(fleet);
+}
+
+bool nmeaFleetStart(NmeaFleet *fleet) {
+  size_t i;
+
+  if (!fleet //
+      || fleet->running) {
+    return false;
+  }
+
+  fleet->stop = false;
+  fleet->running = true;
+
+  for (i = 0; i < fleet->threads; i++) {
+    NmeaFleetWorker *worker = &fleet->workers[i];
+
+    worker->failed = false;
+    if (pthread_create(&worker->thread, NULL, nmeaFleetWorkerRun, worker)) {
+      /* can't be covered in a test */
+      nmeaFleetStop(fleet);
+      nmeaFleetJoin(fleet);
+      return false;
+    }
+    worker->started = true;
+  }
+
+  return true;
+}
+
+void nmeaFleetStop(NmeaFleet *fleet) {
+  if (!fleet) {
+    return;
+  }
+
+  __atomic_store_n(&fleet->stop, true, __ATOMIC_RELAXED);
+}
+
+bool nmeaFleetJoin(NmeaFleet *fleet) {
+  bool r = true;
+  size_t i;
+
+  if (!fleet) {
+    return false;
+  }
+
+  if (!fleet->running) {
+    return true;
+  }
+
+  for (i = 0; i < fleet->threads; i++) {
+    NmeaFleetWorker *worker = &fleet->workers[i];
+
+    if (worker->started) {
+      pthread_join(worker->thread, NULL);
+      worker->started = false;
+    }
+
+    if (worker->failed) {
+      r = false;
+    }
+  }
+
+  fleet->running = false;
+
+  return r;
+}
+
+void nmeaFleetStatistics(const NmeaFleet *fleet, uint64_t *epochs, uint64_t *bytes) {
+  uint64_t e = 0;
+  uint64_t b = 0;
+  size_t i;
+
+  if (fleet) {
+    for (i = 0; i < fleet->threads; i++) {
+      e += __atomic_load_n(&fleet->workers[i].epochs, __ATOMIC_RELAXED);
+      b += __atomic_load_n(&fleet->workers[i].bytes, __ATOMIC_RELAXED);
+    }
+  }
+
+  if (epochs) {
+    *epochs = e;
+  }
+
+  if (bytes) {
+    *bytes = b;
+  }
+}
@@ -19,27 +19,38 @@
 
 #include <nmealib/context.h>
 #include <nmealib/nmath.h>
+#include <nmealib/parser.h>
 #include <nmealib/sentence.h>
+#include <errno.h>
 #include <math.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 
 /*
  * Forward declarations
  */
 
 bool nmeaGeneratorInvokeNoise(NmeaGenerator *gen, NmeaInfo *info);
+bool nmeaGeneratorInvokeBatchNoise(NmeaGenerator *gen, NmeaInfo *infos, size_t n);
 
 bool nmeaGeneratorInitStatic(NmeaGenerator *gen, NmeaInfo *info);
 bool nmeaGeneratorInvokeStatic(NmeaGenerator *gen, NmeaInfo *info);
+bool nmeaGeneratorInvokeBatchStatic(NmeaGenerator *gen, NmeaInfo *infos, size_t n);
 bool nmeaGeneratorResetStatic(NmeaGenerator *gen, NmeaInfo *info);
 
 bool nmeaGeneratorInitRotate(NmeaGenerator *gen, NmeaInfo *info);
 bool nmeaGeneratorInvokeRotate(NmeaGenerator *gen, NmeaInfo *info);
+bool nmeaGeneratorInvokeBatchRotate(NmeaGenerator *gen, NmeaInfo *infos, size_t n);
 bool nmeaGeneratorResetRotate(NmeaGenerator *gen, NmeaInfo *info);
 
 bool nmeaGeneratorInitRandomMove(NmeaGenerator *gen, NmeaInfo *info);
 bool nmeaGeneratorInvokeRandomMove(NmeaGenerator *gen, NmeaInfo *info);
+bool nmeaGeneratorInvokeBatchRandomMove(NmeaGenerator *gen, NmeaInfo *infos, size_t n);
+
+bool nmeaGeneratorInvokeReplay(NmeaGenerator *gen, NmeaInfo *info);
+bool nmeaGeneratorResetReplay(NmeaGenerator *gen, NmeaInfo *info);
 
 /*
  * NOISE generator
@@ -55,6 +66,8 @@ bool nmeaGeneratorInvokeRandomMove(NmeaGenerator *gen, NmeaInfo *info);
  * @return True on success
  */
 bool nmeaGeneratorInvokeNoise(NmeaGenerator *gen __attribute__ ((unused)), NmeaInfo *info) {
+  NmeaSatellite inView[NMEALIB_MAX_SATELLITES];
+  unsigned int inViewCount = 0;
   size_t i;
   size_t inUseCount;
 
@@ -95,7 +108,6 @@ bool nmeaGeneratorInvokeNoise(NmeaGenerator *gen __attribute__ ((unused)), NmeaI
   nmeaInfoSetPresent(&info->present, NMEALIB_PRESENT_DGPSSID);
 
   info->satellites.inUseCount = 0;
-  info->satellites.inViewCount = 0;
 
   for (i = 0; i < NMEALIB_MAX_SATELLITES; i++) {
     inUseCount = (size_t) labs(lrint(nmeaRandom(0.0, 3.0)));
@@ -107,17 +119,19 @@ bool nmeaGeneratorInvokeNoise(NmeaGenerator *gen __attribute__ ((unused)), NmeaI
       info->satellites.inUseCount++;
     }
 
-    info->satellites.inView[i].prn = (unsigned int) i;
-    info->satellites.inView[i].elevation = (int) lrint(nmeaRandom(0.0, 90.0));
-    info->satellites.inView[i].azimuth = (unsigned int) lrint(nmeaRandom(0.0, 359.0));
-    info->satellites.inView[i].snr = inUseCount ?
+    inView[i].prn = (unsigned int) i;
+    inView[i].elevation = (int) lrint(nmeaRandom(0.0, 90.0));
+    inView[i].azimuth = (unsigned int) lrint(nmeaRandom(0.0, 359.0));
+    inView[i].snr = inUseCount ?
         (unsigned int) lrint(nmeaRandom(40.0, 99.0)) :
         (unsigned int) lrint(nmeaRandom(0.0, 40.0));
-    if (info->satellites.inView[i].snr) {
-      info->satellites.inViewCount++;
+    if (inView[i].snr) {
+      inViewCount++;
     }
   }
 
+  (void) nmeaInfoSatellitesInViewPublish(info, inView, inViewCount);
+
   nmeaInfoSetPresent(&info->present, NMEALIB_PRESENT_SATINUSECOUNT);
   nmeaInfoSetPresent(&info->present, NMEALIB_PRESENT_SATINUSE);
   nmeaInfoSetPresent(&info->present, NMEALIB_PRESENT_SATINVIEWCOUNT);
@@ -126,6 +140,28 @@ bool nmeaGeneratorInvokeNoise(NmeaGenerator *gen __attribute__ ((unused)), NmeaI
   return true;
 }
 
+/**
+ * NOISE Generator batch invoke function
+ *
+ * @param gen The generator
+ * @param infos The info structures to use during generation
+ * @param n The number of info structures
+ * @return True on success
+ */
+bool nmeaGeneratorInvokeBatchNoise(NmeaGenerator *gen, NmeaInfo *infos, size_t n) {
+  size_t i;
+
+  if (!infos) {
+    return false;
+  }
+
+  for (i = 0; i < n; i++) {
+    nmeaGeneratorInvokeNoise(gen, &infos[i]);
+  }
+
+  return true;
+}
+
 /*
  * STATIC generator
  */
@@ -175,6 +211,35 @@ bool nmeaGeneratorInvokeStatic(NmeaGenerator *gen __attribute__ ((unused)), Nmea
   return true;
 }
 
+/**
+ * STATIC Generator batch invoke function
+ *
+ * Only touches utc in the info structures, all get the same time.
+ *
+ * @param gen The generator
+ * @param infos The info structures to use during generation
+ * @param n The number of info structures
+ * @return True on success
+ */
+bool nmeaGeneratorInvokeBatchStatic(NmeaGenerator *gen __attribute__ ((unused)), NmeaInfo *infos, size_t n) {
+  NmeaTime utc;
+  uint32_t present = 0;
+  size_t i;
+
+  if (!infos) {
+    return false;
+  }
+
+  nmeaTimeSet(&utc, &present, NULL);
+
+  for (i = 0; i < n; i++) {
+    infos[i].utc = utc;
+    infos[i].present |= present;
+  }
+
+  return true;
+}
+
 /**
  * STATIC Generator reset function
  *
@@ -185,36 +250,41 @@ bool nmeaGeneratorInvokeStatic(NmeaGenerator *gen __attribute__ ((unused)), Nmea
  * @return True on success
  */
 bool nmeaGeneratorResetStatic(NmeaGenerator *gen __attribute__ ((unused)), NmeaInfo *info) {
+  NmeaSatellite inView[NMEALIB_MAX_SATELLITES];
+
   if (!info) {
     return false;
   }
 
+  memcpy(inView, info->satellites.inView, sizeof(inView));
+
   info->satellites.inUseCount = 4;
-  info->satellites.inViewCount = 4;
 
   info->satellites.inUse[0] = 1;
-  info->satellites.inView[0].prn = 1;
-  info->satellites.inView[0].elevation = 50;
-  info->satellites.inView[0].azimuth = 0;
-  info->satellites.inView[0].snr = 99;
+  inView[0].prn = 1;
+  inView[0].elevation = 50;
+  inView[0].azimuth = 0;
+  inView[0].snr = 99;
 
   info->satellites.inUse[1] = 2;
-  info->satellites.inView[1].prn = 2;
-  info->satellites.inView[1].elevation = 50;
-  info->satellites.inView[1].azimuth = 90;
-  info->satellites.inView[1].snr = 99;
+  inView[1].prn = 2;
+  inView[1].elevation = 50;
+  inView[1].azimuth = 90;
+  inView[1].snr = 99;
 
   info->satellites.inUse[2] = 3;
-  info->satellites.inView[2].prn = 3;
-  info->satellites.inView[2].elevation = 50;
-  info->satellites.inView[2].azimuth = 180;
-  info->satellites.inView[2].snr = 99;
+  inView[2].prn = 3;
+  inView[2].elevation = 50;
+  inView[2].azimuth = 180;
+  inView[2].snr = 99;
 
   info->satellites.inUse[3] = 4;
-  info->satellites.inView[3].prn = 4;
-  info->satellites.inView[3].elevation = 50;
-  info->satellites.inView[3].azimuth = 270;
-  info->satellites.inView[3].snr = 99;
+  inView[3].prn = 4;
+  inView[3].elevation = 50;
+  inView[3].azimuth = 270;
+  inView[3].snr = 99;
+
+  (void) nmeaInfoSatellitesInViewPublish(info, inView, 4);
 
   nmeaInfoSetPresent(&info->present, NMEALIB_PRESENT_SATINUSECOUNT);
   nmeaInfoSetPresent(&info->present, NMEALIB_PRESENT_SATINUSE);
@@ -255,42 +325,80 @@ bool nmeaGeneratorInitRotate(NmeaGenerator *gen, NmeaInfo *info) {
 }
 
 /**
- * SAT_ROTATE Generator invoke function.
+ * Rotate the satellites in view of an info structure by 5 degrees
  *
- * @param gen The generator
- * @param info The info structure to use during generation
- * @return True on success
+ * @param info The info structure
  */
-bool nmeaGeneratorInvokeRotate(NmeaGenerator *gen __attribute__ ((unused)), NmeaInfo *info) {
+static void nmeaGeneratorRotateSatellites(NmeaInfo *info) {
+  NmeaSatellite inView[NMEALIB_MAX_SATELLITES];
   size_t i;
-  size_t inViewCount;
-  double degreesPerSatellite;
-  double azimuth;
-
-  if (!info) {
-    return false;
-  }
-
-  inViewCount = info->satellites.inViewCount;
-  degreesPerSatellite = 360.0 / (inViewCount ?
+  size_t inViewCount = info->satellites.inViewCount;
+  double degreesPerSatellite = 360.0 / (inViewCount ?
       (double) inViewCount :
       1.0);
-  azimuth = (inViewCount ?
+  double azimuth = (inViewCount ?
       (info->satellites.inView[0].azimuth) :
       0) + 5;
 
-  nmeaTimeSet(&info->utc, &info->present, NULL);
+  memcpy(inView, info->satellites.inView, sizeof(inView));
 
   for (i = 0; i < inViewCount; i++) {
     while (azimuth >= 360.0) {
       azimuth -= 360.0;
     }
-    info->satellites.inView[i].azimuth = (unsigned int) azimuth;
+    inView[i].azimuth = (unsigned int) azimuth;
     azimuth += degreesPerSatellite;
   }
 
-  nmeaInfoSetPresent(&info->present, NMEALIB_PRESENT_SATINVIEWCOUNT);
-  nmeaInfoSetPresent(&info->present, NMEALIB_PRESENT_SATINVIEW);
+  (void) nmeaInfoSatellitesInViewPublish(info, inView, info->satellites.inViewCount);
+
+  nmeaInfoSetPresent(&info->present, NMEALIB_PRESENT_SATINVIEWCOUNT | NMEALIB_PRESENT_SATINVIEW);
+}
+
+/**
+ * SAT_ROTATE Generator invoke function.
+ *
+ * @param gen The generator
+ * @param info The info structure to use during generation
+ * @return True on success
+ */
+bool nmeaGeneratorInvokeRotate(NmeaGenerator *gen __attribute__ ((unused)), NmeaInfo *info) {
+  if (!info) {
+    return false;
+  }
+
+  nmeaTimeSet(&info->utc, &info->present, NULL);
+  nmeaGeneratorRotateSatellites(info);
+
+  return true;
+}
+
+/**
+ * SAT_ROTATE Generator batch invoke function.
+ *
+ * All info structures get the same time.
+ *
+ * @param gen The generator
+ * @param infos The info structures to use during generation
+ * @param n The number of info structures
+ * @return True on success
+ */
+bool nmeaGeneratorInvokeBatchRotate(NmeaGenerator *gen __attribute__ ((unused)), NmeaInfo *infos, size_t n) {
+  NmeaTime utc;
+  uint32_t present = 0;
+  size_t i;
+
+  if (!infos) {
+    return false;
+  }
+
+  nmeaTimeSet(&utc, &present, NULL);
+
+  for (i = 0; i < n; i++) {
+    infos[i].utc = utc;
+    infos[i].present |= present;
+    nmeaGeneratorRotateSatellites(&infos[i]);
+  }
 
   return true;
 }
@@ -303,6 +411,7 @@ bool nmeaGeneratorInvokeRotate(NmeaGenerator *gen __attribute__ ((unused)), Nmea
  * @return True on success
  */
 bool nmeaGeneratorResetRotate(NmeaGenerator *gen __attribute__ ((unused)), NmeaInfo *info) {
+  NmeaSatellite inView[NMEALIB_MAX_SATELLITES];
   size_t i;
   double degrees = 360 / 8;
   double azimuth = 0;
@@ -311,18 +420,21 @@ bool nmeaGeneratorResetRotate(NmeaGenerator *gen __attribute__ ((unused)), NmeaI
     return false;
   }
 
+  memcpy(inView, info->satellites.inView, sizeof(inView));
+
   info->satellites.inUseCount = 8;
-  info->satellites.inViewCount = 8;
 
-  for (i = 0; i < info->satellites.inViewCount; i++) {
+  for (i = 0; i < info->satellites.inUseCount; i++) {
     info->satellites.inUse[i] = (unsigned int) (i + 1);
-    info->satellites.inView[i].prn = (unsigned int) (i + 1);
-    info->satellites.inView[i].elevation = 5;
-    info->satellites.inView[i].azimuth = (unsigned int) azimuth;
-    info->satellites.inView[i].snr = 80;
+    inView[i].prn = (unsigned int) (i + 1);
+    inView[i].elevation = 5;
+    inView[i].azimuth = (unsigned int) azimuth;
+    inView[i].snr = 80;
     azimuth += degrees;
   }
 
+  (void) nmeaInfoSatellitesInViewPublish(info, inView, 8);
+
   nmeaInfoSetPresent(&info->present, NMEALIB_PRESENT_SATINUSECOUNT);
   nmeaInfoSetPresent(&info->present, NMEALIB_PRESENT_SATINUSE);
   nmeaInfoSetPresent(&info->present, NMEALIB_PRESENT_SATINVIEWCOUNT);
@@ -367,19 +479,11 @@ bool nmeaGeneratorInitRandomMove(NmeaGenerator *gen __attribute__ ((unused)), Nm
 }
 
 /**
- * POS_RANDMOVE Generator invoke function
+ * Randomly change the course (track, mtrack and speed) of an info structure
  *
- * @param gen The generator
- * @param info The info structure to use during generation
- * @return True on success
+ * @param info The info structure
  */
-bool nmeaGeneratorInvokeRandomMove(NmeaGenerator *gen __attribute__ ((unused)), NmeaInfo *info) {
-  NmeaPosition pos;
-
-  if (!info) {
-    return false;
-  }
-
+static void nmeaGeneratorRandomMoveCourse(NmeaInfo *info) {
   info->track += nmeaRandom(-10.0, 10.0);
   info->mtrack += nmeaRandom(-10.0, 10.0);
   info->speed += nmeaRandom(-2.0, 3.0);
@@ -404,7 +508,23 @@ bool nmeaGeneratorInvokeRandomMove(NmeaGenerator *gen __attribute__ ((unused)),
   if (info->speed > 40.0) {
     info->speed = 40.0;
   }
+}
+
+/**
+ * POS_RANDMOVE Generator invoke function
+ *
+ * @param gen The generator
+ * @param info The info structure to use during generation
+ * @return True on success
+ */
+bool nmeaGeneratorInvokeRandomMove(NmeaGenerator *gen __attribute__ ((unused)), NmeaInfo *info) {
+  NmeaPosition pos;
+
+  if (!info) {
+    return false;
+  }
 
+  nmeaGeneratorRandomMoveCourse(info);
 
   nmeaMathInfoToPosition(info, &pos);
   nmeaMathMoveFlat(&pos, &pos, info->track, info->speed / 3600.0);
@@ -422,6 +542,426 @@ bool nmeaGeneratorInvokeRandomMove(NmeaGenerator *gen __attribute__ ((unused)),
   return true;
 }
 
+/**
+ * POS_RANDMOVE Generator batch invoke function
+ *
+ * First randomly changes the course of all info structures, then moves all
+ * of them (the same computation as nmeaMathMoveFlat) in a loop without
+ * function calls other than those into the maths library.
+ *
+ * @param gen The generator
+ * @param infos The info structures to use during generation
+ * @param n The number of info structures
+ * @return True on success
+ */
+bool nmeaGeneratorInvokeBatchRandomMove(NmeaGenerator *gen __attribute__ ((unused)), NmeaInfo *infos, size_t n) {
+  const uint32_t present = NMEALIB_PRESENT_LAT //
+      | NMEALIB_PRESENT_LON //
+      | NMEALIB_PRESENT_SPEED //
+      | NMEALIB_PRESENT_TRACK //
+      | NMEALIB_PRESENT_MTRACK //
+      | NMEALIB_PRESENT_MAGVAR;
+  size_t i;
+
+  if (!infos) {
+    return false;
+  }
+
+  for (i = 0; i < n; i++) {
+    nmeaGeneratorRandomMoveCourse(&infos[i]);
+  }
+
+  for (i = 0; i < n; i++) {
+    NmeaInfo *info = &infos[i];
+    double lat = nmeaInfoIsPresentAll(info->present, NMEALIB_PRESENT_LAT) ?
+        info->latitude :
+        NMEALIB_LATITUDE_DEFAULT_NDEG;
+    double lon = nmeaInfoIsPresentAll(info->present, NMEALIB_PRESENT_LON) ?
+        info->longitude :
+        NMEALIB_LONGITUDE_DEFAULT_NDEG;
+    double distance = (info->speed / 3600.0) / NMEALIB_EARTHRADIUS_KM;
+    double azimuth = info->track * NMEALIB_DEGREE_TO_RADIAN;
+    double sinDistance = sin(distance);
+    double cosDistance = cos(distance);
+    double sinLat;
+    double cosLat;
+    double toLat;
+
+    lat = nmeaMathNdegToRadian(lat);
+    lon = nmeaMathNdegToRadian(lon);
+    sinLat = sin(lat);
+    cosLat = cos(lat);
+
+    toLat = asin((sinLat * cosDistance) + (cosLat * sinDistance * cos(azimuth)));
+    lon += atan2(sin(azimuth) * sinDistance * cosLat, cosDistance - (sinLat * sin(toLat)));
+
+    info->latitude = nmeaMathRadianToNdeg(toLat);
+    info->longitude = nmeaMathRadianToNdeg(lon);
+    info->magvar = info->track;
+    info->present |= present;
+  }
+
+  return true;
+}
+
+/*
+ * REPLAY generator
+ */
+
+/** The number of epochs by which the epochs of a parsed log grow */
+#define NMEALIB_GENERATOR_REPLAY_GROW (64u)
+
+/**
+ * REPLAY generator epoch
+ */
+typedef struct _NmeaGeneratorReplayEpoch {
+    int64_t  offset; /**< the offset from the first epoch, in microseconds */
+    NmeaInfo info;   /**< the recorded info                                */
+} NmeaGeneratorReplayEpoch;
+
+/**
+ * REPLAY generator
+ *
+ * The generator must be the first member so that the generator functions
+ * (and nmeaGeneratorDestroy) can treat it as a plain generator.
+ */
+typedef struct _NmeaGeneratorReplay {
+    NmeaGenerator             gen;        /**< the generator                                            */
+    NmeaGeneratorReplayConfig config;     /**< the playback configuration                               */
+    bool                      started;    /**< true when the playback was started                       */
+    struct timespec           startClock; /**< the (monotonic) time at which the playback was started   */
+    struct timeval            startUtc;   /**< the utc of the first epoch                               */
+    int64_t                   loopOffset; /**< the offset of the current loop, in microseconds          */
+    size_t                    index;      /**< the index of the next epoch                              */
+    size_t                    count;      /**< the number of epochs                                     */
+    NmeaGeneratorReplayEpoch  epochs[];   /**< the epochs                                               */
+} NmeaGeneratorReplay;
+
+/**
+ * Get the time of an info structure in microseconds
+ *
+ * @param info The info structure
+ * @return The time in microseconds since the epoch when the utc date is
+ * present, otherwise since midnight
+ */
+static int64_t nmeaGeneratorReplayTime(const NmeaInfo *info) {
+  NmeaTime utc = info->utc;
+
+  if (!nmeaInfoIsPresentAll(info->present, NMEALIB_PRESENT_UTCDATE)) {
+    utc.year = 1970;
+    utc.mon = 1;
+    utc.day = 1;
+  }
+
+  return nmeaTimeToEpochUs(&utc);
+}
+
+/**
+ * Determine the offsets of the epochs of a REPLAY generator
+ *
+ * Epochs without utc time get the offset of the preceding epoch. Time that
+ * runs backwards by more than half a day is taken to have passed midnight
+ * (without a utc date, or with a utc date that was not yet updated), time
+ * that runs backwards otherwise (out of order epochs) is treated as no time
+ * at all.
+ *
+ * @param replay The REPLAY generator
+ */
+static void nmeaGeneratorReplayOffsets(NmeaGeneratorReplay *replay) {
+  int64_t offset = 0;
+  int64_t previous = 0;
+  bool previousPresent = false;
+  size_t i;
+
+  for (i = 0; i < replay->count; i++) {
+    const NmeaInfo *info = &replay->epochs[i].info;
+
+    if (nmeaInfoIsPresentAll(info->present, NMEALIB_PRESENT_UTCTIME)) {
+      int64_t time = nmeaGeneratorReplayTime(info);
+
+      if (previousPresent) {
+        int64_t delta = time - previous;
+
+        /* over midnight without (an updated) utc date */
+        if (delta < ((int64_t) -43200 * 1000000)) {
+          delta += (int64_t) 86400 * 1000000;
+        }
+
+        if (delta > 0) {
+          offset += delta;
+        }
+      }
+
+      previous = time;
+      previousPresent = true;
+    }
+
+    replay->epochs[i].offset = offset;
+  }
+}
+
+/**
+ * Allocate (or grow) a REPLAY generator
+ *
+ * @param replay The REPLAY generator to grow, NULL to allocate a new one
+ * @param count The number of epochs
+ * @return The REPLAY generator, or NULL on failure (replay is not freed)
+ */
+static NmeaGeneratorReplay *nmeaGeneratorReplayAllocate(NmeaGeneratorReplay *replay, size_t count) {
+  size_t size;
+
+  if (count > ((SIZE_MAX - sizeof(NmeaGeneratorReplay)) / sizeof(NmeaGeneratorReplayEpoch))) {
+    /* can't be covered in a test */
+    return NULL;
+  }
+
+  size = sizeof(NmeaGeneratorReplay) + (count * sizeof(NmeaGeneratorReplayEpoch));
+
+  if (!replay) {
+    return calloc(1, size);
+  }
+
+  return realloc(replay, size);
+}
+
+/**
+ * Finish the setup of a REPLAY generator of which the epochs have been
+ * filled in, and initialise it
+ *
+ * @param replay The REPLAY generator
+ * @param config The playback configuration, NULL for real time playback
+ * without jitter and looping
+ * @param info The info structure to use during generation
+ * @return The generator
+ */
+static NmeaGenerator *nmeaGeneratorReplaySetup(NmeaGeneratorReplay *replay, const NmeaGeneratorReplayConfig *config,
+    NmeaInfo *info) {
+  memset(&replay->gen, 0, sizeof(replay->gen));
+  replay->gen.invoke = nmeaGeneratorInvokeReplay;
+  replay->gen.reset = nmeaGeneratorResetReplay;
+
+  if (config) {
+    replay->config = *config;
+  } else {
+    memset(&replay->config, 0, sizeof(replay->config));
+    replay->config.speed = 1.0;
+  }
+
+  nmeaGeneratorReplayOffsets(replay);
+  nmeaGeneratorResetReplay(&replay->gen, info);
+  nmeaGeneratorInit(&replay->gen, info);
+
+  return &replay->gen;
+}
+
+/**
+ * REPLAY Generator invoke function
+ *
+ * Replaces info by the next epoch, see nmeaGeneratorCreateReplay.
+ *
+ * @param gen The generator
+ * @param info The info structure to use during generation
+ * @return True on success, false when there are no more epochs
+ */
+bool nmeaGeneratorInvokeReplay(NmeaGenerator *gen, NmeaInfo *info) {
+  NmeaGeneratorReplay *replay = (NmeaGeneratorReplay *) gen;
+  const NmeaGeneratorReplayEpoch *epoch;
+  int64_t offset;
+  struct timeval tv;
+
+  if (!gen //
+      || !info //
+      || !replay->count) {
+    return false;
+  }
+
+  if (replay->index >= replay->count) {
+    int64_t last = replay->epochs[replay->count - 1].offset;
+
+    if (!replay->config.loop) {
+      return false;
+    }
+
+    /* continue with the average epoch interval */
+    replay->loopOffset += last + ((replay->count > 1) ?
+        (last / (int64_t) (replay->count - 1)) :
+        1000000);
+    replay->index = 0;
+  }
+
+  if (!replay->started) {
+    clock_gettime(CLOCK_MONOTONIC, &replay->startClock);
+    if (replay->config.start.tv_sec || replay->config.start.tv_usec) {
+      replay->startUtc = replay->config.start;
+    } else {
+      gettimeofday(&replay->startUtc, NULL);
+    }
+    replay->started = true;
+  }
+
+  epoch = &replay->epochs[replay->index];
+  offset = replay->loopOffset + epoch->offset;
+
+  if (replay->config.speed > 0.0) {
+    double due;
+    struct timespec t;
+    int64_t ns;
+
+    offset = (int64_t) llround((double) offset / replay->config.speed);
+
+    due = (double) offset;
+    if (replay->config.jitter > 0.0) {
+      due += nmeaRandom(-replay->config.jitter, replay->config.jitter) * 1000000.0;
+    }
+
+    if (due > 0.0) {
+      ns = (int64_t) replay->startClock.tv_nsec + ((int64_t) due * 1000);
+      t.tv_sec = replay->startClock.tv_sec + (time_t) (ns / 1000000000);
+      t.tv_nsec = (long) (ns % 1000000000);
+
+      while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &t, NULL) == EINTR) {
+        /* retry */
+      }
+    }
+  }
+
+  *info = epoch->info;
+
+  offset += replay->startUtc.tv_usec;
+  tv.tv_sec = replay->startUtc.tv_sec + (time_t) (offset / 1000000);
+  tv.tv_usec = (suseconds_t) (offset % 1000000);
+  nmeaTimeSet(&info->utc, &info->present, &tv);
+
+  replay->index++;
+
+  return true;
+}
+
+/**
+ * REPLAY Generator reset function
+ *
+ * Restarts the playback at the first epoch.
+ *
+ * @param gen The generator
+ * @param info The info structure to use during generation
+ * @return True on success
+ */
+bool nmeaGeneratorResetReplay(NmeaGenerator *gen, NmeaInfo *info __attribute__ ((unused))) {
+  NmeaGeneratorReplay *replay = (NmeaGeneratorReplay *) gen;
+
+  if (!gen) {
+    return false;
+  }
+
+  replay->started = false;
+  replay->loopOffset = 0;
+  replay->index = 0;
+
+  return true;
+}
+
+NmeaGenerator *nmeaGeneratorCreateReplay(const NmeaInfo *epochs, size_t count, const NmeaGeneratorReplayConfig *config,
+    NmeaInfo *info) {
+  NmeaGeneratorReplay *replay;
+  size_t i;
+
+  if (!epochs //
+      || !count //
+      || (config && ((config->speed < 0.0) || (config->jitter < 0.0))) //
+      || !info) {
+    return NULL;
+  }
+
+  replay = nmeaGeneratorReplayAllocate(NULL, count);
+  if (!replay) {
+    /* can't be covered in a test */
+    return NULL;
+  }
+
+  replay->count = count;
+  for (i = 0; i < count; i++) {
+    replay->epochs[i].info = epochs[i];
+  }
+
+  return nmeaGeneratorReplaySetup(replay, config, info);
+}
+
+NmeaGenerator *nmeaGeneratorCreateReplayLog(const char *s, size_t sz, const NmeaGeneratorReplayConfig *config,
+    NmeaInfo *info) {
+  NmeaGeneratorReplay *replay = NULL;
+  NmeaParser parser;
+  NmeaInfo current;
+  size_t allocated = 0;
+  size_t i;
+
+  if (!s //
+      || !sz //
+      || (config && ((config->speed < 0.0) || (config->jitter < 0.0))) //
+      || !info) {
+    return NULL;
+  }
+
+  if (!nmeaParserInit(&parser, 0)) {
+    /* can't be covered in a test */
+    return NULL;
+  }
+
+  nmeaInfoClear(&current);
+
+  for (i = 0; i < sz; i++) {
+    const NmeaInfo *last;
+
+    if (!nmeaParserParse(&parser, &s[i], 1, &current, NULL)) {
+      continue;
+    }
+
+    last = (replay && replay->count) ?
+        &replay->epochs[replay->count - 1].info :
+        NULL;
+
+    if (nmeaInfoIsPresentAll(current.present, NMEALIB_PRESENT_UTCTIME) //
+        && (!last //
+            || (last->utc.hour != current.utc.hour) //
+            || (last->utc.min != current.utc.min) //
+            || (last->utc.sec != current.utc.sec) //
+            || (last->utc.hsec != current.utc.hsec))) {
+      /* start a new epoch */
+      if (!replay //
+          || (replay->count == allocated)) {
+        NmeaGeneratorReplay *grown = nmeaGeneratorReplayAllocate(replay, allocated + NMEALIB_GENERATOR_REPLAY_GROW);
+        if (!grown) {
+          /* can't be covered in a test */
+          free(replay);
+          nmeaParserDestroy(&parser);
+          return NULL;
+        }
+
+        if (!replay) {
+          grown->count = 0;
+        }
+
+        replay = grown;
+        allocated += NMEALIB_GENERATOR_REPLAY_GROW;
+      }
+
+      replay->count++;
+    } else if (!last) {
+      /* no utc time yet */
+      continue;
+    }
+
+    replay->epochs[replay->count - 1].info = current;
+  }
+
+  nmeaParserDestroy(&parser);
+
+  if (!replay) {
+    return NULL;
+  }
+
+  return nmeaGeneratorReplaySetup(replay, config, info);
+}
+
 /*
  * Generator
  */
@@ -480,12 +1020,14 @@ NmeaGenerator *nmeaGeneratorCreate(NmeaGeneratorType type, NmeaInfo *info) {
   switch (type) {
     case NMEALIB_GENERATOR_NOISE:
       gen->invoke = nmeaGeneratorInvokeNoise;
+      gen->invokeBatch = nmeaGeneratorInvokeBatchNoise;
       break;
 
     case NMEALIB_GENERATOR_STATIC:
     case NMEALIB_GENERATOR_SAT_STATIC:
       gen->init = nmeaGeneratorInitStatic;
       gen->invoke = nmeaGeneratorInvokeStatic;
+      gen->invokeBatch = nmeaGeneratorInvokeBatchStatic;
       gen->reset = nmeaGeneratorResetStatic;
       break;
 
@@ -493,6 +1035,7 @@ NmeaGenerator *nmeaGeneratorCreate(NmeaGeneratorType type, NmeaInfo *info) {
     case NMEALIB_GENERATOR_SAT_ROTATE:
       gen->init = nmeaGeneratorInitRotate;
       gen->invoke = nmeaGeneratorInvokeRotate;
+      gen->invokeBatch = nmeaGeneratorInvokeBatchRotate;
       gen->reset = nmeaGeneratorResetRotate;
 
       if (type == NMEALIB_GENERATOR_ROTATE) {
@@ -503,8 +1046,14 @@ NmeaGenerator *nmeaGeneratorCreate(NmeaGeneratorType type, NmeaInfo *info) {
     case NMEALIB_GENERATOR_POS_RANDMOVE:
       gen->init = nmeaGeneratorInitRandomMove;
       gen->invoke = nmeaGeneratorInvokeRandomMove;
+      gen->invokeBatch = nmeaGeneratorInvokeBatchRandomMove;
       break;
 
+    case NMEALIB_GENERATOR_REPLAY:
+      /* needs recorded epochs, see nmeaGeneratorCreateReplay */
+      free(gen);
+      return NULL;
+
     default:
       free(gen);
       return NULL;
@@ -563,6 +1112,35 @@ bool nmeaGeneratorInvoke(NmeaGenerator *gen, NmeaInfo *info) {
   return r;
 }
 
+bool nmeaGeneratorInvokeBatch(NmeaGenerator *gen, NmeaInfo *infos, size_t n) {
+  NmeaGenerator *g = gen;
+
+  if (!gen //
+      || !infos) {
+    return false;
+  }
+
+  while (g) {
+    if (g->invokeBatch) {
+      if (!(*g->invokeBatch)(g, infos, n)) {
+        return false;
+      }
+    } else if (g->invoke) {
+      size_t i;
+
+      for (i = 0; i < n; i++) {
+        if (!(*g->invoke)(g, &infos[i])) {
+          return false;
+        }
+      }
+    }
+
+    g = g->next;
+  }
+
+  return true;
+}
+
 void nmeaGeneratorAppend(NmeaGenerator *to, NmeaGenerator *gen) {
   NmeaGenerator *next;
 
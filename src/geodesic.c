@@ -0,0 +1,1006 @@
+/*
+ * This file is part of nmealib.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <nmealib/geodesic.h>
+
+#include <nmealib/nmath.h>
+#include <nmealib/util.h>
+#include <float.h>
+#include <math.h>
+#include <string.h>
+
+/*
+ * WGS84 ellipsoid
+ */
+
+/** The equatorial radius */
+#define NMEALIB_GEODESIC_A   ((double) NMEALIB_EARTHRADIUS_M)
+
+/** The flattening */
+#define NMEALIB_GEODESIC_F   (NMEALIB_EARTH_FLATTENING)
+
+/** 1 - f */
+#define NMEALIB_GEODESIC_F1  (1.0 - NMEALIB_GEODESIC_F)
+
+/** The polar semi-axis */
+#define NMEALIB_GEODESIC_B   (NMEALIB_GEODESIC_A * NMEALIB_GEODESIC_F1)
+
+/** The squared eccentricity */
+#define NMEALIB_GEODESIC_E2  (NMEALIB_GEODESIC_F * (2.0 - NMEALIB_GEODESIC_F))
+
+/** The squared second eccentricity */
+#define NMEALIB_GEODESIC_EP2 (NMEALIB_GEODESIC_E2 / (NMEALIB_GEODESIC_F1 * NMEALIB_GEODESIC_F1))
+
+/** The third flattening */
+#define NMEALIB_GEODESIC_N   (NMEALIB_GEODESIC_F / (2.0 - NMEALIB_GEODESIC_F))
+
+/*
+ * Tolerances
+ */
+
+/** sqrt(DBL_EPSILON) */
+#define NMEALIB_GEODESIC_TOL2    (1.4901161193847656e-08)
+
+/** The tolerance of the bisection */
+#define NMEALIB_GEODESIC_TOLB    (DBL_EPSILON * NMEALIB_GEODESIC_TOL2)
+
+/** The threshold of the astroid cut */
+#define NMEALIB_GEODESIC_XTHRESH (1000.0 * NMEALIB_GEODESIC_TOL2)
+
+/** 0.1 * sqrt(DBL_EPSILON) / sqrt(f * (1 - f / 2) / 2): the limit of really short lines */
+#define NMEALIB_GEODESIC_ETOL2   (3.6424611488788524e-08)
+
+/** sqrt(DBL_MIN) */
+#define NMEALIB_GEODESIC_TINY    (1.4916681462400413e-154)
+
+/** The maximum number of Newton steps */
+#define NMEALIB_GEODESIC_MAXIT1  (20u)
+
+/** The maximum number of Newton and bisection steps */
+#define NMEALIB_GEODESIC_MAXIT2  (NMEALIB_GEODESIC_MAXIT1 + DBL_MANT_DIG + 10u)
+
+/** The order of the series */
+#define NMEALIB_GEODESIC_ORDER   (6)
+
+/*
+ * Series coefficients
+ */
+
+/** The coefficients of eps^j of A3 */
+static const double nmeaGeodesicA3[NMEALIB_GEODESIC_ORDER] = {
+    1.0, //
+    -(1.0 / 2 - NMEALIB_GEODESIC_N / 2), //
+    -(1.0 / 4 + NMEALIB_GEODESIC_N / 8 - 3.0 / 8 * NMEALIB_GEODESIC_N * NMEALIB_GEODESIC_N), //
+    -(1.0 / 16 + 3.0 / 16 * NMEALIB_GEODESIC_N + 1.0 / 16 * NMEALIB_GEODESIC_N * NMEALIB_GEODESIC_N), //
+    -(3.0 / 64 + 1.0 / 32 * NMEALIB_GEODESIC_N), //
+    -(3.0 / 128) //
+};
+
+/** The coefficients of eps^j (columns) of C3l (rows) */
+static const double nmeaGeodesicC3[NMEALIB_GEODESIC_ORDER][NMEALIB_GEODESIC_ORDER] = {
+    { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 }, //
+    { 0.0, //
+      1.0 / 4 - NMEALIB_GEODESIC_N / 4, //
+      1.0 / 8 - NMEALIB_GEODESIC_N * NMEALIB_GEODESIC_N / 8, //
+      3.0 / 64 + 3.0 / 64 * NMEALIB_GEODESIC_N - 1.0 / 64 * NMEALIB_GEODESIC_N * NMEALIB_GEODESIC_N, //
+      5.0 / 128 + 1.0 / 64 * NMEALIB_GEODESIC_N, //
+      3.0 / 128 }, //
+    { 0.0, //
+      0.0, //
+      1.0 / 16 - 3.0 / 32 * NMEALIB_GEODESIC_N + 1.0 / 32 * NMEALIB_GEODESIC_N * NMEALIB_GEODESIC_N, //
+      3.0 / 64 - 1.0 / 32 * NMEALIB_GEODESIC_N - 3.0 / 64 * NMEALIB_GEODESIC_N * NMEALIB_GEODESIC_N, //
+      3.0 / 128 + 1.0 / 128 * NMEALIB_GEODESIC_N, //
+      5.0 / 256 }, //
+    { 0.0, //
+      0.0, //
+      0.0, //
+      5.0 / 192 - 3.0 / 64 * NMEALIB_GEODESIC_N + 5.0 / 192 * NMEALIB_GEODESIC_N * NMEALIB_GEODESIC_N, //
+      3.0 / 128 - 5.0 / 192 * NMEALIB_GEODESIC_N, //
+      7.0 / 512 }, //
+    { 0.0, 0.0, 0.0, 0.0, 7.0 / 512 - 7.0 / 256 * NMEALIB_GEODESIC_N, 7.0 / 512 }, //
+    { 0.0, 0.0, 0.0, 0.0, 0.0, 21.0 / 2560 } //
+};
+
+/**
+ * Calculate A1 - 1
+ *
+ * @param eps The expansion parameter
+ * @return A1 - 1
+ */
+static double nmeaGeodesicA1m1(double eps) {
+  double eps2 = eps * eps;
+  double t = eps2 * (1.0 / 4 + eps2 * (1.0 / 64 + eps2 * (1.0 / 256)));
+
+  return (t + eps) / (1 - eps);
+}
+
+/**
+ * Calculate the coefficients C1l
+ *
+ * @param eps The expansion parameter
+ * @param c The coefficients, c[1] to c[6]
+ */
+static void nmeaGeodesicC1(double eps, double c[]) {
+  double eps2 = eps * eps;
+  double d = eps;
+
+  c[1] = d * (-1.0 / 2 + eps2 * (3.0 / 16 + eps2 * (-1.0 / 32)));
+  d *= eps;
+  c[2] = d * (-1.0 / 16 + eps2 * (1.0 / 32 + eps2 * (-9.0 / 2048)));
+  d *= eps;
+  c[3] = d * (-1.0 / 48 + eps2 * (3.0 / 256));
+  d *= eps;
+  c[4] = d * (-5.0 / 512 + eps2 * (3.0 / 512));
+  d *= eps;
+  c[5] = d * (-7.0 / 1280);
+  d *= eps;
+  c[6] = d * (-7.0 / 2048);
+}
+
+/**
+ * Calculate the coefficients C1'l of the reverted series
+ *
+ * @param eps The expansion parameter
+ * @param c The coefficients, c[1] to c[6]
+ */
+static void nmeaGeodesicC1p(double eps, double c[]) {
+  double eps2 = eps * eps;
+  double d = eps;
+
+  c[1] = d * (1.0 / 2 + eps2 * (-9.0 / 32 + eps2 * (205.0 / 1536)));
+  d *= eps;
+  c[2] = d * (5.0 / 16 + eps2 * (-37.0 / 96 + eps2 * (1335.0 / 4096)));
+  d *= eps;
+  c[3] = d * (29.0 / 96 + eps2 * (-75.0 / 128));
+  d *= eps;
+  c[4] = d * (539.0 / 1536 + eps2 * (-2391.0 / 2560));
+  d *= eps;
+  c[5] = d * (3467.0 / 7680);
+  d *= eps;
+  c[6] = d * (38081.0 / 61440);
+}
+
+/**
+ * Calculate A2 - 1
+ *
+ * @param eps The expansion parameter
+ * @return A2 - 1
+ */
+static double nmeaGeodesicA2m1(double eps) {
+  double eps2 = eps * eps;
+  double t = eps2 * (-3.0 / 4 + eps2 * (-7.0 / 64 + eps2 * (-11.0 / 256)));
+
+  return (t - eps) / (1 + eps);
+}
+
+/**
+ * Calculate the coefficients C2l
+ *
+ * @param eps The expansion parameter
+ * @param c The coefficients, c[1] to c[6]
+ */
+static void nmeaGeodesicC2(double eps, double c[]) {
+  double eps2 = eps * eps;
+  double d = eps;
+
+  c[1] = d * (1.0 / 2 + eps2 * (1.0 / 16 + eps2 * (1.0 / 32)));
+  d *= eps;
+  c[2] = d * (3.0 / 16 + eps2 * (1.0 / 32 + eps2 * (35.0 / 2048)));
+  d *= eps;
+  c[3] = d * (5.0 / 48 + eps2 * (5.0 / 256));
+  d *= eps;
+  c[4] = d * (35.0 / 512 + eps2 * (7.0 / 512));
+  d *= eps;
+  c[5] = d * (63.0 / 1280);
+  d *= eps;
+  c[6] = d * (77.0 / 2048);
+}
+
+/**
+ * Calculate A3
+ *
+ * @param eps The expansion parameter
+ * @return A3
+ */
+static double nmeaGeodesicA3f(double eps) {
+  double r = 0.0;
+  int j;
+
+  for (j = NMEALIB_GEODESIC_ORDER - 1; j >= 0; j--) {
+    r = r * eps + nmeaGeodesicA3[j];
+  }
+
+  return r;
+}
+
+/**
+ * Calculate the coefficients C3l
+ *
+ * @param eps The expansion parameter
+ * @param c The coefficients, c[1] to c[5]
+ */
+static void nmeaGeodesicC3f(double eps, double c[]) {
+  int l;
+  int j;
+
+  for (l = 1; l < NMEALIB_GEODESIC_ORDER; l++) {
+    double r = 0.0;
+
+    for (j = NMEALIB_GEODESIC_ORDER - 1; j >= l; j--) {
+      r = r * eps + nmeaGeodesicC3[l][j];
+    }
+
+    c[l] = r;
+    for (j = 0; j < l; j++) {
+      c[l] *= eps;
+    }
+  }
+}
+
+/**
+ * Calculate the sum of c[l] * sin(2 * l * x) for l = 1 to n with Clenshaw
+ * summation
+ *
+ * @param sinx The sine of x
+ * @param cosx The cosine of x
+ * @param c The coefficients, c[1] to c[n]
+ * @param n The number of coefficients
+ * @return The sum
+ */
+static double nmeaGeodesicSinSeries(double sinx, double cosx, const double c[], int n) {
+  double ar = 2 * (cosx - sinx) * (cosx + sinx); /* 2 * cos(2 * x) */
+  double y0 = (n & 1) ?
+      c[n] :
+      0.0;
+  double y1 = 0.0;
+  int l = n - (n & 1);
+
+  while (l > 0) {
+    y1 = ar * y0 - y1 + c[l--];
+    y0 = ar * y1 - y0 + c[l--];
+  }
+
+  return 2 * sinx * cosx * y0; /* sin(2 * x) * y0 */
+}
+
+/**
+ * Normalise a sine and cosine pair
+ *
+ * @param s The sine
+ * @param c The cosine
+ */
+static void nmeaGeodesicNorm(double *s, double *c) {
+  double r = hypot(*s, *c);
+
+  *s /= r;
+  *c /= r;
+}
+
+/**
+ * Round tiny values so that they don't cause underflow, and so that values
+ * close to zero become zero
+ *
+ * @param x The value
+ * @return The rounded value
+ */
+static double nmeaGeodesicRound(double x) {
+  const double z = 1.0 / 16;
+  double y = fabs(x);
+
+  y = (y < z) ?
+      z - (z - y) :
+      y;
+
+  return copysign(y, x);
+}
+
+/**
+ * Calculate the distance and the reduced length of a geodesic, divided by
+ * the polar semi-axis
+ *
+ * @param eps The expansion parameter
+ * @param sig12 The arc length on the auxiliary sphere
+ * @param ssig1 The sine of the arc length of point 1 from the equator
+ * @param csig1 The cosine of the arc length of point 1 from the equator
+ * @param dn1 sqrt(1 + ep2 sin(beta1)^2)
+ * @param ssig2 The sine of the arc length of point 2 from the equator
+ * @param csig2 The cosine of the arc length of point 2 from the equator
+ * @param dn2 sqrt(1 + ep2 sin(beta2)^2)
+ * @param s12b Where to store the distance, can be NULL
+ * @param m12b Where to store the reduced length, can be NULL
+ */
+static void nmeaGeodesicLengths(double eps, double sig12, double ssig1, double csig1, double dn1, double ssig2,
+    double csig2, double dn2, double *s12b, double *m12b) {
+  double Ca[NMEALIB_GEODESIC_ORDER + 1];
+  double Cb[NMEALIB_GEODESIC_ORDER + 1];
+  double A1 = nmeaGeodesicA1m1(eps);
+  double A2 = 0.0;
+  double m0 = 0.0;
+  double J12 = 0.0;
+  int l;
+
+  nmeaGeodesicC1(eps, Ca);
+  if (m12b) {
+    A2 = nmeaGeodesicA2m1(eps);
+    nmeaGeodesicC2(eps, Cb);
+    m0 = A1 - A2;
+    A2 = 1 + A2;
+  }
+  A1 = 1 + A1;
+
+  if (s12b) {
+    double B1 = nmeaGeodesicSinSeries(ssig2, csig2, Ca, NMEALIB_GEODESIC_ORDER)
+        - nmeaGeodesicSinSeries(ssig1, csig1, Ca, NMEALIB_GEODESIC_ORDER);
+
+    *s12b = A1 * (sig12 + B1);
+    if (m12b) {
+      double B2 = nmeaGeodesicSinSeries(ssig2, csig2, Cb, NMEALIB_GEODESIC_ORDER)
+          - nmeaGeodesicSinSeries(ssig1, csig1, Cb, NMEALIB_GEODESIC_ORDER);
+
+      J12 = m0 * sig12 + (A1 * B1 - A2 * B2);
+    }
+  } else if (m12b) {
+    for (l = 1; l <= NMEALIB_GEODESIC_ORDER; l++) {
+      Cb[l] = A1 * Ca[l] - A2 * Cb[l];
+    }
+    J12 = m0 * sig12
+        + (nmeaGeodesicSinSeries(ssig2, csig2, Cb, NMEALIB_GEODESIC_ORDER)
+            - nmeaGeodesicSinSeries(ssig1, csig1, Cb, NMEALIB_GEODESIC_ORDER));
+  }
+
+  if (m12b) {
+    /* the parentheses ensure accurate cancellation for coincident points */
+    *m12b = dn2 * (csig1 * ssig2) - dn1 * (ssig1 * csig2) - csig1 * csig2 * J12;
+  }
+}
+
+/**
+ * Solve the astroid equation k^4 + 2k^3 - (x^2 + y^2 - 1)k^2 - 2y^2k - y^2 = 0
+ * for its positive root
+ *
+ * @param x The x coordinate
+ * @param y The y coordinate
+ * @return The positive root k
+ */
+static double nmeaGeodesicAstroid(double x, double y) {
+  double p = x * x;
+  double q = y * y;
+  double r = (p + q - 1) / 6;
+  double S, r2, r3, disc, u, v, uv, w;
+
+  if ((q == 0) //
+      && (r <= 0)) {
+    /* y = 0 with |x| <= 1 */
+    return 0.0;
+  }
+
+  S = p * q / 4;
+  r2 = r * r;
+  r3 = r * r2;
+
+  /* the discriminant of the quadratic equation for T3 */
+  disc = S * (S + 2 * r3);
+  u = r;
+  if (disc >= 0) {
+    double T3 = S + r3;
+    double T;
+
+    /* pick the sign of the square root that avoids cancellation */
+    T3 += (T3 < 0) ?
+        -sqrt(disc) :
+        sqrt(disc);
+    T = cbrt(T3);
+    u += T + ((T != 0) ?
+        r2 / T :
+        0);
+  } else {
+    /* T is complex, but u is real */
+    double ang = atan2(sqrt(-disc), -(S + r3));
+    u += 2 * r * cos(ang / 3);
+  }
+
+  v = sqrt(u * u + q);
+  uv = (u < 0) ?
+      q / (v - u) :
+      u + v;
+  w = (uv - q) / (2 * v);
+
+  return uv / (sqrt(uv + w * w) + w);
+}
+
+/**
+ * The state of the inverse problem, in the canonical form
+ * (lat1 <= 0, lat1 <= lat2 <= -lat1, 0 <= lon12 <= pi)
+ */
+typedef struct _NmeaGeodesicInverse {
+    double sbet1;  /**< the sine of the reduced latitude of point 1       */
+    double cbet1;  /**< the cosine of the reduced latitude of point 1     */
+    double dn1;    /**< sqrt(1 + ep2 sbet1^2)                             */
+    double sbet2;  /**< the sine of the reduced latitude of point 2       */
+    double cbet2;  /**< the cosine of the reduced latitude of point 2     */
+    double dn2;    /**< sqrt(1 + ep2 sbet2^2)                             */
+    double lam12;  /**< the difference in longitude                       */
+    double slam12; /**< the sine of lam12                                 */
+    double clam12; /**< the cosine of lam12                               */
+    double salp1;  /**< the sine of the azimuth at point 1                */
+    double calp1;  /**< the cosine of the azimuth at point 1              */
+    double salp2;  /**< the sine of the azimuth at point 2                */
+    double calp2;  /**< the cosine of the azimuth at point 2              */
+    double sig12;  /**< the arc length on the auxiliary sphere            */
+    double ssig1;  /**< the sine of the arc length of point 1             */
+    double csig1;  /**< the cosine of the arc length of point 1           */
+    double ssig2;  /**< the sine of the arc length of point 2             */
+    double csig2;  /**< the cosine of the arc length of point 2           */
+    double eps;    /**< the expansion parameter                           */
+    double dnm;    /**< the mean dn for short lines                       */
+} NmeaGeodesicInverseState;
+
+/**
+ * Calculate a starting point for Newton's method
+ *
+ * Sets salp1 and calp1. For short lines Newton's method is not needed, then
+ * salp2, calp2 and dnm are set too.
+ *
+ * @param g The state
+ * @return The arc length on the auxiliary sphere for short lines, -1 when
+ * Newton's method must be used
+ */
+static double nmeaGeodesicInverseStart(NmeaGeodesicInverseState *g) {
+  double sbet1 = g->sbet1;
+  double cbet1 = g->cbet1;
+  double sbet2 = g->sbet2;
+  double cbet2 = g->cbet2;
+  double sig12 = -1;
+  /* bet12 = bet2 - bet1 in [0, pi); bet12a = bet2 + bet1 in (-pi, 0] */
+  double sbet12 = sbet2 * cbet1 - cbet2 * sbet1;
+  double cbet12 = cbet2 * cbet1 + sbet2 * sbet1;
+  double sbet12a = sbet2 * cbet1 + cbet2 * sbet1;
+  bool shortline = (cbet12 >= 0) //
+      && (sbet12 < 0.5) //
+      && ((cbet2 * g->lam12) < 0.5);
+  double somg12;
+  double comg12;
+  double ssig12;
+  double csig12;
+  double salp1;
+  double calp1;
+
+  if (shortline) {
+    /* sin((bet1 + bet2) / 2)^2 */
+    double sbetm2 = (sbet1 + sbet2) * (sbet1 + sbet2);
+    double omg12;
+
+    sbetm2 /= sbetm2 + (cbet1 + cbet2) * (cbet1 + cbet2);
+    g->dnm = sqrt(1 + NMEALIB_GEODESIC_EP2 * sbetm2);
+    omg12 = g->lam12 / (NMEALIB_GEODESIC_F1 * g->dnm);
+    somg12 = sin(omg12);
+    comg12 = cos(omg12);
+  } else {
+    somg12 = g->slam12;
+    comg12 = g->clam12;
+  }
+
+  salp1 = cbet2 * somg12;
+  calp1 = (comg12 >= 0) ?
+      sbet12 + cbet2 * sbet1 * somg12 * somg12 / (1 + comg12) :
+      sbet12a - cbet2 * sbet1 * somg12 * somg12 / (1 - comg12);
+
+  ssig12 = hypot(salp1, calp1);
+  csig12 = sbet1 * sbet2 + cbet1 * cbet2 * comg12;
+
+  if (shortline //
+      && (ssig12 < NMEALIB_GEODESIC_ETOL2)) {
+    /* really short lines */
+    g->salp2 = cbet1 * somg12;
+    g->calp2 = sbet12 - cbet1 * sbet2 * ((comg12 >= 0) ?
+        somg12 * somg12 / (1 + comg12) :
+        1 - comg12);
+    nmeaGeodesicNorm(&g->salp2, &g->calp2);
+    sig12 = atan2(ssig12, csig12);
+  } else if ((csig12 >= 0) //
+      || (ssig12 >= (6 * NMEALIB_GEODESIC_N * NMEALIB_PI * cbet1 * cbet1))) {
+    /* the zeroth order spherical approximation is good enough */
+  } else {
+    /* nearly antipodal: scale lam12 and bet2 to a coordinate system where
+     * the antipodal point is at the origin */
+    double lam12x = atan2(-g->slam12, -g->clam12); /* lam12 - pi */
+    double k2 = sbet1 * sbet1 * NMEALIB_GEODESIC_EP2;
+    double eps = k2 / (2 * (1 + sqrt(1 + k2)) + k2);
+    double lamscale = NMEALIB_GEODESIC_F * cbet1 * nmeaGeodesicA3f(eps) * NMEALIB_PI;
+    double betscale = lamscale * cbet1;
+    double x = lam12x / lamscale;
+    double y = sbet12a / betscale;
+
+    if ((y > -(200 * DBL_EPSILON)) //
+        && (x > (-1 - NMEALIB_GEODESIC_XTHRESH))) {
+      /* strip near the cut */
+      salp1 = MIN(1.0, -x);
+      calp1 = -sqrt(1 - salp1 * salp1);
+    } else {
+      /* estimate omg12 from the solution of the astroid problem, and use the
+       * spherical formula to estimate alp1 from it */
+      double k = nmeaGeodesicAstroid(x, y);
+      double omg12a = lamscale * (-x * k / (1 + k));
+
+      somg12 = sin(omg12a);
+      comg12 = -cos(omg12a);
+      salp1 = cbet2 * somg12;
+      calp1 = sbet12a - cbet2 * sbet1 * somg12 * somg12 / (1 - comg12);
+    }
+  }
+
+  /* sanity check on the starting guess, backwards to let NaN through */
+  if (!(salp1 <= 0)) {
+    nmeaGeodesicNorm(&salp1, &calp1);
+  } else {
+    salp1 = 1;
+    calp1 = 0;
+  }
+
+  g->salp1 = salp1;
+  g->calp1 = calp1;
+
+  return sig12;
+}
+
+/**
+ * Calculate the difference in longitude for an azimuth at point 1, minus the
+ * difference in longitude of the points
+ *
+ * Sets salp2, calp2, sig12, ssig1, csig1, ssig2, csig2 and eps.
+ *
+ * @param g The state, with the azimuth at point 1 in salp1 and calp1
+ * @param dlam12 Where to store the derivative with respect to the azimuth at
+ * point 1, can be NULL
+ * @return The difference in longitude minus lam12
+ */
+static double nmeaGeodesicLambda12(NmeaGeodesicInverseState *g, double *dlam12) {
+  double Ca[NMEALIB_GEODESIC_ORDER];
+  double sbet1 = g->sbet1;
+  double cbet1 = g->cbet1;
+  double sbet2 = g->sbet2;
+  double cbet2 = g->cbet2;
+  double salp1 = g->salp1;
+  double calp1 = g->calp1;
+  double salp0, calp0, somg1, comg1, somg2, comg2, somg12, comg12, eta, k2, B312, domg12;
+
+  if ((sbet1 == 0) //
+      && (calp1 == 0)) {
+    /* break the degeneracy of the equatorial line */
+    calp1 = -NMEALIB_GEODESIC_TINY;
+  }
+
+  /* sin(alp1) * cos(bet1) = sin(alp0) */
+  salp0 = salp1 * cbet1;
+  calp0 = hypot(calp1, salp1 * sbet1);
+
+  /* tan(bet1) = tan(sig1) * cos(alp1), tan(omg1) = sin(alp0) * tan(sig1) */
+  g->ssig1 = sbet1;
+  somg1 = salp0 * sbet1;
+  g->csig1 = comg1 = calp1 * cbet1;
+  nmeaGeodesicNorm(&g->ssig1, &g->csig1);
+
+  /* enforce the symmetries in the case abs(bet2) = -bet1 */
+  g->salp2 = (cbet2 != cbet1) ?
+      salp0 / cbet2 :
+      salp1;
+  g->calp2 = ((cbet2 != cbet1) || (fabs(sbet2) != -sbet1)) ?
+      sqrt(calp1 * cbet1 * calp1 * cbet1 + ((cbet1 < -sbet1) ?
+          (cbet2 - cbet1) * (cbet1 + cbet2) :
+          (sbet1 - sbet2) * (sbet1 + sbet2))) / cbet2 :
+      fabs(calp1);
+
+  /* tan(bet2) = tan(sig2) * cos(alp2), tan(omg2) = sin(alp0) * tan(sig2) */
+  g->ssig2 = sbet2;
+  somg2 = salp0 * sbet2;
+  g->csig2 = comg2 = g->calp2 * cbet2;
+  nmeaGeodesicNorm(&g->ssig2, &g->csig2);
+
+  /* sig12 = sig2 - sig1, limited to [0, pi] */
+  g->sig12 = atan2(MAX(0.0, g->csig1 * g->ssig2 - g->ssig1 * g->csig2) + 0.0,
+      g->csig1 * g->csig2 + g->ssig1 * g->ssig2);
+
+  /* omg12 = omg2 - omg1, limited to [0, pi] */
+  somg12 = MAX(0.0, comg1 * somg2 - somg1 * comg2) + 0.0;
+  comg12 = comg1 * comg2 + somg1 * somg2;
+
+  /* eta = omg12 - lam12 */
+  eta = atan2(somg12 * g->clam12 - comg12 * g->slam12, comg12 * g->clam12 + somg12 * g->slam12);
+  k2 = calp0 * calp0 * NMEALIB_GEODESIC_EP2;
+  g->eps = k2 / (2 * (1 + sqrt(1 + k2)) + k2);
+  nmeaGeodesicC3f(g->eps, Ca);
+  B312 = nmeaGeodesicSinSeries(g->ssig2, g->csig2, Ca, NMEALIB_GEODESIC_ORDER - 1)
+      - nmeaGeodesicSinSeries(g->ssig1, g->csig1, Ca, NMEALIB_GEODESIC_ORDER - 1);
+  domg12 = -NMEALIB_GEODESIC_F * nmeaGeodesicA3f(g->eps) * salp0 * (g->sig12 + B312);
+
+  if (dlam12) {
+    if (g->calp2 == 0) {
+      *dlam12 = -2 * NMEALIB_GEODESIC_F1 * g->dn1 / sbet1;
+    } else {
+      nmeaGeodesicLengths(g->eps, g->sig12, g->ssig1, g->csig1, g->dn1, g->ssig2, g->csig2, g->dn2, NULL, dlam12);
+      *dlam12 *= NMEALIB_GEODESIC_F1 / (g->calp2 * cbet2);
+    }
+  }
+
+  return eta + domg12;
+}
+
+/**
+ * Solve the inverse problem with Newton's method
+ *
+ * Newton's method solves lambda12(alp1) - lam12 = 0, which has exactly one
+ * root in (0, pi). A bracket around the root is maintained, and its midpoint
+ * is used instead of the Newton step when the derivative is not positive or
+ * when the step leaves the bracket.
+ *
+ * @param g The state, with the starting point in salp1 and calp1
+ */
+static void nmeaGeodesicNewton(NmeaGeodesicInverseState *g) {
+  double salp1a = NMEALIB_GEODESIC_TINY;
+  double calp1a = 1;
+  double salp1b = NMEALIB_GEODESIC_TINY;
+  double calp1b = -1;
+  bool tripn = false;
+  bool tripb = false;
+  unsigned int numit;
+
+  for (numit = 0;; numit++) {
+    double dv = 0.0;
+    double v = nmeaGeodesicLambda12(g, (numit < NMEALIB_GEODESIC_MAXIT1) ?
+        &dv :
+        NULL);
+
+    if (tripb //
+        || !(fabs(v) >= ((tripn ?
+            8 :
+            1) * DBL_EPSILON)) //
+        || (numit == NMEALIB_GEODESIC_MAXIT2)) {
+      break;
+    }
+
+    /* update the bracket */
+    if ((v > 0) //
+        && ((numit > NMEALIB_GEODESIC_MAXIT1) || ((g->calp1 / g->salp1) > (calp1b / salp1b)))) {
+      salp1b = g->salp1;
+      calp1b = g->calp1;
+    } else if ((v < 0) //
+        && ((numit > NMEALIB_GEODESIC_MAXIT1) || ((g->calp1 / g->salp1) < (calp1a / salp1a)))) {
+      salp1a = g->salp1;
+      calp1a = g->calp1;
+    }
+
+    if ((numit < NMEALIB_GEODESIC_MAXIT1) //
+        && (dv > 0)) {
+      double dalp1 = -v / dv;
+
+      if (fabs(dalp1) < NMEALIB_PI) {
+        double sdalp1 = sin(dalp1);
+        double cdalp1 = cos(dalp1);
+        double nsalp1 = g->salp1 * cdalp1 + g->calp1 * sdalp1;
+
+        if (nsalp1 > 0) {
+          g->calp1 = g->calp1 * cdalp1 - g->salp1 * sdalp1;
+          g->salp1 = nsalp1;
+          nmeaGeodesicNorm(&g->salp1, &g->calp1);
+
+          /* convergence can be linear when the slope goes to zero */
+          tripn = fabs(v) <= (16 * DBL_EPSILON);
+          continue;
+        }
+      }
+    }
+
+    /* bisection */
+    g->salp1 = (salp1a + salp1b) / 2;
+    g->calp1 = (calp1a + calp1b) / 2;
+    nmeaGeodesicNorm(&g->salp1, &g->calp1);
+    tripn = false;
+    tripb = ((fabs(salp1a - g->salp1) + (calp1a - g->calp1)) < NMEALIB_GEODESIC_TOLB) //
+        || ((fabs(g->salp1 - salp1b) + (g->calp1 - calp1b)) < NMEALIB_GEODESIC_TOLB);
+  }
+}
+
+double nmeaGeodesicInverse(const NmeaPosition *from, const NmeaPosition *to, double *fromAzimuth,
+    double *toAzimuth) {
+  NmeaGeodesicInverseState g;
+  double lat1;
+  double lat2;
+  double lon12s;
+  double s12x = 0.0;
+  double m12x = 0.0;
+  double lonsign;
+  double latsign;
+  bool swapped;
+  bool meridian;
+
+  if (!from //
+      || !to) {
+    return NaN;
+  }
+
+  if (isNaN(from->lat) //
+      || isNaN(from->lon) //
+      || isNaN(to->lat) //
+      || isNaN(to->lon) //
+      || (fabs(from->lat) > (NMEALIB_PI / 2)) //
+      || (fabs(to->lat) > (NMEALIB_PI / 2))) {
+    if (fromAzimuth) {
+      *fromAzimuth = NaN;
+    }
+    if (toAzimuth) {
+      *toAzimuth = NaN;
+    }
+
+    return NaN;
+  }
+
+  memset(&g, 0, sizeof(g));
+
+  /* make the difference in longitude positive, in [0, pi] */
+  g.lam12 = remainder(to->lon - from->lon, 2 * NMEALIB_PI);
+  lonsign = signbit(g.lam12) ?
+      -1 :
+      1;
+  g.lam12 *= lonsign;
+  if (g.lam12 == NMEALIB_PI) {
+    g.slam12 = 0.0;
+    g.clam12 = -1.0;
+  } else {
+    g.slam12 = sin(g.lam12);
+    g.clam12 = cos(g.lam12);
+  }
+  lon12s = NMEALIB_PI - g.lam12;
+
+  /* treat points that are really close to the equator as on the equator, and
+   * make point 1 the point with the higher absolute latitude */
+  lat1 = nmeaGeodesicRound(from->lat);
+  lat2 = nmeaGeodesicRound(to->lat);
+  swapped = fabs(lat1) < fabs(lat2);
+  if (swapped) {
+    double tmp = lat1;
+
+    lonsign = -lonsign;
+    lat1 = lat2;
+    lat2 = tmp;
+  }
+
+  /* make lat1 <= -0 */
+  latsign = signbit(lat1) ?
+      1 :
+      -1;
+  lat1 *= latsign;
+  lat2 *= latsign;
+
+  /* now 0 <= lam12 <= pi, -pi/2 <= lat1 <= -0 and lat1 <= lat2 <= -lat1 */
+
+  g.sbet1 = NMEALIB_GEODESIC_F1 * sin(lat1);
+  g.cbet1 = cos(lat1);
+  nmeaGeodesicNorm(&g.sbet1, &g.cbet1);
+  g.cbet1 = MAX(NMEALIB_GEODESIC_TINY, g.cbet1);
+
+  g.sbet2 = NMEALIB_GEODESIC_F1 * sin(lat2);
+  g.cbet2 = cos(lat2);
+  nmeaGeodesicNorm(&g.sbet2, &g.cbet2);
+  g.cbet2 = MAX(NMEALIB_GEODESIC_TINY, g.cbet2);
+
+  /* force bet2 = +/- bet1 when the difference vanishes */
+  if (g.cbet1 < -g.sbet1) {
+    if (g.cbet2 == g.cbet1) {
+      g.sbet2 = copysign(g.sbet1, g.sbet2);
+    }
+  } else {
+    if (fabs(g.sbet2) == -g.sbet1) {
+      g.cbet2 = g.cbet1;
+    }
+  }
+
+  g.dn1 = sqrt(1 + NMEALIB_GEODESIC_EP2 * g.sbet1 * g.sbet1);
+  g.dn2 = sqrt(1 + NMEALIB_GEODESIC_EP2 * g.sbet2 * g.sbet2);
+
+  meridian = (lat1 == -(NMEALIB_PI / 2)) //
+      || (g.slam12 == 0);
+
+  if (meridian) {
+    /* the points are on a single full meridian, the geodesic might run
+     * along it: head to the target longitude, arrive heading north */
+    g.calp1 = g.clam12;
+    g.salp1 = g.slam12;
+    g.calp2 = 1;
+    g.salp2 = 0;
+
+    /* tan(bet) = tan(sig) * cos(alp) */
+    g.ssig1 = g.sbet1;
+    g.csig1 = g.calp1 * g.cbet1;
+    g.ssig2 = g.sbet2;
+    g.csig2 = g.calp2 * g.cbet2;
+
+    g.sig12 = atan2(MAX(0.0, g.csig1 * g.ssig2 - g.ssig1 * g.csig2) + 0.0,
+        g.csig1 * g.csig2 + g.ssig1 * g.ssig2);
+    nmeaGeodesicLengths(NMEALIB_GEODESIC_N, g.sig12, g.ssig1, g.csig1, g.dn1, g.ssig2, g.csig2, g.dn2, &s12x,
+        &m12x);
+
+    /* a meridional geodesic with sig12 > pi/2 and m12 < 0 is not the
+     * shortest path */
+    if ((g.sig12 < 1) //
+        || (m12x >= 0)) {
+      if ((g.sig12 < (3 * NMEALIB_GEODESIC_TINY)) //
+          || ((g.sig12 < DBL_EPSILON) && ((s12x < 0) || (m12x < 0)))) {
+        g.sig12 = m12x = s12x = 0;
+      }
+      s12x *= NMEALIB_GEODESIC_B;
+    } else {
+      meridian = false;
+    }
+  }
+
+  if (!meridian //
+      && (g.sbet1 == 0) //
+      && (lon12s >= (NMEALIB_GEODESIC_F * NMEALIB_PI))) {
+    /* the geodesic runs along the equator */
+    g.calp1 = g.calp2 = 0;
+    g.salp1 = g.salp2 = 1;
+    s12x = NMEALIB_GEODESIC_A * g.lam12;
+  } else if (!meridian) {
+    double sig12 = nmeaGeodesicInverseStart(&g);
+
+    if (sig12 >= 0) {
+      /* short lines */
+      s12x = sig12 * NMEALIB_GEODESIC_B * g.dnm;
+    } else {
+      nmeaGeodesicNewton(&g);
+      nmeaGeodesicLengths(g.eps, g.sig12, g.ssig1, g.csig1, g.dn1, g.ssig2, g.csig2, g.dn2, &s12x, NULL);
+      s12x *= NMEALIB_GEODESIC_B;
+    }
+  }
+
+  /* undo the transformation to the canonical form */
+  if (swapped) {
+    double tmp = g.salp1;
+
+    g.salp1 = g.salp2;
+    g.salp2 = tmp;
+    tmp = g.calp1;
+    g.calp1 = g.calp2;
+    g.calp2 = tmp;
+  }
+
+  g.salp1 *= (swapped ?
+      -1 :
+      1) * lonsign;
+  g.calp1 *= (swapped ?
+      -1 :
+      1) * latsign;
+  g.salp2 *= (swapped ?
+      -1 :
+      1) * lonsign;
+  g.calp2 *= (swapped ?
+      -1 :
+      1) * latsign;
+
+  if (fromAzimuth) {
+    *fromAzimuth = atan2(g.salp1, g.calp1);
+  }
+  if (toAzimuth) {
+    *toAzimuth = atan2(g.salp2, g.calp2);
+  }
+
+  return 0.0 + s12x; /* convert -0 to 0 */
+}
+
+bool nmeaGeodesicDirect(const NmeaPosition *from, NmeaPosition *to, double azimuth, double distance,
+    double *toAzimuth) {
+  double C1a[NMEALIB_GEODESIC_ORDER + 1];
+  double C1pa[NMEALIB_GEODESIC_ORDER + 1];
+  double C3a[NMEALIB_GEODESIC_ORDER];
+  double lat1, alp1, salp1, calp1, sbet1, cbet1, salp0, calp0, ssig1, csig1, somg1, comg1;
+  double k2, eps, A1m1, A3c, B11, B12, B31, s, c, stau1, ctau1, tau12;
+  double sig12, ssig12, csig12, ssig2, csig2, sbet2, cbet2, somg2, comg2, salp2, calp2, omg12, lam12;
+
+  if (!from //
+      || !to) {
+    return false;
+  }
+
+  if (isNaN(from->lat) //
+      || isNaN(from->lon) //
+      || (fabs(from->lat) > (NMEALIB_PI / 2))) {
+    to->lat = NaN;
+    to->lon = NaN;
+    if (toAzimuth) {
+      *toAzimuth = NaN;
+    }
+
+    return false;
+  }
+
+  alp1 = nmeaGeodesicRound(remainder(azimuth, 2 * NMEALIB_PI));
+  salp1 = sin(alp1);
+  calp1 = cos(alp1);
+
+  lat1 = nmeaGeodesicRound(from->lat);
+  sbet1 = NMEALIB_GEODESIC_F1 * sin(lat1);
+  cbet1 = cos(lat1);
+  nmeaGeodesicNorm(&sbet1, &cbet1);
+  cbet1 = MAX(NMEALIB_GEODESIC_TINY, cbet1);
+
+  /* sin(alp1) * cos(bet1) = sin(alp0) */
+  salp0 = salp1 * cbet1;
+  calp0 = hypot(calp1, salp1 * sbet1);
+
+  /* tan(bet1) = tan(sig1) * cos(alp1), tan(omg1) = sin(alp0) * tan(sig1) */
+  ssig1 = sbet1;
+  somg1 = salp0 * sbet1;
+  csig1 = comg1 = ((sbet1 != 0) || (calp1 != 0)) ?
+      cbet1 * calp1 :
+      1;
+  nmeaGeodesicNorm(&ssig1, &csig1);
+
+  k2 = calp0 * calp0 * NMEALIB_GEODESIC_EP2;
+  eps = k2 / (2 * (1 + sqrt(1 + k2)) + k2);
+
+  A1m1 = nmeaGeodesicA1m1(eps);
+  nmeaGeodesicC1(eps, C1a);
+  nmeaGeodesicC1p(eps, C1pa);
+  A3c = -NMEALIB_GEODESIC_F * salp0 * nmeaGeodesicA3f(eps);
+  nmeaGeodesicC3f(eps, C3a);
+
+  B11 = nmeaGeodesicSinSeries(ssig1, csig1, C1a, NMEALIB_GEODESIC_ORDER);
+  s = sin(B11);
+  c = cos(B11);
+  stau1 = ssig1 * c + csig1 * s;
+  ctau1 = csig1 * c - ssig1 * s;
+  B31 = nmeaGeodesicSinSeries(ssig1, csig1, C3a, NMEALIB_GEODESIC_ORDER - 1);
+
+  /* the arc length on the auxiliary sphere from the reverted series */
+  tau12 = distance / (NMEALIB_GEODESIC_B * (1 + A1m1));
+  s = sin(tau12);
+  c = cos(tau12);
+  B12 = -nmeaGeodesicSinSeries(stau1 * c + ctau1 * s, ctau1 * c - stau1 * s, C1pa, NMEALIB_GEODESIC_ORDER);
+  sig12 = tau12 - (B12 - B11);
+  ssig12 = sin(sig12);
+  csig12 = cos(sig12);
+
+  /* sig2 = sig1 + sig12 */
+  ssig2 = ssig1 * csig12 + csig1 * ssig12;
+  csig2 = csig1 * csig12 - ssig1 * ssig12;
+
+  sbet2 = calp0 * ssig2;
+  cbet2 = hypot(salp0, calp0 * csig2);
+  if (cbet2 == 0) {
+    /* the geodesic ends at a pole */
+    cbet2 = csig2 = NMEALIB_GEODESIC_TINY;
+  }
+
+  /* tan(omg2) = sin(alp0) * tan(sig2) */
+  somg2 = salp0 * ssig2;
+  comg2 = csig2;
+
+  /* tan(alp0) = cos(sig2) * tan(alp2) */
+  salp2 = salp0;
+  calp2 = calp0 * csig2;
+
+  omg12 = atan2(somg2 * comg1 - comg2 * somg1, comg2 * comg1 + somg2 * somg1);
+  lam12 = omg12 + A3c * (sig12 + (nmeaGeodesicSinSeries(ssig2, csig2, C3a, NMEALIB_GEODESIC_ORDER - 1) - B31));
+
+  to->lat = atan2(sbet2, NMEALIB_GEODESIC_F1 * cbet2);
+  to->lon = remainder(from->lon + lam12, 2 * NMEALIB_PI);
+  if (toAzimuth) {
+    *toAzimuth = atan2(salp2, calp2);
+  }
+
+  return true;
+}
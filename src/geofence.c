@@ -0,0 +1,718 @@
+/*
+ * This file is part of nmealib.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <nmealib/geofence.h>
+
+#include <nmealib/geodesic.h>
+#include <nmealib/nmath.h>
+#include <nmealib/util.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+/** The capacity of the fences, vertices and device lists when they grow for the first time */
+#define NMEALIB_GEOFENCE_CAPACITY_MIN (16u)
+
+/** A conservative (small) radius of curvature of the earth, in meters, for bounding boxes of circles */
+#define NMEALIB_GEOFENCE_RADIUS_MIN_M (6300000.0)
+
+/** The maximum radius of a circle, in meters, that is tested in the tangent plane (error at most 4 cm) */
+#define NMEALIB_GEOFENCE_TANGENTPLANE_RADIUS_MAX_M (10000.0)
+
+/** The key of an empty slot of the cell hash table */
+#define NMEALIB_GEOFENCE_CELL_EMPTY (UINT64_MAX)
+
+/**
+ * Fence
+ */
+typedef struct _NmeaGeofence {
+    uint32_t             id;        /**< the identifier                                  */
+    bool                 polygon;   /**< true for a polygon, false for a circle          */
+    double               latMin;    /**< the minimum latitude of the bounding box        */
+    double               latMax;    /**< the maximum latitude of the bounding box        */
+    double               lonCentre; /**< the centre longitude of the bounding box        */
+    double               lonHalf;   /**< half the longitude span of the bounding box     */
+    NmeaPosition         centre;    /**< the centre of a circle                          */
+    double               radius;    /**< the radius of a circle, in meters               */
+    NmeaMathDistanceMode mode;      /**< the distance calculation mode of a circle       */
+    size_t               first;     /**< the index of the first vertex of a polygon      */
+    size_t               count;     /**< the number of vertices of a polygon             */
+} NmeaGeofence;
+
+/**
+ * Cell of the index: a slot of the cell hash table
+ */
+typedef struct _NmeaGeofenceCell {
+    uint64_t key;   /**< the key of the cell, NMEALIB_GEOFENCE_CELL_EMPTY for an empty slot */
+    size_t   first; /**< the index of the first fence of the cell in cellFences             */
+    size_t   count; /**< the number of fences of the cell                                    */
+} NmeaGeofenceCell;
+
+/**
+ * Fence of a cell, used while the index is built
+ */
+typedef struct _NmeaGeofencePair {
+    uint64_t key;   /**< the key of the cell      */
+    size_t   fence; /**< the index of the fence   */
+} NmeaGeofencePair;
+
+/**
+ * The fences that a device is in, sorted by index
+ */
+typedef struct _NmeaGeofenceList {
+    size_t *fences;   /**< the indices of the fences */
+    size_t  count;    /**< the number of fences      */
+    size_t  capacity; /**< the capacity of fences    */
+} NmeaGeofenceList;
+
+/**
+ * Geofence set
+ */
+struct _NmeaGeofences {
+    NmeaGeofenceConfig config;         /**< the configuration                                   */
+    size_t             rows;           /**< the number of latitude rows of the grid             */
+    size_t             cols;           /**< the number of longitude columns of the grid         */
+    NmeaGeofence      *fences;         /**< the fences                                          */
+    size_t             fenceCount;     /**< the number of fences                                */
+    size_t             fenceCapacity;  /**< the capacity of fences                              */
+    NmeaPosition      *vertices;       /**< the vertices of the polygons, longitudes unwrapped  */
+    size_t             vertexCount;    /**< the number of vertices                              */
+    size_t             vertexCapacity; /**< the capacity of vertices                            */
+    bool               dirty;          /**< true when the index must be rebuilt                 */
+    NmeaGeofenceCell  *cells;          /**< the cell hash table                                 */
+    size_t             cellMask;       /**< the size of the cell hash table minus one           */
+    size_t            *cellFences;     /**< the indices of the fences of the cells              */
+    NmeaGeofenceList  *devices;        /**< the fences that the devices are in                  */
+    NmeaGeofenceList   scratch;        /**< the fences that a device is in after a fix          */
+};
+
+/**
+ * Grow an array
+ *
+ * The array is left alone when there is not enough memory.
+ *
+ * @param array The array
+ * @param capacity The capacity of the array, in entries
+ * @param count The required capacity, in entries
+ * @param size The size of an entry
+ * @return True on success
+ */
+static bool nmeaGeofenceGrow(void **array, size_t *capacity, size_t count, size_t size) {
+  size_t grown;
+  void *p;
+
+  if (count <= *capacity) {
+    return true;
+  }
+
+  grown = MAX(count, MAX(NMEALIB_GEOFENCE_CAPACITY_MIN, *capacity * 2));
+  if (grown > (SIZE_MAX / size)) {
+    /* can't be covered in a test */
+    return false;
+  }
+
+  p = realloc(*array, grown * size);
+  if (!p) {
+    /* can't be covered in a test */
+    return false;
+  }
+
+  *array = p;
+  *capacity = grown;
+
+  return true;
+}
+
+/**
+ * Get the row of the grid for a latitude
+ *
+ * @param geofences The geofence set
+ * @param lat The latitude (in radians)
+ * @return The row
+ */
+static size_t nmeaGeofenceRow(const NmeaGeofences *geofences, double lat) {
+  double row = floor((nmeaMathRadianToDegree(lat) + 90.0) / geofences->config.cellSize);
+
+  if (row < 0.0) {
+    return 0;
+  }
+
+  return MIN((size_t) row, geofences->rows - 1);
+}
+
+/**
+ * Get the (unwrapped) column of the grid for a longitude
+ *
+ * @param geofences The geofence set
+ * @param lon The longitude (in radians)
+ * @return The column, negative or beyond the last column for longitudes
+ * beyond [-pi, pi]
+ */
+static int64_t nmeaGeofenceColumn(const NmeaGeofences *geofences, double lon) {
+  double col = floor((nmeaMathRadianToDegree(lon) + 180.0) / geofences->config.cellSize);
+
+  return (int64_t) col;
+}
+
+/**
+ * Get the key of the cell of a position
+ *
+ * @param geofences The geofence set
+ * @param pos The position (in radians)
+ * @return The key of the cell
+ */
+static uint64_t nmeaGeofenceKey(const NmeaGeofences *geofences, const NmeaPosition *pos) {
+  int64_t cols = (int64_t) geofences->cols;
+  int64_t col = nmeaGeofenceColumn(geofences, remainder(pos->lon, 2 * NMEALIB_PI));
+
+  col = ((col % cols) + cols) % cols;
+
+  return ((uint64_t) nmeaGeofenceRow(geofences, pos->lat) * (uint64_t) cols) + (uint64_t) col;
+}
+
+/**
+ * Get the slot of a cell in the cell hash table
+ *
+ * @param geofences The geofence set
+ * @param key The key of the cell
+ * @return The slot of the cell, or the empty slot where it belongs
+ */
+static size_t nmeaGeofenceSlot(const NmeaGeofences *geofences, uint64_t key) {
+  size_t slot = (size_t) ((key * 0x9e3779b97f4a7c15ull) >> 32) & geofences->cellMask;
+
+  while ((geofences->cells[slot].key != NMEALIB_GEOFENCE_CELL_EMPTY) //
+      && (geofences->cells[slot].key != key)) {
+    slot = (slot + 1) & geofences->cellMask;
+  }
+
+  return slot;
+}
+
+/**
+ * Get the range of cells that the bounding box of a fence overlaps
+ *
+ * @param geofences The geofence set
+ * @param fence The fence
+ * @param row0 The first row
+ * @param row1 The last row
+ * @param col0 The first (unwrapped) column
+ * @param col1 The last (unwrapped) column
+ */
+static void nmeaGeofenceCells(const NmeaGeofences *geofences, const NmeaGeofence *fence, size_t *row0,
+    size_t *row1, int64_t *col0, int64_t *col1) {
+  *row0 = nmeaGeofenceRow(geofences, fence->latMin);
+  *row1 = nmeaGeofenceRow(geofences, fence->latMax);
+  *col0 = nmeaGeofenceColumn(geofences, fence->lonCentre - fence->lonHalf);
+  *col1 = nmeaGeofenceColumn(geofences, fence->lonCentre + fence->lonHalf);
+
+  if ((*col1 - *col0) >= (int64_t) geofences->cols) {
+    *col0 = 0;
+    *col1 = (int64_t) geofences->cols - 1;
+  }
+}
+
+/**
+ * Compare two fences of cells by the key of their cell, then by the index of
+ * their fence
+ *
+ * @param a The first fence of a cell
+ * @param b The second fence of a cell
+ * @return -1, 0 or 1
+ */
+static int nmeaGeofencePairCompare(const void *a, const void *b) {
+  const NmeaGeofencePair *pa = (const NmeaGeofencePair *) a;
+  const NmeaGeofencePair *pb = (const NmeaGeofencePair *) b;
+
+  if (pa->key != pb->key) {
+    return (pa->key < pb->key) ?
+        -1 :
+        1;
+  }
+
+  if (pa->fence != pb->fence) {
+    return (pa->fence < pb->fence) ?
+        -1 :
+        1;
+  }
+
+  return 0;
+}
+
+/**
+ * Build the index of the fences
+ *
+ * @param geofences The geofence set
+ * @return True on success
+ */
+static bool nmeaGeofenceBuild(NmeaGeofences *geofences) {
+  NmeaGeofencePair *pairs = NULL;
+  size_t pairCount = 0;
+  size_t cellCount = 0;
+  size_t tableSize;
+  size_t i;
+  size_t j;
+
+  free(geofences->cells);
+  free(geofences->cellFences);
+  geofences->cells = NULL;
+  geofences->cellFences = NULL;
+  geofences->cellMask = 0;
+
+  /* count the fences of the cells */
+  for (i = 0; i < geofences->fenceCount; i++) {
+    size_t row0, row1;
+    int64_t col0, col1;
+    size_t cells;
+
+    nmeaGeofenceCells(geofences, &geofences->fences[i], &row0, &row1, &col0, &col1);
+    cells = (row1 - row0 + 1) * (size_t) (col1 - col0 + 1);
+    if (cells > ((SIZE_MAX / sizeof(*pairs)) - pairCount)) {
+      /* can't be covered in a test */
+      return false;
+    }
+
+    pairCount += cells;
+  }
+
+  if (pairCount) {
+    pairs = malloc(pairCount * sizeof(*pairs));
+    geofences->cellFences = malloc(pairCount * sizeof(geofences->cellFences[0]));
+    if (!pairs //
+        || !geofences->cellFences) {
+      /* can't be covered in a test */
+      free(pairs);
+      return false;
+    }
+  }
+
+  /* list the fences of the cells, sorted by cell */
+  pairCount = 0;
+  for (i = 0; i < geofences->fenceCount; i++) {
+    int64_t cols = (int64_t) geofences->cols;
+    size_t row0, row1, row;
+    int64_t col0, col1, col;
+
+    nmeaGeofenceCells(geofences, &geofences->fences[i], &row0, &row1, &col0, &col1);
+    for (row = row0; row <= row1; row++) {
+      for (col = col0; col <= col1; col++) {
+        pairs[pairCount].key = ((uint64_t) row * (uint64_t) cols) + (uint64_t) (((col % cols) + cols) % cols);
+        pairs[pairCount].fence = i;
+        pairCount++;
+      }
+    }
+  }
+
+  if (pairCount) {
+    qsort(pairs, pairCount, sizeof(*pairs), nmeaGeofencePairCompare);
+  }
+
+  for (i = 0; i < pairCount; i++) {
+    if (!i //
+        || (pairs[i].key != pairs[i - 1].key)) {
+      cellCount++;
+    }
+  }
+
+  /* the cell hash table is at most half full */
+  tableSize = NMEALIB_GEOFENCE_CAPACITY_MIN;
+  while (tableSize < (2 * cellCount)) {
+    tableSize *= 2;
+  }
+
+  geofences->cells = malloc(tableSize * sizeof(geofences->cells[0]));
+  if (!geofences->cells) {
+    /* can't be covered in a test */
+    free(pairs);
+    return false;
+  }
+
+  geofences->cellMask = tableSize - 1;
+  for (i = 0; i < tableSize; i++) {
+    geofences->cells[i].key = NMEALIB_GEOFENCE_CELL_EMPTY;
+  }
+
+  for (i = 0; i < pairCount; i = j) {
+    NmeaGeofenceCell *cell = &geofences->cells[nmeaGeofenceSlot(geofences, pairs[i].key)];
+
+    for (j = i; (j < pairCount) && (pairs[j].key == pairs[i].key); j++) {
+      geofences->cellFences[j] = pairs[j].fence;
+    }
+
+    cell->key = pairs[i].key;
+    cell->first = i;
+    cell->count = j - i;
+  }
+
+  free(pairs);
+
+  geofences->dirty = false;
+
+  return true;
+}
+
+/**
+ * Determine whether a position is in a fence
+ *
+ * @param geofences The geofence set
+ * @param fence The fence
+ * @param pos The position (in radians)
+ * @return True when the position is in the fence
+ */
+static bool nmeaGeofenceContains(const NmeaGeofences *geofences, const NmeaGeofence *fence, const NmeaPosition *pos) {
+  const NmeaPosition *v;
+  double lon;
+  bool inside = false;
+  size_t i;
+  size_t j;
+
+  /* the bounding box */
+  lon = remainder(pos->lon - fence->lonCentre, 2 * NMEALIB_PI);
+  if ((pos->lat < fence->latMin) //
+      || (pos->lat > fence->latMax) //
+      || (fabs(lon) > fence->lonHalf)) {
+    return false;
+  }
+
+  if (!fence->polygon) {
+    return nmeaMathDistanceWithMode(&fence->centre, pos, fence->mode) <= fence->radius;
+  }
+
+  /* even-odd rule, in the unwrapped longitudes of the polygon */
+  lon += fence->lonCentre;
+  v = &geofences->vertices[fence->first];
+  for (i = 0, j = fence->count - 1; i < fence->count; j = i++) {
+    if (((v[i].lat > pos->lat) != (v[j].lat > pos->lat)) //
+        && (lon < ((v[j].lon - v[i].lon) * (pos->lat - v[i].lat) / (v[j].lat - v[i].lat) + v[i].lon))) {
+      inside = !inside;
+    }
+  }
+
+  return inside;
+}
+
+/**
+ * Add a fence to the geofence set
+ *
+ * @param geofences The geofence set
+ * @param fence The fence
+ * @return True on success
+ */
+static bool nmeaGeofenceAdd(NmeaGeofences *geofences, const NmeaGeofence *fence) {
+  if (!nmeaGeofenceGrow((void **) &geofences->fences, &geofences->fenceCapacity, geofences->fenceCount + 1,
+      sizeof(geofences->fences[0]))) {
+    /* can't be covered in a test */
+    return false;
+  }
+
+  geofences->fences[geofences->fenceCount++] = *fence;
+  geofences->dirty = true;
+
+  return true;
+}
+
+NmeaGeofences *nmeaGeofencesCreate(const NmeaGeofenceConfig *config) {
+  NmeaGeofences *geofences;
+  double cellSize;
+  double rows;
+  double cols;
+
+  if (!config //
+      || !config->devices //
+      || !(config->cellSize >= 0.0) //
+      || (config->cellSize > 180.0)) {
+    return NULL;
+  }
+
+  cellSize = (config->cellSize > 0.0) ?
+      config->cellSize :
+      NMEALIB_GEOFENCE_CELL_SIZE_DEFAULT;
+
+  /* keep the number of cells (and so the keys) reasonable */
+  if (cellSize < 0.001) {
+    return NULL;
+  }
+
+  geofences = calloc(1, sizeof(*geofences));
+  if (!geofences) {
+    /* can't be covered in a test */
+    return NULL;
+  }
+
+  geofences->config = *config;
+  geofences->config.cellSize = cellSize;
+  rows = ceil(180.0 / cellSize);
+  cols = ceil(360.0 / cellSize);
+  geofences->rows = (size_t) rows;
+  geofences->cols = (size_t) cols;
+  geofences->dirty = true;
+
+  geofences->devices = calloc(config->devices, sizeof(geofences->devices[0]));
+  if (!geofences->devices) {
+    /* can't be covered in a test */
+    free(geofences);
+    return NULL;
+  }
+
+  return geofences;
+}
+
+void nmeaGeofencesDestroy(NmeaGeofences *geofences) {
+  size_t i;
+
+  if (!geofences) {
+    return;
+  }
+
+  for (i = 0; i < geofences->config.devices; i++) {
+    free(geofences->devices[i].fences);
+  }
+
+  free(geofences->devices);
+  free(geofences->scratch.fences);
+  free(geofences->cellFences);
+  free(geofences->cells);
+  free(geofences->vertices);
+  free(geofences->fences);
+  free(geofences);
+}
+
+size_t nmeaGeofencesCount(const NmeaGeofences *geofences) {
+  if (!geofences) {
+    return 0;
+  }
+
+  return geofences->fenceCount;
+}
+
+bool nmeaGeofencesAddCircle(NmeaGeofences *geofences, uint32_t id, const NmeaPosition *centre, double radius) {
+  NmeaGeofence fence;
+  double dlat;
+  double latPole;
+
+  if (!geofences //
+      || !centre //
+      || isNaN(centre->lon) //
+      || !(fabs(centre->lat) <= (NMEALIB_PI / 2)) //
+      || !(radius > 0.0)) {
+    return false;
+  }
+
+  memset(&fence, 0, sizeof(fence));
+  fence.id = id;
+  fence.polygon = false;
+  fence.centre = *centre;
+  fence.radius = radius;
+  fence.mode = (radius <= NMEALIB_GEOFENCE_TANGENTPLANE_RADIUS_MAX_M) ?
+      NMEALIB_MATH_DISTANCE_TANGENTPLANE :
+      NMEALIB_MATH_DISTANCE_GEODESIC;
+
+  dlat = radius / NMEALIB_GEOFENCE_RADIUS_MIN_M;
+  fence.latMin = MAX(centre->lat - dlat, -(NMEALIB_PI / 2));
+  fence.latMax = MIN(centre->lat + dlat, NMEALIB_PI / 2);
+  fence.lonCentre = centre->lon;
+  fence.lonHalf = NMEALIB_PI;
+
+  /* the longitude span is the widest at the latitude that is closest to a pole */
+  latPole = MAX(fabs(fence.latMin), fabs(fence.latMax));
+  if ((dlat < (NMEALIB_PI / 2)) //
+      && (latPole < (NMEALIB_PI / 2)) //
+      && (sin(dlat) < cos(latPole))) {
+    fence.lonHalf = asin(sin(dlat) / cos(latPole));
+  }
+
+  return nmeaGeofenceAdd(geofences, &fence);
+}
+
+bool nmeaGeofencesAddPolygon(NmeaGeofences *geofences, uint32_t id, const NmeaPosition *vertices, size_t count) {
+  NmeaGeofence fence;
+  NmeaPosition *v;
+  double lonMin;
+  double lonMax;
+  size_t i;
+
+  if (!geofences //
+      || !vertices //
+      || (count < 3)) {
+    return false;
+  }
+
+  for (i = 0; i < count; i++) {
+    if (isNaN(vertices[i].lon) //
+        || !(fabs(vertices[i].lat) <= (NMEALIB_PI / 2))) {
+      return false;
+    }
+  }
+
+  if (!nmeaGeofenceGrow((void **) &geofences->vertices, &geofences->vertexCapacity, geofences->vertexCount + count,
+      sizeof(geofences->vertices[0]))) {
+    /* can't be covered in a test */
+    return false;
+  }
+
+  memset(&fence, 0, sizeof(fence));
+  fence.id = id;
+  fence.polygon = true;
+  fence.first = geofences->vertexCount;
+  fence.count = count;
+  fence.latMin = vertices[0].lat;
+  fence.latMax = vertices[0].lat;
+
+  /* unwrap the longitudes relative to the first vertex */
+  v = &geofences->vertices[fence.first];
+  lonMin = lonMax = v[0].lon = remainder(vertices[0].lon, 2 * NMEALIB_PI);
+  v[0].lat = vertices[0].lat;
+  for (i = 1; i < count; i++) {
+    v[i].lat = vertices[i].lat;
+    v[i].lon = v[0].lon + remainder(vertices[i].lon - v[0].lon, 2 * NMEALIB_PI);
+    fence.latMin = MIN(fence.latMin, v[i].lat);
+    fence.latMax = MAX(fence.latMax, v[i].lat);
+    lonMin = MIN(lonMin, v[i].lon);
+    lonMax = MAX(lonMax, v[i].lon);
+  }
+
+  if ((lonMax - lonMin) >= NMEALIB_PI) {
+    return false;
+  }
+
+  fence.lonCentre = (lonMin + lonMax) / 2;
+  fence.lonHalf = (lonMax - lonMin) / 2;
+
+  if (!nmeaGeofenceAdd(geofences, &fence)) {
+    /* can't be covered in a test */
+    return false;
+  }
+
+  geofences->vertexCount += count;
+
+  return true;
+}
+
+size_t nmeaGeofencesUpdate(NmeaGeofences *geofences, size_t device, const NmeaPosition *pos) {
+  NmeaGeofenceList *list;
+  NmeaGeofenceList previous;
+  const NmeaGeofenceCell *cell;
+  size_t events = 0;
+  size_t i;
+  size_t j;
+
+  if (!geofences //
+      || !pos //
+      || (device >= geofences->config.devices) //
+      || isNaN(pos->lat) //
+      || isNaN(pos->lon)) {
+    return 0;
+  }
+
+  if (geofences->dirty //
+      && !nmeaGeofenceBuild(geofences)) {
+    /* can't be covered in a test */
+    return 0;
+  }
+
+  /* the fences of the cell that contain the position */
+  cell = &geofences->cells[nmeaGeofenceSlot(geofences, nmeaGeofenceKey(geofences, pos))];
+  geofences->scratch.count = 0;
+  if (cell->key != NMEALIB_GEOFENCE_CELL_EMPTY) {
+    /* the scratch list can be the (smaller) list of another device */
+    if (!nmeaGeofenceGrow((void **) &geofences->scratch.fences, &geofences->scratch.capacity, cell->count,
+        sizeof(geofences->scratch.fences[0]))) {
+      /* can't be covered in a test */
+      return 0;
+    }
+
+    for (i = 0; i < cell->count; i++) {
+      size_t fence = geofences->cellFences[cell->first + i];
+
+      if (nmeaGeofenceContains(geofences, &geofences->fences[fence], pos)) {
+        geofences->scratch.fences[geofences->scratch.count++] = fence;
+      }
+    }
+  }
+
+  /* swap the lists, the scratch list then holds the previous fences */
+  list = &geofences->devices[device];
+  previous = *list;
+  *list = geofences->scratch;
+  geofences->scratch = previous;
+
+  /* both lists are sorted: exits first, then enters */
+  for (i = 0, j = 0; i < previous.count; i++) {
+    while ((j < list->count) //
+        && (list->fences[j] < previous.fences[i])) {
+      j++;
+    }
+
+    if ((j >= list->count) //
+        || (list->fences[j] != previous.fences[i])) {
+      if (geofences->config.handler) {
+        geofences->config.handler(geofences->config.user, device, geofences->fences[previous.fences[i]].id,
+            NMEALIB_GEOFENCE_EXIT);
+      }
+      events++;
+    }
+  }
+
+  for (i = 0, j = 0; i < list->count; i++) {
+    while ((j < previous.count) //
+        && (previous.fences[j] < list->fences[i])) {
+      j++;
+    }
+
+    if ((j >= previous.count) //
+        || (previous.fences[j] != list->fences[i])) {
+      if (geofences->config.handler) {
+        geofences->config.handler(geofences->config.user, device, geofences->fences[list->fences[i]].id,
+            NMEALIB_GEOFENCE_ENTER);
+      }
+      events++;
+    }
+  }
+
+  return events;
+}
+
+size_t nmeaGeofencesUpdateInfo(NmeaGeofences *geofences, size_t device, const NmeaInfo *info) {
+  NmeaPosition pos;
+
+  if (!info //
+      || !nmeaInfoIsPresentAll(info->present, NMEALIB_PRESENT_LAT | NMEALIB_PRESENT_LON)) {
+    return 0;
+  }
+
+  nmeaMathInfoToPosition(info, &pos);
+
+  return nmeaGeofencesUpdate(geofences, device, &pos);
+}
+
+bool nmeaGeofencesInside(const NmeaGeofences *geofences, size_t device, uint32_t id) {
+  const NmeaGeofenceList *list;
+  size_t i;
+
+  if (!geofences //
+      || (device >= geofences->config.devices)) {
+    return false;
+  }
+
+  list = &geofences->devices[device];
+  for (i = 0; i < list->count; i++) {
+    if (geofences->fences[list->fences[i]].id == id) {
+      return true;
+    }
+  }
+
+  return false;
+}
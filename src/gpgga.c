@@ -178,17 +178,25 @@ err:
   return false;
 }
 
-void nmeaGPGGAToInfo(const NmeaGPGGA *pack, NmeaInfo *info) {
+uint32_t nmeaGPGGAToInfo(const NmeaGPGGA *pack, NmeaInfo *info) {
+  uint32_t changed = 0;
+
   if (!pack //
       || !info) {
-    return;
+    return 0;
   }
 
+  changed |= nmeaInfoChanged(info->present, NMEALIB_PRESENT_SMASK, !(info->smask & NMEALIB_SENTENCE_GPGGA));
   nmeaInfoSetPresent(&info->present, NMEALIB_PRESENT_SMASK);
 
   info->smask |= NMEALIB_SENTENCE_GPGGA;
 
   if (nmeaInfoIsPresentAll(pack->present, NMEALIB_PRESENT_UTCTIME)) {
+    changed |= nmeaInfoChanged(info->present, NMEALIB_PRESENT_UTCTIME, //
+        (info->utc.hour != pack->utc.hour) //
+        || (info->utc.min != pack->utc.min) //
+        || (info->utc.sec != pack->utc.sec) //
+        || (info->utc.hsec != pack->utc.hsec));
     info->utc.hour = pack->utc.hour;
     info->utc.min = pack->utc.min;
     info->utc.sec = pack->utc.sec;
@@ -197,53 +205,66 @@ void nmeaGPGGAToInfo(const NmeaGPGGA *pack, NmeaInfo *info) {
   }
 
   if (nmeaInfoIsPresentAll(pack->present, NMEALIB_PRESENT_LAT)) {
-    info->latitude = ((pack->latitudeNS == 'S') ?
+    double latitude = ((pack->latitudeNS == 'S') ?
         -pack->latitude :
         pack->latitude);
+    changed |= nmeaInfoChanged(info->present, NMEALIB_PRESENT_LAT, (info->latitude != latitude));
+    info->latitude = latitude;
     nmeaInfoSetPresent(&info->present, NMEALIB_PRESENT_LAT);
   }
 
   if (nmeaInfoIsPresentAll(pack->present, NMEALIB_PRESENT_LON)) {
-    info->longitude = ((pack->longitudeEW == 'W') ?
+    double longitude = ((pack->longitudeEW == 'W') ?
         -pack->longitude :
         pack->longitude);
+    changed |= nmeaInfoChanged(info->present, NMEALIB_PRESENT_LON, (info->longitude != longitude));
+    info->longitude = longitude;
     nmeaInfoSetPresent(&info->present, NMEALIB_PRESENT_LON);
   }
 
   if (nmeaInfoIsPresentAll(pack->present, NMEALIB_PRESENT_SIG)) {
+    changed |= nmeaInfoChanged(info->present, NMEALIB_PRESENT_SIG, (info->sig != pack->sig));
     info->sig = pack->sig;
     nmeaInfoSetPresent(&info->present, NMEALIB_PRESENT_SIG);
   }
 
   if (nmeaInfoIsPresentAll(pack->present, NMEALIB_PRESENT_SATINVIEWCOUNT)) {
-    info->satellites.inViewCount = pack->inViewCount;
+    changed |= nmeaInfoChanged(info->present, NMEALIB_PRESENT_SATINVIEWCOUNT, //
+        nmeaInfoSatellitesInViewPublish(info, info->satellites.inView, pack->inViewCount));
     nmeaInfoSetPresent(&info->present, NMEALIB_PRESENT_SATINVIEWCOUNT);
   }
 
   if (nmeaInfoIsPresentAll(pack->present, NMEALIB_PRESENT_HDOP)) {
+    changed |= nmeaInfoChanged(info->present, NMEALIB_PRESENT_HDOP, (info->hdop != pack->hdop));
     info->hdop = pack->hdop;
     nmeaInfoSetPresent(&info->present, NMEALIB_PRESENT_HDOP);
   }
 
   if (nmeaInfoIsPresentAll(pack->present, NMEALIB_PRESENT_ELV)) {
+    changed |= nmeaInfoChanged(info->present, NMEALIB_PRESENT_ELV, (info->elevation != pack->elevation));
     info->elevation = pack->elevation;
     nmeaInfoSetPresent(&info->present, NMEALIB_PRESENT_ELV);
   }
 
   if (nmeaInfoIsPresentAll(pack->present, NMEALIB_PRESENT_HEIGHT)) {
+    changed |= nmeaInfoChanged(info->present, NMEALIB_PRESENT_HEIGHT, (info->height != pack->height));
     info->height = pack->height;
     nmeaInfoSetPresent(&info->present, NMEALIB_PRESENT_HEIGHT);
   }
 
   if (nmeaInfoIsPresentAll(pack->present, NMEALIB_PRESENT_DGPSAGE)) {
+    changed |= nmeaInfoChanged(info->present, NMEALIB_PRESENT_DGPSAGE, (info->dgpsAge != pack->dgpsAge));
     info->dgpsAge = pack->dgpsAge;
     nmeaInfoSetPresent(&info->present, NMEALIB_PRESENT_DGPSAGE);
   }
 
   if (nmeaInfoIsPresentAll(pack->present, NMEALIB_PRESENT_DGPSSID)) {
+    changed |= nmeaInfoChanged(info->present, NMEALIB_PRESENT_DGPSSID, (info->dgpsSid != pack->dgpsSid));
     info->dgpsSid = pack->dgpsSid;
     nmeaInfoSetPresent(&info->present, NMEALIB_PRESENT_DGPSSID);
   }
+
+  return changed;
 }
 
 void nmeaGPGGAFromInfo(const NmeaInfo *info, NmeaGPGGA *pack) {
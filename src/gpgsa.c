@@ -138,12 +138,15 @@ err:
   return false;
 }
 
-void nmeaGPGSAToInfo(const NmeaGPGSA *pack, NmeaInfo *info) {
+uint32_t nmeaGPGSAToInfo(const NmeaGPGSA *pack, NmeaInfo *info) {
+  uint32_t changed = 0;
+
   if (!pack //
       || !info) {
-    return;
+    return 0;
   }
 
+  changed |= nmeaInfoChanged(info->present, NMEALIB_PRESENT_SMASK, !(info->smask & NMEALIB_SENTENCE_GPGSA));
   nmeaInfoSetPresent(&info->present, NMEALIB_PRESENT_SMASK);
 
   info->smask |= NMEALIB_SENTENCE_GPGSA;
@@ -156,10 +159,13 @@ void nmeaGPGSAToInfo(const NmeaGPGSA *pack, NmeaInfo *info) {
       info->sig = NMEALIB_SIG_FIX;
     }
 
+    /* the signal was invalid, so it always changes */
+    changed |= NMEALIB_PRESENT_SIG;
     nmeaInfoSetPresent(&info->present, NMEALIB_PRESENT_SIG);
   }
 
   if (nmeaInfoIsPresentAll(pack->present, NMEALIB_PRESENT_FIX)) {
+    changed |= nmeaInfoChanged(info->present, NMEALIB_PRESENT_FIX, (info->fix != pack->fix));
     info->fix = pack->fix;
     nmeaInfoSetPresent(&info->present, NMEALIB_PRESENT_FIX);
   }
@@ -167,7 +173,21 @@ void nmeaGPGSAToInfo(const NmeaGPGSA *pack, NmeaInfo *info) {
   if (nmeaInfoIsPresentAll(pack->present, NMEALIB_PRESENT_SATINUSE)) {
     size_t p = 0;
     size_t i = 0;
+    bool differs = false;
 
+    for (p = 0; (p < NMEALIB_GPGSA_SATS_IN_SENTENCE) && (i < NMEALIB_MAX_SATELLITES); p++) {
+      unsigned int prn = pack->prn[p];
+      if (prn) {
+        differs = differs || (info->satellites.inUse[i] != prn);
+        i++;
+      }
+    }
+
+    differs = differs || (info->satellites.inUseCount != i);
+    changed |= nmeaInfoChanged(info->present, NMEALIB_PRESENT_SATINUSECOUNT, (info->satellites.inUseCount != i));
+    changed |= nmeaInfoChanged(info->present, NMEALIB_PRESENT_SATINUSE, differs);
+
+    i = 0;
     info->satellites.inUseCount = 0;
     memset(&info->satellites.inUse, 0, sizeof(info->satellites.inUse[0]));
 
@@ -183,19 +203,24 @@ void nmeaGPGSAToInfo(const NmeaGPGSA *pack, NmeaInfo *info) {
   }
 
   if (nmeaInfoIsPresentAll(pack->present, NMEALIB_PRESENT_PDOP)) {
+    changed |= nmeaInfoChanged(info->present, NMEALIB_PRESENT_PDOP, (info->pdop != pack->pdop));
     info->pdop = pack->pdop;
     nmeaInfoSetPresent(&info->present, NMEALIB_PRESENT_PDOP);
   }
 
   if (nmeaInfoIsPresentAll(pack->present, NMEALIB_PRESENT_HDOP)) {
+    changed |= nmeaInfoChanged(info->present, NMEALIB_PRESENT_HDOP, (info->hdop != pack->hdop));
     info->hdop = pack->hdop;
     nmeaInfoSetPresent(&info->present, NMEALIB_PRESENT_HDOP);
   }
 
   if (nmeaInfoIsPresentAll(pack->present, NMEALIB_PRESENT_VDOP)) {
+    changed |= nmeaInfoChanged(info->present, NMEALIB_PRESENT_VDOP, (info->vdop != pack->vdop));
     info->vdop = pack->vdop;
     nmeaInfoSetPresent(&info->present, NMEALIB_PRESENT_VDOP);
   }
+
+  return changed;
 }
 
 void nmeaGPGSAFromInfo(const NmeaInfo *info, NmeaGPGSA *pack) {
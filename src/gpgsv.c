@@ -169,83 +169,143 @@ err:
 
 }
 
-void nmeaGPGSVToInfo(const NmeaGPGSV *pack, NmeaInfo *info) {
+uint32_t nmeaGPGSVToInfo(const NmeaGPGSV *pack, NmeaInfo *info, NmeaGPGSVStaging *staging) {
+  uint32_t changed = 0;
+
   if (!pack //
       || !info) {
-    return;
+    return 0;
   }
 
   if (nmeaInfoIsPresentAll(pack->present, NMEALIB_PRESENT_SATINVIEWCOUNT)) {
     if (pack->inViewCount > NMEALIB_MAX_SATELLITES) {
       nmeaContextError("%s error: can't handle %u satellites (maximum is %u)", __FUNCTION__, pack->inViewCount,
       NMEALIB_MAX_SATELLITES);
-      return;
+      return changed;
     }
 
-    info->satellites.inViewCount = pack->inViewCount;
-    nmeaInfoSetPresent(&info->present, NMEALIB_PRESENT_SATINVIEWCOUNT);
+    /* the count of a sequence is published together with its satellites */
+    if (!nmeaInfoIsPresentAll(pack->present, NMEALIB_PRESENT_SATINVIEW)) {
+      changed |= nmeaInfoChanged(info->present, NMEALIB_PRESENT_SATINVIEWCOUNT, //
+          nmeaInfoSatellitesInViewPublish(info, info->satellites.inView, pack->inViewCount));
+      nmeaInfoSetPresent(&info->present, NMEALIB_PRESENT_SATINVIEWCOUNT);
+    }
   }
 
   if (nmeaInfoIsPresentAll(pack->present, NMEALIB_PRESENT_SATINVIEW)) {
+    NmeaSatellite unstaged[NMEALIB_MAX_SATELLITES];
+    NmeaSatellite *inView;
     size_t i;
     size_t p;
 
     if (!pack->sentenceCount) {
       nmeaContextError("%s error: sentences count %u is invalid", __FUNCTION__, pack->sentenceCount);
-      return;
+      return changed;
     }
 
     if (pack->sentenceCount > NMEALIB_GPGSV_MAX_SENTENCES) {
       nmeaContextError("%s error: can't handle %u sentences (maximum is %u)", __FUNCTION__, pack->sentenceCount,
       NMEALIB_GPGSV_MAX_SENTENCES);
-      return;
+      return changed;
     }
 
     if (pack->sentenceCount != nmeaGPGSVsatellitesToSentencesCount(pack->inViewCount)) {
       nmeaContextError("%s error: sentences count %u does not correspond to satellite count %u", __FUNCTION__,
           pack->sentenceCount, pack->inViewCount);
-      return;
+      return changed;
     }
 
     if (!pack->sentence) {
       nmeaContextError("%s error: sentence index %u is invalid", __FUNCTION__, pack->sentence);
-      return;
+      return changed;
     }
 
     if (pack->sentence > pack->sentenceCount) {
       nmeaContextError("%s error: sentence %u is beyond the sentence count (%u)", __FUNCTION__, pack->sentence,
           pack->sentenceCount);
-      return;
+      return changed;
     }
 
-    if (pack->sentence <= pack->sentenceCount) {
-      /* clear non-present satellites */
-      size_t start = pack->sentence << NMEALIB_GPGSV_MAX_SATS_PER_SENTENCE_SHIFT;
-      size_t clearCount = NMEALIB_MAX_SATELLITES - start;
-      if (clearCount) {
-        memset(&info->satellites.inView[start], 0, clearCount * sizeof(info->satellites.inView[0]));
+    if ((pack->sentence != 1) //
+        && (!info->progress.gpgsvInProgress //
+            || (pack->sentence != (info->progress.gpgsvSentence + 1)))) {
+      /* out of sequence: drop the sequence */
+      info->progress.gpgsvInProgress = false;
+      info->progress.gpgsvSentence = 0;
+      goto out;
+    }
+
+    if (staging) {
+      if (pack->sentence == 1) {
+        /* start a new sequence */
+        memset(staging->inView, 0, sizeof(staging->inView));
+        staging->inViewCountPresent = nmeaInfoIsPresentAll(pack->present, NMEALIB_PRESENT_SATINVIEWCOUNT);
+        staging->inViewCount = staging->inViewCountPresent ?
+            pack->inViewCount :
+            0;
+      }
+      inView = staging->inView;
+    } else {
+      /* every sentence is published on top of the previous ones */
+      if (pack->sentence == 1) {
+        memset(unstaged, 0, sizeof(unstaged));
+      } else {
+        memcpy(unstaged, info->satellites.inView, sizeof(unstaged));
       }
+      inView = unstaged;
     }
 
     i = (pack->sentence - 1) << NMEALIB_GPGSV_MAX_SATS_PER_SENTENCE_SHIFT;
 
     for (p = 0; (p < NMEALIB_GPGSV_MAX_SATS_PER_SENTENCE) && (i < NMEALIB_MAX_SATELLITES); p++, i++) {
       const NmeaSatellite *src = &pack->inView[p];
+      NmeaSatellite *dst = &inView[i];
       if (!src->prn) {
-        memset(&info->satellites.inView[i], 0, sizeof(info->satellites.inView[i]));
+        memset(dst, 0, sizeof(*dst));
       } else {
-        info->satellites.inView[i] = *src;
+        *dst = *src;
       }
     }
 
-    nmeaInfoSetPresent(&info->present, NMEALIB_PRESENT_SATINVIEW);
-
+    info->progress.gpgsvSentence = pack->sentence;
     info->progress.gpgsvInProgress = (pack->sentence != pack->sentenceCount);
+
+    if (!staging //
+        || !info->progress.gpgsvInProgress) {
+      /* publish the satellites, see nmeaInfoSatellitesInViewSnapshot */
+      bool countPresent = staging ?
+          staging->inViewCountPresent :
+          nmeaInfoIsPresentAll(pack->present, NMEALIB_PRESENT_SATINVIEWCOUNT);
+      unsigned int count = info->satellites.inViewCount;
+      bool differs = !!memcmp(info->satellites.inView, inView, sizeof(info->satellites.inView));
+
+      if (countPresent) {
+        count = staging ?
+            staging->inViewCount :
+            pack->inViewCount;
+        changed |= nmeaInfoChanged(info->present, NMEALIB_PRESENT_SATINVIEWCOUNT, //
+            (info->satellites.inViewCount != count));
+        nmeaInfoSetPresent(&info->present, NMEALIB_PRESENT_SATINVIEWCOUNT);
+      }
+
+      (void) nmeaInfoSatellitesInViewPublish(info, inView, count);
+
+      changed |= nmeaInfoChanged(info->present, NMEALIB_PRESENT_SATINVIEW, differs);
+      nmeaInfoSetPresent(&info->present, NMEALIB_PRESENT_SATINVIEW);
+    }
+
+    if (!info->progress.gpgsvInProgress) {
+      info->progress.gpgsvSentence = 0;
+    }
   }
 
+out:
+  changed |= nmeaInfoChanged(info->present, NMEALIB_PRESENT_SMASK, !(info->smask & NMEALIB_SENTENCE_GPGSV));
   nmeaInfoSetPresent(&info->present, NMEALIB_PRESENT_SMASK);
 
   info->smask |= NMEALIB_SENTENCE_GPGSV;
+
+  return changed;
 }
 
 void nmeaGPGSVFromInfo(const NmeaInfo *info, NmeaGPGSV *pack, size_t sentence) {
@@ -190,17 +190,25 @@ err:
   return false;
 }
 
-void nmeaGPRMCToInfo(const NmeaGPRMC *pack, NmeaInfo *info) {
+uint32_t nmeaGPRMCToInfo(const NmeaGPRMC *pack, NmeaInfo *info) {
+  uint32_t changed = 0;
+
   if (!pack //
       || !info) {
-    return;
+    return 0;
   }
 
+  changed |= nmeaInfoChanged(info->present, NMEALIB_PRESENT_SMASK, !(info->smask & NMEALIB_SENTENCE_GPRMC));
   nmeaInfoSetPresent(&info->present, NMEALIB_PRESENT_SMASK);
 
   info->smask |= NMEALIB_SENTENCE_GPRMC;
 
   if (nmeaInfoIsPresentAll(pack->present, NMEALIB_PRESENT_UTCTIME)) {
+    changed |= nmeaInfoChanged(info->present, NMEALIB_PRESENT_UTCTIME, //
+        (info->utc.hour != pack->utc.hour) //
+        || (info->utc.min != pack->utc.min) //
+        || (info->utc.sec != pack->utc.sec) //
+        || (info->utc.hsec != pack->utc.hsec));
     info->utc.hour = pack->utc.hour;
     info->utc.min = pack->utc.min;
     info->utc.sec = pack->utc.sec;
@@ -213,46 +221,62 @@ void nmeaGPRMCToInfo(const NmeaGPRMC *pack, NmeaInfo *info) {
       /* no mode */
       if ((pack->sigSelection == 'A') //
           && (info->sig == NMEALIB_SIG_INVALID)) {
+        /* the signal was invalid, so it always changes */
+        changed |= NMEALIB_PRESENT_SIG;
         info->sig = NMEALIB_SIG_FIX;
         nmeaInfoSetPresent(&info->present, NMEALIB_PRESENT_SIG);
       }
     } else {
       /* with mode */
+      NmeaSignal sig;
 
       if (pack->sigSelection != 'A') {
-        info->sig = NMEALIB_SIG_INVALID;
+        sig = NMEALIB_SIG_INVALID;
       } else {
-        info->sig = nmeaInfoModeToSignal(pack->sig);
+        sig = nmeaInfoModeToSignal(pack->sig);
       }
+      changed |= nmeaInfoChanged(info->present, NMEALIB_PRESENT_SIG, (info->sig != sig));
+      info->sig = sig;
       nmeaInfoSetPresent(&info->present, NMEALIB_PRESENT_SIG);
     }
   }
 
   if (nmeaInfoIsPresentAll(pack->present, NMEALIB_PRESENT_LAT)) {
-    info->latitude = ((pack->latitudeNS == 'N') ?
+    double latitude = ((pack->latitudeNS == 'N') ?
         pack->latitude :
         -pack->latitude);
+    changed |= nmeaInfoChanged(info->present, NMEALIB_PRESENT_LAT, (info->latitude != latitude));
+    info->latitude = latitude;
     nmeaInfoSetPresent(&info->present, NMEALIB_PRESENT_LAT);
   }
 
   if (nmeaInfoIsPresentAll(pack->present, NMEALIB_PRESENT_LON)) {
-    info->longitude = ((pack->longitudeEW == 'E') ?
+    double longitude = ((pack->longitudeEW == 'E') ?
         pack->longitude :
         -pack->longitude);
+    changed |= nmeaInfoChanged(info->present, NMEALIB_PRESENT_LON, (info->longitude != longitude));
+    info->longitude = longitude;
     nmeaInfoSetPresent(&info->present, NMEALIB_PRESENT_LON);
   }
 
   if (nmeaInfoIsPresentAll(pack->present, NMEALIB_PRESENT_SPEED)) {
-    info->speed = pack->speed * NMEALIB_KNOT_TO_KPH;
+    double speed = pack->speed * NMEALIB_KNOT_TO_KPH;
+    changed |= nmeaInfoChanged(info->present, NMEALIB_PRESENT_SPEED, (info->speed != speed));
+    info->speed = speed;
     nmeaInfoSetPresent(&info->present, NMEALIB_PRESENT_SPEED);
   }
 
   if (nmeaInfoIsPresentAll(pack->present, NMEALIB_PRESENT_TRACK)) {
+    changed |= nmeaInfoChanged(info->present, NMEALIB_PRESENT_TRACK, (info->track != pack->track));
     info->track = pack->track;
     nmeaInfoSetPresent(&info->present, NMEALIB_PRESENT_TRACK);
   }
 
   if (nmeaInfoIsPresentAll(pack->present, NMEALIB_PRESENT_UTCDATE)) {
+    changed |= nmeaInfoChanged(info->present, NMEALIB_PRESENT_UTCDATE, //
+        (info->utc.year != pack->utc.year) //
+        || (info->utc.mon != pack->utc.mon) //
+        || (info->utc.day != pack->utc.day));
     info->utc.year = pack->utc.year;
     info->utc.mon = pack->utc.mon;
     info->utc.day = pack->utc.day;
@@ -260,11 +284,15 @@ void nmeaGPRMCToInfo(const NmeaGPRMC *pack, NmeaInfo *info) {
   }
 
   if (nmeaInfoIsPresentAll(pack->present, NMEALIB_PRESENT_MAGVAR)) {
-    info->magvar = ((pack->magvarEW == 'E') ?
+    double magvar = ((pack->magvarEW == 'E') ?
         pack->magvar :
         -pack->magvar);
+    changed |= nmeaInfoChanged(info->present, NMEALIB_PRESENT_MAGVAR, (info->magvar != magvar));
+    info->magvar = magvar;
     nmeaInfoSetPresent(&info->present, NMEALIB_PRESENT_MAGVAR);
   }
+
+  return changed;
 }
 
 void nmeaGPRMCFromInfo(const NmeaInfo *info, NmeaGPRMC *pack) {
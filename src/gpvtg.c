@@ -134,34 +134,45 @@ err:
   return false;
 }
 
-void nmeaGPVTGToInfo(const NmeaGPVTG *pack, NmeaInfo *info) {
+uint32_t nmeaGPVTGToInfo(const NmeaGPVTG *pack, NmeaInfo *info) {
+  uint32_t changed = 0;
+
   if (!pack //
       || !info) {
-    return;
+    return 0;
   }
 
+  changed |= nmeaInfoChanged(info->present, NMEALIB_PRESENT_SMASK, !(info->smask & NMEALIB_SENTENCE_GPVTG));
   nmeaInfoSetPresent(&info->present, NMEALIB_PRESENT_SMASK);
 
   info->smask |= NMEALIB_SENTENCE_GPVTG;
 
   if (nmeaInfoIsPresentAll(pack->present, NMEALIB_PRESENT_TRACK)) {
+    changed |= nmeaInfoChanged(info->present, NMEALIB_PRESENT_TRACK, (info->track != pack->track));
     info->track = pack->track;
     nmeaInfoSetPresent(&info->present, NMEALIB_PRESENT_TRACK);
   }
 
   if (nmeaInfoIsPresentAll(pack->present, NMEALIB_PRESENT_MTRACK)) {
+    changed |= nmeaInfoChanged(info->present, NMEALIB_PRESENT_MTRACK, (info->mtrack != pack->mtrack));
     info->mtrack = pack->mtrack;
     nmeaInfoSetPresent(&info->present, NMEALIB_PRESENT_MTRACK);
   }
 
   if (nmeaInfoIsPresentAll(pack->present, NMEALIB_PRESENT_SPEED)) {
+    double speed;
+
     if (pack->spkK) {
-      info->speed = pack->spk;
+      speed = pack->spk;
     } else {
-      info->speed = pack->spn * NMEALIB_KNOT_TO_KPH;
+      speed = pack->spn * NMEALIB_KNOT_TO_KPH;
     }
+    changed |= nmeaInfoChanged(info->present, NMEALIB_PRESENT_SPEED, (info->speed != speed));
+    info->speed = speed;
     nmeaInfoSetPresent(&info->present, NMEALIB_PRESENT_SPEED);
   }
+
+  return changed;
 }
 
 void nmeaGPVTGFromInfo(const NmeaInfo *info, NmeaGPVTG *pack) {
@@ -17,8 +17,10 @@
 
 #include <nmealib/info.h>
 
+#include <nmealib/context.h>
 #include <nmealib/nmath.h>
 #include <nmealib/sentence.h>
+#include <nmealib/util.h>
 #include <math.h>
 #include <stdlib.h>
 #include <string.h>
@@ -92,108 +94,342 @@ char nmeaInfoSignalToMode(NmeaSignal sig) {
   }
 }
 
+/**
+ * Determine whether a character is whitespace (like isspace in the C locale)
+ *
+ * @param c The character
+ * @return True when the character is whitespace
+ */
+static INLINE bool nmeaTimeIsSpace(char c) {
+  return (c == ' ') //
+      || ((c >= '\t') && (c <= '\r'));
+}
+
+/**
+ * Get the token of a time or date string: the string without surrounding
+ * whitespace
+ *
+ * @param s The string
+ * @param sz Where to store the length of the token
+ * @return The token, or NULL when it contains whitespace
+ */
+static const char *nmeaTimeToken(const char *s, size_t *sz) {
+  const char *end;
+
+  while (nmeaTimeIsSpace(*s)) {
+    s++;
+  }
+
+  end = s;
+  while (*end //
+      && !nmeaTimeIsSpace(*end)) {
+    end++;
+  }
+
+  *sz = (size_t) (end - s);
+
+  while (*end) {
+    if (!nmeaTimeIsSpace(*end)) {
+      return NULL;
+    }
+    end++;
+  }
+
+  return s;
+}
+
+/**
+ * Decode a fixed number of decimal digits
+ *
+ * @param s The digits
+ * @param n The number of digits
+ * @param v Where to store the value
+ * @return True when all characters are digits
+ */
+static INLINE bool nmeaTimeDigits(const char *s, size_t n, unsigned int *v) {
+  unsigned int r = 0;
+  size_t i;
+
+  for (i = 0; i < n; i++) {
+    unsigned int digit = (unsigned int) (unsigned char) s[i] - '0';
+    if (digit > 9) {
+      return false;
+    }
+    r = (r * 10) + digit;
+  }
+
+  *v = r;
+  return true;
+}
+
 bool nmeaTimeParseTime(const char *s, NmeaTime *ntime) {
   const char *t;
   size_t sz;
+  unsigned int hour;
+  unsigned int min;
+  unsigned int sec;
+  unsigned int frac = 0;
 
   if (!s //
       || !ntime) {
     return false;
   }
 
-  t = s;
-  sz = nmeaStringTrim(&t);
-
-  if (nmeaStringContainsWhitespace(t, sz)) {
+  /* HHMMSS, HHMMSS.t, HHMMSS.hh or HHMMSS.mmm */
+  t = nmeaTimeToken(s, &sz);
+  if (!t //
+      || ((sz != 6) && ((sz < 8) || (sz > 10))) //
+      || ((sz > 6) && (t[6] != '.'))) {
     return false;
   }
 
-  if (sz == 6) { // HHMMSS
-    ntime->hsec = 0;
-    return (3 == nmeaScanf(t, sz, "%2u%2u%2u", &ntime->hour, &ntime->min, &ntime->sec));
-  }
-
-  if (sz == 8) { // HHMMSS.t
-    if (4 == nmeaScanf(t, sz, "%2u%2u%2u.%u", &ntime->hour, &ntime->min, &ntime->sec, &ntime->hsec)) {
-      ntime->hsec *= 10;
-      return true;
-    }
+  if (!nmeaTimeDigits(&t[0], 2, &hour) //
+      || !nmeaTimeDigits(&t[2], 2, &min) //
+      || !nmeaTimeDigits(&t[4], 2, &sec) //
+      || ((sz > 6) && !nmeaTimeDigits(&t[7], sz - 7, &frac))) {
+    nmeaContextError("%s error: invalid time '%s'", __FUNCTION__, s);
     return false;
   }
 
-  if (sz == 9) { // HHMMSS.hh
-    return (4 == nmeaScanf(t, sz, "%2u%2u%2u.%u", &ntime->hour, &ntime->min, &ntime->sec, &ntime->hsec));
-  }
+  ntime->hour = hour;
+  ntime->min = min;
+  ntime->sec = sec;
 
-  if (sz == 10) { // HHMMSS.mmm
-    if ((4 == nmeaScanf(t, sz, "%2u%2u%2u.%u", &ntime->hour, &ntime->min, &ntime->sec, &ntime->hsec))) {
-      ntime->hsec = (ntime->hsec + 5) / 10;
-      return true;
-    }
-    return false;
+  switch (sz) {
+    case 8:
+      ntime->hsec = frac * 10;
+      break;
+
+    case 10:
+      ntime->hsec = (frac + 5) / 10;
+      break;
+
+    case 6:
+    case 9:
+    default:
+      ntime->hsec = frac;
+      break;
   }
 
-  return false;
+  return true;
 }
 
 bool nmeaTimeParseDate(const char *s, NmeaTime *date) {
-  size_t sz;
   const char *d;
+  size_t sz;
+  unsigned int day;
+  unsigned int mon;
+  unsigned int year;
 
   if (!s //
       || !date) {
     return false;
   }
 
-  d = s;
-  sz = nmeaStringTrim(&d);
-
-  if (nmeaStringContainsWhitespace(d, sz)) {
+  /* DDMMYY */
+  d = nmeaTimeToken(s, &sz);
+  if (!d //
+      || (sz != 6)) {
     return false;
   }
 
-  if (sz != 6) {
+  if (!nmeaTimeDigits(&d[0], 2, &day) //
+      || !nmeaTimeDigits(&d[2], 2, &mon) //
+      || !nmeaTimeDigits(&d[4], 2, &year)) {
+    nmeaContextError("%s error: invalid date '%s'", __FUNCTION__, s);
     return false;
   }
 
-  if (3 != nmeaScanf(d, sz, "%2u%2u%2u", &date->day, &date->mon, &date->year)) {
-    return false;
+  date->day = day;
+  date->mon = mon;
+  date->year = nmeaTimeYearExpand(year);
+
+  return true;
+}
+
+unsigned int nmeaTimeYearExpand(unsigned int year) {
+  if (year >= 100) {
+    return year;
   }
 
-  if (date->year > 90) {
-    date->year += 1900;
-  } else {
-    date->year += 2000;
+  return year + ((year > 90) ?
+      1900 :
+      2000);
+}
+
+/**
+ * Divide, rounding towards negative infinity
+ *
+ * @param a The dividend
+ * @param b The (positive) divisor
+ * @return The quotient
+ */
+static int64_t nmeaTimeFloorDiv(int64_t a, int64_t b) {
+  return (a - ((a < 0) ?
+      (b - 1) :
+      0)) / b;
+}
+
+/**
+ * Get the number of days since the epoch of a civil date (days from civil)
+ *
+ * @param year The year
+ * @param mon The month, [1 - 12]
+ * @param day The day of the month, [1 - 31]
+ * @return The number of days since the epoch
+ */
+static int64_t nmeaTimeDaysFromCivil(unsigned int year, unsigned int mon, unsigned int day) {
+  /* the year starts in March so that the leap day is the last day */
+  int64_t y = (int64_t) year - ((mon <= 2) ?
+      1 :
+      0);
+  int64_t era = nmeaTimeFloorDiv(y, 400);
+  int64_t yoe = y - (era * 400);
+  int64_t mp = ((int64_t) mon + 9) % 12;
+  int64_t doy = (((153 * mp) + 2) / 5) + (int64_t) day - 1;
+  int64_t doe = (yoe * 365) + (yoe / 4) - (yoe / 100) + doy;
+
+  return (era * 146097) + doe - 719468;
+}
+
+/**
+ * Get the civil date of a number of days since the epoch (civil from days)
+ *
+ * @param days The number of days since the epoch
+ * @param utc The time in which to store the date
+ */
+static void nmeaTimeCivilFromDays(int64_t days, NmeaTime *utc) {
+  int64_t z = days + 719468;
+  int64_t era = nmeaTimeFloorDiv(z, 146097);
+  int64_t doe = z - (era * 146097);
+  int64_t yoe = (doe - (doe / 1460) + (doe / 36524) - (doe / 146096)) / 365;
+  int64_t doy = doe - ((yoe * 365) + (yoe / 4) - (yoe / 100));
+  int64_t mp = ((5 * doy) + 2) / 153;
+  int64_t mon = mp + ((mp < 10) ?
+      3 :
+      -9);
+
+  utc->year = (unsigned int) ((era * 400) + yoe + ((mon <= 2) ?
+      1 :
+      0));
+  utc->mon = (unsigned int) mon;
+  utc->day = (unsigned int) (doy - (((153 * mp) + 2) / 5) + 1);
+}
+
+/**
+ * Scale seconds since the epoch and hundredths of a second into smaller
+ * units, saturating at the limits of int64_t
+ *
+ * @param seconds The seconds since the epoch
+ * @param hsec The hundredths of a second
+ * @param perSecond The number of units per second
+ * @return The units since the epoch, INT64_MIN or INT64_MAX when they do
+ * not fit
+ */
+static int64_t nmeaTimeScale(int64_t seconds, unsigned int hsec, int64_t perSecond) {
+  seconds += (int64_t) (hsec / 100);
+  hsec %= 100;
+
+  if (seconds < (INT64_MIN / perSecond)) {
+    return INT64_MIN;
   }
 
-  return true;
+  if (seconds > ((INT64_MAX - (99 * (perSecond / 100))) / perSecond)) {
+    return INT64_MAX;
+  }
+
+  return (seconds * perSecond) + ((int64_t) hsec * (perSecond / 100));
+}
+
+int64_t nmeaTimeToEpochSeconds(const NmeaTime *utc) {
+  if (!utc) {
+    return 0;
+  }
+
+  return (nmeaTimeDaysFromCivil(nmeaTimeYearExpand(utc->year), utc->mon, utc->day) * 86400) //
+      + ((int64_t) utc->hour * 3600) //
+      + ((int64_t) utc->min * 60) //
+      + (int64_t) utc->sec;
+}
+
+void nmeaTimeFromEpochSeconds(int64_t seconds, unsigned int hsec, NmeaTime *utc) {
+  int64_t days = nmeaTimeFloorDiv(seconds, 86400);
+  int64_t sod = seconds - (days * 86400);
+
+  if (!utc) {
+    return;
+  }
+
+  nmeaTimeCivilFromDays(days, utc);
+  utc->hour = (unsigned int) (sod / 3600);
+  utc->min = (unsigned int) ((sod / 60) % 60);
+  utc->sec = (unsigned int) (sod % 60);
+  utc->hsec = hsec;
+}
+
+int64_t nmeaTimeToEpochNs(const NmeaTime *utc) {
+  if (!utc) {
+    return 0;
+  }
+
+  return nmeaTimeScale(nmeaTimeToEpochSeconds(utc), utc->hsec, 1000000000);
+}
+
+int64_t nmeaTimeToEpochUs(const NmeaTime *utc) {
+  if (!utc) {
+    return 0;
+  }
+
+  return nmeaTimeScale(nmeaTimeToEpochSeconds(utc), utc->hsec, 1000000);
+}
+
+void nmeaTimeFromEpochNs(int64_t ns, NmeaTime *utc) {
+  int64_t seconds = nmeaTimeFloorDiv(ns, 1000000000);
+
+  if (!utc) {
+    return;
+  }
+
+  nmeaTimeFromEpochSeconds(seconds, (unsigned int) ((ns - (seconds * 1000000000)) / 10000000), utc);
+}
+
+void nmeaTimeFromEpochUs(int64_t us, NmeaTime *utc) {
+  int64_t seconds = nmeaTimeFloorDiv(us, 1000000);
+
+  if (!utc) {
+    return;
+  }
+
+  nmeaTimeFromEpochSeconds(seconds, (unsigned int) ((us - (seconds * 1000000)) / 10000), utc);
+}
+
+/** The clock of nmeaTimeSet, NULL for gettimeofday */
+static volatile NmeaTimeClockFunction nmeaTimeClock = NULL;
+
+NmeaTimeClockFunction nmeaTimeSetClock(NmeaTimeClockFunction clockFunction) {
+  NmeaTimeClockFunction r = nmeaTimeClock;
+  nmeaTimeClock = clockFunction;
+  return r;
 }
 
 void nmeaTimeSet(NmeaTime *utc, uint32_t *present, struct timeval *timeval) {
+  NmeaTimeClockFunction clockFunction = nmeaTimeClock;
   struct timeval tv;
-  struct tm tm;
-  long usec;
 
   if (!utc) {
     return;
   }
 
   if (timeval) {
-    gmtime_r(&timeval->tv_sec, &tm);
-    usec = timeval->tv_usec;
+    tv = *timeval;
+  } else if (clockFunction) {
+    clockFunction(&tv);
   } else {
     gettimeofday(&tv, NULL);
-    gmtime_r(&tv.tv_sec, &tm);
-    usec = tv.tv_usec;
   }
 
-  utc->year = (unsigned int) tm.tm_year + 1900;
-  utc->mon = (unsigned int) tm.tm_mon + 1;
-  utc->day = (unsigned int) tm.tm_mday;
-  utc->hour = (unsigned int) tm.tm_hour;
-  utc->min = (unsigned int) tm.tm_min;
-  utc->sec = (unsigned int) tm.tm_sec;
-  utc->hsec = (unsigned int) (usec / 10000);
+  nmeaTimeFromEpochSeconds((int64_t) tv.tv_sec, (unsigned int) (tv.tv_usec / 10000), utc);
+
   if (present) {
     nmeaInfoSetPresent(present, NMEALIB_PRESENT_UTCDATE | NMEALIB_PRESENT_UTCTIME);
   }
@@ -213,7 +449,511 @@ void nmeaInfoClear(NmeaInfo *info) {
   nmeaInfoSetPresent(&info->present, NMEALIB_PRESENT_FIX);
 }
 
-void nmeaInfoSanitise(NmeaInfo *info) {
+/** The number of info structures in a column block */
+#define NMEALIB_INFO_COLUMNS_BLOCK (32u)
+
+/** The NmeaPresence bits of the fields in a column block */
+#define NMEALIB_INFO_COLUMNS_FIELDS ( \
+    NMEALIB_PRESENT_PDOP \
+    | NMEALIB_PRESENT_HDOP \
+    | NMEALIB_PRESENT_VDOP \
+    | NMEALIB_PRESENT_LAT \
+    | NMEALIB_PRESENT_LON \
+    | NMEALIB_PRESENT_SPEED \
+    | NMEALIB_PRESENT_TRACK \
+    | NMEALIB_PRESENT_MTRACK \
+    | NMEALIB_PRESENT_MAGVAR \
+    | NMEALIB_PRESENT_DGPSAGE)
+
+/**
+ * Column block: a structure-of-arrays view of the floating point fields of
+ * a block of info structures, so that the batch functions can process a
+ * field for all info structures of the block in one (vectorisable) loop
+ */
+typedef struct _NmeaInfoColumns {
+    size_t   count;                                 /**< the number of info structures in the block */
+    uint32_t present[NMEALIB_INFO_COLUMNS_BLOCK];   /**< present                                     */
+    double   pdop[NMEALIB_INFO_COLUMNS_BLOCK];      /**< pdop                                        */
+    double   hdop[NMEALIB_INFO_COLUMNS_BLOCK];      /**< hdop                                        */
+    double   vdop[NMEALIB_INFO_COLUMNS_BLOCK];      /**< vdop                                        */
+    double   latitude[NMEALIB_INFO_COLUMNS_BLOCK];  /**< latitude                                    */
+    double   longitude[NMEALIB_INFO_COLUMNS_BLOCK]; /**< longitude                                   */
+    double   speed[NMEALIB_INFO_COLUMNS_BLOCK];     /**< speed                                       */
+    double   track[NMEALIB_INFO_COLUMNS_BLOCK];     /**< track                                       */
+    double   mtrack[NMEALIB_INFO_COLUMNS_BLOCK];    /**< mtrack                                      */
+    double   magvar[NMEALIB_INFO_COLUMNS_BLOCK];    /**< magvar                                      */
+    double   dgpsAge[NMEALIB_INFO_COLUMNS_BLOCK];   /**< dgpsAge                                     */
+} NmeaInfoColumns;
+
+/**
+ * Copy the fields of a block of info structures into a column block
+ *
+ * @param columns The column block
+ * @param infos The info structures
+ * @param count The number of info structures, at most NMEALIB_INFO_COLUMNS_BLOCK
+ */
+static void nmeaInfoColumnsGather(NmeaInfoColumns *columns, const NmeaInfo *infos, size_t count) {
+  size_t i;
+
+  columns->count = count;
+
+  for (i = 0; i < count; i++) {
+    const NmeaInfo *info = &infos[i];
+
+    columns->present[i] = info->present;
+    columns->pdop[i] = info->pdop;
+    columns->hdop[i] = info->hdop;
+    columns->vdop[i] = info->vdop;
+    columns->latitude[i] = info->latitude;
+    columns->longitude[i] = info->longitude;
+    columns->speed[i] = info->speed;
+    columns->track[i] = info->track;
+    columns->mtrack[i] = info->mtrack;
+    columns->magvar[i] = info->magvar;
+    columns->dgpsAge[i] = info->dgpsAge;
+  }
+
+  /* the padding of a partial block is not present, so it is left alone */
+  for (; i < NMEALIB_INFO_COLUMNS_BLOCK; i++) {
+    columns->present[i] = 0;
+    columns->pdop[i] = 0.0;
+    columns->hdop[i] = 0.0;
+    columns->vdop[i] = 0.0;
+    columns->latitude[i] = 0.0;
+    columns->longitude[i] = 0.0;
+    columns->speed[i] = 0.0;
+    columns->track[i] = 0.0;
+    columns->mtrack[i] = 0.0;
+    columns->magvar[i] = 0.0;
+    columns->dgpsAge[i] = 0.0;
+  }
+}
+
+/**
+ * Copy the fields of a column block back into the block of info structures
+ *
+ * @param columns The column block
+ * @param infos The info structures
+ */
+static void nmeaInfoColumnsScatter(const NmeaInfoColumns *columns, NmeaInfo *infos) {
+  size_t i;
+
+  for (i = 0; i < columns->count; i++) {
+    NmeaInfo *info = &infos[i];
+
+    info->pdop = columns->pdop[i];
+    info->hdop = columns->hdop[i];
+    info->vdop = columns->vdop[i];
+    info->latitude = columns->latitude[i];
+    info->longitude = columns->longitude[i];
+    info->speed = columns->speed[i];
+    info->track = columns->track[i];
+    info->mtrack = columns->mtrack[i];
+    info->magvar = columns->magvar[i];
+    info->dgpsAge = columns->dgpsAge[i];
+  }
+}
+
+/**
+ * Take the absolute value of the present values of a column
+ *
+ * @param columns The column block
+ * @param column The column
+ * @param field The NmeaPresence bit of the column
+ */
+static void nmeaInfoColumnsAbs(const NmeaInfoColumns *columns, double *column, NmeaPresence field) {
+  size_t i;
+
+  for (i = 0; i < NMEALIB_INFO_COLUMNS_BLOCK; i++) {
+    double v = column[i];
+
+    column[i] = (columns->present[i] & field) ?
+        fabs(v) :
+        v;
+  }
+}
+
+/**
+ * Scale the present values of a column
+ *
+ * @param columns The column block
+ * @param column The column
+ * @param field The NmeaPresence bit of the column
+ * @param factor The scale factor
+ */
+static void nmeaInfoColumnsScale(const NmeaInfoColumns *columns, double *column, NmeaPresence field, double factor) {
+  size_t i;
+
+  for (i = 0; i < NMEALIB_INFO_COLUMNS_BLOCK; i++) {
+    double v = column[i];
+
+    column[i] = (columns->present[i] & field) ?
+        (v * factor) :
+        v;
+  }
+}
+
+/**
+ * Convert the present values of a column between NDEG and degrees, in the
+ * same way as nmeaMathNdegToDegree and nmeaMathDegreeToNdeg do
+ *
+ * The whole and fractional parts are determined with trunc instead of modf,
+ * which the compiler can vectorise.
+ *
+ * @param columns The column block
+ * @param column The column
+ * @param field The NmeaPresence bit of the column
+ * @param toDegree True to convert from NDEG to degrees, false to convert
+ * from degrees to NDEG
+ */
+static void nmeaInfoColumnsNdeg(const NmeaInfoColumns *columns, double *column, NmeaPresence field, bool toDegree) {
+  size_t i;
+
+  if (toDegree) {
+    for (i = 0; i < NMEALIB_INFO_COLUMNS_BLOCK; i++) {
+      double v = column[i] / 100.0;
+      double whole = trunc(v);
+      double fraction = copysign(isinf(v) ?
+          0.0 :
+          (v - whole), v);
+
+      column[i] = (columns->present[i] & field) ?
+          (whole + ((fraction * 10.0) / 6.0)) :
+          column[i];
+    }
+  } else {
+    for (i = 0; i < NMEALIB_INFO_COLUMNS_BLOCK; i++) {
+      double v = column[i];
+      double whole = trunc(v);
+      double fraction = copysign(isinf(v) ?
+          0.0 :
+          (v - whole), v);
+
+      column[i] = (columns->present[i] & field) ?
+          ((whole * 100.0) + (fraction * 60.0)) :
+          v;
+    }
+  }
+}
+
+/**
+ * Force the present values of a column in [0, 360>
+ *
+ * The first loop handles values that are at most one turn out of range
+ * without branches, the second loop handles the values that are still out
+ * of range (which is rare) in the same way as nmeaInfoSanitise does.
+ *
+ * @param columns The column block
+ * @param column The column
+ * @param field The NmeaPresence bit of the column
+ */
+static void nmeaInfoColumnsWrap360(const NmeaInfoColumns *columns, double *column, NmeaPresence field) {
+  size_t i;
+
+  for (i = 0; i < NMEALIB_INFO_COLUMNS_BLOCK; i++) {
+    double v = column[i];
+    double w = (v < 0.0) ?
+        (v + 360.0) :
+        ((v >= 360.0) ?
+            (v - 360.0) :
+            v);
+
+    column[i] = (columns->present[i] & field) ?
+        w :
+        v;
+  }
+
+  for (i = 0; i < columns->count; i++) {
+    if (!(columns->present[i] & field)) {
+      continue;
+    }
+
+    while (column[i] < 0.0) {
+      column[i] += 360.0;
+    }
+    while (column[i] >= 360.0) {
+      column[i] -= 360.0;
+    }
+  }
+}
+
+/**
+ * Sanitise the fields of a column block, in the same way as
+ * nmeaInfoSanitise does
+ *
+ * @param columns The column block
+ */
+static void nmeaInfoColumnsSanitise(NmeaInfoColumns *columns) {
+  double wrapped[NMEALIB_INFO_COLUMNS_BLOCK];
+  double turned[NMEALIB_INFO_COLUMNS_BLOCK];
+  size_t i;
+
+  nmeaInfoColumnsAbs(columns, columns->pdop, NMEALIB_PRESENT_PDOP);
+  nmeaInfoColumnsAbs(columns, columns->hdop, NMEALIB_PRESENT_HDOP);
+  nmeaInfoColumnsAbs(columns, columns->vdop, NMEALIB_PRESENT_VDOP);
+  nmeaInfoColumnsAbs(columns, columns->dgpsAge, NMEALIB_PRESENT_DGPSAGE);
+
+  /*
+   * lat and lon: the first loops handle latitudes that are at most one turn
+   * out of range and longitudes that are at most one turn out of range
+   * after the latitude was handled, without branches
+   */
+
+  /* force lat in [-18000, 18000] */
+  for (i = 0; i < NMEALIB_INFO_COLUMNS_BLOCK; i++) {
+    double lat = columns->latitude[i];
+
+    wrapped[i] = (lat < -18000.0) ?
+        (lat + 36000.0) :
+        ((lat > 18000.0) ?
+            (lat - 36000.0) :
+            lat);
+  }
+
+  /* force lat in [-9000, 9000], unless it is still out of range */
+  for (i = 0; i < NMEALIB_INFO_COLUMNS_BLOCK; i++) {
+    uint32_t present = columns->present[i];
+    double original = columns->latitude[i];
+    double lat = wrapped[i];
+    double high = (lat > 18000.0) ?
+        lat :
+        (18000.0 - lat);
+    double low = (lat < -18000.0) ?
+        lat :
+        (-18000.0 - lat);
+
+    columns->latitude[i] = (present & NMEALIB_PRESENT_LAT) ?
+        ((lat > 9000.0) ?
+            high :
+            ((lat < -9000.0) ?
+                low :
+                lat)) :
+        original;
+  }
+
+  /* turn lon around when lat was forced in [-9000, 9000] */
+  for (i = 0; i < NMEALIB_INFO_COLUMNS_BLOCK; i++) {
+    uint32_t present = columns->present[i];
+    double lat = wrapped[i];
+    double lon = columns->longitude[i];
+    double lonTurned = lon + 18000.0;
+    double lonHigh = (lat > 18000.0) ?
+        lon :
+        lonTurned;
+    double lonLow = (lat < -18000.0) ?
+        lon :
+        lonTurned;
+
+    turned[i] = (present & NMEALIB_PRESENT_LAT) ?
+        ((lat > 9000.0) ?
+            lonHigh :
+            ((lat < -9000.0) ?
+                lonLow :
+                lon)) :
+        lon;
+  }
+
+  /* force lon in [-18000, 18000], unless lat is still out of range */
+  for (i = 0; i < NMEALIB_INFO_COLUMNS_BLOCK; i++) {
+    uint32_t present = columns->present[i];
+    double lat = wrapped[i];
+    double lon = turned[i];
+    double wlon = (lon < -18000.0) ?
+        (lon + 36000.0) :
+        ((lon > 18000.0) ?
+            (lon - 36000.0) :
+            lon);
+
+    columns->longitude[i] = ((present & NMEALIB_PRESENT_LON) //
+        && !((present & NMEALIB_PRESENT_LAT) && ((lat > 18000.0) || (lat < -18000.0)))) ?
+        wlon :
+        columns->longitude[i];
+  }
+
+  /* the values that are still out of range (which is rare) are handled as nmeaInfoSanitise does */
+  for (i = 0; i < columns->count; i++) {
+    uint32_t present = columns->present[i];
+    double lat = columns->latitude[i];
+    double lon = columns->longitude[i];
+
+    if ((present & NMEALIB_PRESENT_LAT) //
+        && ((lat < -18000.0) || (lat > 18000.0))) {
+      while (lat < -18000.0) {
+        lat += 36000.0;
+      }
+      while (lat > 18000.0) {
+        lat -= 36000.0;
+      }
+      if (lat > 9000.0) {
+        lat = 18000.0 - lat;
+        lon += 18000.0;
+      }
+      if (lat < -9000.0) {
+        lat = -18000.0 - lat;
+        lon += 18000.0;
+      }
+      columns->latitude[i] = lat;
+    }
+
+    if (present & NMEALIB_PRESENT_LON) {
+      while (lon < -18000.0) {
+        lon += 36000.0;
+      }
+      while (lon > 18000.0) {
+        lon -= 36000.0;
+      }
+      columns->longitude[i] = lon;
+    }
+  }
+
+  /* speed: a negative speed turns track and mtrack around */
+  for (i = 0; i < NMEALIB_INFO_COLUMNS_BLOCK; i++) {
+    uint32_t present = columns->present[i];
+    double speed = columns->speed[i];
+    double track = columns->track[i];
+    double mtrack = columns->mtrack[i];
+    double reversedTrack = (speed < 0.0) ?
+        (track + 180.0) :
+        track;
+    double reversedMtrack = (speed < 0.0) ?
+        (mtrack + 180.0) :
+        mtrack;
+
+    columns->speed[i] = (present & NMEALIB_PRESENT_SPEED) ?
+        ((speed < 0.0) ?
+            -speed :
+            speed) :
+        speed;
+    columns->track[i] = ((present & NMEALIB_PRESENT_SPEED) && (present & NMEALIB_PRESENT_TRACK)) ?
+        reversedTrack :
+        track;
+    columns->mtrack[i] = ((present & NMEALIB_PRESENT_SPEED) && (present & NMEALIB_PRESENT_MTRACK)) ?
+        reversedMtrack :
+        mtrack;
+  }
+
+  nmeaInfoColumnsWrap360(columns, columns->track, NMEALIB_PRESENT_TRACK);
+  nmeaInfoColumnsWrap360(columns, columns->mtrack, NMEALIB_PRESENT_MTRACK);
+  nmeaInfoColumnsWrap360(columns, columns->magvar, NMEALIB_PRESENT_MAGVAR);
+}
+
+/**
+ * Compact satellite PRNs in one linear pass: move the non-zero PRNs to the
+ * front (without reordering them) and put zeroes last
+ *
+ * @param prns The satellite PRNs
+ * @param count The number of satellite PRNs
+ */
+static void nmeaInfoCompactPRNs(unsigned int *prns, size_t count) {
+  size_t used = 0;
+  size_t i;
+
+  for (i = 0; i < count; i++) {
+    if (prns[i]) {
+      prns[used++] = prns[i];
+    }
+  }
+
+  for (i = used; i < count; i++) {
+    prns[i] = 0;
+  }
+}
+
+/**
+ * Compact satellites in one linear pass: move the satellites with a
+ * non-zero PRN to the front (without reordering them) and clear the rest
+ *
+ * @param satellites The satellites
+ * @param count The number of satellites
+ */
+static void nmeaInfoCompactSatellites(NmeaSatellite *satellites, size_t count) {
+  size_t used = 0;
+  size_t i;
+
+  for (i = 0; i < count; i++) {
+    if (satellites[i].prn) {
+      if (used != i) {
+        satellites[used] = satellites[i];
+      }
+      used++;
+    }
+  }
+
+  if (used < count) {
+    memset(&satellites[used], 0, (count - used) * sizeof(satellites[0]));
+  }
+}
+
+/**
+ * Sanitise the satellites in view of an NmeaInfo structure
+ *
+ * The satellites are sanitised in a copy that is then published, so that
+ * nmeaInfoSatellitesInViewSnapshot never copies a half sanitised table.
+ *
+ * @param info The NMEA info structure to sanitise
+ */
+static void nmeaInfoSanitiseSatellitesInView(NmeaInfo *info) {
+  NmeaSatellite inView[NMEALIB_MAX_SATELLITES];
+  size_t i;
+
+  memcpy(inView, info->satellites.inView, sizeof(inView));
+  nmeaInfoCompactSatellites(inView, NMEALIB_MAX_SATELLITES);
+
+  for (i = 0; i < NMEALIB_MAX_SATELLITES; i++) {
+    NmeaSatellite *sat = &inView[i];
+    if (!sat->prn) {
+      break;
+    }
+
+    /* force elv in [-180, 180] */
+    while (sat->elevation < -180) {
+      sat->elevation += 360;
+    }
+    while (sat->elevation > 180) {
+      sat->elevation -= 360;
+    }
+
+    /* elv is now in [-180, 180] */
+
+    /* force elv from <90, 180] in [90, 0] */
+    if (sat->elevation > 90) {
+      sat->elevation = 180 - sat->elevation;
+      sat->azimuth += 180;
+    }
+
+    /* force elv from [-180, -90> in [0, -90] */
+    if (sat->elevation < -90) {
+      sat->elevation = -180 - sat->elevation;
+      sat->azimuth += 180;
+    }
+
+    /* elv is now in [-90, 90] */
+
+    /* force azimuth in [0, 360> */
+    while (sat->azimuth >= 360) {
+      sat->azimuth -= 360;
+    }
+    /* azimuth is now in [0, 360> */
+
+    /* force snr in [0, 99] */
+    if (sat->snr > 99) {
+      sat->snr = 99;
+    }
+    /* snr is now in [0, 99] */
+  }
+
+  (void) nmeaInfoSatellitesInViewPublish(info, inView, info->satellites.inViewCount);
+}
+
+/**
+ * Sanitise fields of an NmeaInfo structure
+ *
+ * @param info The NMEA info structure to sanitise
+ * @param fields The NmeaPresence bits of the fields to sanitise
+ * @param skip The NmeaPresence bits of the (present) fields whose values
+ * must not be checked, because the caller checks them
+ */
+static void nmeaInfoSanitiseFields(NmeaInfo *info, uint32_t fields, uint32_t skip) {
   double lat = 0;
   double lon = 0;
   double speed = 0;
@@ -226,116 +966,120 @@ void nmeaInfoSanitise(NmeaInfo *info) {
   bool trackAdjusted = false;
   bool mtrackAdjusted = false;
   bool magvarAdjusted = false;
+  uint32_t reset;
+  uint32_t check;
   NmeaTime utc;
-  size_t i;
-
-  if (!info) {
-    return;
-  }
 
   /* convert back to non-metric */
   nmeaInfoUnitConversion(info, false);
 
+  reset = fields & ~info->present;
+
   /*
    * Reset to default when not present
    */
 
   /* no need to reset present; always present */
 
-  if (!nmeaInfoIsPresentAll(info->present, NMEALIB_PRESENT_SMASK)) {
+  if (reset & NMEALIB_PRESENT_SMASK) {
     info->smask = 0;
   }
 
-  nmeaTimeSet(&utc, NULL, NULL);
+  if (reset & (NMEALIB_PRESENT_UTCDATE | NMEALIB_PRESENT_UTCTIME)) {
+    nmeaTimeSet(&utc, NULL, NULL);
+  }
 
-  if (!nmeaInfoIsPresentAll(info->present, NMEALIB_PRESENT_UTCDATE)) {
+  if (reset & NMEALIB_PRESENT_UTCDATE) {
     info->utc.year = utc.year;
     info->utc.mon = utc.mon;
     info->utc.day = utc.day;
   }
 
-  if (!nmeaInfoIsPresentAll(info->present, NMEALIB_PRESENT_UTCTIME)) {
+  if (reset & NMEALIB_PRESENT_UTCTIME) {
     info->utc.hour = utc.hour;
     info->utc.min = utc.min;
     info->utc.sec = utc.sec;
     info->utc.hsec = utc.hsec;
   }
 
-  if (!nmeaInfoIsPresentAll(info->present, NMEALIB_PRESENT_SIG)) {
+  if (reset & NMEALIB_PRESENT_SIG) {
     info->sig = NMEALIB_SIG_INVALID;
   }
 
-  if (!nmeaInfoIsPresentAll(info->present, NMEALIB_PRESENT_FIX)) {
+  if (reset & NMEALIB_PRESENT_FIX) {
     info->fix = NMEALIB_FIX_BAD;
   }
 
-  if (!nmeaInfoIsPresentAll(info->present, NMEALIB_PRESENT_PDOP)) {
+  if (reset & NMEALIB_PRESENT_PDOP) {
     info->pdop = 0.0;
   }
 
-  if (!nmeaInfoIsPresentAll(info->present, NMEALIB_PRESENT_HDOP)) {
+  if (reset & NMEALIB_PRESENT_HDOP) {
     info->hdop = 0.0;
   }
 
-  if (!nmeaInfoIsPresentAll(info->present, NMEALIB_PRESENT_VDOP)) {
+  if (reset & NMEALIB_PRESENT_VDOP) {
     info->vdop = 0.0;
   }
 
-  if (!nmeaInfoIsPresentAll(info->present, NMEALIB_PRESENT_LAT)) {
+  if (reset & NMEALIB_PRESENT_LAT) {
     info->latitude = NMEALIB_LATITUDE_DEFAULT_NDEG;
   }
 
-  if (!nmeaInfoIsPresentAll(info->present, NMEALIB_PRESENT_LON)) {
+  if (reset & NMEALIB_PRESENT_LON) {
     info->longitude = NMEALIB_LONGITUDE_DEFAULT_NDEG;
   }
 
-  if (!nmeaInfoIsPresentAll(info->present, NMEALIB_PRESENT_ELV)) {
+  if (reset & NMEALIB_PRESENT_ELV) {
     info->elevation = 0.0;
   }
 
-  if (!nmeaInfoIsPresentAll(info->present, NMEALIB_PRESENT_HEIGHT)) {
+  if (reset & NMEALIB_PRESENT_HEIGHT) {
     info->height = 0.0;
   }
 
-  if (!nmeaInfoIsPresentAll(info->present, NMEALIB_PRESENT_SPEED)) {
+  if (reset & NMEALIB_PRESENT_SPEED) {
     info->speed = 0.0;
   }
 
-  if (!nmeaInfoIsPresentAll(info->present, NMEALIB_PRESENT_TRACK)) {
+  if (reset & NMEALIB_PRESENT_TRACK) {
     info->track = 0.0;
   }
 
-  if (!nmeaInfoIsPresentAll(info->present, NMEALIB_PRESENT_MTRACK)) {
+  if (reset & NMEALIB_PRESENT_MTRACK) {
     info->mtrack = 0.0;
   }
 
-  if (!nmeaInfoIsPresentAll(info->present, NMEALIB_PRESENT_MAGVAR)) {
+  if (reset & NMEALIB_PRESENT_MAGVAR) {
     info->magvar = 0.0;
   }
 
-  if (!nmeaInfoIsPresentAll(info->present, NMEALIB_PRESENT_DGPSAGE)) {
+  if (reset & NMEALIB_PRESENT_DGPSAGE) {
     info->dgpsAge = 0.0;
   }
 
-  if (!nmeaInfoIsPresentAll(info->present, NMEALIB_PRESENT_DGPSSID)) {
+  if (reset & NMEALIB_PRESENT_DGPSSID) {
     info->dgpsSid = 0;
   }
 
-  if (!nmeaInfoIsPresentAll(info->present, NMEALIB_PRESENT_SATINUSECOUNT)) {
+  if (reset & NMEALIB_PRESENT_SATINUSECOUNT) {
     info->satellites.inUseCount = 0;
   }
 
-  if (!nmeaInfoIsPresentAll(info->present, NMEALIB_PRESENT_SATINUSE)) {
+  if (reset & NMEALIB_PRESENT_SATINUSE) {
     memset(&info->satellites.inUse, 0, sizeof(info->satellites.inUse));
   }
 
-  if (!nmeaInfoIsPresentAll(info->present, NMEALIB_PRESENT_SATINVIEWCOUNT)) {
-    info->satellites.inViewCount = 0;
-  }
-
-  if (!info->progress.gpgsvInProgress //
-      && !nmeaInfoIsPresentAll(info->present, NMEALIB_PRESENT_SATINVIEW)) {
-    memset(&info->satellites.inView, 0, sizeof(info->satellites.inView));
+  if ((reset & NMEALIB_PRESENT_SATINVIEWCOUNT) //
+      || (!info->progress.gpgsvInProgress //
+          && (reset & NMEALIB_PRESENT_SATINVIEW))) {
+    (void) nmeaInfoSatellitesInViewPublish(info, //
+        (!info->progress.gpgsvInProgress && (reset & NMEALIB_PRESENT_SATINVIEW)) ?
+            NULL :
+            info->satellites.inView, //
+        (reset & NMEALIB_PRESENT_SATINVIEWCOUNT) ?
+            0 :
+            info->satellites.inViewCount);
   }
 
   /*
@@ -343,6 +1087,7 @@ void nmeaInfoSanitise(NmeaInfo *info) {
    */
 
   info->present = info->present & NMEALIB_INFO_PRESENT_MASK;
+  check = fields & info->present & ~skip;
 
   /*
    * smask
@@ -354,7 +1099,7 @@ void nmeaInfoSanitise(NmeaInfo *info) {
    * utc
    */
 
-  if (nmeaInfoIsPresentAll(info->present, NMEALIB_PRESENT_UTCDATE)) {
+  if (check & NMEALIB_PRESENT_UTCDATE) {
     if (info->utc.year < 1990) {
       info->utc.year = 1990;
     } else if (info->utc.year > 2189) {
@@ -372,7 +1117,7 @@ void nmeaInfoSanitise(NmeaInfo *info) {
     }
   }
 
-  if (nmeaInfoIsPresentAll(info->present, NMEALIB_PRESENT_UTCDATE)) {
+  if (check & NMEALIB_PRESENT_UTCDATE) {
     info->utc.hour = info->utc.hour % 24;
     info->utc.min = info->utc.min % 60;
     info->utc.sec = info->utc.sec % 61;
@@ -383,7 +1128,7 @@ void nmeaInfoSanitise(NmeaInfo *info) {
    * sig
    */
 
-  if (nmeaInfoIsPresentAll(info->present, NMEALIB_PRESENT_SIG)) {
+  if (check & NMEALIB_PRESENT_SIG) {
     if (info->sig > NMEALIB_SIG_LAST) {
       info->sig = NMEALIB_SIG_INVALID;
     }
@@ -393,7 +1138,7 @@ void nmeaInfoSanitise(NmeaInfo *info) {
    * fix
    */
 
-  if (nmeaInfoIsPresentAll(info->present, NMEALIB_PRESENT_FIX)) {
+  if (check & NMEALIB_PRESENT_FIX) {
     if ((info->fix < NMEALIB_FIX_FIRST) //
         || (info->fix > NMEALIB_FIX_LAST)) {
       info->fix = NMEALIB_FIX_BAD;
@@ -404,7 +1149,7 @@ void nmeaInfoSanitise(NmeaInfo *info) {
    * pdop
    */
 
-  if (nmeaInfoIsPresentAll(info->present, NMEALIB_PRESENT_PDOP)) {
+  if (check & NMEALIB_PRESENT_PDOP) {
     info->pdop = fabs(info->pdop);
   }
 
@@ -412,7 +1157,7 @@ void nmeaInfoSanitise(NmeaInfo *info) {
    * hdop
    */
 
-  if (nmeaInfoIsPresentAll(info->present, NMEALIB_PRESENT_HDOP)) {
+  if (check & NMEALIB_PRESENT_HDOP) {
     info->hdop = fabs(info->hdop);
   }
 
@@ -420,7 +1165,7 @@ void nmeaInfoSanitise(NmeaInfo *info) {
    * vdop
    */
 
-  if (nmeaInfoIsPresentAll(info->present, NMEALIB_PRESENT_VDOP)) {
+  if (check & NMEALIB_PRESENT_VDOP) {
     info->vdop = fabs(info->vdop);
   }
 
@@ -431,7 +1176,7 @@ void nmeaInfoSanitise(NmeaInfo *info) {
   lat = info->latitude;
   lon = info->longitude;
 
-  if (nmeaInfoIsPresentAll(info->present, NMEALIB_PRESENT_LAT)) {
+  if (check & NMEALIB_PRESENT_LAT) {
     /* force lat in [-18000, 18000] */
     while (lat < -18000.0) {
       lat += 36000.0;
@@ -471,7 +1216,7 @@ void nmeaInfoSanitise(NmeaInfo *info) {
    * lon
    */
 
-  if (nmeaInfoIsPresentAll(info->present, NMEALIB_PRESENT_LON)) {
+  if (check & NMEALIB_PRESENT_LON) {
     /* force lon in [-18000, 18000] */
     while (lon < -18000.0) {
       lon += 36000.0;
@@ -505,7 +1250,7 @@ void nmeaInfoSanitise(NmeaInfo *info) {
   track = info->track;
   mtrack = info->mtrack;
 
-  if (nmeaInfoIsPresentAll(info->present, NMEALIB_PRESENT_SPEED)) {
+  if (check & NMEALIB_PRESENT_SPEED) {
     if (speed < 0.0) {
       speed = -speed;
       track += 180.0;
@@ -526,7 +1271,7 @@ void nmeaInfoSanitise(NmeaInfo *info) {
    * track
    */
 
-  if (nmeaInfoIsPresentAll(info->present, NMEALIB_PRESENT_TRACK)) {
+  if (check & NMEALIB_PRESENT_TRACK) {
     /* force track in [0, 360> */
     while (track < 0.0) {
       track += 360.0;
@@ -548,7 +1293,7 @@ void nmeaInfoSanitise(NmeaInfo *info) {
    * mtrack
    */
 
-  if (nmeaInfoIsPresentAll(info->present, NMEALIB_PRESENT_MTRACK)) {
+  if (check & NMEALIB_PRESENT_MTRACK) {
     /* force mtrack in [0, 360> */
     while (mtrack < 0.0) {
       mtrack += 360.0;
@@ -570,7 +1315,7 @@ void nmeaInfoSanitise(NmeaInfo *info) {
    * magvar
    */
 
-  if (nmeaInfoIsPresentAll(info->present, NMEALIB_PRESENT_MAGVAR)) {
+  if (check & NMEALIB_PRESENT_MAGVAR) {
     magvar = info->magvar;
 
     /* force magvar in [0, 360> */
@@ -594,7 +1339,7 @@ void nmeaInfoSanitise(NmeaInfo *info) {
    * dgpsAge
    */
 
-  if (nmeaInfoIsPresentAll(info->present, NMEALIB_PRESENT_DGPSAGE)) {
+  if (check & NMEALIB_PRESENT_DGPSAGE) {
     info->dgpsAge = fabs(info->dgpsAge);
   }
 
@@ -610,62 +1355,131 @@ void nmeaInfoSanitise(NmeaInfo *info) {
 
   /* nothing to do for inUseCount */
 
-  if (nmeaInfoIsPresentAll(info->present, NMEALIB_PRESENT_SATINUSE)) {
-    qsort(info->satellites.inUse, NMEALIB_MAX_SATELLITES, sizeof(info->satellites.inUse[0]), nmeaQsortPRNCompact);
+  if (check & NMEALIB_PRESENT_SATINUSE) {
+    nmeaInfoCompactPRNs(info->satellites.inUse, NMEALIB_MAX_SATELLITES);
   }
 
   /* nothing to do for inViewCount */
 
-  if (nmeaInfoIsPresentAll(info->present, NMEALIB_PRESENT_SATINVIEW) //
+  if ((check & NMEALIB_PRESENT_SATINVIEW) //
       && !info->progress.gpgsvInProgress) {
-    qsort(info->satellites.inView, NMEALIB_MAX_SATELLITES, sizeof(info->satellites.inView[0]),
-        nmeaQsortSatelliteCompact);
+    nmeaInfoSanitiseSatellitesInView(info);
+  }
+}
 
-    for (i = 0; i < NMEALIB_MAX_SATELLITES; i++) {
-      NmeaSatellite *sat = &info->satellites.inView[i];
-      if (!sat->prn) {
-        break;
-      }
+void nmeaInfoSanitise(NmeaInfo *info) {
+  if (!info) {
+    return;
+  }
 
-      /* force elv in [-180, 180] */
-      while (sat->elevation < -180) {
-        sat->elevation += 360;
-      }
-      while (sat->elevation > 180) {
-        sat->elevation -= 360;
-      }
+  nmeaInfoSanitiseFields(info, NMEALIB_INFO_PRESENT_MASK, 0);
+}
+
+void nmeaInfoSanitiseChanged(NmeaInfo *info, uint32_t changed) {
+  if (!info) {
+    return;
+  }
 
-      /* elv is now in [-180, 180] */
+  /* fields that are sanitised together */
 
-      /* force elv from <90, 180] in [90, 0] */
-      if (sat->elevation > 90) {
-        sat->elevation = 180 - sat->elevation;
-        sat->azimuth += 180;
-      }
+  if (changed & (NMEALIB_PRESENT_UTCDATE | NMEALIB_PRESENT_UTCTIME)) {
+    changed |= NMEALIB_PRESENT_UTCDATE | NMEALIB_PRESENT_UTCTIME;
+  }
 
-      /* force elv from [-180, -90> in [0, -90] */
-      if (sat->elevation < -90) {
-        sat->elevation = -180 - sat->elevation;
-        sat->azimuth += 180;
-      }
+  if (changed & NMEALIB_PRESENT_LAT) {
+    changed |= NMEALIB_PRESENT_LON;
+  }
 
-      /* elv is now in [-90, 90] */
+  if (changed & NMEALIB_PRESENT_SPEED) {
+    changed |= NMEALIB_PRESENT_TRACK | NMEALIB_PRESENT_MTRACK;
+  }
 
-      /* force azimuth in [0, 360> */
-      while (sat->azimuth >= 360) {
-        sat->azimuth -= 360;
-      }
-      /* azimuth is now in [0, 360> */
+  nmeaInfoSanitiseFields(info, changed & NMEALIB_INFO_PRESENT_MASK, 0);
+}
 
-      /* force snr in [0, 99] */
-      if (sat->snr > 99) {
-        sat->snr = 99;
-      }
-      /* snr is now in [0, 99] */
+void nmeaInfoSanitiseBatch(NmeaInfo *infos, size_t count) {
+  NmeaInfoColumns columns;
+  size_t block;
+  size_t i;
+
+  if (!infos) {
+    return;
+  }
+
+  /* convert back to non-metric */
+  nmeaInfoUnitConversionBatch(infos, count, false);
+
+  for (block = 0; block < count; block += NMEALIB_INFO_COLUMNS_BLOCK) {
+    NmeaInfo *blockInfos = &infos[block];
+    size_t blockCount = MIN(NMEALIB_INFO_COLUMNS_BLOCK, count - block);
+
+    /* everything but the values of the column fields */
+    for (i = 0; i < blockCount; i++) {
+      nmeaInfoSanitiseFields(&blockInfos[i], NMEALIB_INFO_PRESENT_MASK, NMEALIB_INFO_COLUMNS_FIELDS);
     }
+
+    nmeaInfoColumnsGather(&columns, blockInfos, blockCount);
+    nmeaInfoColumnsSanitise(&columns);
+    nmeaInfoColumnsScatter(&columns, blockInfos);
   }
 }
 
+bool nmeaInfoSatellitesInViewPublish(NmeaInfo *info, const NmeaSatellite *inView, unsigned int inViewCount) {
+  static const NmeaSatellite none[NMEALIB_MAX_SATELLITES];
+  uint32_t sequence;
+
+  if (!info) {
+    return false;
+  }
+
+  if (!inView) {
+    inView = none;
+  }
+
+  if ((info->satellites.inViewCount == inViewCount) //
+      && ((inView == info->satellites.inView) //
+          || !memcmp(info->satellites.inView, inView, sizeof(info->satellites.inView)))) {
+    return false;
+  }
+
+  sequence = info->progress.gpgsvSequence;
+  __atomic_store_n(&info->progress.gpgsvSequence, sequence + 1, __ATOMIC_RELAXED);
+  __atomic_thread_fence(__ATOMIC_RELEASE);
+  info->satellites.inViewCount = inViewCount;
+  if (inView != info->satellites.inView) {
+    memcpy(info->satellites.inView, inView, sizeof(info->satellites.inView));
+  }
+  __atomic_store_n(&info->progress.gpgsvSequence, sequence + 2, __ATOMIC_RELEASE);
+
+  return true;
+}
+
+uint32_t nmeaInfoSatellitesInViewSnapshot(const NmeaInfo *info, NmeaSatellite *inView, unsigned int *inViewCount) {
+  unsigned int count;
+  uint32_t before;
+  uint32_t after;
+
+  if (!info //
+      || !inView) {
+    return 0;
+  }
+
+  do {
+    before = __atomic_load_n(&info->progress.gpgsvSequence, __ATOMIC_ACQUIRE);
+    count = info->satellites.inViewCount;
+    memcpy(inView, info->satellites.inView, sizeof(info->satellites.inView));
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    after = __atomic_load_n(&info->progress.gpgsvSequence, __ATOMIC_RELAXED);
+  } while ((before & 1) //
+      || (before != after));
+
+  if (inViewCount) {
+    *inViewCount = count;
+  }
+
+  return before;
+}
+
 void nmeaInfoUnitConversion(NmeaInfo *info, bool toMetric) {
   if (!info) {
     return;
@@ -733,6 +1547,45 @@ void nmeaInfoUnitConversion(NmeaInfo *info, bool toMetric) {
   info->metric = toMetric;
 }
 
+void nmeaInfoUnitConversionBatch(NmeaInfo *infos, size_t count, bool toMetric) {
+  NmeaInfoColumns columns;
+  double dopFactor = toMetric ?
+      NMEALIB_DOP_TO_METER :
+      NMEALIB_METER_TO_DOP;
+  size_t block;
+  size_t i;
+
+  if (!infos) {
+    return;
+  }
+
+  for (block = 0; block < count; block += NMEALIB_INFO_COLUMNS_BLOCK) {
+    NmeaInfo *blockInfos = &infos[block];
+    size_t blockCount = MIN(NMEALIB_INFO_COLUMNS_BLOCK, count - block);
+
+    nmeaInfoColumnsGather(&columns, blockInfos, blockCount);
+
+    /* info structures that are already in the requested format are not converted */
+    for (i = 0; i < blockCount; i++) {
+      if (blockInfos[i].metric == toMetric) {
+        columns.present[i] = 0;
+      }
+    }
+
+    nmeaInfoColumnsScale(&columns, columns.pdop, NMEALIB_PRESENT_PDOP, dopFactor);
+    nmeaInfoColumnsScale(&columns, columns.hdop, NMEALIB_PRESENT_HDOP, dopFactor);
+    nmeaInfoColumnsScale(&columns, columns.vdop, NMEALIB_PRESENT_VDOP, dopFactor);
+    nmeaInfoColumnsNdeg(&columns, columns.latitude, NMEALIB_PRESENT_LAT, toMetric);
+    nmeaInfoColumnsNdeg(&columns, columns.longitude, NMEALIB_PRESENT_LON, toMetric);
+
+    nmeaInfoColumnsScatter(&columns, blockInfos);
+
+    for (i = 0; i < blockCount; i++) {
+      blockInfos[i].metric = toMetric;
+    }
+  }
+}
+
 int nmeaQsortPRNCompare(const void *p1, const void *p2) {
   unsigned int prn1 = *((const unsigned int *) p1);
   unsigned int prn2 = *((const unsigned int *) p2);
@@ -17,6 +17,8 @@
 
 #include <nmealib/nmath.h>
 
+#include <nmealib/geodesic.h>
+
 #include <nmealib/util.h>
 #include <math.h>
 
@@ -100,6 +102,24 @@ void nmeaMathPositionToInfo(const NmeaPosition *pos, NmeaInfo *info) {
   nmeaInfoSetPresent(&info->present, NMEALIB_PRESENT_LAT | NMEALIB_PRESENT_LON);
 }
 
+void nmeaMathPositionPrepare(const NmeaPosition *pos, NmeaPositionPrepared *prepared) {
+  double U;
+
+  if (!pos //
+      || !prepared) {
+    return;
+  }
+
+  prepared->pos = *pos;
+  prepared->sinLat = sin(pos->lat);
+  prepared->cosLat = cos(pos->lat);
+  prepared->tanU = (1 - NMEALIB_EARTH_FLATTENING) * tan(pos->lat);
+
+  U = atan(prepared->tanU);
+  prepared->sinU = sin(U);
+  prepared->cosU = cos(U);
+}
+
 double nmeaMathDistance(const NmeaPosition *from, const NmeaPosition *to) {
   if (!from //
       || !to) {
@@ -115,15 +135,167 @@ double nmeaMathDistance(const NmeaPosition *from, const NmeaPosition *to) {
       + cos(to->lat) * cos(from->lat) * cos(to->lon - from->lon));
 }
 
+double nmeaMathDistancePrepared(const NmeaPositionPrepared *from, const NmeaPositionPrepared *to) {
+  if (!from //
+      || !to) {
+    return NaN;
+  }
+
+  if ((from->pos.lat == to->pos.lat) //
+      && (from->pos.lon == to->pos.lon)) {
+    return 0.0;
+  }
+
+  return ((double) NMEALIB_EARTHRADIUS_M) * acos(to->sinLat * from->sinLat //
+      + to->cosLat * from->cosLat * cos(to->pos.lon - from->pos.lon));
+}
+
+/*
+ * Vincenty inverse
+ */
+
+/** The number of position pairs that nmeaMathDistanceEllipsoidBatch iterates in lockstep */
+#define NMEALIB_MATH_BATCH_BLOCK (32u)
+
+/**
+ * The state of the Vincenty inverse iteration for one pair of positions
+ */
+typedef struct _NmeaMathVincenty {
+    double L;                /**< the difference in longitude                    */
+    double sin_U1;           /**< the sine of the reduced latitude of 'from'     */
+    double cos_U1;           /**< the cosine of the reduced latitude of 'from'   */
+    double sin_U2;           /**< the sine of the reduced latitude of 'to'       */
+    double cos_U2;           /**< the cosine of the reduced latitude of 'to'     */
+    double lambda;           /**< the difference in longitude on the sphere      */
+    double sin_lambda;       /**< the sine of lambda                             */
+    double cos_lambda;       /**< the cosine of lambda                           */
+    double delta_lambda;     /**< the change of lambda in the last iteration     */
+    double sigma;            /**< the angular distance on the sphere             */
+    double sin_sigma;        /**< the sine of sigma                              */
+    double cos_sigma;        /**< the cosine of sigma                            */
+    double cos_2_sigmam;     /**< the cosine of twice the midpoint angle         */
+    double sqr_cos_2_sigmam; /**< the square of cos_2_sigmam                     */
+    double sqr_cos_alpha;    /**< the square of the cosine of the azimuth at the equator */
+} NmeaMathVincenty;
+
+/**
+ * Initialise the Vincenty inverse iteration for a pair of (different)
+ * positions
+ *
+ * @param v The iteration state
+ * @param L The difference in longitude (in radians)
+ * @param sin_U1 The sine of the reduced latitude of the 'from' position
+ * @param cos_U1 The cosine of the reduced latitude of the 'from' position
+ * @param sin_U2 The sine of the reduced latitude of the 'to' position
+ * @param cos_U2 The cosine of the reduced latitude of the 'to' position
+ */
+static void nmeaMathVincentyInit(NmeaMathVincenty *v, double L, double sin_U1, double cos_U1, double sin_U2,
+    double cos_U2) {
+  v->L = L;
+  v->sin_U1 = sin_U1;
+  v->sin_U2 = sin_U2;
+  v->cos_U1 = cos_U1;
+  v->cos_U2 = cos_U2;
+
+  v->sigma = 0;
+  v->sin_sigma = sin(v->sigma);
+  v->cos_sigma = cos(v->sigma);
+  v->cos_2_sigmam = 0;
+  v->sqr_cos_2_sigmam = v->cos_2_sigmam * v->cos_2_sigmam;
+  v->sqr_cos_alpha = 0;
+  v->lambda = v->L;
+  v->sin_lambda = sin(v->lambda);
+  v->cos_lambda = cos(v->lambda);
+  v->delta_lambda = fabs(((double) 2.0 * (double) NMEALIB_PI) - v->lambda);
+}
+
+/**
+ * Initialise the Vincenty inverse iteration for a pair of (different)
+ * positions
+ *
+ * @param v The iteration state
+ * @param from The 'from' position (in radians)
+ * @param to The 'to' position (in radians)
+ */
+static void nmeaMathVincentyInitPositions(NmeaMathVincenty *v, const NmeaPosition *from, const NmeaPosition *to) {
+  double f = NMEALIB_EARTH_FLATTENING;
+  double U1 = atan((1 - f) * tan(from->lat));
+  double U2 = atan((1 - f) * tan(to->lat));
+
+  nmeaMathVincentyInit(v, to->lon - from->lon, sin(U1), cos(U1), sin(U2), cos(U2));
+}
+
+/**
+ * Perform one step of the Vincenty inverse iteration
+ *
+ * @param v The iteration state
+ */
+static void nmeaMathVincentyStep(NmeaMathVincenty *v) {
+  double f = NMEALIB_EARTH_FLATTENING;
+  double tmp1, tmp2, sin_alpha, cos_alpha, C, lambda_prev;
+
+  tmp1 = v->cos_U2 * v->sin_lambda;
+  tmp2 = v->cos_U1 * v->sin_U2 - v->sin_U1 * v->cos_U2 * v->cos_lambda;
+  v->sin_sigma = sqrt(tmp1 * tmp1 + tmp2 * tmp2);
+  v->cos_sigma = v->sin_U1 * v->sin_U2 + v->cos_U1 * v->cos_U2 * v->cos_lambda;
+  sin_alpha = v->cos_U1 * v->cos_U2 * v->sin_lambda / v->sin_sigma;
+  cos_alpha = cos(asin(sin_alpha));
+  v->sqr_cos_alpha = cos_alpha * cos_alpha;
+  v->cos_2_sigmam = v->cos_sigma - 2 * v->sin_U1 * v->sin_U2 / v->sqr_cos_alpha;
+  v->sqr_cos_2_sigmam = v->cos_2_sigmam * v->cos_2_sigmam;
+  C = f / 16 * v->sqr_cos_alpha * (4 + f * (4 - 3 * v->sqr_cos_alpha));
+  lambda_prev = v->lambda;
+  v->sigma = asin(v->sin_sigma);
+  v->lambda = v->L
+      + (1 - C) * f * sin_alpha
+          * (v->sigma + C * v->sin_sigma * (v->cos_2_sigmam + C * v->cos_sigma * (-1 + 2 * v->sqr_cos_2_sigmam)));
+  v->delta_lambda = fabs(lambda_prev - v->lambda);
+  v->sin_lambda = sin(v->lambda);
+  v->cos_lambda = cos(v->lambda);
+}
+
+/**
+ * Calculate the result of the Vincenty inverse iteration
+ *
+ * @param v The iteration state
+ * @param fromAzimuth The azimuth at 'from' position (in radians), can be NULL
+ * @param toAzimuth The azimuth at 'to' position (in radians), can be NULL
+ * @return Distance in meters
+ */
+static double nmeaMathVincentyResult(const NmeaMathVincenty *v, double *fromAzimuth, double *toAzimuth) {
+  double f = NMEALIB_EARTH_FLATTENING;
+  double a = NMEALIB_EARTH_SEMIMAJORAXIS_M;
+  double b = (1 - f) * a;
+  double sqr_a = a * a;
+  double sqr_b = b * b;
+  double sqr_u, A, B, delta_sigma;
+
+  sqr_u = v->sqr_cos_alpha * (sqr_a - sqr_b) / sqr_b;
+  A = 1 + sqr_u / 16384 * (4096 + sqr_u * (-768 + sqr_u * (320 - 175 * sqr_u)));
+  B = sqr_u / 1024 * (256 + sqr_u * (-128 + sqr_u * (74 - 47 * sqr_u)));
+  delta_sigma = B * v->sin_sigma
+      * (v->cos_2_sigmam
+          + B / 4
+              * (v->cos_sigma * (-1 + 2 * v->sqr_cos_2_sigmam)
+                  - B / 6 * v->cos_2_sigmam * (-3 + 4 * v->sin_sigma * v->sin_sigma)
+                      * (-3 + 4 * v->sqr_cos_2_sigmam)));
+
+  if (fromAzimuth) {
+    double tan_alpha_1 = v->cos_U2 * v->sin_lambda / (v->cos_U1 * v->sin_U2 - v->sin_U1 * v->cos_U2 * v->cos_lambda);
+    *fromAzimuth = atan(tan_alpha_1);
+  }
+  if (toAzimuth) {
+    double tan_alpha_2 = v->cos_U1 * v->sin_lambda / (-v->sin_U1 * v->cos_U2 + v->cos_U1 * v->sin_U2 * v->cos_lambda);
+    *toAzimuth = atan(tan_alpha_2);
+  }
+
+  return b * A * (v->sigma - delta_sigma);
+}
+
 double nmeaMathDistanceEllipsoid(const NmeaPosition *from, const NmeaPosition *to, double *fromAzimuth,
     double *toAzimuth) {
-  /* All variables */
-  double f, a, b, sqr_a, sqr_b;
-  double L, phi1, phi2, U1, U2, sin_U1, sin_U2, cos_U1, cos_U2;
-  double sigma, sin_sigma, cos_sigma, cos_2_sigmam, sqr_cos_2_sigmam, sqr_cos_alpha, lambda, sin_lambda, cos_lambda,
-      delta_lambda;
+  NmeaMathVincenty v;
   int remaining_steps;
-  double sqr_u, A, B, delta_sigma, lambda_prev;
 
   if (!from //
       || !to) {
@@ -142,99 +314,302 @@ double nmeaMathDistanceEllipsoid(const NmeaPosition *from, const NmeaPosition *t
     return 0.0;
   }
 
-  /* Earth geometry */
-  f = NMEALIB_EARTH_FLATTENING;
-  a = NMEALIB_EARTH_SEMIMAJORAXIS_M;
-  b = (1 - f) * a;
-  sqr_a = a * a;
-  sqr_b = b * b;
+  nmeaMathVincentyInitPositions(&v, from, to);
 
-  /* Calculation */
-  L = to->lon - from->lon;
-  phi1 = from->lat;
-  phi2 = to->lat;
-  U1 = atan((1 - f) * tan(phi1));
-  U2 = atan((1 - f) * tan(phi2));
-  sin_U1 = sin(U1);
-  sin_U2 = sin(U2);
-  cos_U1 = cos(U1);
-  cos_U2 = cos(U2);
+  for (remaining_steps = 20; (v.delta_lambda > 1e-12) && (remaining_steps > 0); remaining_steps--) {
+    nmeaMathVincentyStep(&v);
+  }
 
-  /* Initialize iteration */
-  sigma = 0;
-  sin_sigma = sin(sigma);
-  cos_sigma = cos(sigma);
-  cos_2_sigmam = 0;
-  sqr_cos_2_sigmam = cos_2_sigmam * cos_2_sigmam;
-  sqr_cos_alpha = 0;
-  lambda = L;
-  sin_lambda = sin(lambda);
-  cos_lambda = cos(lambda);
-  lambda_prev = (double) 2.0 * (double) NMEALIB_PI;
-  delta_lambda = lambda_prev - lambda;
-  if (delta_lambda < 0) {
-    delta_lambda = -delta_lambda;
+  return nmeaMathVincentyResult(&v, fromAzimuth, toAzimuth);
+}
+
+double nmeaMathDistanceEllipsoidPrepared(const NmeaPositionPrepared *from, const NmeaPositionPrepared *to,
+    double *fromAzimuth, double *toAzimuth) {
+  NmeaMathVincenty v;
+  int remaining_steps;
+
+  if (!from //
+      || !to) {
+    return NaN;
   }
-  remaining_steps = 20;
 
-  while ((delta_lambda > 1e-12) && (remaining_steps > 0)) {
-    double tmp1, tmp2, sin_alpha, cos_alpha, C;
-
-    /* Calculation */
-    tmp1 = cos_U2 * sin_lambda;
-    tmp2 = cos_U1 * sin_U2 - sin_U1 * cos_U2 * cos_lambda;
-    sin_sigma = sqrt(tmp1 * tmp1 + tmp2 * tmp2);
-    cos_sigma = sin_U1 * sin_U2 + cos_U1 * cos_U2 * cos_lambda;
-    sin_alpha = cos_U1 * cos_U2 * sin_lambda / sin_sigma;
-    cos_alpha = cos(asin(sin_alpha));
-    sqr_cos_alpha = cos_alpha * cos_alpha;
-    cos_2_sigmam = cos_sigma - 2 * sin_U1 * sin_U2 / sqr_cos_alpha;
-    sqr_cos_2_sigmam = cos_2_sigmam * cos_2_sigmam;
-    C = f / 16 * sqr_cos_alpha * (4 + f * (4 - 3 * sqr_cos_alpha));
-    lambda_prev = lambda;
-    sigma = asin(sin_sigma);
-    lambda = L
-        + (1 - C) * f * sin_alpha
-            * (sigma + C * sin_sigma * (cos_2_sigmam + C * cos_sigma * (-1 + 2 * sqr_cos_2_sigmam)));
-    delta_lambda = lambda_prev - lambda;
-    if (delta_lambda < 0)
-      delta_lambda = -delta_lambda;
-    sin_lambda = sin(lambda);
-    cos_lambda = cos(lambda);
-    remaining_steps--;
+  if ((from->pos.lat == to->pos.lat) //
+      && (from->pos.lon == to->pos.lon)) {
+    if (fromAzimuth) {
+      *fromAzimuth = 0.0;
+    }
+    if (toAzimuth) {
+      *toAzimuth = 0.0;
+    }
+
+    return 0.0;
   }
 
-  /* More calculation  */
-  sqr_u = sqr_cos_alpha * (sqr_a - sqr_b) / sqr_b;
-  A = 1 + sqr_u / 16384 * (4096 + sqr_u * (-768 + sqr_u * (320 - 175 * sqr_u)));
-  B = sqr_u / 1024 * (256 + sqr_u * (-128 + sqr_u * (74 - 47 * sqr_u)));
-  delta_sigma = B * sin_sigma
-      * (cos_2_sigmam
-          + B / 4
-              * (cos_sigma * (-1 + 2 * sqr_cos_2_sigmam)
-                  - B / 6 * cos_2_sigmam * (-3 + 4 * sin_sigma * sin_sigma) * (-3 + 4 * sqr_cos_2_sigmam)));
+  nmeaMathVincentyInit(&v, to->pos.lon - from->pos.lon, from->sinU, from->cosU, to->sinU, to->cosU);
 
-  /* Calculate result */
-  if (fromAzimuth) {
-    double tan_alpha_1 = cos_U2 * sin_lambda / (cos_U1 * sin_U2 - sin_U1 * cos_U2 * cos_lambda);
-    *fromAzimuth = atan(tan_alpha_1);
+  for (remaining_steps = 20; (v.delta_lambda > 1e-12) && (remaining_steps > 0); remaining_steps--) {
+    nmeaMathVincentyStep(&v);
   }
-  if (toAzimuth) {
-    double tan_alpha_2 = cos_U1 * sin_lambda / (-sin_U1 * cos_U2 + cos_U1 * sin_U2 * cos_lambda);
-    *toAzimuth = atan(tan_alpha_2);
+
+  return nmeaMathVincentyResult(&v, fromAzimuth, toAzimuth);
+}
+
+void nmeaMathDistanceEllipsoidBatch(const NmeaPosition *from, const NmeaPosition *to, size_t count,
+    double *distances, double *fromAzimuths, double *toAzimuths) {
+  NmeaMathVincenty lanes[NMEALIB_MATH_BATCH_BLOCK];
+  size_t active[NMEALIB_MATH_BATCH_BLOCK];
+  size_t first;
+
+  if (!from //
+      || !to //
+      || !distances) {
+    return;
   }
 
-  return b * A * (sigma - delta_sigma);
+  for (first = 0; first < count; first += NMEALIB_MATH_BATCH_BLOCK) {
+    size_t n = MIN(NMEALIB_MATH_BATCH_BLOCK, count - first);
+    size_t activeCount = 0;
+    int remaining_steps;
+    size_t i;
+
+    for (i = 0; i < n; i++) {
+      const NmeaPosition *f = &from[first + i];
+      const NmeaPosition *t = &to[first + i];
+
+      if ((f->lat == t->lat) //
+          && (f->lon == t->lon)) {
+        continue;
+      }
+
+      nmeaMathVincentyInitPositions(&lanes[i], f, t);
+      active[activeCount++] = i;
+    }
+
+    /* iterate the lanes in lockstep, dropping the lanes that converged */
+    for (remaining_steps = 20; activeCount && (remaining_steps > 0); remaining_steps--) {
+      size_t remaining = 0;
+
+      for (i = 0; i < activeCount; i++) {
+        NmeaMathVincenty *v = &lanes[active[i]];
+
+        if (v->delta_lambda > 1e-12) {
+          nmeaMathVincentyStep(v);
+          active[remaining++] = active[i];
+        }
+      }
+
+      activeCount = remaining;
+    }
+
+    for (i = 0; i < n; i++) {
+      const NmeaPosition *f = &from[first + i];
+      const NmeaPosition *t = &to[first + i];
+      double *fromAzimuth = fromAzimuths ?
+          &fromAzimuths[first + i] :
+          NULL;
+      double *toAzimuth = toAzimuths ?
+          &toAzimuths[first + i] :
+          NULL;
+
+      if ((f->lat == t->lat) //
+          && (f->lon == t->lon)) {
+        distances[first + i] = 0.0;
+        if (fromAzimuth) {
+          *fromAzimuth = 0.0;
+        }
+        if (toAzimuth) {
+          *toAzimuth = 0.0;
+        }
+        continue;
+      }
+
+      distances[first + i] = nmeaMathVincentyResult(&lanes[i], fromAzimuth, toAzimuth);
+    }
+  }
 }
 
-bool nmeaMathMoveFlat(const NmeaPosition *from, NmeaPosition *to, double azimuth, double distance) {
-  NmeaPosition pos;
+/*
+ * Distance approximations
+ */
+
+/** The mean radius (2a + b) / 3 of the WGS84 ellipsoid */
+#define NMEALIB_MATH_MEAN_RADIUS_M \
+  (((double) NMEALIB_EARTHRADIUS_M * (3.0 - NMEALIB_EARTH_FLATTENING)) / 3.0)
+
+/** The squared eccentricity of the WGS84 ellipsoid */
+#define NMEALIB_MATH_ECCENTRICITY2 (NMEALIB_EARTH_FLATTENING * (2.0 - NMEALIB_EARTH_FLATTENING))
+
+/**
+ * The maximum relative errors of the distance modes versus
+ * nmeaGeodesicInverse for distances up to a range, for latitudes up to
+ * 80 degrees (measured, rounded up)
+ */
+static const struct {
+    double range;                                  /**< the range in meters            */
+    double error[NMEALIB_MATH_DISTANCE_MODE_COUNT]; /**< the maximum relative errors    */
+} nmeaMathDistanceErrors[] = {
+    {     100.0, { 0.006, 2e-8, 0.006, 1.0, 0.0034, 0.0 } },
+    {    1000.0, { 0.006, 4e-8, 0.006, 1.0, 0.0034, 0.0 } },
+    {   10000.0, { 0.006, 4e-6, 0.006, 1.0, 0.0034, 0.0 } },
+    {  100000.0, { 0.006, 4e-4, 0.006, 1.0, 0.0034, 0.0 } },
+    { 1000000.0, { 0.026, 0.03, 0.006, 1.0, 0.0034, 0.0 } }
+};
+
+/**
+ * Normalise a difference in longitude into [-pi, pi]
+ *
+ * @param dlon The difference in longitude (in radians)
+ * @return The normalised difference in longitude (in radians)
+ */
+static INLINE double nmeaMathLongitudeDelta(double dlon) {
+  if (dlon > NMEALIB_PI) {
+    dlon -= 2.0 * NMEALIB_PI;
+  } else if (dlon < -NMEALIB_PI) {
+    dlon += 2.0 * NMEALIB_PI;
+  }
+
+  return dlon;
+}
+
+double nmeaMathDistanceEquirectangular(const NmeaPosition *from, const NmeaPosition *to) {
+  double x;
+  double y;
 
   if (!from //
       || !to) {
-    return false;
+    return NaN;
+  }
+
+  x = nmeaMathLongitudeDelta(to->lon - from->lon) * cos(0.5 * (from->lat + to->lat));
+  y = to->lat - from->lat;
+
+  return NMEALIB_MATH_MEAN_RADIUS_M * sqrt(x * x + y * y);
+}
+
+double nmeaMathDistanceHaversine(const NmeaPosition *from, const NmeaPosition *to) {
+  if (!from //
+      || !to) {
+    return NaN;
+  }
+
+  return nmeaMathDistanceHaversineCached(from, cos(from->lat), to, cos(to->lat));
+}
+
+double nmeaMathDistanceHaversineCached(const NmeaPosition *from, double cosFromLat, const NmeaPosition *to,
+    double cosToLat) {
+  double sinHalfDlat;
+  double sinHalfDlon;
+  double h;
+
+  if (!from //
+      || !to) {
+    return NaN;
+  }
+
+  sinHalfDlat = sin(0.5 * (to->lat - from->lat));
+  sinHalfDlon = sin(0.5 * (to->lon - from->lon));
+  h = sinHalfDlat * sinHalfDlat + cosFromLat * cosToLat * sinHalfDlon * sinHalfDlon;
+
+  return 2.0 * NMEALIB_MATH_MEAN_RADIUS_M * asin(sqrt(MIN(h, 1.0)));
+}
+
+double nmeaMathDistanceHaversinePrepared(const NmeaPositionPrepared *from, const NmeaPositionPrepared *to) {
+  if (!from //
+      || !to) {
+    return NaN;
+  }
+
+  return nmeaMathDistanceHaversineCached(&from->pos, from->cosLat, &to->pos, to->cosLat);
+}
+
+double nmeaMathDistanceTangentPlane(const NmeaPosition *from, const NmeaPosition *to) {
+  double a = (double) NMEALIB_EARTHRADIUS_M;
+  double e2 = NMEALIB_MATH_ECCENTRICITY2;
+  double lat;
+  double sinLat;
+  double w2;
+  double w;
+  double north;
+  double east;
+
+  if (!from //
+      || !to) {
+    return NaN;
   }
 
+  /* the meridional and prime vertical radii of curvature at the mean latitude */
+  lat = 0.5 * (from->lat + to->lat);
+  sinLat = sin(lat);
+  w2 = 1.0 - e2 * sinLat * sinLat;
+  w = sqrt(w2);
+
+  north = (a * (1.0 - e2) / (w2 * w)) * (to->lat - from->lat);
+  east = (a / w) * cos(lat) * nmeaMathLongitudeDelta(to->lon - from->lon);
+
+  return sqrt(north * north + east * east);
+}
+
+double nmeaMathDistanceWithMode(const NmeaPosition *from, const NmeaPosition *to, NmeaMathDistanceMode mode) {
+  switch (mode) {
+    case NMEALIB_MATH_DISTANCE_EQUIRECTANGULAR:
+      return nmeaMathDistanceEquirectangular(from, to);
+
+    case NMEALIB_MATH_DISTANCE_TANGENTPLANE:
+      return nmeaMathDistanceTangentPlane(from, to);
+
+    case NMEALIB_MATH_DISTANCE_HAVERSINE:
+      return nmeaMathDistanceHaversine(from, to);
+
+    case NMEALIB_MATH_DISTANCE_GREATCIRCLE:
+      return nmeaMathDistance(from, to);
+
+    case NMEALIB_MATH_DISTANCE_ELLIPSOID:
+      return nmeaMathDistanceEllipsoid(from, to, NULL, NULL);
+
+    case NMEALIB_MATH_DISTANCE_GEODESIC:
+    case NMEALIB_MATH_DISTANCE_MODE_COUNT:
+    default:
+      return nmeaGeodesicInverse(from, to, NULL, NULL);
+  }
+}
+
+NmeaMathDistanceMode nmeaMathDistanceModeSelect(double range, double maxError) {
+  size_t i;
+  size_t mode;
+
+  for (i = 0; i < (sizeof(nmeaMathDistanceErrors) / sizeof(nmeaMathDistanceErrors[0])); i++) {
+    if (range > nmeaMathDistanceErrors[i].range) {
+      continue;
+    }
+
+    /* the modes are ordered by cost */
+    for (mode = 0; mode < NMEALIB_MATH_DISTANCE_GEODESIC; mode++) {
+      if (nmeaMathDistanceErrors[i].error[mode] <= maxError) {
+        return (NmeaMathDistanceMode) mode;
+      }
+    }
+
+    break;
+  }
+
+  return NMEALIB_MATH_DISTANCE_GEODESIC;
+}
+
+/**
+ * Perform a flat (horizontal) move
+ *
+ * @param from The 'from' position (in radians)
+ * @param sinLat The sine of the latitude of the 'from' position
+ * @param cosLat The cosine of the latitude of the 'from' position
+ * @param to The 'to' position (in radians)
+ * @param azimuth Azimuth (in degrees, [0, 359])
+ * @param distance The distance (in km)
+ * @return True on success
+ */
+static bool nmeaMathMoveFlatTrig(const NmeaPosition *from, double sinLat, double cosLat, NmeaPosition *to,
+    double azimuth, double distance) {
+  NmeaPosition pos;
+
   if (isNaN(from->lat) //
       || isNaN(from->lon)) {
     to->lat = NaN;
@@ -246,27 +621,51 @@ bool nmeaMathMoveFlat(const NmeaPosition *from, NmeaPosition *to, double azimuth
   distance /= NMEALIB_EARTHRADIUS_KM; /* Angular distance covered on earth's surface */
   azimuth = nmeaMathDegreeToRadian(azimuth);
 
-  to->lat = asin(sin(pos.lat) * cos(distance) + cos(pos.lat) * sin(distance) * cos(azimuth));
-  to->lon = pos.lon + atan2(sin(azimuth) * sin(distance) * cos(pos.lat), cos(distance) - sin(pos.lat) * sin(to->lat));
+  to->lat = asin(sinLat * cos(distance) + cosLat * sin(distance) * cos(azimuth));
+  to->lon = pos.lon + atan2(sin(azimuth) * sin(distance) * cosLat, cos(distance) - sinLat * sin(to->lat));
 
   return true;
 }
 
-bool nmeaMathMoveFlatEllipsoid(const NmeaPosition *from, NmeaPosition *to, double azimuth, double distance,
-    double *toAzimuth) {
+bool nmeaMathMoveFlat(const NmeaPosition *from, NmeaPosition *to, double azimuth, double distance) {
+  if (!from //
+      || !to) {
+    return false;
+  }
+
+  return nmeaMathMoveFlatTrig(from, sin(from->lat), cos(from->lat), to, azimuth, distance);
+}
+
+bool nmeaMathMoveFlatPrepared(const NmeaPositionPrepared *from, NmeaPosition *to, double azimuth, double distance) {
+  if (!from //
+      || !to) {
+    return false;
+  }
+
+  return nmeaMathMoveFlatTrig(&from->pos, from->sinLat, from->cosLat, to, azimuth, distance);
+}
+
+/**
+ * Perform a flat (horizontal) move against the ellipsoid
+ *
+ * @param from The 'from' position (in radians)
+ * @param tan_U1 The tangent of the reduced latitude of the 'from' position
+ * @param to The 'to' position (in radians)
+ * @param azimuth Azimuth (in radians)
+ * @param distance The distance (in km)
+ * @param toAzimuth Azimuth at end position (in radians)
+ * @return True on success
+ */
+static bool nmeaMathMoveFlatEllipsoidReduced(const NmeaPosition *from, double tan_U1, NmeaPosition *to,
+    double azimuth, double distance, double *toAzimuth) {
   /* Variables */
   double f, a, b, sqr_a, sqr_b;
-  double phi1, tan_U1, sin_U1, cos_U1, s, alpha1, sin_alpha1, cos_alpha1;
+  double sin_U1, cos_U1, s, alpha1, sin_alpha1, cos_alpha1;
   double sigma1, sin_alpha, sqr_cos_alpha, sqr_u, A, B;
   double sigma_initial, sigma, sigma_prev, sin_sigma, cos_sigma, cos_2_sigmam, sqr_cos_2_sigmam, delta_sigma;
   int remaining_steps;
   double tmp1, phi2, lambda, C, L;
 
-  if (!from //
-      || !to) {
-    return false;
-  }
-
   if (isNaN(from->lat) //
       || isNaN(from->lon)) {
     to->lat = NaN;
@@ -295,8 +694,6 @@ bool nmeaMathMoveFlatEllipsoid(const NmeaPosition *from, NmeaPosition *to, doubl
   sqr_b = b * b;
 
   /* Calculation */
-  phi1 = from->lat;
-  tan_U1 = (1 - f) * tan(phi1);
   cos_U1 = 1 / sqrt(1 + tan_U1 * tan_U1);
   sin_U1 = tan_U1 * cos_U1;
   s = distance;
@@ -355,3 +752,24 @@ bool nmeaMathMoveFlatEllipsoid(const NmeaPosition *from, NmeaPosition *to, doubl
 
   return true;
 }
+
+bool nmeaMathMoveFlatEllipsoid(const NmeaPosition *from, NmeaPosition *to, double azimuth, double distance,
+    double *toAzimuth) {
+  if (!from //
+      || !to) {
+    return false;
+  }
+
+  return nmeaMathMoveFlatEllipsoidReduced(from, (1 - NMEALIB_EARTH_FLATTENING) * tan(from->lat), to, azimuth,
+      distance, toAzimuth);
+}
+
+bool nmeaMathMoveFlatEllipsoidPrepared(const NmeaPositionPrepared *from, NmeaPosition *to, double azimuth,
+    double distance, double *toAzimuth) {
+  if (!from //
+      || !to) {
+    return false;
+  }
+
+  return nmeaMathMoveFlatEllipsoidReduced(&from->pos, from->tanU, to, azimuth, distance, toAzimuth);
+}
@@ -28,7 +28,6 @@
 
 void nmeaParserReset(NmeaParser *parser, NmeaParserSentenceState new_state);
 bool nmeaParserIsHexCharacter(char c);
-bool nmeaParserProcessCharacter(NmeaParser *parser, const char *c);
 
 bool nmeaParserIsHexCharacter(char c) {
   switch (tolower(c)) {
@@ -82,6 +81,7 @@ bool nmeaParserInit(NmeaParser *parser, size_t sz) {
     return false;
   }
 
+  memset(&parser->gpgsv, 0, sizeof(parser->gpgsv));
   nmeaParserReset(parser, NMEALIB_SENTENCE_STATE_SKIP_UNTIL_START);
   return true;
 }
@@ -207,9 +207,14 @@ bool nmeaParserProcessCharacter(NmeaParser *parser, const char *c) {
   return false;
 }
 
-size_t nmeaParserParse(NmeaParser *parser, const char *s, size_t sz, NmeaInfo *info) {
+size_t nmeaParserParse(NmeaParser *parser, const char *s, size_t sz, NmeaInfo *info, uint32_t *changed) {
   size_t sentences_count = 0;
   size_t charIndex = 0;
+  uint32_t changedAll = 0;
+
+  if (changed) {
+    *changed = 0;
+  }
 
   if (!parser //
       || !s //
@@ -222,11 +227,18 @@ size_t nmeaParserParse(NmeaParser *parser, const char *s, size_t sz, NmeaInfo *i
   for (charIndex = 0; charIndex < sz; charIndex++) {
     bool sentence_read_successfully = nmeaParserProcessCharacter(parser, &s[charIndex]);
     if (sentence_read_successfully) {
-      if (nmeaSentenceToInfo(parser->buffer, parser->bufferLength, info)) {
+      NmeaSentencePack pack;
+
+      if (nmeaSentenceParse(parser->buffer, parser->bufferLength, &pack)) {
+        changedAll |= nmeaSentencePackToInfo(&pack, info, &parser->gpgsv);
         sentences_count++;
       }
     }
   }
 
+  if (changed) {
+    *changed = changedAll;
+  }
+
   return sentences_count;
 }
@@ -0,0 +1,106 @@
+/*
+ * This file is part of nmealib.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <nmealib/publisher.h>
+
+#include <string.h>
+
+void nmeaInfoPublisherInit(NmeaInfoPublisher *publisher) {
+  if (!publisher) {
+    return;
+  }
+
+  memset(publisher, 0, sizeof(*publisher));
+  nmeaInfoClear(&publisher->info);
+}
+
+void nmeaInfoPublisherPublish(NmeaInfoPublisher *publisher, const NmeaInfo *info) {
+  uint32_t sequence;
+
+  if (!publisher //
+      || !info) {
+    return;
+  }
+
+  sequence = __atomic_load_n(&publisher->sequence, __ATOMIC_RELAXED);
+
+  __atomic_store_n(&publisher->sequence, sequence + 1, __ATOMIC_RELAXED);
+  __atomic_thread_fence(__ATOMIC_RELEASE);
+  memcpy(&publisher->info, info, sizeof(publisher->info));
+  __atomic_store_n(&publisher->sequence, sequence + 2, __ATOMIC_RELEASE);
+}
+
+uint32_t nmeaInfoPublisherSequence(const NmeaInfoPublisher *publisher) {
+  if (!publisher) {
+    return 0;
+  }
+
+  return __atomic_load_n(&publisher->sequence, __ATOMIC_ACQUIRE);
+}
+
+uint32_t nmeaInfoPublisherSnapshot(const NmeaInfoPublisher *publisher, NmeaInfo *info) {
+  uint32_t before;
+  uint32_t after;
+
+  if (!publisher //
+      || !info) {
+    return 0;
+  }
+
+  do {
+    before = __atomic_load_n(&publisher->sequence, __ATOMIC_ACQUIRE);
+    memcpy(info, &publisher->info, sizeof(*info));
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    after = __atomic_load_n(&publisher->sequence, __ATOMIC_RELAXED);
+  } while ((before & 1) //
+      || (before != after));
+
+  return before;
+}
+
+bool nmeaInfoPublisherTrySnapshot(const NmeaInfoPublisher *publisher, NmeaInfo *info, unsigned int attempts,
+    uint32_t *sequence) {
+  uint32_t before;
+  uint32_t after;
+
+  if (!publisher //
+      || !info) {
+    return false;
+  }
+
+  while (attempts) {
+    attempts--;
+
+    before = __atomic_load_n(&publisher->sequence, __ATOMIC_ACQUIRE);
+    if (before & 1) {
+      continue;
+    }
+
+    memcpy(info, &publisher->info, sizeof(*info));
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    after = __atomic_load_n(&publisher->sequence, __ATOMIC_RELAXED);
+    if (before == after) {
+      if (sequence) {
+        *sequence = before;
+      }
+
+      return true;
+    }
+  }
+
+  return false;
+}
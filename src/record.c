@@ -0,0 +1,636 @@
+/*
+ * This file is part of nmealib.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <nmealib/record.h>
+
+#include <nmealib/context.h>
+#include <nmealib/nmath.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/** The number of records that a writer buffers */
+#define NMEALIB_RECORD_WRITER_BUFFER (64u)
+
+/**
+ * Record file writer
+ */
+struct _NmeaRecordWriter {
+    int     fd;                                                          /**< the file descriptor          */
+    size_t  buffered;                                                    /**< the number of records in buf */
+    uint8_t buf[NMEALIB_RECORD_WRITER_BUFFER * NMEALIB_RECORD_SIZE];     /**< the buffered records         */
+};
+
+/**
+ * Record file reader
+ */
+struct _NmeaRecordFile {
+    const uint8_t *mapping; /**< the mapping of the file        */
+    size_t         size;    /**< the size of the mapping        */
+    size_t         count;   /**< the number of (whole) records  */
+};
+
+/*
+ * Little-endian encoding
+ */
+
+static void nmeaRecordPut16(uint8_t **p, uint16_t v) {
+  (*p)[0] = (uint8_t) v;
+  (*p)[1] = (uint8_t) (v >> 8);
+  *p += 2;
+}
+
+static void nmeaRecordPut32(uint8_t **p, uint32_t v) {
+  (*p)[0] = (uint8_t) v;
+  (*p)[1] = (uint8_t) (v >> 8);
+  (*p)[2] = (uint8_t) (v >> 16);
+  (*p)[3] = (uint8_t) (v >> 24);
+  *p += 4;
+}
+
+static uint16_t nmeaRecordGet16(const uint8_t **p) {
+  uint16_t v = (uint16_t) ((*p)[0] | ((*p)[1] << 8));
+  *p += 2;
+  return v;
+}
+
+static uint32_t nmeaRecordGet32(const uint8_t **p) {
+  uint32_t v = (uint32_t) (*p)[0] //
+      | ((uint32_t) (*p)[1] << 8) //
+      | ((uint32_t) (*p)[2] << 16) //
+      | ((uint32_t) (*p)[3] << 24);
+  *p += 4;
+  return v;
+}
+
+/*
+ * Fixed-point conversion
+ */
+
+/**
+ * Convert a value into a signed fixed-point value
+ *
+ * @param v The value
+ * @param scale The scale of the fixed-point value
+ * @return The (rounded and clamped) fixed-point value, zero for NaN
+ */
+static int32_t nmeaRecordFixedSigned(double v, double scale) {
+  double f = round(v * scale);
+
+  if (isnan(f)) {
+    return 0;
+  }
+
+  if (f <= (double) INT32_MIN) {
+    return INT32_MIN;
+  }
+
+  if (f >= (double) INT32_MAX) {
+    return INT32_MAX;
+  }
+
+  return (int32_t) f;
+}
+
+/**
+ * Convert a value into an unsigned fixed-point value
+ *
+ * @param v The value
+ * @param scale The scale of the fixed-point value
+ * @param max The maximum fixed-point value
+ * @return The (rounded and clamped) fixed-point value, zero for NaN
+ */
+static uint32_t nmeaRecordFixedUnsigned(double v, double scale, uint32_t max) {
+  double f = round(v * scale);
+
+  if (isnan(f) //
+      || (f <= 0.0)) {
+    return 0;
+  }
+
+  if (f >= (double) max) {
+    return max;
+  }
+
+  return (uint32_t) f;
+}
+
+/**
+ * Clamp an unsigned integer
+ *
+ * @param v The value
+ * @param max The maximum value
+ * @return The clamped value
+ */
+static unsigned int nmeaRecordClamp(unsigned int v, unsigned int max) {
+  return (v > max) ?
+      max :
+      v;
+}
+
+void nmeaRecordFromInfo(const NmeaInfo *info, NmeaRecord *record) {
+  uint32_t present;
+
+  if (!record) {
+    return;
+  }
+
+  memset(record, 0, sizeof(*record));
+
+  if (!info) {
+    return;
+  }
+
+  present = info->present & NMEALIB_INFO_PRESENT_MASK;
+  record->present = present;
+  record->smask = info->smask;
+
+  if (present & NMEALIB_PRESENT_UTCDATE) {
+    record->utc.year = (uint16_t) nmeaRecordClamp(info->utc.year, UINT16_MAX);
+    record->utc.mon = (uint8_t) nmeaRecordClamp(info->utc.mon, UINT8_MAX);
+    record->utc.day = (uint8_t) nmeaRecordClamp(info->utc.day, UINT8_MAX);
+  }
+
+  if (present & NMEALIB_PRESENT_UTCTIME) {
+    record->utc.hour = (uint8_t) nmeaRecordClamp(info->utc.hour, UINT8_MAX);
+    record->utc.min = (uint8_t) nmeaRecordClamp(info->utc.min, UINT8_MAX);
+    record->utc.sec = (uint8_t) nmeaRecordClamp(info->utc.sec, UINT8_MAX);
+    record->utc.hsec = (uint8_t) nmeaRecordClamp(info->utc.hsec, UINT8_MAX);
+  }
+
+  if (present & NMEALIB_PRESENT_SIG) {
+    record->sig = (uint8_t) nmeaRecordClamp(info->sig, UINT8_MAX);
+  }
+
+  if (present & NMEALIB_PRESENT_FIX) {
+    record->fix = (uint8_t) nmeaRecordClamp(info->fix, UINT8_MAX);
+  }
+
+  if (present & NMEALIB_PRESENT_PDOP) {
+    record->pdop = (uint16_t) nmeaRecordFixedUnsigned(info->metric ?
+        nmeaMathMetersToDop(info->pdop) :
+        info->pdop, 100.0, UINT16_MAX);
+  }
+
+  if (present & NMEALIB_PRESENT_HDOP) {
+    record->hdop = (uint16_t) nmeaRecordFixedUnsigned(info->metric ?
+        nmeaMathMetersToDop(info->hdop) :
+        info->hdop, 100.0, UINT16_MAX);
+  }
+
+  if (present & NMEALIB_PRESENT_VDOP) {
+    record->vdop = (uint16_t) nmeaRecordFixedUnsigned(info->metric ?
+        nmeaMathMetersToDop(info->vdop) :
+        info->vdop, 100.0, UINT16_MAX);
+  }
+
+  if (present & NMEALIB_PRESENT_LAT) {
+    record->latitude = nmeaRecordFixedSigned(info->metric ?
+        info->latitude :
+        nmeaMathNdegToDegree(info->latitude), 1e7);
+  }
+
+  if (present & NMEALIB_PRESENT_LON) {
+    record->longitude = nmeaRecordFixedSigned(info->metric ?
+        info->longitude :
+        nmeaMathNdegToDegree(info->longitude), 1e7);
+  }
+
+  if (present & NMEALIB_PRESENT_ELV) {
+    record->elevation = nmeaRecordFixedSigned(info->elevation, 1000.0);
+  }
+
+  if (present & NMEALIB_PRESENT_HEIGHT) {
+    record->height = nmeaRecordFixedSigned(info->height, 1000.0);
+  }
+
+  if (present & NMEALIB_PRESENT_SPEED) {
+    record->speed = nmeaRecordFixedUnsigned(info->speed, 1000.0, UINT32_MAX);
+  }
+
+  if (present & NMEALIB_PRESENT_TRACK) {
+    record->track = (uint16_t) nmeaRecordFixedUnsigned(info->track, 100.0, UINT16_MAX);
+  }
+
+  if (present & NMEALIB_PRESENT_MTRACK) {
+    record->mtrack = (uint16_t) nmeaRecordFixedUnsigned(info->mtrack, 100.0, UINT16_MAX);
+  }
+
+  if (present & NMEALIB_PRESENT_MAGVAR) {
+    record->magvar = (uint16_t) nmeaRecordFixedUnsigned(info->magvar, 100.0, UINT16_MAX);
+  }
+
+  if (present & NMEALIB_PRESENT_SATINUSECOUNT) {
+    record->inUseCount = (uint8_t) nmeaRecordClamp(info->satellites.inUseCount, UINT8_MAX);
+  }
+
+  if (present & NMEALIB_PRESENT_SATINVIEWCOUNT) {
+    record->inViewCount = (uint8_t) nmeaRecordClamp(info->satellites.inViewCount, UINT8_MAX);
+  }
+
+  if (present & NMEALIB_PRESENT_DGPSAGE) {
+    record->dgpsAge = (uint16_t) nmeaRecordFixedUnsigned(info->dgpsAge, 10.0, UINT16_MAX);
+  }
+
+  if (present & NMEALIB_PRESENT_DGPSSID) {
+    record->dgpsSid = (uint16_t) nmeaRecordClamp(info->dgpsSid, UINT16_MAX);
+  }
+}
+
+void nmeaRecordToInfo(const NmeaRecord *record, NmeaInfo *info) {
+  if (!info) {
+    return;
+  }
+
+  memset(info, 0, sizeof(*info));
+
+  if (!record) {
+    return;
+  }
+
+  /* the satellites are not stored */
+  info->present = record->present //
+      & NMEALIB_INFO_PRESENT_MASK //
+      & ~(uint32_t) (NMEALIB_PRESENT_SATINUSE | NMEALIB_PRESENT_SATINVIEW);
+  info->smask = record->smask;
+  info->utc.year = record->utc.year;
+  info->utc.mon = record->utc.mon;
+  info->utc.day = record->utc.day;
+  info->utc.hour = record->utc.hour;
+  info->utc.min = record->utc.min;
+  info->utc.sec = record->utc.sec;
+  info->utc.hsec = record->utc.hsec;
+  info->sig = (NmeaSignal) record->sig;
+  info->fix = (NmeaFix) record->fix;
+  info->pdop = (double) record->pdop / 100.0;
+  info->hdop = (double) record->hdop / 100.0;
+  info->vdop = (double) record->vdop / 100.0;
+  info->latitude = nmeaMathDegreeToNdeg((double) record->latitude / 1e7);
+  info->longitude = nmeaMathDegreeToNdeg((double) record->longitude / 1e7);
+  info->elevation = (double) record->elevation / 1000.0;
+  info->height = (double) record->height / 1000.0;
+  info->speed = (double) record->speed / 1000.0;
+  info->track = (double) record->track / 100.0;
+  info->mtrack = (double) record->mtrack / 100.0;
+  info->magvar = (double) record->magvar / 100.0;
+  info->dgpsAge = (double) record->dgpsAge / 10.0;
+  info->dgpsSid = record->dgpsSid;
+  info->satellites.inUseCount = record->inUseCount;
+  info->satellites.inViewCount = record->inViewCount;
+}
+
+void nmeaRecordEncode(const NmeaRecord *record, uint8_t *buf) {
+  uint8_t *p = buf;
+
+  if (!record //
+      || !buf) {
+    return;
+  }
+
+  nmeaRecordPut16(&p, record->utc.year);
+  *p++ = record->utc.mon;
+  *p++ = record->utc.day;
+  *p++ = record->utc.hour;
+  *p++ = record->utc.min;
+  *p++ = record->utc.sec;
+  *p++ = record->utc.hsec;
+  nmeaRecordPut32(&p, record->present);
+  nmeaRecordPut32(&p, record->smask);
+  nmeaRecordPut32(&p, (uint32_t) record->latitude);
+  nmeaRecordPut32(&p, (uint32_t) record->longitude);
+  nmeaRecordPut32(&p, (uint32_t) record->elevation);
+  nmeaRecordPut32(&p, (uint32_t) record->height);
+  nmeaRecordPut32(&p, record->speed);
+  nmeaRecordPut16(&p, record->track);
+  nmeaRecordPut16(&p, record->mtrack);
+  nmeaRecordPut16(&p, record->magvar);
+  nmeaRecordPut16(&p, record->pdop);
+  nmeaRecordPut16(&p, record->hdop);
+  nmeaRecordPut16(&p, record->vdop);
+  nmeaRecordPut16(&p, record->dgpsAge);
+  nmeaRecordPut16(&p, record->dgpsSid);
+  *p++ = record->sig;
+  *p++ = record->fix;
+  *p++ = record->inUseCount;
+  *p = record->inViewCount;
+}
+
+void nmeaRecordDecode(const uint8_t *buf, NmeaRecord *record) {
+  const uint8_t *p = buf;
+
+  if (!buf //
+      || !record) {
+    return;
+  }
+
+  record->utc.year = nmeaRecordGet16(&p);
+  record->utc.mon = *p++;
+  record->utc.day = *p++;
+  record->utc.hour = *p++;
+  record->utc.min = *p++;
+  record->utc.sec = *p++;
+  record->utc.hsec = *p++;
+  record->present = nmeaRecordGet32(&p);
+  record->smask = nmeaRecordGet32(&p);
+  record->latitude = (int32_t) nmeaRecordGet32(&p);
+  record->longitude = (int32_t) nmeaRecordGet32(&p);
+  record->elevation = (int32_t) nmeaRecordGet32(&p);
+  record->height = (int32_t) nmeaRecordGet32(&p);
+  record->speed = nmeaRecordGet32(&p);
+  record->track = nmeaRecordGet16(&p);
+  record->mtrack = nmeaRecordGet16(&p);
+  record->magvar = nmeaRecordGet16(&p);
+  record->pdop = nmeaRecordGet16(&p);
+  record->hdop = nmeaRecordGet16(&p);
+  record->vdop = nmeaRecordGet16(&p);
+  record->dgpsAge = nmeaRecordGet16(&p);
+  record->dgpsSid = nmeaRecordGet16(&p);
+  record->sig = *p++;
+  record->fix = *p++;
+  record->inUseCount = *p++;
+  record->inViewCount = *p;
+}
+
+/**
+ * Encode the header of a record file
+ *
+ * @param buf The buffer of NMEALIB_RECORD_HEADER_SIZE bytes
+ */
+static void nmeaRecordHeaderEncode(uint8_t *buf) {
+  uint8_t *p = buf;
+
+  memset(buf, 0, NMEALIB_RECORD_HEADER_SIZE);
+  nmeaRecordPut32(&p, NMEALIB_RECORD_MAGIC);
+  nmeaRecordPut16(&p, NMEALIB_RECORD_VERSION);
+  nmeaRecordPut16(&p, NMEALIB_RECORD_HEADER_SIZE);
+  nmeaRecordPut16(&p, NMEALIB_RECORD_SIZE);
+}
+
+/**
+ * Validate the header of a record file
+ *
+ * @param buf The buffer of NMEALIB_RECORD_HEADER_SIZE bytes
+ * @return True when the header is that of a record file with the supported
+ * layout version
+ */
+static bool nmeaRecordHeaderValid(const uint8_t *buf) {
+  uint8_t expected[NMEALIB_RECORD_HEADER_SIZE];
+
+  nmeaRecordHeaderEncode(expected);
+  return !memcmp(buf, expected, NMEALIB_RECORD_HEADER_SIZE);
+}
+
+/**
+ * Write a buffer completely to a file descriptor
+ *
+ * @param fd The file descriptor
+ * @param buf The buffer
+ * @param sz The length of the buffer
+ * @return True on success
+ */
+static bool nmeaRecordWrite(int fd, const uint8_t *buf, size_t sz) {
+  while (sz) {
+    ssize_t written = write(fd, buf, sz);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+
+      return false;
+    }
+
+    buf += written;
+    sz -= (size_t) written;
+  }
+
+  return true;
+}
+
+NmeaRecordWriter *nmeaRecordWriterOpen(const char *path) {
+  uint8_t header[NMEALIB_RECORD_HEADER_SIZE];
+  NmeaRecordWriter *writer;
+  struct stat st;
+  int fd;
+
+  if (!path) {
+    return NULL;
+  }
+
+  fd = open(path, O_RDWR | O_CREAT, 0644);
+  if (fd < 0) {
+    nmeaContextError("%s error: could not open %s: %s", __FUNCTION__, path, strerror(errno));
+    return NULL;
+  }
+
+  if (fstat(fd, &st)) {
+    /* can't be covered in a test */
+    nmeaContextError("%s error: could not stat %s: %s", __FUNCTION__, path, strerror(errno));
+    goto err;
+  }
+
+  if (!st.st_size) {
+    nmeaRecordHeaderEncode(header);
+    if (!nmeaRecordWrite(fd, header, sizeof(header))) {
+      /* can't be covered in a test */
+      nmeaContextError("%s error: could not write to %s: %s", __FUNCTION__, path, strerror(errno));
+      goto err;
+    }
+  } else {
+    size_t records;
+
+    if ((st.st_size < (off_t) NMEALIB_RECORD_HEADER_SIZE) //
+        || (pread(fd, header, sizeof(header), 0) != (ssize_t) sizeof(header)) //
+        || !nmeaRecordHeaderValid(header)) {
+      nmeaContextError("%s error: %s is not a record file with layout version %u", __FUNCTION__, path,
+          NMEALIB_RECORD_VERSION);
+      goto err;
+    }
+
+    /* drop a partially written record */
+    records = ((size_t) st.st_size - NMEALIB_RECORD_HEADER_SIZE) / NMEALIB_RECORD_SIZE;
+    if (ftruncate(fd, (off_t) (NMEALIB_RECORD_HEADER_SIZE + (records * NMEALIB_RECORD_SIZE))) //
+        || (lseek(fd, 0, SEEK_END) < 0)) {
+      /* can't be covered in a test */
+      nmeaContextError("%s error: could not append to %s: %s", __FUNCTION__, path, strerror(errno));
+      goto err;
+    }
+  }
+
+  writer = calloc(1, sizeof(*writer));
+  if (!writer) {
+    /* can't be covered in a test */
+    goto err;
+  }
+
+  writer->fd = fd;
+  return writer;
+
+err:
+  close(fd);
+  return NULL;
+}
+
+bool nmeaRecordWriterAppend(NmeaRecordWriter *writer, const NmeaInfo *info) {
+  NmeaRecord record;
+
+  if (!writer //
+      || !info) {
+    return false;
+  }
+
+  if ((writer->buffered == NMEALIB_RECORD_WRITER_BUFFER) //
+      && !nmeaRecordWriterFlush(writer)) {
+    return false;
+  }
+
+  nmeaRecordFromInfo(info, &record);
+  nmeaRecordEncode(&record, &writer->buf[writer->buffered * NMEALIB_RECORD_SIZE]);
+  writer->buffered++;
+
+  return true;
+}
+
+void nmeaRecordWriterEpochHandler(void *user, const NmeaEpoch *epoch) {
+  if (!epoch) {
+    return;
+  }
+
+  nmeaRecordWriterAppend((NmeaRecordWriter *) user, &epoch->info);
+}
+
+bool nmeaRecordWriterFlush(NmeaRecordWriter *writer) {
+  if (!writer) {
+    return false;
+  }
+
+  if (!writer->buffered) {
+    return true;
+  }
+
+  if (!nmeaRecordWrite(writer->fd, writer->buf, writer->buffered * NMEALIB_RECORD_SIZE)) {
+    /* can't be covered in a test */
+    nmeaContextError("%s error: could not write to fd %d: %s", __FUNCTION__, writer->fd, strerror(errno));
+    return false;
+  }
+
+  writer->buffered = 0;
+  return true;
+}
+
+bool nmeaRecordWriterClose(NmeaRecordWriter *writer) {
+  bool r;
+
+  if (!writer) {
+    return false;
+  }
+
+  r = nmeaRecordWriterFlush(writer);
+  close(writer->fd);
+  free(writer);
+
+  return r;
+}
+
+NmeaRecordFile *nmeaRecordFileOpen(const char *path) {
+  NmeaRecordFile *file;
+  struct stat st;
+  void *mapping;
+  size_t size;
+  int fd;
+
+  if (!path) {
+    return NULL;
+  }
+
+  fd = open(path, O_RDONLY);
+  if (fd < 0) {
+    nmeaContextError("%s error: could not open %s: %s", __FUNCTION__, path, strerror(errno));
+    return NULL;
+  }
+
+  if (fstat(fd, &st) //
+      || (st.st_size < (off_t) NMEALIB_RECORD_HEADER_SIZE)) {
+    nmeaContextError("%s error: %s is not a record file with layout version %u", __FUNCTION__, path,
+        NMEALIB_RECORD_VERSION);
+    close(fd);
+    return NULL;
+  }
+
+  size = (size_t) st.st_size;
+  mapping = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+
+  if (mapping == MAP_FAILED) {
+    /* can't be covered in a test */
+    nmeaContextError("%s error: could not map %lu bytes: %s", __FUNCTION__, (unsigned long) size, strerror(errno));
+    return NULL;
+  }
+
+  if (!nmeaRecordHeaderValid((const uint8_t *) mapping)) {
+    nmeaContextError("%s error: %s is not a record file with layout version %u", __FUNCTION__, path,
+        NMEALIB_RECORD_VERSION);
+    munmap(mapping, size);
+    return NULL;
+  }
+
+  file = calloc(1, sizeof(*file));
+  if (!file) {
+    /* can't be covered in a test */
+    munmap(mapping, size);
+    return NULL;
+  }
+
+  file->mapping = (const uint8_t *) mapping;
+  file->size = size;
+  file->count = (size - NMEALIB_RECORD_HEADER_SIZE) / NMEALIB_RECORD_SIZE;
+
+  return file;
+}
+
+void nmeaRecordFileClose(NmeaRecordFile *file) {
+  if (!file) {
+    return;
+  }
+
+  munmap((void *) (uintptr_t) file->mapping, file->size);
+  free(file);
+}
+
+size_t nmeaRecordFileCount(const NmeaRecordFile *file) {
+  if (!file) {
+    return 0;
+  }
+
+  return file->count;
+}
+
+bool nmeaRecordFileGet(const NmeaRecordFile *file, size_t index, NmeaRecord *record) {
+  if (!file //
+      || (index >= file->count) //
+      || !record) {
+    return false;
+  }
+
+  nmeaRecordDecode(&file->mapping[NMEALIB_RECORD_HEADER_SIZE + (index * NMEALIB_RECORD_SIZE)], record);
+  return true;
+}
@@ -0,0 +1,321 @@
+/*
+ * This file is part of nmealib.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <nmealib/satellite.h>
+
+#include <string.h>
+
+/**
+ * A range of NMEA PRNs of a constellation
+ */
+typedef struct _NmeaSatellitePrnRange {
+    unsigned int first; /**< the NMEA PRN of PRN 1 of the constellation  */
+    unsigned int count; /**< the number of PRNs of the constellation     */
+} NmeaSatellitePrnRange;
+
+/** The NMEA PRN ranges of the constellations, indexed by NmeaConstellation */
+static const NmeaSatellitePrnRange nmeaSatellitePrnRanges[NMEALIB_CONSTELLATIONS] = {
+    { 1u, 32u }, /* GPS     */
+    { 33u, 32u }, /* SBAS    */
+    { 65u, 32u }, /* GLONASS */
+    { 193u, 10u }, /* QZSS    */
+    { 301u, 64u }, /* Galileo */
+    { 401u, 64u } /* BeiDou  */
+};
+
+/**
+ * Determine whether a constellation and a PRN are valid for the store
+ *
+ * @param constellation The constellation
+ * @param prn The PRN within the constellation
+ * @return True when valid
+ */
+static bool nmeaSatelliteStoreValid(NmeaConstellation constellation, unsigned int prn) {
+  return (constellation <= NMEALIB_CONSTELLATION_LAST) //
+      && prn //
+      && (prn <= NMEALIB_SATELLITE_STORE_PRNS);
+}
+
+bool nmeaSatelliteFromNmeaPrn(unsigned int nmeaPrn, NmeaConstellation *constellation, unsigned int *prn) {
+  unsigned int c;
+
+  if (!constellation //
+      || !prn) {
+    return false;
+  }
+
+  for (c = NMEALIB_CONSTELLATION_FIRST; c <= NMEALIB_CONSTELLATION_LAST; c++) {
+    const NmeaSatellitePrnRange *range = &nmeaSatellitePrnRanges[c];
+
+    if ((nmeaPrn >= range->first) //
+        && (nmeaPrn < (range->first + range->count))) {
+      *constellation = (NmeaConstellation) c;
+      *prn = nmeaPrn - range->first + 1;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+unsigned int nmeaSatelliteToNmeaPrn(NmeaConstellation constellation, unsigned int prn) {
+  if (!nmeaSatelliteStoreValid(constellation, prn) //
+      || (prn > nmeaSatellitePrnRanges[constellation].count)) {
+    return 0;
+  }
+
+  return nmeaSatellitePrnRanges[constellation].first + prn - 1;
+}
+
+void nmeaSatelliteStoreClear(NmeaSatelliteStore *store) {
+  if (!store) {
+    return;
+  }
+
+  /* the satellites are only valid when present, no need to clear them */
+  memset(store->present, 0, sizeof(store->present));
+  memset(store->inUse, 0, sizeof(store->inUse));
+}
+
+bool nmeaSatelliteStoreSet(NmeaSatelliteStore *store, NmeaConstellation constellation, unsigned int prn,
+    const NmeaSatellite *satellite) {
+  NmeaSatellite *dst;
+
+  if (!store //
+      || !satellite //
+      || !nmeaSatelliteStoreValid(constellation, prn)) {
+    return false;
+  }
+
+  dst = &store->satellites[constellation][prn - 1];
+  *dst = *satellite;
+  dst->prn = prn;
+  store->present[constellation] |= (1ull << (prn - 1));
+
+  return true;
+}
+
+const NmeaSatellite *nmeaSatelliteStoreGet(const NmeaSatelliteStore *store, NmeaConstellation constellation,
+    unsigned int prn) {
+  if (!store //
+      || !nmeaSatelliteStoreValid(constellation, prn) //
+      || !(store->present[constellation] & (1ull << (prn - 1)))) {
+    return NULL;
+  }
+
+  return &store->satellites[constellation][prn - 1];
+}
+
+bool nmeaSatelliteStoreRemove(NmeaSatelliteStore *store, NmeaConstellation constellation, unsigned int prn) {
+  uint64_t bit;
+
+  if (!store //
+      || !nmeaSatelliteStoreValid(constellation, prn)) {
+    return false;
+  }
+
+  bit = 1ull << (prn - 1);
+  if (!(store->present[constellation] & bit)) {
+    return false;
+  }
+
+  store->present[constellation] &= ~bit;
+  store->inUse[constellation] &= ~bit;
+
+  return true;
+}
+
+bool nmeaSatelliteStoreSetInUse(NmeaSatelliteStore *store, NmeaConstellation constellation, unsigned int prn,
+    bool inUse) {
+  uint64_t bit;
+
+  if (!store //
+      || !nmeaSatelliteStoreValid(constellation, prn)) {
+    return false;
+  }
+
+  bit = 1ull << (prn - 1);
+  if (inUse) {
+    store->inUse[constellation] |= bit;
+  } else {
+    store->inUse[constellation] &= ~bit;
+  }
+
+  return true;
+}
+
+bool nmeaSatelliteStoreIsInUse(const NmeaSatelliteStore *store, NmeaConstellation constellation, unsigned int prn) {
+  return store //
+      && nmeaSatelliteStoreValid(constellation, prn) //
+      && (store->inUse[constellation] & (1ull << (prn - 1)));
+}
+
+size_t nmeaSatelliteStoreCount(const NmeaSatelliteStore *store) {
+  size_t count = 0;
+  unsigned int c;
+
+  if (!store) {
+    return 0;
+  }
+
+  for (c = NMEALIB_CONSTELLATION_FIRST; c <= NMEALIB_CONSTELLATION_LAST; c++) {
+    count += (size_t) __builtin_popcountll(store->present[c]);
+  }
+
+  return count;
+}
+
+const NmeaSatellite *nmeaSatelliteStoreNext(const NmeaSatelliteStore *store, NmeaConstellation *constellation,
+    unsigned int *prn) {
+  unsigned int c;
+  unsigned int from;
+
+  if (!store //
+      || !constellation //
+      || !prn) {
+    return NULL;
+  }
+
+  c = *constellation;
+  from = *prn;
+
+  for (; c <= NMEALIB_CONSTELLATION_LAST; c++, from = 0) {
+    uint64_t remaining;
+
+    if (from >= NMEALIB_SATELLITE_STORE_PRNS) {
+      continue;
+    }
+
+    /* the PRNs after 'from' are bits 'from' and up */
+    remaining = store->present[c] & (~0ull << from);
+    if (remaining) {
+      unsigned int next = (unsigned int) __builtin_ctzll(remaining) + 1;
+
+      *constellation = (NmeaConstellation) c;
+      *prn = next;
+      return &store->satellites[c][next - 1];
+    }
+  }
+
+  return NULL;
+}
+
+size_t nmeaSatelliteStoreFromInfo(NmeaSatelliteStore *store, const NmeaInfo *info) {
+  NmeaConstellation constellation;
+  unsigned int prn;
+  size_t skipped = 0;
+  size_t i;
+
+  if (!store //
+      || !info) {
+    return 0;
+  }
+
+  nmeaSatelliteStoreClear(store);
+
+  if (nmeaInfoIsPresentAll(info->present, NMEALIB_PRESENT_SATINVIEW)) {
+    for (i = 0; i < NMEALIB_MAX_SATELLITES; i++) {
+      const NmeaSatellite *sat = &info->satellites.inView[i];
+
+      if (!sat->prn) {
+        continue;
+      }
+
+      if (!nmeaSatelliteFromNmeaPrn(sat->prn, &constellation, &prn)) {
+        skipped++;
+        continue;
+      }
+
+      nmeaSatelliteStoreSet(store, constellation, prn, sat);
+    }
+  }
+
+  if (nmeaInfoIsPresentAll(info->present, NMEALIB_PRESENT_SATINUSE)) {
+    for (i = 0; i < NMEALIB_MAX_SATELLITES; i++) {
+      unsigned int nmeaPrn = info->satellites.inUse[i];
+
+      if (!nmeaPrn) {
+        continue;
+      }
+
+      if (!nmeaSatelliteFromNmeaPrn(nmeaPrn, &constellation, &prn)) {
+        skipped++;
+        continue;
+      }
+
+      nmeaSatelliteStoreSetInUse(store, constellation, prn, true);
+    }
+  }
+
+  return skipped;
+}
+
+void nmeaSatelliteStoreToInfo(const NmeaSatelliteStore *store, NmeaInfo *info) {
+  NmeaSatellite satellites[NMEALIB_MAX_SATELLITES];
+  size_t inView = 0;
+  size_t inUse = 0;
+  unsigned int c;
+
+  if (!store //
+      || !info) {
+    return;
+  }
+
+  memset(satellites, 0, sizeof(satellites));
+  memset(info->satellites.inUse, 0, sizeof(info->satellites.inUse));
+
+  for (c = NMEALIB_CONSTELLATION_FIRST; c <= NMEALIB_CONSTELLATION_LAST; c++) {
+    uint64_t remaining = store->present[c];
+
+    while (remaining) {
+      unsigned int prn = (unsigned int) __builtin_ctzll(remaining) + 1;
+      unsigned int nmeaPrn = nmeaSatelliteToNmeaPrn((NmeaConstellation) c, prn);
+
+      remaining &= remaining - 1;
+
+      if (!nmeaPrn) {
+        continue;
+      }
+
+      if (inView < NMEALIB_MAX_SATELLITES) {
+        NmeaSatellite *dst = &satellites[inView++];
+
+        *dst = store->satellites[c][prn - 1];
+        dst->prn = nmeaPrn;
+      }
+    }
+
+    remaining = store->inUse[c];
+
+    while (remaining) {
+      unsigned int prn = (unsigned int) __builtin_ctzll(remaining) + 1;
+      unsigned int nmeaPrn = nmeaSatelliteToNmeaPrn((NmeaConstellation) c, prn);
+
+      remaining &= remaining - 1;
+
+      if (nmeaPrn //
+          && (inUse < NMEALIB_MAX_SATELLITES)) {
+        info->satellites.inUse[inUse++] = nmeaPrn;
+      }
+    }
+  }
+
+  nmeaInfoSatellitesInViewPublish(info, satellites, info->satellites.inViewCount);
+
+  nmeaInfoSetPresent(&info->present, NMEALIB_PRESENT_SATINVIEW);
+  nmeaInfoSetPresent(&info->present, NMEALIB_PRESENT_SATINUSE);
+}
@@ -50,86 +50,161 @@ NmeaSentence nmeaSentenceFromPrefix(const char *s, const size_t sz) {
   return NMEALIB_SENTENCE_GPNON;
 }
 
-bool nmeaSentenceToInfo(const char *s, const size_t sz, NmeaInfo *info) {
-  switch (nmeaSentenceFromPrefix(s, sz)) {
-    case NMEALIB_SENTENCE_GPGGA: {
-      NmeaGPGGA gpgga;
-      if (nmeaGPGGAParse(s, sz, &gpgga)) {
-        nmeaGPGGAToInfo(&gpgga, info);
-        return true;
-      }
+bool nmeaSentenceParse(const char *s, const size_t sz, NmeaSentencePack *pack) {
+  bool r = false;
 
-      return false;
-    }
+  if (!pack) {
+    return false;
+  }
 
-    case NMEALIB_SENTENCE_GPGSA: {
-      NmeaGPGSA gpgsa;
-      if (nmeaGPGSAParse(s, sz, &gpgsa)) {
-        nmeaGPGSAToInfo(&gpgsa, info);
-        return true;
-      }
+  pack->sentence = nmeaSentenceFromPrefix(s, sz);
 
-      return false;
-    }
+  switch (pack->sentence) {
+    case NMEALIB_SENTENCE_GPGGA:
+      r = nmeaGPGGAParse(s, sz, &pack->pack.gpgga);
+      break;
 
-    case NMEALIB_SENTENCE_GPGSV: {
-      NmeaGPGSV gpgsv;
-      if (nmeaGPGSVParse(s, sz, &gpgsv)) {
-        nmeaGPGSVToInfo(&gpgsv, info);
-        return true;
-      }
+    case NMEALIB_SENTENCE_GPGSA:
+      r = nmeaGPGSAParse(s, sz, &pack->pack.gpgsa);
+      break;
 
-      return false;
-    }
+    case NMEALIB_SENTENCE_GPGSV:
+      r = nmeaGPGSVParse(s, sz, &pack->pack.gpgsv);
+      break;
 
-    case NMEALIB_SENTENCE_GPRMC: {
-      NmeaGPRMC gprmc;
-      if (nmeaGPRMCParse(s, sz, &gprmc)) {
-        nmeaGPRMCToInfo(&gprmc, info);
-        return true;
-      }
+    case NMEALIB_SENTENCE_GPRMC:
+      r = nmeaGPRMCParse(s, sz, &pack->pack.gprmc);
+      break;
 
-      return false;
-    }
+    case NMEALIB_SENTENCE_GPVTG:
+      r = nmeaGPVTGParse(s, sz, &pack->pack.gpvtg);
+      break;
 
-    case NMEALIB_SENTENCE_GPVTG: {
-      NmeaGPVTG gpvtg;
-      if (nmeaGPVTGParse(s, sz, &gpvtg)) {
-        nmeaGPVTGToInfo(&gpvtg, info);
-        return true;
-      }
+    case NMEALIB_SENTENCE_GPNON:
+    default:
+      break;
+  }
 
-      return false;
-    }
+  if (!r) {
+    pack->sentence = NMEALIB_SENTENCE_GPNON;
+  }
+
+  return r;
+}
+
+bool nmeaSentencePackUtc(const NmeaSentencePack *pack, NmeaTime *utc, bool *dated) {
+  uint32_t present;
+
+  if (!pack //
+      || !utc) {
+    return false;
+  }
+
+  switch (pack->sentence) {
+    case NMEALIB_SENTENCE_GPGGA:
+      present = pack->pack.gpgga.present;
+      *utc = pack->pack.gpgga.utc;
+      break;
+
+    case NMEALIB_SENTENCE_GPRMC:
+      present = pack->pack.gprmc.present;
+      *utc = pack->pack.gprmc.utc;
+      break;
 
     case NMEALIB_SENTENCE_GPNON:
+    case NMEALIB_SENTENCE_GPGSA:
+    case NMEALIB_SENTENCE_GPGSV:
+    case NMEALIB_SENTENCE_GPVTG:
     default:
       return false;
   }
+
+  if (dated) {
+    *dated = nmeaInfoIsPresentAll(present, NMEALIB_PRESENT_UTCDATE);
+  }
+
+  return nmeaInfoIsPresentAll(present, NMEALIB_PRESENT_UTCTIME);
 }
 
-size_t nmeaSentenceFromInfo(NmeaMallocedBuffer *buf, const NmeaInfo *info, const NmeaSentence mask) {
+uint32_t nmeaSentencePackToInfo(const NmeaSentencePack *pack, NmeaInfo *info, NmeaGPGSVStaging *gpgsv) {
+  if (!pack) {
+    return 0;
+  }
 
-#define dst       (&s[chars])
-#define available ((sz <= (size_t) chars) ? 0 : (sz - (size_t) chars))
+  switch (pack->sentence) {
+    case NMEALIB_SENTENCE_GPGGA:
+      return nmeaGPGGAToInfo(&pack->pack.gpgga, info);
 
-#define generateSentence(expression) { \
-  size_t addedChars = expression; \
-  while (addedChars >= available) { \
-    sz += NMEALIB_BUFFER_CHUNK_SIZE; \
-    s = realloc(s, sz); \
-    if (!s) { \
-      return 0; \
-    } \
-    addedChars = expression; \
-  } \
-  chars += addedChars; \
+    case NMEALIB_SENTENCE_GPGSA:
+      return nmeaGPGSAToInfo(&pack->pack.gpgsa, info);
+
+    case NMEALIB_SENTENCE_GPGSV:
+      return nmeaGPGSVToInfo(&pack->pack.gpgsv, info, gpgsv);
+
+    case NMEALIB_SENTENCE_GPRMC:
+      return nmeaGPRMCToInfo(&pack->pack.gprmc, info);
+
+    case NMEALIB_SENTENCE_GPVTG:
+      return nmeaGPVTGToInfo(&pack->pack.gpvtg, info);
+
+    case NMEALIB_SENTENCE_GPNON:
+    default:
+      return 0;
+  }
+}
+
+bool nmeaSentenceToInfo(const char *s, const size_t sz, NmeaInfo *info, uint32_t *changed) {
+  NmeaSentencePack pack;
+  uint32_t c = 0;
+  bool r;
+
+  r = nmeaSentenceParse(s, sz, &pack);
+  if (r) {
+    c = nmeaSentencePackToInfo(&pack, info, NULL);
+  }
+
+  if (changed) {
+    *changed = c;
+  }
+
+  return r;
 }
 
-  char *s;
+size_t nmeaSentenceFromInfoLengthMax(const NmeaInfo *info, const NmeaSentence mask) {
+  size_t length = 0;
+
+  if (!info) {
+    return 0;
+  }
+
+  if (mask & NMEALIB_SENTENCE_GPGGA) {
+    length += NMEALIB_GPGGA_GENERATE_LENGTH_MAX;
+  }
+
+  if (mask & NMEALIB_SENTENCE_GPGSA) {
+    length += NMEALIB_GPGSA_GENERATE_LENGTH_MAX;
+  }
+
+  if (mask & NMEALIB_SENTENCE_GPGSV) {
+    size_t satCount = nmeaInfoIsPresentAll(info->present, NMEALIB_PRESENT_SATINVIEWCOUNT) ?
+        info->satellites.inViewCount :
+        0;
+    length += nmeaGPGSVsatellitesToSentencesCount(satCount) * NMEALIB_GPGSV_GENERATE_LENGTH_MAX;
+  }
+
+  if (mask & NMEALIB_SENTENCE_GPRMC) {
+    length += NMEALIB_GPRMC_GENERATE_LENGTH_MAX;
+  }
+
+  if (mask & NMEALIB_SENTENCE_GPVTG) {
+    length += NMEALIB_GPVTG_GENERATE_LENGTH_MAX;
+  }
+
+  return length;
+}
+
+size_t nmeaSentenceFromInfo(NmeaMallocedBuffer *buf, const NmeaInfo *info, const NmeaSentence mask) {
   size_t sz;
-  size_t chars;
-  NmeaSentence msk;
 
   if (!buf //
       || (!buf->buffer && buf->bufferSize) //
@@ -139,22 +214,66 @@ size_t nmeaSentenceFromInfo(NmeaMallocedBuffer *buf, const NmeaInfo *info, const
     return 0;
   }
 
-  sz = buf->bufferSize;
-  s = buf->buffer;
+  /* reserve up front (in whole chunks) so that no sentence has to be regenerated */
+  sz = nmeaSentenceFromInfoLengthMax(info, mask) + 1;
+  sz = (sz + NMEALIB_BUFFER_CHUNK_SIZE - 1) & ~(NMEALIB_BUFFER_CHUNK_SIZE - 1);
 
-  if (!s) {
-    sz = NMEALIB_BUFFER_CHUNK_SIZE;
-    s = malloc(sz);
+  if (buf->bufferSize < sz) {
+    char *s = realloc(buf->buffer, sz);
     if (!s) {
       /* can't be covered in a test */
       return 0;
     }
+
+    buf->buffer = s;
+    buf->bufferSize = sz;
   }
 
-  *s = '\0';
+  return nmeaSentenceFromInfoFixed(buf->buffer, buf->bufferSize, info, mask);
+}
+
+/**
+ * Generate NMEA sentences from a sanitised NmeaInfo structure into a fixed
+ * buffer, optionally recording where each sentence is located.
+ *
+ * @param s The buffer
+ * @param sz The size of the buffer
+ * @param iov The vector in which to record the location of each sentence,
+ * can be NULL
+ * @param iovCount The number of entries in the vector
+ * @param iovUsed Where to store the number of used entries in the vector
+ * @param info The sanitised NmeaInfo structure
+ * @param mask The bit-mask of sentences to generate
+ * @return The total length of the generated sentences
+ */
+static size_t nmeaSentenceFromInfoInternal(char *s, const size_t sz, struct iovec *iov, const size_t iovCount,
+    size_t *iovUsed, const NmeaInfo *info, const NmeaSentence mask) {
+
+#define dst       (&s[chars])
+#define available (sz - chars)
+
+#define generateSentence(expression) { \
+  size_t addedChars; \
+  if (iov && (sentences >= iovCount)) { \
+    /* no entry left to record the sentence in: drop it (and all sentences after it) */ \
+    goto out; \
+  } \
+  addedChars = expression; \
+  if (addedChars >= available) { \
+    /* the sentence does not fit: drop it (and all sentences after it) */ \
+    goto out; \
+  } \
+  if (iov) { \
+    iov[sentences].iov_base = dst; \
+    iov[sentences].iov_len = addedChars; \
+  } \
+  sentences++; \
+  chars += addedChars; \
+}
 
-  chars = 0;
-  msk = mask;
+  size_t chars = 0;
+  size_t sentences = 0;
+  NmeaSentence msk = mask;
 
   while (msk) {
     if (msk & NMEALIB_SENTENCE_GPGGA) {
@@ -173,9 +292,9 @@ size_t nmeaSentenceFromInfo(NmeaMallocedBuffer *buf, const NmeaInfo *info, const
           0;
       NmeaGPGSV pack;
       size_t sentence;
-      size_t sentences = nmeaGPGSVsatellitesToSentencesCount(satCount);
+      size_t gpgsvSentences = nmeaGPGSVsatellitesToSentencesCount(satCount);
 
-      for (sentence = 0; sentence < sentences; sentence++) {
+      for (sentence = 0; sentence < gpgsvSentences; sentence++) {
         nmeaGPGSVFromInfo(info, &pack, sentence);
         generateSentence(nmeaGPGSVGenerate(dst, available, &pack));
       }
@@ -196,10 +315,12 @@ size_t nmeaSentenceFromInfo(NmeaMallocedBuffer *buf, const NmeaInfo *info, const
     }
   }
 
+out:
   s[chars] = '\0';
 
-  buf->buffer = s;
-  buf->bufferSize = sz;
+  if (iovUsed) {
+    *iovUsed = sentences;
+  }
 
   return chars;
 
@@ -208,3 +329,32 @@ size_t nmeaSentenceFromInfo(NmeaMallocedBuffer *buf, const NmeaInfo *info, const
 #undef dst
 
 }
+
+size_t nmeaSentenceFromInfoFixed(char *s, const size_t sz, const NmeaInfo *info, const NmeaSentence mask) {
+  if (!s //
+      || !sz //
+      || !info //
+      || !mask) {
+    return 0;
+  }
+
+  return nmeaSentenceFromInfoInternal(s, sz, NULL, 0, NULL, info, mask);
+}
+
+size_t nmeaSentenceFromInfoVector(char *s, const size_t sz, struct iovec *iov, const size_t iovCount,
+    const NmeaInfo *info, const NmeaSentence mask) {
+  size_t iovUsed = 0;
+
+  if (!s //
+      || !sz //
+      || !iov //
+      || !iovCount //
+      || !info //
+      || !mask) {
+    return 0;
+  }
+
+  nmeaSentenceFromInfoInternal(s, sz, iov, iovCount, &iovUsed, info, mask);
+
+  return iovUsed;
+}
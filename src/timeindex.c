@@ -0,0 +1,498 @@
+/*
+ * This file is part of nmealib.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <nmealib/timeindex.h>
+
+#include <nmealib/context.h>
+#include <nmealib/parser.h>
+#include <nmealib/sentence.h>
+#include <nmealib/util.h>
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+
+/** The size of the read buffer when building an index */
+#define NMEALIB_TIMEINDEX_READ_SIZE (64u * 1024u)
+
+/** The minimum number of allocated entries */
+#define NMEALIB_TIMEINDEX_GROW (256u)
+
+/**
+ * Time index builder state
+ */
+typedef struct _NmeaTimeIndexBuilder {
+    NmeaTimeIndex *index;   /**< the index                                              */
+    bool           dated;   /**< true when a date was seen                              */
+    int64_t        days;    /**< the days since the epoch of the current date           */
+    int64_t        last;    /**< the second of the day of the last entry, -1 for none   */
+    size_t         undated; /**< the number of (trailing) entries that have no date yet */
+} NmeaTimeIndexBuilder;
+
+/**
+ * Make room for a number of entries in a time index
+ *
+ * @param index The index
+ * @param count The number of entries
+ * @return True on success
+ */
+static bool nmeaTimeIndexGrow(NmeaTimeIndex *index, size_t count) {
+  NmeaTimeIndexEntry *entries;
+  size_t capacity;
+
+  if (count <= index->capacity) {
+    return true;
+  }
+
+  capacity = MAX(count, MAX(NMEALIB_TIMEINDEX_GROW, index->capacity * 2));
+  if (capacity > (SIZE_MAX / sizeof(index->entries[0]))) {
+    /* can't be covered in a test */
+    return false;
+  }
+
+  entries = realloc(index->entries, capacity * sizeof(index->entries[0]));
+  if (!entries) {
+    /* can't be covered in a test */
+    return false;
+  }
+
+  index->entries = entries;
+  index->capacity = capacity;
+
+  return true;
+}
+
+/**
+ * Add a sentence with a UTC time to a time index that is being built
+ *
+ * A second starts at the first sentence with its UTC time. Time that runs
+ * backwards by more than half a day is taken to have passed midnight, until
+ * a GPRMC sentence supplies the (new) date.
+ *
+ * @param builder The builder
+ * @param offset The byte offset of the sentence
+ * @param utc The UTC time (and date) of the sentence
+ * @param dated True when the UTC date of the sentence is present
+ * @return True on success
+ */
+static bool nmeaTimeIndexBuilderAdd(NmeaTimeIndexBuilder *builder, uint64_t offset, const NmeaTime *utc, bool dated) {
+  NmeaTimeIndex *index = builder->index;
+  int64_t second = ((int64_t) utc->hour * 3600) //
+      + ((int64_t) utc->min * 60) //
+      + (int64_t) utc->sec;
+
+  if (second != builder->last) {
+    NmeaTimeIndexEntry *entry;
+
+    if (!nmeaTimeIndexGrow(index, index->count + 1)) {
+      /* can't be covered in a test */
+      return false;
+    }
+
+    if (builder->dated //
+        && (builder->last >= 0) //
+        && ((builder->last - second) > 43200)) {
+      builder->days++;
+    }
+
+    entry = &index->entries[index->count++];
+    entry->offset = offset;
+    entry->time = second;
+    if (builder->dated) {
+      entry->time += builder->days * 86400;
+    } else {
+      builder->undated++;
+    }
+
+    builder->last = second;
+  }
+
+  if (dated) {
+    NmeaTime date = *utc;
+    int64_t days;
+    size_t i;
+
+    date.hour = 0;
+    date.min = 0;
+    date.sec = 0;
+    date.hsec = 0;
+    days = nmeaTimeToEpochSeconds(&date) / 86400;
+
+    if (!builder->dated) {
+      /* date the entries before the first date */
+      for (i = index->count - builder->undated; i < index->count; i++) {
+        NmeaTimeIndexEntry *entry = &index->entries[i];
+
+        entry->time += (days * 86400) - ((entry->time > second) ?
+            86400 :
+            0);
+      }
+
+      builder->undated = 0;
+      builder->dated = true;
+    } else {
+      /* (re)date the entry of this second */
+      index->entries[index->count - 1].time = (days * 86400) + second;
+    }
+
+    builder->days = days;
+  }
+
+  return true;
+}
+
+/**
+ * Add a sentence to a time index that is being built
+ *
+ * @param builder The builder
+ * @param offset The byte offset of the sentence
+ * @param s The sentence
+ * @param sz The length of the sentence
+ * @return True on success
+ */
+static bool nmeaTimeIndexBuilderSentence(NmeaTimeIndexBuilder *builder, uint64_t offset, const char *s, size_t sz) {
+  NmeaSentencePack pack;
+  NmeaTime utc;
+  bool dated;
+
+  /* only these sentences have a UTC time, don't parse the others */
+  if (!(nmeaSentenceFromPrefix(s, sz) & (NMEALIB_SENTENCE_GPGGA | NMEALIB_SENTENCE_GPRMC)) //
+      || !nmeaSentenceParse(s, sz, &pack) //
+      || !nmeaSentencePackUtc(&pack, &utc, &dated)) {
+    return true;
+  }
+
+  return nmeaTimeIndexBuilderAdd(builder, offset, &utc, dated);
+}
+
+/**
+ * Compare two time index entries on time and then on offset (qsort
+ * comparator)
+ *
+ * @param a The first entry
+ * @param b The second entry
+ * @return -1, 0 or 1
+ */
+static int nmeaTimeIndexCompare(const void *a, const void *b) {
+  const NmeaTimeIndexEntry *x = (const NmeaTimeIndexEntry *) a;
+  const NmeaTimeIndexEntry *y = (const NmeaTimeIndexEntry *) b;
+
+  if (x->time != y->time) {
+    return (x->time < y->time) ?
+        -1 :
+        1;
+  }
+
+  if (x->offset != y->offset) {
+    return (x->offset < y->offset) ?
+        -1 :
+        1;
+  }
+
+  return 0;
+}
+
+/**
+ * Sort the entries of a time index, unless they already are sorted (the
+ * normal case for a log)
+ *
+ * @param index The index
+ */
+static void nmeaTimeIndexSort(NmeaTimeIndex *index) {
+  size_t i;
+
+  for (i = 1; i < index->count; i++) {
+    if (nmeaTimeIndexCompare(&index->entries[i - 1], &index->entries[i]) > 0) {
+      qsort(index->entries, index->count, sizeof(index->entries[0]), nmeaTimeIndexCompare);
+      return;
+    }
+  }
+}
+
+/*
+ * Little-endian encoding
+ */
+
+static void nmeaTimeIndexPut(uint8_t *p, uint64_t v, size_t sz) {
+  size_t i;
+
+  for (i = 0; i < sz; i++) {
+    p[i] = (uint8_t) (v >> (8 * i));
+  }
+}
+
+static uint64_t nmeaTimeIndexGet(const uint8_t *p, size_t sz) {
+  uint64_t v = 0;
+  size_t i;
+
+  for (i = 0; i < sz; i++) {
+    v |= (uint64_t) p[i] << (8 * i);
+  }
+
+  return v;
+}
+
+/**
+ * Encode the header of a time index file
+ *
+ * @param buf The buffer of NMEALIB_TIMEINDEX_HEADER_SIZE bytes
+ */
+static void nmeaTimeIndexHeaderEncode(uint8_t *buf) {
+  memset(buf, 0, NMEALIB_TIMEINDEX_HEADER_SIZE);
+  nmeaTimeIndexPut(&buf[0], NMEALIB_TIMEINDEX_MAGIC, 4);
+  nmeaTimeIndexPut(&buf[4], NMEALIB_TIMEINDEX_VERSION, 2);
+  nmeaTimeIndexPut(&buf[6], NMEALIB_TIMEINDEX_HEADER_SIZE, 2);
+  nmeaTimeIndexPut(&buf[8], NMEALIB_TIMEINDEX_ENTRY_SIZE, 2);
+}
+
+void nmeaTimeIndexInit(NmeaTimeIndex *index) {
+  if (!index) {
+    return;
+  }
+
+  memset(index, 0, sizeof(*index));
+}
+
+void nmeaTimeIndexDestroy(NmeaTimeIndex *index) {
+  if (!index) {
+    return;
+  }
+
+  free(index->entries);
+  memset(index, 0, sizeof(*index));
+}
+
+bool nmeaTimeIndexBuild(NmeaTimeIndex *index, FILE *file) {
+  NmeaTimeIndexBuilder builder;
+  NmeaParser parser;
+  char *buf;
+  uint64_t base = 0;
+  uint64_t start = 0;
+  bool r = true;
+
+  if (!index //
+      || !file) {
+    return false;
+  }
+
+  if (fseeko(file, 0, SEEK_SET)) {
+    nmeaContextError("%s error: could not seek: %s", __FUNCTION__, strerror(errno));
+    return false;
+  }
+
+  buf = malloc(NMEALIB_TIMEINDEX_READ_SIZE);
+  if (!buf) {
+    /* can't be covered in a test */
+    return false;
+  }
+
+  if (!nmeaParserInit(&parser, 0)) {
+    /* can't be covered in a test */
+    free(buf);
+    return false;
+  }
+
+  memset(&builder, 0, sizeof(builder));
+  builder.index = index;
+  builder.last = -1;
+  index->count = 0;
+
+  while (r) {
+    size_t sz = fread(buf, 1, NMEALIB_TIMEINDEX_READ_SIZE, file);
+    size_t i;
+
+    for (i = 0; r && (i < sz); i++) {
+      if (buf[i] == '$') {
+        start = base + i;
+      }
+
+      if (nmeaParserProcessCharacter(&parser, &buf[i])) {
+        r = nmeaTimeIndexBuilderSentence(&builder, start, parser.buffer, parser.bufferLength);
+      }
+    }
+
+    base += sz;
+
+    if (sz < NMEALIB_TIMEINDEX_READ_SIZE) {
+      if (ferror(file)) {
+        nmeaContextError("%s error: could not read: %s", __FUNCTION__, strerror(errno));
+        r = false;
+      }
+      break;
+    }
+  }
+
+  nmeaParserDestroy(&parser);
+  free(buf);
+
+  if (!r) {
+    index->count = 0;
+    return false;
+  }
+
+  nmeaTimeIndexSort(index);
+
+  return true;
+}
+
+bool nmeaTimeIndexWrite(const NmeaTimeIndex *index, const char *path) {
+  uint8_t buf[NMEALIB_TIMEINDEX_HEADER_SIZE];
+  FILE *file;
+  bool r;
+  size_t i;
+
+  if (!index //
+      || !path) {
+    return false;
+  }
+
+  file = fopen(path, "wb");
+  if (!file) {
+    nmeaContextError("%s error: could not open %s: %s", __FUNCTION__, path, strerror(errno));
+    return false;
+  }
+
+  nmeaTimeIndexHeaderEncode(buf);
+  r = (fwrite(buf, sizeof(buf), 1, file) == 1);
+
+  for (i = 0; r && (i < index->count); i++) {
+    uint8_t entry[NMEALIB_TIMEINDEX_ENTRY_SIZE];
+
+    nmeaTimeIndexPut(&entry[0], (uint64_t) index->entries[i].time, 8);
+    nmeaTimeIndexPut(&entry[8], index->entries[i].offset, 8);
+    r = (fwrite(entry, sizeof(entry), 1, file) == 1);
+  }
+
+  if (fclose(file)) {
+    /* can't be covered in a test */
+    r = false;
+  }
+
+  if (!r) {
+    /* can't be covered in a test */
+    nmeaContextError("%s error: could not write to %s", __FUNCTION__, path);
+  }
+
+  return r;
+}
+
+bool nmeaTimeIndexRead(NmeaTimeIndex *index, const char *path) {
+  uint8_t header[NMEALIB_TIMEINDEX_HEADER_SIZE];
+  uint8_t expected[NMEALIB_TIMEINDEX_HEADER_SIZE];
+  uint8_t entry[NMEALIB_TIMEINDEX_ENTRY_SIZE];
+  FILE *file;
+  bool r = true;
+
+  if (!index //
+      || !path) {
+    return false;
+  }
+
+  file = fopen(path, "rb");
+  if (!file) {
+    nmeaContextError("%s error: could not open %s: %s", __FUNCTION__, path, strerror(errno));
+    return false;
+  }
+
+  nmeaTimeIndexHeaderEncode(expected);
+  if ((fread(header, sizeof(header), 1, file) != 1) //
+      || memcmp(header, expected, sizeof(header))) {
+    nmeaContextError("%s error: %s is not a time index file with layout version %u", __FUNCTION__, path,
+        NMEALIB_TIMEINDEX_VERSION);
+    fclose(file);
+    return false;
+  }
+
+  index->count = 0;
+
+  while (fread(entry, sizeof(entry), 1, file) == 1) {
+    NmeaTimeIndexEntry *e;
+
+    if (!nmeaTimeIndexGrow(index, index->count + 1)) {
+      /* can't be covered in a test */
+      r = false;
+      break;
+    }
+
+    e = &index->entries[index->count++];
+    e->time = (int64_t) nmeaTimeIndexGet(&entry[0], 8);
+    e->offset = nmeaTimeIndexGet(&entry[8], 8);
+  }
+
+  if (ferror(file)) {
+    /* can't be covered in a test */
+    nmeaContextError("%s error: could not read %s", __FUNCTION__, path);
+    r = false;
+  }
+
+  fclose(file);
+
+  if (!r) {
+    /* can't be covered in a test */
+    index->count = 0;
+    return false;
+  }
+
+  /* a hand-made sidecar file might not be sorted */
+  nmeaTimeIndexSort(index);
+
+  return true;
+}
+
+size_t nmeaTimeIndexFind(const NmeaTimeIndex *index, int64_t t) {
+  size_t lo = 0;
+  size_t hi;
+
+  if (!index) {
+    return 0;
+  }
+
+  hi = index->count;
+  while (lo < hi) {
+    size_t mid = lo + ((hi - lo) / 2);
+
+    if (index->entries[mid].time < t) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+
+  return lo;
+}
+
+bool nmeaParserSeekTime(FILE *file, const NmeaTimeIndex *index, int64_t t) {
+  size_t i;
+
+  if (!file //
+      || !index) {
+    return false;
+  }
+
+  i = nmeaTimeIndexFind(index, t);
+  if (i >= index->count) {
+    return false;
+  }
+
+  if (index->entries[i].offset > (uint64_t) INT64_MAX //
+      || fseeko(file, (off_t) index->entries[i].offset, SEEK_SET)) {
+    nmeaContextError("%s error: could not seek: %s", __FUNCTION__, strerror(errno));
+    return false;
+  }
+
+  return true;
+}
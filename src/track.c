@@ -0,0 +1,294 @@
+/*
+ * This file is part of nmealib.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <nmealib/track.h>
+
+#include <nmealib/nmath.h>
+#include <nmealib/util.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+/** The capacity of a track when it grows for the first time */
+#define NMEALIB_TRACK_CAPACITY_MIN (64u)
+
+/**
+ * Grow a column
+ *
+ * The column is left alone when there is not enough memory.
+ *
+ * @param column The column
+ * @param capacity The new capacity, in entries
+ * @param size The size of an entry
+ * @return True on success
+ */
+static bool nmeaTrackColumnGrow(void **column, size_t capacity, size_t size) {
+  void *grown = realloc(*column, capacity * size);
+
+  if (!grown) {
+    /* can't be covered in a test */
+    return false;
+  }
+
+  *column = grown;
+  return true;
+}
+
+/**
+ * Get the time of an info structure in nanoseconds
+ *
+ * @param info The info structure
+ * @return The time in nanoseconds since the epoch when the utc date is
+ * present, otherwise since midnight
+ */
+static int64_t nmeaTrackTime(const NmeaInfo *info) {
+  NmeaTime utc = info->utc;
+
+  if (!nmeaInfoIsPresentAll(info->present, NMEALIB_PRESENT_UTCDATE)) {
+    utc.year = 1970;
+    utc.mon = 1;
+    utc.day = 1;
+  }
+
+  return nmeaTimeToEpochNs(&utc);
+}
+
+/**
+ * Store a fix in a track, there must be room for it
+ *
+ * @param track The track
+ * @param info The fix
+ * @param nan NaN
+ */
+static void nmeaTrackStore(NmeaTrack *track, const NmeaInfo *info, double nan) {
+  size_t i = track->count++;
+  uint32_t present = info->present;
+
+  track->present[i] = present;
+
+  track->time[i] = nmeaInfoIsPresentAny(present, NMEALIB_PRESENT_UTCDATE | NMEALIB_PRESENT_UTCTIME) ?
+      nmeaTrackTime(info) :
+      0;
+
+  if (info->metric) {
+    track->lat[i] = nmeaInfoIsPresentAll(present, NMEALIB_PRESENT_LAT) ?
+        nmeaMathDegreeToRadian(info->latitude) :
+        nan;
+    track->lon[i] = nmeaInfoIsPresentAll(present, NMEALIB_PRESENT_LON) ?
+        nmeaMathDegreeToRadian(info->longitude) :
+        nan;
+    track->hdop[i] = nmeaInfoIsPresentAll(present, NMEALIB_PRESENT_HDOP) ?
+        nmeaMathMetersToDop(info->hdop) :
+        nan;
+  } else {
+    track->lat[i] = nmeaInfoIsPresentAll(present, NMEALIB_PRESENT_LAT) ?
+        nmeaMathNdegToRadian(info->latitude) :
+        nan;
+    track->lon[i] = nmeaInfoIsPresentAll(present, NMEALIB_PRESENT_LON) ?
+        nmeaMathNdegToRadian(info->longitude) :
+        nan;
+    track->hdop[i] = nmeaInfoIsPresentAll(present, NMEALIB_PRESENT_HDOP) ?
+        info->hdop :
+        nan;
+  }
+
+  track->elevation[i] = nmeaInfoIsPresentAll(present, NMEALIB_PRESENT_ELV) ?
+      info->elevation :
+      nan;
+  track->speed[i] = nmeaInfoIsPresentAll(present, NMEALIB_PRESENT_SPEED) ?
+      info->speed :
+      nan;
+  track->track[i] = nmeaInfoIsPresentAll(present, NMEALIB_PRESENT_TRACK) ?
+      info->track :
+      nan;
+  track->sig[i] = nmeaInfoIsPresentAll(present, NMEALIB_PRESENT_SIG) ?
+      info->sig :
+      NMEALIB_SIG_INVALID;
+  track->fix[i] = nmeaInfoIsPresentAll(present, NMEALIB_PRESENT_FIX) ?
+      info->fix :
+      NMEALIB_FIX_BAD;
+}
+
+/**
+ * Make sure that a track has room for a number of additional fixes,
+ * growing it with at least a factor of two
+ *
+ * @param track The track
+ * @param count The number of additional fixes
+ * @return True on success
+ */
+static bool nmeaTrackGrow(NmeaTrack *track, size_t count) {
+  size_t needed = track->count + count;
+  size_t capacity;
+
+  if (needed <= track->capacity) {
+    return true;
+  }
+
+  capacity = MAX(MAX(track->capacity * 2, NMEALIB_TRACK_CAPACITY_MIN), needed);
+  return nmeaTrackReserve(track, capacity);
+}
+
+bool nmeaTrackInit(NmeaTrack *track, size_t capacity) {
+  if (!track) {
+    return false;
+  }
+
+  memset(track, 0, sizeof(*track));
+
+  if (!capacity) {
+    return true;
+  }
+
+  if (!nmeaTrackReserve(track, capacity)) {
+    /* can't be covered in a test */
+    nmeaTrackDestroy(track);
+    return false;
+  }
+
+  return true;
+}
+
+void nmeaTrackDestroy(NmeaTrack *track) {
+  if (!track) {
+    return;
+  }
+
+  free(track->present);
+  free(track->time);
+  free(track->lat);
+  free(track->lon);
+  free(track->elevation);
+  free(track->speed);
+  free(track->track);
+  free(track->hdop);
+  free(track->sig);
+  free(track->fix);
+  memset(track, 0, sizeof(*track));
+}
+
+void nmeaTrackClear(NmeaTrack *track) {
+  if (!track) {
+    return;
+  }
+
+  track->count = 0;
+}
+
+bool nmeaTrackReserve(NmeaTrack *track, size_t capacity) {
+  if (!track) {
+    return false;
+  }
+
+  if (capacity <= track->capacity) {
+    return true;
+  }
+
+  /* a column that grew before a failure is just bigger than needed */
+  if (!nmeaTrackColumnGrow((void **) &track->present, capacity, sizeof(track->present[0])) //
+      || !nmeaTrackColumnGrow((void **) &track->time, capacity, sizeof(track->time[0])) //
+      || !nmeaTrackColumnGrow((void **) &track->lat, capacity, sizeof(track->lat[0])) //
+      || !nmeaTrackColumnGrow((void **) &track->lon, capacity, sizeof(track->lon[0])) //
+      || !nmeaTrackColumnGrow((void **) &track->elevation, capacity, sizeof(track->elevation[0])) //
+      || !nmeaTrackColumnGrow((void **) &track->speed, capacity, sizeof(track->speed[0])) //
+      || !nmeaTrackColumnGrow((void **) &track->track, capacity, sizeof(track->track[0])) //
+      || !nmeaTrackColumnGrow((void **) &track->hdop, capacity, sizeof(track->hdop[0])) //
+      || !nmeaTrackColumnGrow((void **) &track->sig, capacity, sizeof(track->sig[0])) //
+      || !nmeaTrackColumnGrow((void **) &track->fix, capacity, sizeof(track->fix[0]))) {
+    /* can't be covered in a test */
+    return false;
+  }
+
+  track->capacity = capacity;
+  return true;
+}
+
+bool nmeaTrackAppend(NmeaTrack *track, const NmeaInfo *info) {
+  return nmeaTrackAppendInfos(track, info, 1);
+}
+
+bool nmeaTrackAppendInfos(NmeaTrack *track, const NmeaInfo *infos, size_t count) {
+  double nan = NaN;
+  size_t i;
+
+  if (!track //
+      || !infos) {
+    return false;
+  }
+
+  if (!nmeaTrackGrow(track, count)) {
+    /* can't be covered in a test */
+    return false;
+  }
+
+  for (i = 0; i < count; i++) {
+    nmeaTrackStore(track, &infos[i], nan);
+  }
+
+  return true;
+}
+
+void nmeaTrackEpochHandler(void *user, const NmeaEpoch *epoch) {
+  if (!epoch) {
+    return;
+  }
+
+  nmeaTrackAppend((NmeaTrack *) user, &epoch->info);
+}
+
+bool nmeaTrackPosition(const NmeaTrack *track, size_t index, NmeaPosition *pos) {
+  if (!track //
+      || (index >= track->count) //
+      || !pos) {
+    return false;
+  }
+
+  pos->lat = track->lat[index];
+  pos->lon = track->lon[index];
+  return true;
+}
+
+double nmeaTrackDistances(const NmeaTrack *track, double *distances) {
+  NmeaPosition from;
+  NmeaPosition to;
+  double total = 0.0;
+  size_t i;
+
+  if (!track //
+      || !distances //
+      || !track->count) {
+    return 0.0;
+  }
+
+  distances[0] = 0.0;
+  from.lat = track->lat[0];
+  from.lon = track->lon[0];
+
+  for (i = 1; i < track->count; i++) {
+    to.lat = track->lat[i];
+    to.lon = track->lon[i];
+
+    distances[i] = nmeaMathDistance(&from, &to);
+    if (!isnan(distances[i])) {
+      total += distances[i];
+    }
+
+    from = to;
+  }
+
+  return total;
+}
@@ -0,0 +1,477 @@
+/*
+ * This file is part of nmealib.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <nmealib/trackcodec.h>
+
+#include <nmealib/info.h>
+#include <string.h>
+
+/** The present and smask fields follow */
+#define NMEALIB_TRACKCODEC_PRESENT (0x01u)
+
+/** The sig, fix and satellite count fields follow */
+#define NMEALIB_TRACKCODEC_STATUS  (0x02u)
+
+/** The pdop, hdop and vdop fields follow */
+#define NMEALIB_TRACKCODEC_DOP     (0x04u)
+
+/** The track, mtrack and magvar fields follow */
+#define NMEALIB_TRACKCODEC_ANGLES  (0x08u)
+
+/** The dgpsAge and dgpsSid fields follow */
+#define NMEALIB_TRACKCODEC_DGPS    (0x10u)
+
+/** The height field follows */
+#define NMEALIB_TRACKCODEC_HEIGHT  (0x20u)
+
+/** The utc follows as is, instead of as a predicted time */
+#define NMEALIB_TRACKCODEC_UTC     (0x40u)
+
+/** The flags that are defined */
+#define NMEALIB_TRACKCODEC_FLAGS   (0x7fu)
+
+/** The maximum length of a varint of 64 bits */
+#define NMEALIB_TRACKCODEC_VARINT_MAX (10u)
+
+/** The earliest time that is encoded as a time: 0100-01-01 00:00:00.00, in hundredths of a second since the epoch */
+#define NMEALIB_TRACKCODEC_TIME_MIN (-5901145920000LL)
+
+/** The latest time that is encoded as a time: 65535-12-31 23:59:59.99, in hundredths of a second since the epoch */
+#define NMEALIB_TRACKCODEC_TIME_MAX (200594914559999LL)
+
+/*
+ * Varints
+ */
+
+static uint64_t nmeaTrackCodecZigzag(int64_t v) {
+  return ((uint64_t) v << 1) ^ (uint64_t) (v >> 63);
+}
+
+static int64_t nmeaTrackCodecUnzigzag(uint64_t v) {
+  return (int64_t) (v >> 1) ^ -(int64_t) (v & 1);
+}
+
+static void nmeaTrackCodecPut(uint8_t **p, uint64_t v) {
+  while (v >= 0x80) {
+    *(*p)++ = (uint8_t) (v | 0x80);
+    v >>= 7;
+  }
+
+  *(*p)++ = (uint8_t) v;
+}
+
+static void nmeaTrackCodecPutSigned(uint8_t **p, int64_t v) {
+  nmeaTrackCodecPut(p, nmeaTrackCodecZigzag(v));
+}
+
+static bool nmeaTrackCodecGet(const uint8_t **p, const uint8_t *end, uint64_t *v) {
+  uint64_t r = 0;
+  unsigned int shift = 0;
+  size_t i;
+
+  for (i = 0; (i < NMEALIB_TRACKCODEC_VARINT_MAX) && (*p < end); i++) {
+    uint8_t b = *(*p)++;
+
+    r |= (uint64_t) (b & 0x7f) << shift;
+    if (!(b & 0x80)) {
+      *v = r;
+      return true;
+    }
+
+    shift += 7;
+  }
+
+  return false;
+}
+
+/**
+ * Add a decoded difference to a value, wrapping around instead of
+ * overflowing on corrupt input
+ *
+ * @param v The value
+ * @param d The difference
+ * @return The sum
+ */
+static int64_t nmeaTrackCodecAdd(int64_t v, int64_t d) {
+  return (int64_t) ((uint64_t) v + (uint64_t) d);
+}
+
+static bool nmeaTrackCodecGetSigned(const uint8_t **p, const uint8_t *end, int64_t *v) {
+  uint64_t u;
+
+  if (!nmeaTrackCodecGet(p, end, &u)) {
+    return false;
+  }
+
+  *v = nmeaTrackCodecUnzigzag(u);
+  return true;
+}
+
+static bool nmeaTrackCodecGetBytes(const uint8_t **p, const uint8_t *end, uint8_t *bytes, size_t count) {
+  if ((size_t) (end - *p) < count) {
+    return false;
+  }
+
+  memcpy(bytes, *p, count);
+  *p += count;
+  return true;
+}
+
+/*
+ * Time
+ */
+
+/**
+ * Get the utc of a time in hundredths of a second
+ *
+ * @param time The time in hundredths of a second since the epoch, or since
+ * midnight when the date is not present
+ * @param present The NmeaPresence bits of the record
+ * @param utc The utc
+ */
+static void nmeaTrackCodecUtc(int64_t time, uint32_t present, NmeaTimeCompact *utc) {
+  int64_t seconds = (time - ((time < 0) ?
+      99 :
+      0)) / 100;
+  NmeaTime t;
+
+  nmeaTimeFromEpochSeconds(seconds, (unsigned int) (time - (seconds * 100)), &t);
+  memset(utc, 0, sizeof(*utc));
+
+  if (present & NMEALIB_PRESENT_UTCDATE) {
+    utc->year = (uint16_t) t.year;
+    utc->mon = (uint8_t) t.mon;
+    utc->day = (uint8_t) t.day;
+  }
+
+  if (present & NMEALIB_PRESENT_UTCTIME) {
+    utc->hour = (uint8_t) t.hour;
+    utc->min = (uint8_t) t.min;
+    utc->sec = (uint8_t) t.sec;
+    utc->hsec = (uint8_t) t.hsec;
+  }
+}
+
+/**
+ * Get the time of a record in hundredths of a second
+ *
+ * @param record The record
+ * @param time Where to store the time, in hundredths of a second since the
+ * epoch, or since midnight when the date is not present
+ * @return True when the utc of the record follows from the time, false for
+ * a utc that is not a valid date and time, or that is not present but not
+ * zero
+ */
+static bool nmeaTrackCodecTime(const NmeaRecord *record, int64_t *time) {
+  NmeaTimeCompact utc;
+  NmeaTime t;
+
+  t.year = 1970;
+  t.mon = 1;
+  t.day = 1;
+  if (record->present & NMEALIB_PRESENT_UTCDATE) {
+    t.year = record->utc.year;
+    t.mon = record->utc.mon;
+    t.day = record->utc.day;
+  }
+
+  t.hour = record->utc.hour;
+  t.min = record->utc.min;
+  t.sec = record->utc.sec;
+  t.hsec = record->utc.hsec;
+
+  *time = (nmeaTimeToEpochSeconds(&t) * 100) + (int64_t) t.hsec;
+
+  nmeaTrackCodecUtc(*time, record->present, &utc);
+  return !memcmp(&utc, &record->utc, sizeof(utc));
+}
+
+/*
+ * Codec
+ */
+
+void nmeaTrackCodecInit(NmeaTrackCodec *codec, size_t blockSize) {
+  if (!codec) {
+    return;
+  }
+
+  codec->blockSize = blockSize;
+  nmeaTrackCodecReset(codec);
+}
+
+void nmeaTrackCodecReset(NmeaTrackCodec *codec) {
+  if (!codec) {
+    return;
+  }
+
+  codec->index = 0;
+  memset(&codec->previous, 0, sizeof(codec->previous));
+  codec->time = 0;
+  codec->timeRate = 0;
+  codec->latRate = 0;
+  codec->lonRate = 0;
+}
+
+bool nmeaTrackCodecIsBlockStart(const NmeaTrackCodec *codec) {
+  if (!codec) {
+    return false;
+  }
+
+  return !codec->index;
+}
+
+/**
+ * Advance the codec to the next record, resetting it at the end of a block
+ *
+ * @param codec The codec
+ * @param record The record that was encoded or decoded
+ */
+static void nmeaTrackCodecNext(NmeaTrackCodec *codec, const NmeaRecord *record) {
+  codec->latRate = (int64_t) record->latitude - (int64_t) codec->previous.latitude;
+  codec->lonRate = (int64_t) record->longitude - (int64_t) codec->previous.longitude;
+  codec->previous = *record;
+  codec->index++;
+
+  if (codec->blockSize //
+      && (codec->index >= codec->blockSize)) {
+    nmeaTrackCodecReset(codec);
+  }
+}
+
+size_t nmeaTrackCodecEncode(NmeaTrackCodec *codec, const NmeaRecord *record, uint8_t *buf) {
+  const NmeaRecord *previous;
+  uint8_t *p = buf + 1;
+  uint8_t flags = 0;
+  int64_t time;
+
+  if (!codec //
+      || !record //
+      || !buf) {
+    return 0;
+  }
+
+  previous = &codec->previous;
+
+  if (nmeaTrackCodecTime(record, &time)) {
+    nmeaTrackCodecPutSigned(&p, time - (codec->time + codec->timeRate));
+    codec->timeRate = time - codec->time;
+    codec->time = time;
+  } else {
+    flags |= NMEALIB_TRACKCODEC_UTC;
+    nmeaTrackCodecPut(&p, record->utc.year);
+    *p++ = record->utc.mon;
+    *p++ = record->utc.day;
+    *p++ = record->utc.hour;
+    *p++ = record->utc.min;
+    *p++ = record->utc.sec;
+    *p++ = record->utc.hsec;
+  }
+
+  nmeaTrackCodecPutSigned(&p, (int64_t) record->latitude - ((int64_t) previous->latitude + codec->latRate));
+  nmeaTrackCodecPutSigned(&p, (int64_t) record->longitude - ((int64_t) previous->longitude + codec->lonRate));
+  nmeaTrackCodecPutSigned(&p, (int64_t) record->elevation - (int64_t) previous->elevation);
+  nmeaTrackCodecPutSigned(&p, (int64_t) record->speed - (int64_t) previous->speed);
+
+  if ((record->present != previous->present) //
+      || (record->smask != previous->smask)) {
+    flags |= NMEALIB_TRACKCODEC_PRESENT;
+    nmeaTrackCodecPut(&p, record->present);
+    nmeaTrackCodecPut(&p, record->smask);
+  }
+
+  if ((record->sig != previous->sig) //
+      || (record->fix != previous->fix) //
+      || (record->inUseCount != previous->inUseCount) //
+      || (record->inViewCount != previous->inViewCount)) {
+    flags |= NMEALIB_TRACKCODEC_STATUS;
+    *p++ = record->sig;
+    *p++ = record->fix;
+    *p++ = record->inUseCount;
+    *p++ = record->inViewCount;
+  }
+
+  if ((record->pdop != previous->pdop) //
+      || (record->hdop != previous->hdop) //
+      || (record->vdop != previous->vdop)) {
+    flags |= NMEALIB_TRACKCODEC_DOP;
+    nmeaTrackCodecPutSigned(&p, (int64_t) record->pdop - (int64_t) previous->pdop);
+    nmeaTrackCodecPutSigned(&p, (int64_t) record->hdop - (int64_t) previous->hdop);
+    nmeaTrackCodecPutSigned(&p, (int64_t) record->vdop - (int64_t) previous->vdop);
+  }
+
+  if ((record->track != previous->track) //
+      || (record->mtrack != previous->mtrack) //
+      || (record->magvar != previous->magvar)) {
+    flags |= NMEALIB_TRACKCODEC_ANGLES;
+    nmeaTrackCodecPutSigned(&p, (int64_t) record->track - (int64_t) previous->track);
+    nmeaTrackCodecPutSigned(&p, (int64_t) record->mtrack - (int64_t) previous->mtrack);
+    nmeaTrackCodecPutSigned(&p, (int64_t) record->magvar - (int64_t) previous->magvar);
+  }
+
+  if ((record->dgpsAge != previous->dgpsAge) //
+      || (record->dgpsSid != previous->dgpsSid)) {
+    flags |= NMEALIB_TRACKCODEC_DGPS;
+    nmeaTrackCodecPutSigned(&p, (int64_t) record->dgpsAge - (int64_t) previous->dgpsAge);
+    nmeaTrackCodecPut(&p, record->dgpsSid);
+  }
+
+  if (record->height != previous->height) {
+    flags |= NMEALIB_TRACKCODEC_HEIGHT;
+    nmeaTrackCodecPutSigned(&p, (int64_t) record->height - (int64_t) previous->height);
+  }
+
+  buf[0] = flags;
+  nmeaTrackCodecNext(codec, record);
+
+  return (size_t) (p - buf);
+}
+
+size_t nmeaTrackCodecDecode(NmeaTrackCodec *codec, const uint8_t *buf, size_t sz, NmeaRecord *record) {
+  const uint8_t *end = buf + sz;
+  const uint8_t *p = buf;
+  const NmeaRecord *previous;
+  NmeaRecord r;
+  uint8_t flags;
+  uint8_t bytes[6];
+  uint64_t u[2];
+  int64_t v[3];
+  int64_t time = 0;
+  bool timed;
+
+  if (!codec //
+      || !buf //
+      || !sz //
+      || !record) {
+    return 0;
+  }
+
+  previous = &codec->previous;
+  r = *previous;
+  flags = *p++;
+  if (flags & ~NMEALIB_TRACKCODEC_FLAGS) {
+    return 0;
+  }
+
+  timed = !(flags & NMEALIB_TRACKCODEC_UTC);
+
+  if (timed) {
+    int64_t predicted = codec->time + codec->timeRate;
+
+    /* corrupt input: a time that the encoder can't have produced */
+    if (!nmeaTrackCodecGetSigned(&p, end, &v[0]) //
+        || (v[0] < (NMEALIB_TRACKCODEC_TIME_MIN - predicted)) //
+        || (v[0] > (NMEALIB_TRACKCODEC_TIME_MAX - predicted))) {
+      return 0;
+    }
+    time = predicted + v[0];
+  } else {
+    if (!nmeaTrackCodecGet(&p, end, &u[0]) //
+        || !nmeaTrackCodecGetBytes(&p, end, bytes, 6)) {
+      return 0;
+    }
+    r.utc.year = (uint16_t) u[0];
+    r.utc.mon = bytes[0];
+    r.utc.day = bytes[1];
+    r.utc.hour = bytes[2];
+    r.utc.min = bytes[3];
+    r.utc.sec = bytes[4];
+    r.utc.hsec = bytes[5];
+  }
+
+  if (!nmeaTrackCodecGetSigned(&p, end, &v[0]) //
+      || !nmeaTrackCodecGetSigned(&p, end, &v[1])) {
+    return 0;
+  }
+  r.latitude = (int32_t) nmeaTrackCodecAdd((int64_t) previous->latitude + codec->latRate, v[0]);
+  r.longitude = (int32_t) nmeaTrackCodecAdd((int64_t) previous->longitude + codec->lonRate, v[1]);
+
+  if (!nmeaTrackCodecGetSigned(&p, end, &v[0]) //
+      || !nmeaTrackCodecGetSigned(&p, end, &v[1])) {
+    return 0;
+  }
+  r.elevation = (int32_t) nmeaTrackCodecAdd((int64_t) previous->elevation, v[0]);
+  r.speed = (uint32_t) nmeaTrackCodecAdd((int64_t) previous->speed, v[1]);
+
+  if (flags & NMEALIB_TRACKCODEC_PRESENT) {
+    if (!nmeaTrackCodecGet(&p, end, &u[0]) //
+        || !nmeaTrackCodecGet(&p, end, &u[1])) {
+      return 0;
+    }
+    r.present = (uint32_t) u[0];
+    r.smask = (uint32_t) u[1];
+  }
+
+  if (flags & NMEALIB_TRACKCODEC_STATUS) {
+    if (!nmeaTrackCodecGetBytes(&p, end, bytes, 4)) {
+      return 0;
+    }
+    r.sig = bytes[0];
+    r.fix = bytes[1];
+    r.inUseCount = bytes[2];
+    r.inViewCount = bytes[3];
+  }
+
+  if (flags & NMEALIB_TRACKCODEC_DOP) {
+    if (!nmeaTrackCodecGetSigned(&p, end, &v[0]) //
+        || !nmeaTrackCodecGetSigned(&p, end, &v[1]) //
+        || !nmeaTrackCodecGetSigned(&p, end, &v[2])) {
+      return 0;
+    }
+    r.pdop = (uint16_t) nmeaTrackCodecAdd((int64_t) previous->pdop, v[0]);
+    r.hdop = (uint16_t) nmeaTrackCodecAdd((int64_t) previous->hdop, v[1]);
+    r.vdop = (uint16_t) nmeaTrackCodecAdd((int64_t) previous->vdop, v[2]);
+  }
+
+  if (flags & NMEALIB_TRACKCODEC_ANGLES) {
+    if (!nmeaTrackCodecGetSigned(&p, end, &v[0]) //
+        || !nmeaTrackCodecGetSigned(&p, end, &v[1]) //
+        || !nmeaTrackCodecGetSigned(&p, end, &v[2])) {
+      return 0;
+    }
+    r.track = (uint16_t) nmeaTrackCodecAdd((int64_t) previous->track, v[0]);
+    r.mtrack = (uint16_t) nmeaTrackCodecAdd((int64_t) previous->mtrack, v[1]);
+    r.magvar = (uint16_t) nmeaTrackCodecAdd((int64_t) previous->magvar, v[2]);
+  }
+
+  if (flags & NMEALIB_TRACKCODEC_DGPS) {
+    if (!nmeaTrackCodecGetSigned(&p, end, &v[0]) //
+        || !nmeaTrackCodecGet(&p, end, &u[0])) {
+      return 0;
+    }
+    r.dgpsAge = (uint16_t) nmeaTrackCodecAdd((int64_t) previous->dgpsAge, v[0]);
+    r.dgpsSid = (uint16_t) u[0];
+  }
+
+  if (flags & NMEALIB_TRACKCODEC_HEIGHT) {
+    if (!nmeaTrackCodecGetSigned(&p, end, &v[0])) {
+      return 0;
+    }
+    r.height = (int32_t) nmeaTrackCodecAdd((int64_t) previous->height, v[0]);
+  }
+
+  /* the utc follows from the time and the (decoded) present field */
+  if (timed) {
+    nmeaTrackCodecUtc(time, r.present, &r.utc);
+    codec->timeRate = time - codec->time;
+    codec->time = time;
+  }
+
+  *record = r;
+  nmeaTrackCodecNext(codec, &r);
+
+  return (size_t) (p - buf);
+}
@@ -33,15 +33,49 @@
 /** The maximum size of a string-to-number conversion buffer*/
 #define NMEALIB_CONVSTR_BUF    64
 
+/** The state of the pseudo random number generator of a thread, zero when not seeded */
+static __thread uint64_t nmeaRandomThreadState = 0;
+
 void nmeaRandomInit(void) {
   srandom((unsigned int) time(NULL));
 }
 
+void nmeaRandomSeedThread(uint64_t seed) {
+  uint64_t z;
+
+  if (!seed) {
+    nmeaRandomThreadState = 0;
+    return;
+  }
+
+  /* splitmix64, to spread the seed over all bits */
+  z = seed + 0x9E3779B97F4A7C15ULL;
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  z = z ^ (z >> 31);
+
+  nmeaRandomThreadState = z ?
+      z :
+      0x9E3779B97F4A7C15ULL;
+}
+
 double nmeaRandom(const double min, const double max) {
   long value;
   int randomFile;
   double range = fabs(max - min);
 
+  if (nmeaRandomThreadState) {
+    /* xorshift64* */
+    uint64_t x = nmeaRandomThreadState;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    nmeaRandomThreadState = x;
+
+    /* use the upper 53 bits: [0, 1] */
+    return min + (((double) ((x * 0x2545F4914F6CDD1DULL) >> 11) * range) / 9007199254740991.0);
+  }
+
   randomFile = open("/dev/urandom", O_RDONLY);
   if (randomFile == -1) {
     /* can't be covered in a test */
@@ -242,6 +276,11 @@ int nmeaAppendChecksum(char *s, size_t sz, size_t len) {
     return 0;
   }
 
+  if (len >= sz) {
+    /* nothing will be written, so don't read beyond the buffer for the checksum */
+    return snprintf(NULL, 0, "*%02X\r\n", 0);
+  }
+
   return snprintf(dst, available, "*%02X\r\n", nmeaCalculateCRC(s, len));
 
 #undef available
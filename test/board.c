@@ -0,0 +1,378 @@
+/*
+ * This file is part of nmealib.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "testHelpers.h"
+
+#include <nmealib/board.h>
+#include <CUnit/Basic.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+int boardSuiteSetup(void);
+
+#define BOARD_TEST_NAME "/nmealib-test-board"
+
+/*
+ * Tests
+ */
+
+static void test_nmeaBoardCreate(void) {
+  NmeaBoard *board;
+  NmeaInfo info;
+
+  memset(&info, 0, sizeof(info));
+
+  /* invalid inputs */
+
+  board = nmeaBoardCreate(NULL, 1);
+  CU_ASSERT_PTR_NULL(board);
+
+  board = nmeaBoardCreate(BOARD_TEST_NAME, 0);
+  CU_ASSERT_PTR_NULL(board);
+
+  board = nmeaBoardCreate(BOARD_TEST_NAME, SIZE_MAX);
+  CU_ASSERT_PTR_NULL(board);
+
+  board = nmeaBoardOpen(NULL);
+  CU_ASSERT_PTR_NULL(board);
+
+  board = nmeaBoardOpen("/nmealib-test-board-does-not-exist");
+  CU_ASSERT_PTR_NULL(board);
+
+  nmeaBoardClose(NULL);
+  CU_ASSERT_EQUAL(nmeaBoardUnlink(NULL), false);
+  CU_ASSERT_EQUAL(nmeaBoardDevices(NULL), 0);
+  CU_ASSERT_EQUAL(nmeaBoardPublish(NULL, 0, &info), false);
+  CU_ASSERT_EQUAL(nmeaBoardSnapshot(NULL, 0, &info, NULL), false);
+  CU_ASSERT_EQUAL(nmeaBoardSequence(NULL, 0), 0);
+
+  validateContext(0, 1);
+}
+
+static void test_nmeaBoardPublish(void) {
+  NmeaBoard *writer;
+  NmeaBoard *reader;
+  NmeaInfo info;
+  NmeaInfo snapshot;
+  uint32_t sequence;
+  bool r;
+
+  memset(&info, 0, sizeof(info));
+  memset(&snapshot, 0xaa, sizeof(snapshot));
+
+  writer = nmeaBoardCreate(BOARD_TEST_NAME, 3);
+  CU_ASSERT_PTR_NOT_NULL_FATAL(writer);
+  CU_ASSERT_EQUAL(nmeaBoardDevices(writer), 3);
+
+  reader = nmeaBoardOpen(BOARD_TEST_NAME);
+  CU_ASSERT_PTR_NOT_NULL_FATAL(reader);
+  CU_ASSERT_EQUAL(nmeaBoardDevices(reader), 3);
+
+  /* initially cleared */
+
+  sequence = 42;
+  r = nmeaBoardSnapshot(reader, 2, &snapshot, &sequence);
+  CU_ASSERT_EQUAL(r, true);
+  CU_ASSERT_EQUAL(sequence, 0);
+  CU_ASSERT_EQUAL(snapshot.present, NMEALIB_PRESENT_SIG | NMEALIB_PRESENT_FIX);
+
+  /* publish */
+
+  info.latitude = 5000.0;
+  info.longitude = 400.0;
+  nmeaInfoSetPresent(&info.present, NMEALIB_PRESENT_LAT | NMEALIB_PRESENT_LON);
+
+  r = nmeaBoardPublish(writer, 1, &info);
+  CU_ASSERT_EQUAL(r, true);
+  CU_ASSERT_EQUAL(nmeaBoardSequence(reader, 0), 0);
+  CU_ASSERT_EQUAL(nmeaBoardSequence(reader, 1), 2);
+
+  r = nmeaBoardSnapshot(reader, 1, &snapshot, &sequence);
+  CU_ASSERT_EQUAL(r, true);
+  CU_ASSERT_EQUAL(sequence, 2);
+  CU_ASSERT_EQUAL(memcmp(&snapshot, &info, sizeof(info)), 0);
+
+  r = nmeaBoardSnapshot(reader, 1, &snapshot, NULL);
+  CU_ASSERT_EQUAL(r, true);
+
+  /* invalid inputs */
+
+  r = nmeaBoardPublish(reader, 1, &info);
+  CU_ASSERT_EQUAL(r, false);
+
+  r = nmeaBoardPublish(writer, 3, &info);
+  CU_ASSERT_EQUAL(r, false);
+
+  r = nmeaBoardPublish(writer, 1, NULL);
+  CU_ASSERT_EQUAL(r, false);
+
+  r = nmeaBoardSnapshot(reader, 3, &snapshot, NULL);
+  CU_ASSERT_EQUAL(r, false);
+
+  r = nmeaBoardSnapshot(reader, 1, NULL, NULL);
+  CU_ASSERT_EQUAL(r, false);
+
+  CU_ASSERT_EQUAL(nmeaBoardSequence(reader, 3), 0);
+
+  nmeaBoardClose(reader);
+  nmeaBoardClose(writer);
+
+  CU_ASSERT_EQUAL(nmeaBoardUnlink(BOARD_TEST_NAME), true);
+  CU_ASSERT_EQUAL(nmeaBoardUnlink(BOARD_TEST_NAME), false);
+
+  validateContext(0, 0);
+}
+
+static void test_nmeaBoardOpenLayout(void) {
+  NmeaBoard *board;
+  NmeaBoardHeader *header;
+  int fd;
+
+  board = nmeaBoardCreate(BOARD_TEST_NAME, 1);
+  CU_ASSERT_PTR_NOT_NULL_FATAL(board);
+  nmeaBoardClose(board);
+
+  fd = shm_open(BOARD_TEST_NAME, O_RDWR, 0);
+  CU_ASSERT_FATAL(fd >= 0);
+  header = mmap(NULL, sizeof(*header), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  CU_ASSERT_FATAL(header != MAP_FAILED);
+
+  /* other layout version */
+
+  header->version = NMEALIB_BOARD_VERSION + 1;
+  board = nmeaBoardOpen(BOARD_TEST_NAME);
+  CU_ASSERT_PTR_NULL(board);
+  header->version = NMEALIB_BOARD_VERSION;
+
+  /* not initialised */
+
+  header->magic = 0;
+  board = nmeaBoardOpen(BOARD_TEST_NAME);
+  CU_ASSERT_PTR_NULL(board);
+  header->magic = NMEALIB_BOARD_MAGIC;
+
+  /* too many devices for the segment */
+
+  header->devices = 2;
+  board = nmeaBoardOpen(BOARD_TEST_NAME);
+  CU_ASSERT_PTR_NULL(board);
+  header->devices = 1;
+
+  /* valid again */
+
+  board = nmeaBoardOpen(BOARD_TEST_NAME);
+  CU_ASSERT_PTR_NOT_NULL(board);
+  nmeaBoardClose(board);
+
+  munmap(header, sizeof(*header));
+  nmeaBoardUnlink(BOARD_TEST_NAME);
+
+  validateContext(0, 3);
+}
+
+static void test_nmeaBoardCreateExisting(void) {
+  NmeaBoard *writer;
+  NmeaBoard *reader;
+  NmeaInfo info;
+  NmeaInfo snapshot;
+  uint32_t sequence;
+  bool r;
+  int fd;
+
+  memset(&info, 0, sizeof(info));
+  memset(&snapshot, 0xaa, sizeof(snapshot));
+
+  writer = nmeaBoardCreate(BOARD_TEST_NAME, 2);
+  CU_ASSERT_PTR_NOT_NULL_FATAL(writer);
+
+  info.latitude = 5000.0;
+  nmeaInfoSetPresent(&info.present, NMEALIB_PRESENT_LAT);
+  r = nmeaBoardPublish(writer, 1, &info);
+  CU_ASSERT_EQUAL(r, true);
+
+  reader = nmeaBoardOpen(BOARD_TEST_NAME);
+  CU_ASSERT_PTR_NOT_NULL_FATAL(reader);
+  nmeaBoardClose(writer);
+
+  /* reuse: the records are not re-initialised */
+
+  writer = nmeaBoardCreate(BOARD_TEST_NAME, 2);
+  CU_ASSERT_PTR_NOT_NULL_FATAL(writer);
+  CU_ASSERT_EQUAL(nmeaBoardDevices(writer), 2);
+  CU_ASSERT_EQUAL(nmeaBoardSequence(reader, 1), 2);
+
+  r = nmeaBoardSnapshot(writer, 1, &snapshot, &sequence);
+  CU_ASSERT_EQUAL(r, true);
+  CU_ASSERT_EQUAL(sequence, 2);
+  CU_ASSERT_EQUAL(memcmp(&snapshot, &info, sizeof(info)), 0);
+  nmeaBoardClose(writer);
+
+  /* refuse to shrink */
+
+  writer = nmeaBoardCreate(BOARD_TEST_NAME, 1);
+  CU_ASSERT_PTR_NULL(writer);
+
+  /* grow: only the new records are initialised */
+
+  writer = nmeaBoardCreate(BOARD_TEST_NAME, 4);
+  CU_ASSERT_PTR_NOT_NULL_FATAL(writer);
+  CU_ASSERT_EQUAL(nmeaBoardDevices(writer), 4);
+  CU_ASSERT_EQUAL(nmeaBoardSequence(writer, 1), 2);
+  CU_ASSERT_EQUAL(nmeaBoardSequence(writer, 3), 0);
+
+  r = nmeaBoardPublish(writer, 3, &info);
+  CU_ASSERT_EQUAL(r, true);
+  CU_ASSERT_EQUAL(nmeaBoardSequence(writer, 3), 2);
+
+  /* a reader that opened before keeps its records */
+
+  CU_ASSERT_EQUAL(nmeaBoardDevices(reader), 2);
+  CU_ASSERT_EQUAL(nmeaBoardSequence(reader, 3), 0);
+  r = nmeaBoardSnapshot(reader, 1, &snapshot, NULL);
+  CU_ASSERT_EQUAL(r, true);
+  nmeaBoardClose(reader);
+
+  reader = nmeaBoardOpen(BOARD_TEST_NAME);
+  CU_ASSERT_PTR_NOT_NULL_FATAL(reader);
+  CU_ASSERT_EQUAL(nmeaBoardDevices(reader), 4);
+  CU_ASSERT_EQUAL(nmeaBoardSequence(reader, 3), 2);
+
+  nmeaBoardClose(reader);
+  nmeaBoardClose(writer);
+  nmeaBoardUnlink(BOARD_TEST_NAME);
+
+  /* an existing segment that is not a board */
+
+  fd = shm_open(BOARD_TEST_NAME, O_RDWR | O_CREAT | O_EXCL, 0644);
+  CU_ASSERT_FATAL(fd >= 0);
+  CU_ASSERT_EQUAL(ftruncate(fd, 4096), 0);
+  close(fd);
+
+  writer = nmeaBoardCreate(BOARD_TEST_NAME, 1);
+  CU_ASSERT_PTR_NULL(writer);
+
+  nmeaBoardUnlink(BOARD_TEST_NAME);
+
+  validateContext(0, 2);
+}
+
+static void test_nmeaBoardSnapshotDeadWriter(void) {
+  NmeaBoard *writer;
+  NmeaBoard *reader;
+  NmeaInfoPublisher *record;
+  NmeaInfo info;
+  NmeaInfo snapshot;
+  uint32_t sequence;
+  uint8_t *mapping;
+  bool r;
+  int fd;
+
+  memset(&info, 0, sizeof(info));
+
+  writer = nmeaBoardCreate(BOARD_TEST_NAME, 1);
+  CU_ASSERT_PTR_NOT_NULL_FATAL(writer);
+
+  reader = nmeaBoardOpen(BOARD_TEST_NAME);
+  CU_ASSERT_PTR_NOT_NULL_FATAL(reader);
+
+  info.latitude = 5000.0;
+  nmeaInfoSetPresent(&info.present, NMEALIB_PRESENT_LAT);
+  r = nmeaBoardPublish(writer, 0, &info);
+  CU_ASSERT_EQUAL(r, true);
+
+  fd = shm_open(BOARD_TEST_NAME, O_RDWR, 0);
+  CU_ASSERT_FATAL(fd >= 0);
+  mapping = mmap(NULL, NMEALIB_BOARD_ALIGNMENT + sizeof(*record), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  CU_ASSERT_FATAL(mapping != MAP_FAILED);
+  record = (NmeaInfoPublisher *) (void *) (mapping + NMEALIB_BOARD_ALIGNMENT);
+
+  /* the writer dies halfway through a publish */
+
+  record->sequence++;
+  record->info.latitude = 1.0;
+  nmeaBoardClose(writer);
+
+  sequence = 42;
+  r = nmeaBoardSnapshot(reader, 0, &snapshot, &sequence);
+  CU_ASSERT_EQUAL(r, false);
+  CU_ASSERT_EQUAL(sequence, 42);
+
+  /* the restarted writer completes the publish with a cleared info */
+
+  writer = nmeaBoardCreate(BOARD_TEST_NAME, 1);
+  CU_ASSERT_PTR_NOT_NULL_FATAL(writer);
+  CU_ASSERT_EQUAL(record->sequence, 4);
+
+  r = nmeaBoardSnapshot(reader, 0, &snapshot, &sequence);
+  CU_ASSERT_EQUAL(r, true);
+  CU_ASSERT_EQUAL(sequence, 4);
+  CU_ASSERT_EQUAL(snapshot.present, NMEALIB_PRESENT_SIG | NMEALIB_PRESENT_FIX);
+
+  /* and keeps the parity of the sequence counter */
+
+  r = nmeaBoardPublish(writer, 0, &info);
+  CU_ASSERT_EQUAL(r, true);
+  r = nmeaBoardPublish(writer, 0, &info);
+  CU_ASSERT_EQUAL(r, true);
+
+  r = nmeaBoardSnapshot(reader, 0, &snapshot, &sequence);
+  CU_ASSERT_EQUAL(r, true);
+  CU_ASSERT_EQUAL(sequence, 8);
+  CU_ASSERT_EQUAL(memcmp(&snapshot, &info, sizeof(info)), 0);
+
+  /* a record that was not being published is left alone */
+
+  nmeaBoardClose(writer);
+  writer = nmeaBoardCreate(BOARD_TEST_NAME, 1);
+  CU_ASSERT_PTR_NOT_NULL_FATAL(writer);
+  CU_ASSERT_EQUAL(nmeaBoardSequence(reader, 0), 8);
+
+  munmap(mapping, NMEALIB_BOARD_ALIGNMENT + sizeof(*record));
+  nmeaBoardClose(reader);
+  nmeaBoardClose(writer);
+  nmeaBoardUnlink(BOARD_TEST_NAME);
+
+  validateContext(0, 0);
+}
+
+/*
+ * Setup
+ */
+
+int boardSuiteSetup(void) {
+  CU_pSuite pSuite = CU_add_suite("board", mockContextSuiteInit, mockContextSuiteClean);
+  if (!pSuite) {
+    return CU_get_error();
+  }
+
+  if ( //
+      (!CU_add_test(pSuite, "nmeaBoardCreate", test_nmeaBoardCreate)) //
+      || (!CU_add_test(pSuite, "nmeaBoardPublish", test_nmeaBoardPublish)) //
+      || (!CU_add_test(pSuite, "nmeaBoardOpenLayout", test_nmeaBoardOpenLayout)) //
+      || (!CU_add_test(pSuite, "nmeaBoardCreateExisting", test_nmeaBoardCreateExisting)) //
+      || (!CU_add_test(pSuite, "nmeaBoardSnapshotDeadWriter", test_nmeaBoardSnapshotDeadWriter)) //
+      ) {
+    return CU_get_error();
+  }
+
+  return CUE_SUCCESS;
+}
@@ -0,0 +1,332 @@
+/*
+ * This file is part of nmealib.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "testHelpers.h"
+
+#include <nmealib/compact.h>
+#include <nmealib/sentence.h>
+#include <CUnit/Basic.h>
+#include <float.h>
+#include <stddef.h>
+#include <string.h>
+
+int compactSuiteSetup(void);
+
+/*
+ * Helpers
+ */
+
+static void compactTestInfo(NmeaInfo *info, size_t satellites) {
+  size_t i;
+
+  nmeaInfoClear(info);
+  info->present = NMEALIB_INFO_PRESENT_MASK;
+  info->smask = NMEALIB_SENTENCE_GPGGA | NMEALIB_SENTENCE_GPGSV;
+  info->utc.year = 2024;
+  info->utc.mon = 2;
+  info->utc.day = 29;
+  info->utc.hour = 23;
+  info->utc.min = 58;
+  info->utc.sec = 60;
+  info->utc.hsec = 99;
+  info->sig = NMEALIB_SIG_DIFFERENTIAL;
+  info->fix = NMEALIB_FIX_3D;
+  info->pdop = 1.5;
+  info->hdop = 0.75;
+  info->vdop = 1.25;
+  info->latitude = 5212.3456789;
+  info->longitude = -412.9876543;
+  info->elevation = 12.5;
+  info->height = -40.25;
+  info->speed = 80.5;
+  info->track = 270.25;
+  info->mtrack = 268.5;
+  info->magvar = 1.75;
+  info->dgpsAge = 2.5;
+  info->dgpsSid = 1023;
+  info->metric = true;
+  info->progress.gpgsvInProgress = true;
+
+  /* sparse, every other entry is empty */
+  info->satellites.inUseCount = (unsigned int) satellites;
+  info->satellites.inViewCount = (unsigned int) satellites;
+  for (i = 0; i < satellites; i++) {
+    info->satellites.inUse[2 * i] = (unsigned int) (i + 1);
+    info->satellites.inView[2 * i].prn = (unsigned int) (i + 1);
+    info->satellites.inView[2 * i].elevation = (int) i - 5;
+    info->satellites.inView[2 * i].azimuth = (unsigned int) (i * 10);
+    info->satellites.inView[2 * i].snr = (unsigned int) (i + 30);
+  }
+}
+
+static void compactTestValidate(const NmeaInfo *info, size_t satellites) {
+  size_t i;
+
+  CU_ASSERT_EQUAL(info->present, NMEALIB_INFO_PRESENT_MASK);
+  CU_ASSERT_EQUAL(info->smask, NMEALIB_SENTENCE_GPGGA | NMEALIB_SENTENCE_GPGSV);
+  CU_ASSERT_EQUAL(info->utc.year, 2024);
+  CU_ASSERT_EQUAL(info->utc.mon, 2);
+  CU_ASSERT_EQUAL(info->utc.day, 29);
+  CU_ASSERT_EQUAL(info->utc.hour, 23);
+  CU_ASSERT_EQUAL(info->utc.min, 58);
+  CU_ASSERT_EQUAL(info->utc.sec, 60);
+  CU_ASSERT_EQUAL(info->utc.hsec, 99);
+  CU_ASSERT_EQUAL(info->sig, NMEALIB_SIG_DIFFERENTIAL);
+  CU_ASSERT_EQUAL(info->fix, NMEALIB_FIX_3D);
+  CU_ASSERT_DOUBLE_EQUAL(info->pdop, 1.5, DBL_EPSILON);
+  CU_ASSERT_DOUBLE_EQUAL(info->hdop, 0.75, DBL_EPSILON);
+  CU_ASSERT_DOUBLE_EQUAL(info->vdop, 1.25, DBL_EPSILON);
+  CU_ASSERT_DOUBLE_EQUAL(info->latitude, 5212.3456789, DBL_EPSILON);
+  CU_ASSERT_DOUBLE_EQUAL(info->longitude, -412.9876543, DBL_EPSILON);
+  CU_ASSERT_DOUBLE_EQUAL(info->elevation, 12.5, DBL_EPSILON);
+  CU_ASSERT_DOUBLE_EQUAL(info->height, -40.25, DBL_EPSILON);
+  CU_ASSERT_DOUBLE_EQUAL(info->speed, 80.5, DBL_EPSILON);
+  CU_ASSERT_DOUBLE_EQUAL(info->track, 270.25, DBL_EPSILON);
+  CU_ASSERT_DOUBLE_EQUAL(info->mtrack, 268.5, DBL_EPSILON);
+  CU_ASSERT_DOUBLE_EQUAL(info->magvar, 1.75, DBL_EPSILON);
+  CU_ASSERT_DOUBLE_EQUAL(info->dgpsAge, 2.5, DBL_EPSILON);
+  CU_ASSERT_EQUAL(info->dgpsSid, 1023);
+  CU_ASSERT_EQUAL(info->metric, true);
+  CU_ASSERT_EQUAL(info->progress.gpgsvInProgress, true);
+
+  /* compacted */
+  CU_ASSERT_EQUAL(info->satellites.inUseCount, satellites);
+  CU_ASSERT_EQUAL(info->satellites.inViewCount, satellites);
+  for (i = 0; i < NMEALIB_MAX_SATELLITES; i++) {
+    if (i < satellites) {
+      CU_ASSERT_EQUAL(info->satellites.inUse[i], i + 1);
+      CU_ASSERT_EQUAL(info->satellites.inView[i].prn, i + 1);
+      CU_ASSERT_EQUAL(info->satellites.inView[i].elevation, (int) i - 5);
+      CU_ASSERT_EQUAL(info->satellites.inView[i].azimuth, i * 10);
+      CU_ASSERT_EQUAL(info->satellites.inView[i].snr, i + 30);
+    } else {
+      CU_ASSERT_EQUAL(info->satellites.inUse[i], 0);
+      CU_ASSERT_EQUAL(info->satellites.inView[i].prn, 0);
+      CU_ASSERT_EQUAL(info->satellites.inView[i].snr, 0);
+    }
+  }
+}
+
+/*
+ * Tests
+ */
+
+static void test_NmeaInfoCompactLayout(void) {
+  CU_ASSERT(offsetof(NmeaInfoCompact, height) + sizeof(float) <= 64);
+  CU_ASSERT(offsetof(NmeaInfoCompact, mtrack) == 64);
+  CU_ASSERT_EQUAL(sizeof(NmeaSatelliteCompact), 6);
+  CU_ASSERT(sizeof(NmeaInfoCompact) < (sizeof(NmeaInfo) / 4));
+}
+
+static void test_nmeaInfoCompactClear(void) {
+  NmeaInfoCompact compact;
+  NmeaInfo info;
+
+  memset(&compact, 0, sizeof(compact));
+
+  /* invalid inputs */
+
+  nmeaInfoCompactClear(NULL);
+  nmeaInfoCompactDestroy(NULL);
+
+  /* normal */
+
+  compactTestInfo(&info, NMEALIB_MAX_SATELLITES / 2);
+  CU_ASSERT_EQUAL(nmeaInfoToCompact(&info, &compact), true);
+  CU_ASSERT_PTR_NOT_NULL(compact.satellites);
+
+  nmeaInfoCompactClear(&compact);
+  CU_ASSERT_PTR_NULL(compact.satellites);
+  CU_ASSERT_EQUAL(compact.present, NMEALIB_PRESENT_SIG | NMEALIB_PRESENT_FIX);
+  CU_ASSERT_EQUAL(compact.sig, NMEALIB_SIG_INVALID);
+  CU_ASSERT_EQUAL(compact.fix, NMEALIB_FIX_BAD);
+  CU_ASSERT_EQUAL(compact.inUseStored, 0);
+  CU_ASSERT_EQUAL(compact.inViewStored, 0);
+
+  /* destroy */
+
+  CU_ASSERT_EQUAL(nmeaInfoToCompact(&info, &compact), true);
+  CU_ASSERT_PTR_NOT_NULL(compact.satellites);
+
+  nmeaInfoCompactDestroy(&compact);
+  CU_ASSERT_PTR_NULL(compact.satellites);
+  CU_ASSERT_EQUAL(compact.inUseStored, 0);
+  CU_ASSERT_EQUAL(compact.inViewStored, 0);
+  CU_ASSERT_EQUAL(compact.inUseCount, NMEALIB_MAX_SATELLITES / 2);
+
+  nmeaInfoCompactDestroy(&compact);
+
+  validateContext(0, 0);
+}
+
+static void test_nmeaInfoToCompact(void) {
+  NmeaInfoCompact compact;
+  NmeaInfo info;
+  NmeaInfo out;
+  bool r;
+
+  memset(&compact, 0, sizeof(compact));
+
+  /* invalid inputs */
+
+  r = nmeaInfoToCompact(NULL, &compact);
+  CU_ASSERT_EQUAL(r, false);
+
+  r = nmeaInfoToCompact(&info, NULL);
+  CU_ASSERT_EQUAL(r, false);
+
+  nmeaInfoFromCompact(NULL, &out);
+  nmeaInfoFromCompact(&compact, NULL);
+
+  /* inline satellites */
+
+  compactTestInfo(&info, NMEALIB_INFO_COMPACT_SATELLITES);
+  r = nmeaInfoToCompact(&info, &compact);
+  CU_ASSERT_EQUAL(r, true);
+  CU_ASSERT_PTR_NULL(compact.satellites);
+  CU_ASSERT_EQUAL(compact.inUseStored, NMEALIB_INFO_COMPACT_SATELLITES);
+  CU_ASSERT_EQUAL(compact.inViewStored, NMEALIB_INFO_COMPACT_SATELLITES);
+  CU_ASSERT_PTR_EQUAL(nmeaInfoCompactSatellitesInUse(&compact), compact.inUse);
+  CU_ASSERT_PTR_EQUAL(nmeaInfoCompactSatellitesInView(&compact), compact.inView);
+
+  memset(&out, 0xaa, sizeof(out));
+  nmeaInfoFromCompact(&compact, &out);
+  compactTestValidate(&out, NMEALIB_INFO_COMPACT_SATELLITES);
+
+  /* out of line satellites */
+
+  compactTestInfo(&info, NMEALIB_MAX_SATELLITES / 2);
+  r = nmeaInfoToCompact(&info, &compact);
+  CU_ASSERT_EQUAL(r, true);
+  CU_ASSERT_PTR_NOT_NULL_FATAL(compact.satellites);
+  CU_ASSERT_EQUAL(compact.inUseStored, NMEALIB_MAX_SATELLITES / 2);
+  CU_ASSERT_EQUAL(compact.inViewStored, NMEALIB_MAX_SATELLITES / 2);
+  CU_ASSERT_PTR_EQUAL(nmeaInfoCompactSatellitesInUse(&compact), compact.satellites->inUse);
+  CU_ASSERT_PTR_EQUAL(nmeaInfoCompactSatellitesInView(&compact), compact.satellites->inView);
+
+  memset(&out, 0xaa, sizeof(out));
+  nmeaInfoFromCompact(&compact, &out);
+  compactTestValidate(&out, NMEALIB_MAX_SATELLITES / 2);
+
+  /* back to inline satellites */
+
+  compactTestInfo(&info, 4);
+  r = nmeaInfoToCompact(&info, &compact);
+  CU_ASSERT_EQUAL(r, true);
+  CU_ASSERT_PTR_NULL(compact.satellites);
+
+  nmeaInfoFromCompact(&compact, &out);
+  compactTestValidate(&out, 4);
+
+  /* clamping */
+
+  info.utc.year = 100000;
+  info.dgpsSid = 100000;
+  info.satellites.inView[0].elevation = -1000;
+  info.satellites.inView[0].snr = 1000;
+  info.satellites.inView[0].azimuth = 100000;
+  info.satellites.inUse[0] = 100000;
+  r = nmeaInfoToCompact(&info, &compact);
+  CU_ASSERT_EQUAL(r, true);
+  CU_ASSERT_EQUAL(compact.utc.year, UINT16_MAX);
+  CU_ASSERT_EQUAL(compact.dgpsSid, UINT16_MAX);
+  CU_ASSERT_EQUAL(compact.inView[0].elevation, INT8_MIN);
+  CU_ASSERT_EQUAL(compact.inView[0].snr, UINT8_MAX);
+  CU_ASSERT_EQUAL(compact.inView[0].azimuth, UINT16_MAX);
+  CU_ASSERT_EQUAL(compact.inUse[0], UINT16_MAX);
+
+  nmeaInfoCompactDestroy(&compact);
+
+  validateContext(0, 0);
+}
+
+static void test_nmeaInfoCompactCopy(void) {
+  NmeaInfoCompact src;
+  NmeaInfoCompact dst;
+  NmeaInfo info;
+  NmeaInfo out;
+  bool r;
+
+  memset(&src, 0, sizeof(src));
+  memset(&dst, 0, sizeof(dst));
+
+  /* invalid inputs */
+
+  r = nmeaInfoCompactCopy(NULL, &src);
+  CU_ASSERT_EQUAL(r, false);
+
+  r = nmeaInfoCompactCopy(&dst, NULL);
+  CU_ASSERT_EQUAL(r, false);
+
+  /* self */
+
+  r = nmeaInfoCompactCopy(&src, &src);
+  CU_ASSERT_EQUAL(r, true);
+
+  /* out of line satellites */
+
+  compactTestInfo(&info, NMEALIB_MAX_SATELLITES / 2);
+  r = nmeaInfoToCompact(&info, &src);
+  CU_ASSERT_EQUAL(r, true);
+
+  r = nmeaInfoCompactCopy(&dst, &src);
+  CU_ASSERT_EQUAL(r, true);
+  CU_ASSERT_PTR_NOT_NULL_FATAL(dst.satellites);
+  CU_ASSERT_PTR_NOT_EQUAL(dst.satellites, src.satellites);
+
+  nmeaInfoCompactDestroy(&src);
+
+  nmeaInfoFromCompact(&dst, &out);
+  compactTestValidate(&out, NMEALIB_MAX_SATELLITES / 2);
+
+  /* inline satellites */
+
+  compactTestInfo(&info, 3);
+  r = nmeaInfoToCompact(&info, &src);
+  CU_ASSERT_EQUAL(r, true);
+
+  r = nmeaInfoCompactCopy(&dst, &src);
+  CU_ASSERT_EQUAL(r, true);
+  CU_ASSERT_PTR_NULL(dst.satellites);
+
+  nmeaInfoFromCompact(&dst, &out);
+  compactTestValidate(&out, 3);
+
+  validateContext(0, 0);
+}
+
+/*
+ * Setup
+ */
+
+int compactSuiteSetup(void) {
+  CU_pSuite pSuite = CU_add_suite("compact", mockContextSuiteInit, mockContextSuiteClean);
+  if (!pSuite) {
+    return CU_get_error();
+  }
+
+  if ( //
+      (!CU_add_test(pSuite, "NmeaInfoCompact layout", test_NmeaInfoCompactLayout)) //
+      || (!CU_add_test(pSuite, "nmeaInfoCompactClear", test_nmeaInfoCompactClear)) //
+      || (!CU_add_test(pSuite, "nmeaInfoToCompact", test_nmeaInfoToCompact)) //
+      || (!CU_add_test(pSuite, "nmeaInfoCompactCopy", test_nmeaInfoCompactCopy)) //
+      ) {
+    return CU_get_error();
+  }
+
+  return CUE_SUCCESS;
+}
@@ -0,0 +1,250 @@
+/*
+ * This file is part of nmealib.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "testHelpers.h"
+
+#include <nmealib/epoch.h>
+#include <CUnit/Basic.h>
+#include <float.h>
+#include <stddef.h>
+#include <string.h>
+#include <time.h>
+
+int epochSuiteSetup(void);
+
+static const char *epochTestSentences = //
+    "$GPGGA,123456.00,5000.000,N,00400.000,E,1,04,1.5,10.0,M,20.0,M,,*59\r\n" //
+    "$GPGSA,A,3,01,02,03,04,,,,,,,,,2.0,1.5,1.3*32\r\n" //
+    "$GPRMC,123456.00,A,5000.000,N,00400.000,E,10.0,90.0,311224,1.0,E*50\r\n" //
+    "$GPGGA,123457.00,5000.001,N,00400.000,E,1,04,1.5,10.0,M,20.0,M,,*59\r\n" //
+    "$GPRMC,123457.00,A,5000.001,N,00400.000,E,10.0,90.0,311224,1.0,E*50\r\n" //
+    "$GPGGA,123458.00,5000.002,N,00400.000,E,1,04,1.5,10.0,M,20.0,M,,*55\r\n";
+
+typedef struct _EpochTestState {
+  size_t count;
+  NmeaEpoch epochs[4];
+} EpochTestState;
+
+static void epochTestHandler(void *user, const NmeaEpoch *epoch) {
+  EpochTestState *state = (EpochTestState *) user;
+
+  if (state->count < (sizeof(state->epochs) / sizeof(state->epochs[0]))) {
+    state->epochs[state->count] = *epoch;
+  }
+  state->count++;
+}
+
+/*
+ * Tests
+ */
+
+static void test_nmeaEpochAssemblerInit(void) {
+  NmeaEpochAssembler assembler;
+  NmeaEpochConfig config;
+  bool r;
+
+  memset(&config, 0, sizeof(config));
+
+  /* invalid inputs */
+
+  r = nmeaEpochAssemblerInit(NULL, &config);
+  CU_ASSERT_EQUAL(r, false);
+
+  r = nmeaEpochAssemblerInit(&assembler, NULL);
+  CU_ASSERT_EQUAL(r, false);
+
+  /* normal */
+
+  config.timeout = 42;
+  r = nmeaEpochAssemblerInit(&assembler, &config);
+  CU_ASSERT_EQUAL(r, true);
+  CU_ASSERT_EQUAL(assembler.config.timeout, 42);
+  CU_ASSERT_EQUAL(assembler.epoch.sentences, 0);
+  CU_ASSERT_PTR_NOT_NULL(assembler.parser.buffer);
+
+  nmeaEpochAssemblerDestroy(&assembler);
+  nmeaEpochAssemblerDestroy(NULL);
+
+  validateContext(0, 0);
+}
+
+static void test_nmeaEpochAssemblerParse(void) {
+  NmeaEpochAssembler assembler;
+  NmeaEpochConfig config;
+  EpochTestState state;
+  size_t r;
+
+  memset(&config, 0, sizeof(config));
+  memset(&state, 0, sizeof(state));
+  config.handler = epochTestHandler;
+  config.user = &state;
+
+  /* invalid inputs */
+
+  r = nmeaEpochAssemblerParse(NULL, epochTestSentences, strlen(epochTestSentences));
+  CU_ASSERT_EQUAL(r, 0);
+
+  r = nmeaEpochAssemblerSentence(NULL, epochTestSentences, strlen(epochTestSentences));
+  CU_ASSERT_EQUAL(r, 0);
+
+  r = nmeaEpochAssemblerPoll(NULL);
+  CU_ASSERT_EQUAL(r, 0);
+
+  r = nmeaEpochAssemblerFlush(NULL);
+  CU_ASSERT_EQUAL(r, 0);
+
+  /* epochs end on UTC changes */
+
+  nmeaEpochAssemblerInit(&assembler, &config);
+
+  r = nmeaEpochAssemblerParse(&assembler, epochTestSentences, 0);
+  CU_ASSERT_EQUAL(r, 0);
+
+  r = nmeaEpochAssemblerParse(&assembler, epochTestSentences, strlen(epochTestSentences));
+  CU_ASSERT_EQUAL(r, 2);
+  CU_ASSERT_EQUAL(state.count, 2);
+  CU_ASSERT_EQUAL(assembler.epoch.sentences, 1);
+
+  CU_ASSERT_EQUAL(state.epochs[0].sentences, 3);
+  CU_ASSERT_EQUAL(state.epochs[0].complete, true);
+  CU_ASSERT_EQUAL(state.epochs[0].end, NMEALIB_EPOCH_END_UTC);
+  CU_ASSERT_EQUAL(state.epochs[0].info.smask, NMEALIB_SENTENCE_GPGGA | NMEALIB_SENTENCE_GPGSA | NMEALIB_SENTENCE_GPRMC);
+  CU_ASSERT_EQUAL(state.epochs[0].info.utc.sec, 56);
+  CU_ASSERT_DOUBLE_EQUAL(state.epochs[0].info.latitude, 5000.000, DBL_EPSILON);
+  CU_ASSERT_EQUAL(state.epochs[0].info.satellites.inUseCount, 4);
+
+  CU_ASSERT_EQUAL(state.epochs[1].sentences, 2);
+  CU_ASSERT_EQUAL(state.epochs[1].end, NMEALIB_EPOCH_END_UTC);
+  CU_ASSERT_EQUAL(state.epochs[1].info.smask, NMEALIB_SENTENCE_GPGGA | NMEALIB_SENTENCE_GPRMC);
+  CU_ASSERT_EQUAL(state.epochs[1].info.utc.sec, 57);
+  CU_ASSERT_DOUBLE_EQUAL(state.epochs[1].info.latitude, 5000.001, DBL_EPSILON);
+  CU_ASSERT_EQUAL(nmeaInfoIsPresentAll(state.epochs[1].info.present, NMEALIB_PRESENT_SATINUSE), false);
+
+  r = nmeaEpochAssemblerFlush(&assembler);
+  CU_ASSERT_EQUAL(r, 1);
+  CU_ASSERT_EQUAL(state.epochs[2].sentences, 1);
+  CU_ASSERT_EQUAL(state.epochs[2].end, NMEALIB_EPOCH_END_FLUSH);
+  CU_ASSERT_EQUAL(state.epochs[2].info.utc.sec, 58);
+
+  r = nmeaEpochAssemblerFlush(&assembler);
+  CU_ASSERT_EQUAL(r, 0);
+
+  nmeaEpochAssemblerDestroy(&assembler);
+
+  /* completeness policy and terminating sentence */
+
+  memset(&state, 0, sizeof(state));
+  config.terminator = NMEALIB_SENTENCE_GPRMC;
+  config.required = NMEALIB_SENTENCE_GPGSA;
+  nmeaEpochAssemblerInit(&assembler, &config);
+
+  r = nmeaEpochAssemblerParse(&assembler, epochTestSentences, strlen(epochTestSentences));
+  CU_ASSERT_EQUAL(r, 1);
+  CU_ASSERT_EQUAL(state.count, 1);
+  CU_ASSERT_EQUAL(state.epochs[0].sentences, 3);
+  CU_ASSERT_EQUAL(state.epochs[0].end, NMEALIB_EPOCH_END_TERMINATOR);
+
+  r = nmeaEpochAssemblerFlush(&assembler);
+  CU_ASSERT_EQUAL(r, 0);
+
+  nmeaEpochAssemblerDestroy(&assembler);
+
+  memset(&state, 0, sizeof(state));
+  config.emitIncomplete = true;
+  config.requiredPresent = NMEALIB_PRESENT_LAT | NMEALIB_PRESENT_SATINUSE;
+  nmeaEpochAssemblerInit(&assembler, &config);
+
+  r = nmeaEpochAssemblerParse(&assembler, epochTestSentences, strlen(epochTestSentences));
+  CU_ASSERT_EQUAL(r, 2);
+  CU_ASSERT_EQUAL(state.epochs[0].complete, true);
+  CU_ASSERT_EQUAL(state.epochs[1].complete, false);
+  CU_ASSERT_EQUAL(state.epochs[1].end, NMEALIB_EPOCH_END_TERMINATOR);
+
+  nmeaEpochAssemblerDestroy(&assembler);
+
+  validateContext(18, 0);
+}
+
+static void test_nmeaEpochAssemblerPoll(void) {
+  NmeaEpochAssembler assembler;
+  NmeaEpochConfig config;
+  EpochTestState state;
+  const char *s = "$GPGSA,A,3,01,02,03,04,,,,,,,,,2.0,1.5,1.3*32\r\n";
+  struct timespec delay = {
+      0,
+      20000000 };
+  size_t r;
+
+  memset(&config, 0, sizeof(config));
+  memset(&state, 0, sizeof(state));
+  config.handler = epochTestHandler;
+  config.user = &state;
+  config.timeout = 10;
+
+  nmeaEpochAssemblerInit(&assembler, &config);
+
+  r = nmeaEpochAssemblerPoll(&assembler);
+  CU_ASSERT_EQUAL(r, 0);
+
+  r = nmeaEpochAssemblerParse(&assembler, s, strlen(s));
+  CU_ASSERT_EQUAL(r, 0);
+
+  nanosleep(&delay, NULL);
+
+  r = nmeaEpochAssemblerPoll(&assembler);
+  CU_ASSERT_EQUAL(r, 1);
+  CU_ASSERT_EQUAL(state.epochs[0].sentences, 1);
+  CU_ASSERT_EQUAL(state.epochs[0].end, NMEALIB_EPOCH_END_TIMEOUT);
+
+  /* a sentence after the timeout ends the previous epoch first */
+
+  r = nmeaEpochAssemblerParse(&assembler, s, strlen(s));
+  CU_ASSERT_EQUAL(r, 0);
+
+  nanosleep(&delay, NULL);
+
+  r = nmeaEpochAssemblerParse(&assembler, s, strlen(s));
+  CU_ASSERT_EQUAL(r, 1);
+  CU_ASSERT_EQUAL(state.count, 2);
+  CU_ASSERT_EQUAL(state.epochs[1].end, NMEALIB_EPOCH_END_TIMEOUT);
+  CU_ASSERT_EQUAL(assembler.epoch.sentences, 1);
+
+  nmeaEpochAssemblerDestroy(&assembler);
+
+  validateContext(3, 0);
+}
+
+/*
+ * Setup
+ */
+
+int epochSuiteSetup(void) {
+  CU_pSuite pSuite = CU_add_suite("epoch", mockContextSuiteInit, mockContextSuiteClean);
+  if (!pSuite) {
+    return CU_get_error();
+  }
+
+  if ( //
+      (!CU_add_test(pSuite, "nmeaEpochAssemblerInit", test_nmeaEpochAssemblerInit)) //
+      || (!CU_add_test(pSuite, "nmeaEpochAssemblerParse", test_nmeaEpochAssemblerParse)) //
+      || (!CU_add_test(pSuite, "nmeaEpochAssemblerPoll", test_nmeaEpochAssemblerPoll)) //
+      ) {
+    return CU_get_error();
+  }
+
+  return CUE_SUCCESS;
+}
@@ -0,0 +1,284 @@
+/*
+ * This file is part of nmealib.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "testHelpers.h"
+
+#include <nmealib/fleet.h>
+#include <CUnit/Basic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+int fleetSuiteSetup(void);
+
+#define FLEET_TEST_VEHICLES (50u)
+
+typedef struct _FleetTestState {
+  uint64_t epochs[FLEET_TEST_VEHICLES];
+  uint64_t bytes;
+  uint64_t bad;
+  size_t initialised;
+} FleetTestState;
+
+static void fleetTestInit(void *user, size_t vehicle, NmeaInfo *info) {
+  FleetTestState *state = (FleetTestState *) user;
+
+  info->latitude = (double) vehicle;
+  state->initialised++;
+}
+
+static void fleetTestOutput(void *user, size_t vehicle, const char *s, size_t sz) {
+  FleetTestState *state = (FleetTestState *) user;
+
+  if ((vehicle >= FLEET_TEST_VEHICLES) //
+      || (sz < 6) //
+      || strncmp(s, "$GPGGA", 6) //
+      || (strlen(s) != sz)) {
+    __atomic_add_fetch(&state->bad, 1, __ATOMIC_RELAXED);
+    return;
+  }
+
+  __atomic_add_fetch(&state->epochs[vehicle], 1, __ATOMIC_RELAXED);
+  __atomic_add_fetch(&state->bytes, sz, __ATOMIC_RELAXED);
+}
+
+/*
+ * Tests
+ */
+
+static void test_nmeaFleetCreate(void) {
+  NmeaFleetConfig config;
+  NmeaFleet *fleet;
+
+  memset(&config, 0, sizeof(config));
+  config.vehicles = 2;
+  config.threads = 1;
+  config.type = NMEALIB_GENERATOR_ROTATE;
+  config.mask = NMEALIB_SENTENCE_GPGGA;
+  config.fd = -1;
+  config.output = fleetTestOutput;
+
+  /* invalid inputs */
+
+  fleet = nmeaFleetCreate(NULL);
+  CU_ASSERT_PTR_NULL(fleet);
+
+  config.vehicles = 0;
+  fleet = nmeaFleetCreate(&config);
+  CU_ASSERT_PTR_NULL(fleet);
+  config.vehicles = 2;
+
+  config.threads = 0;
+  fleet = nmeaFleetCreate(&config);
+  CU_ASSERT_PTR_NULL(fleet);
+  config.threads = 1;
+
+  config.mask = NMEALIB_SENTENCE_LAST << 1;
+  fleet = nmeaFleetCreate(&config);
+  CU_ASSERT_PTR_NULL(fleet);
+  config.mask = NMEALIB_SENTENCE_GPGGA;
+
+  config.rate = -1.0;
+  fleet = nmeaFleetCreate(&config);
+  CU_ASSERT_PTR_NULL(fleet);
+  config.rate = 0.0;
+
+  config.output = NULL;
+  fleet = nmeaFleetCreate(&config);
+  CU_ASSERT_PTR_NULL(fleet);
+  config.output = fleetTestOutput;
+
+  config.type = NMEALIB_GENERATOR_LAST + 1;
+  fleet = nmeaFleetCreate(&config);
+  CU_ASSERT_PTR_NULL(fleet);
+  config.type = NMEALIB_GENERATOR_ROTATE;
+
+  /* success */
+
+  fleet = nmeaFleetCreate(&config);
+  CU_ASSERT_PTR_NOT_NULL(fleet);
+  nmeaFleetDestroy(fleet);
+
+  /* invalid inputs of the other functions */
+
+  CU_ASSERT_EQUAL(nmeaFleetStart(NULL), false);
+  CU_ASSERT_EQUAL(nmeaFleetJoin(NULL), false);
+  nmeaFleetStop(NULL);
+  nmeaFleetStatistics(NULL, NULL, NULL);
+  nmeaFleetDestroy(NULL);
+
+  validateContext(0, 0);
+}
+
+static void test_nmeaFleetOutput(void) {
+  FleetTestState state;
+  NmeaFleetConfig config;
+  NmeaFleet *fleet;
+  uint64_t epochs;
+  uint64_t bytes;
+  size_t i;
+  bool r;
+
+  memset(&state, 0, sizeof(state));
+  memset(&config, 0, sizeof(config));
+  config.vehicles = FLEET_TEST_VEHICLES;
+  config.threads = 4;
+  config.type = NMEALIB_GENERATOR_ROTATE;
+  config.mask = NMEALIB_SENTENCE_GPGGA | NMEALIB_SENTENCE_GPGSV | NMEALIB_SENTENCE_GPRMC;
+  config.epochs = 3;
+  config.seed = 42;
+  config.fd = -1;
+  config.init = fleetTestInit;
+  config.output = fleetTestOutput;
+  config.user = &state;
+
+  fleet = nmeaFleetCreate(&config);
+  CU_ASSERT_PTR_NOT_NULL_FATAL(fleet);
+  CU_ASSERT_EQUAL(state.initialised, FLEET_TEST_VEHICLES);
+
+  r = nmeaFleetStart(fleet);
+  CU_ASSERT_EQUAL(r, true);
+
+  r = nmeaFleetStart(fleet);
+  CU_ASSERT_EQUAL(r, false);
+
+  r = nmeaFleetJoin(fleet);
+  CU_ASSERT_EQUAL(r, true);
+
+  nmeaFleetStatistics(fleet, &epochs, &bytes);
+  CU_ASSERT_EQUAL(epochs, 3 * FLEET_TEST_VEHICLES);
+  CU_ASSERT_EQUAL(bytes, state.bytes);
+  CU_ASSERT_EQUAL(state.bad, 0);
+  for (i = 0; i < FLEET_TEST_VEHICLES; i++) {
+    CU_ASSERT_EQUAL(state.epochs[i], 3);
+  }
+
+  nmeaFleetDestroy(fleet);
+  validateContext(0, 0);
+}
+
+static void test_nmeaFleetFd(void) {
+  NmeaFleetConfig config;
+  NmeaFleet *fleet;
+  FILE *f;
+  struct stat st;
+  uint64_t epochs;
+  uint64_t bytes;
+  char buf[8];
+  bool r;
+
+  f = tmpfile();
+  CU_ASSERT_PTR_NOT_NULL_FATAL(f);
+
+  memset(&config, 0, sizeof(config));
+  config.vehicles = FLEET_TEST_VEHICLES;
+  config.threads = 3;
+  config.type = NMEALIB_GENERATOR_NOISE;
+  config.mask = NMEALIB_SENTENCE_MASK;
+  config.epochs = 2;
+  config.fd = fileno(f);
+
+  fleet = nmeaFleetCreate(&config);
+  CU_ASSERT_PTR_NOT_NULL_FATAL(fleet);
+
+  r = nmeaFleetStart(fleet);
+  CU_ASSERT_EQUAL(r, true);
+
+  r = nmeaFleetJoin(fleet);
+  CU_ASSERT_EQUAL(r, true);
+
+  nmeaFleetStatistics(fleet, &epochs, &bytes);
+  CU_ASSERT_EQUAL(epochs, 2 * FLEET_TEST_VEHICLES);
+
+  CU_ASSERT_EQUAL(fstat(fileno(f), &st), 0);
+  CU_ASSERT_EQUAL((uint64_t) st.st_size, bytes);
+
+  rewind(f);
+  CU_ASSERT_EQUAL(fread(buf, 1, 6, f), 6);
+  CU_ASSERT_EQUAL(strncmp(buf, "$GPGGA", 6), 0);
+
+  nmeaFleetDestroy(fleet);
+  fclose(f);
+  validateContext(0, 0);
+}
+
+static void test_nmeaFleetStop(void) {
+  FleetTestState state;
+  NmeaFleetConfig config;
+  NmeaFleet *fleet;
+  uint64_t epochs;
+  bool r;
+
+  memset(&state, 0, sizeof(state));
+  memset(&config, 0, sizeof(config));
+  config.vehicles = FLEET_TEST_VEHICLES;
+  config.threads = 2;
+  config.type = NMEALIB_GENERATOR_STATIC;
+  config.mask = NMEALIB_SENTENCE_GPGGA;
+  config.rate = 1000.0;
+  config.fd = -1;
+  config.output = fleetTestOutput;
+  config.user = &state;
+
+  fleet = nmeaFleetCreate(&config);
+  CU_ASSERT_PTR_NOT_NULL_FATAL(fleet);
+
+  r = nmeaFleetStart(fleet);
+  CU_ASSERT_EQUAL(r, true);
+
+  nmeaFleetStop(fleet);
+
+  r = nmeaFleetJoin(fleet);
+  CU_ASSERT_EQUAL(r, true);
+
+  nmeaFleetStatistics(fleet, &epochs, NULL);
+  /* each worker stops on a whole epoch of its own vehicles */
+  CU_ASSERT_EQUAL(epochs % (FLEET_TEST_VEHICLES / 2), 0);
+  CU_ASSERT_EQUAL(state.bad, 0);
+
+  /* can be restarted */
+
+  r = nmeaFleetStart(fleet);
+  CU_ASSERT_EQUAL(r, true);
+
+  nmeaFleetDestroy(fleet);
+  validateContext(0, 0);
+}
+
+/*
+ * Setup
+ */
+
+int fleetSuiteSetup(void) {
+  CU_pSuite pSuite = CU_add_suite("fleet", mockContextSuiteInit, mockContextSuiteClean);
+  if (!pSuite) {
+    return CU_get_error();
+  }
+
+  if ( //
+      (!CU_add_test(pSuite, "nmeaFleetCreate", test_nmeaFleetCreate)) //
+      || (!CU_add_test(pSuite, "nmeaFleetOutput", test_nmeaFleetOutput)) //
+      || (!CU_add_test(pSuite, "nmeaFleetFd", test_nmeaFleetFd)) //
+      || (!CU_add_test(pSuite, "nmeaFleetStop", test_nmeaFleetStop)) //
+      ) {
+    return CU_get_error();
+  }
+
+  return CUE_SUCCESS;
+}
@@ -18,6 +18,7 @@
 #include "testHelpers.h"
 
 #include <nmealib/generator.h>
+#include <nmealib/util.h>
 #include <CUnit/Basic.h>
 #include <float.h>
 #include <stddef.h>
@@ -28,17 +29,24 @@
 int generatorSuiteSetup(void);
 
 extern bool nmeaGeneratorInvokeNoise(NmeaGenerator *gen, NmeaInfo *info);
+extern bool nmeaGeneratorInvokeBatchNoise(NmeaGenerator *gen, NmeaInfo *infos, size_t n);
 
 extern bool nmeaGeneratorInvokeStatic(NmeaGenerator *gen, NmeaInfo *info);
+extern bool nmeaGeneratorInvokeBatchStatic(NmeaGenerator *gen, NmeaInfo *infos, size_t n);
 extern bool nmeaGeneratorResetStatic(NmeaGenerator *gen, NmeaInfo *info);
 extern bool nmeaGeneratorInitStatic(NmeaGenerator *gen, NmeaInfo *info);
 
 extern bool nmeaGeneratorInvokeRotate(NmeaGenerator *gen, NmeaInfo *info);
+extern bool nmeaGeneratorInvokeBatchRotate(NmeaGenerator *gen, NmeaInfo *infos, size_t n);
 extern bool nmeaGeneratorResetRotate(NmeaGenerator *gen, NmeaInfo *info);
 extern bool nmeaGeneratorInitRotate(NmeaGenerator *gen, NmeaInfo *info);
 
 extern bool nmeaGeneratorInitRandomMove(NmeaGenerator *gen, NmeaInfo *info);
 extern bool nmeaGeneratorInvokeRandomMove(NmeaGenerator *gen, NmeaInfo *info);
+extern bool nmeaGeneratorInvokeBatchRandomMove(NmeaGenerator *gen, NmeaInfo *infos, size_t n);
+
+extern bool nmeaGeneratorInvokeReplay(NmeaGenerator *gen, NmeaInfo *info);
+extern bool nmeaGeneratorResetReplay(NmeaGenerator *gen, NmeaInfo *info);
 
 /*
  * Failing generator
@@ -52,6 +60,11 @@ static bool failInvoke(NmeaGenerator *gen __attribute__((unused)), NmeaInfo *inf
   return false;
 }
 
+static bool failInvokeBatch(NmeaGenerator *gen __attribute__((unused)), NmeaInfo *infos __attribute__((unused)),
+    size_t n __attribute__((unused))) {
+  return false;
+}
+
 static bool failReset(NmeaGenerator *gen __attribute__((unused)), NmeaInfo *info __attribute__((unused))) {
   return false;
 }
@@ -330,6 +343,7 @@ static void test_nmeaGeneratorInvokeRotate(void) {
   CU_ASSERT_EQUAL(memcmp(info.satellites.inUse, infoEmpty.satellites.inUse, sizeof(info.satellites.inUse)), 0);
   CU_ASSERT_EQUAL(info.satellites.inViewCount, 0);
   CU_ASSERT_EQUAL(memcmp(info.satellites.inView, infoEmpty.satellites.inView, sizeof(info.satellites.inView)), 0);
+  CU_ASSERT_EQUAL(info.progress.gpgsvSequence, 0);
 
   /* normal, 2 sats */
 
@@ -375,6 +389,7 @@ static void test_nmeaGeneratorInvokeRotate(void) {
   CU_ASSERT_EQUAL(memcmp(info.satellites.inUse, infoEmpty.satellites.inUse, sizeof(info.satellites.inUse)), 0);
   CU_ASSERT_EQUAL(info.satellites.inViewCount, 2);
   CU_ASSERT_EQUAL(memcmp(info.satellites.inView, infoEmpty.satellites.inView, sizeof(info.satellites.inView)), 0);
+  CU_ASSERT_EQUAL(info.progress.gpgsvSequence, 2);
 
   /* again */
 
@@ -421,6 +436,7 @@ static void test_nmeaGeneratorInvokeRotate(void) {
   CU_ASSERT_EQUAL(memcmp(info.satellites.inUse, infoEmpty.satellites.inUse, sizeof(info.satellites.inUse)), 0);
   CU_ASSERT_EQUAL(info.satellites.inViewCount, 2);
   CU_ASSERT_EQUAL(memcmp(info.satellites.inView, infoEmpty.satellites.inView, sizeof(info.satellites.inView)), 0);
+  CU_ASSERT_EQUAL(info.progress.gpgsvSequence, 4);
 }
 
 static void test_nmeaGeneratorResetRotate(void) {
@@ -859,6 +875,7 @@ static void test_nmeaGeneratorCreate(void) {
   CU_ASSERT_PTR_NOT_NULL_FATAL(gen);
   CU_ASSERT_PTR_NULL(gen->init);
   CU_ASSERT_EQUAL(gen->invoke, nmeaGeneratorInvokeNoise);
+  CU_ASSERT_EQUAL(gen->invokeBatch, nmeaGeneratorInvokeBatchNoise);
   CU_ASSERT_PTR_NULL(gen->reset);
   CU_ASSERT_PTR_NULL(gen->next);
   nmeaGeneratorDestroy(gen);
@@ -869,6 +886,7 @@ static void test_nmeaGeneratorCreate(void) {
   CU_ASSERT_PTR_NOT_NULL_FATAL(gen);
   CU_ASSERT_EQUAL(gen->init, nmeaGeneratorInitStatic);
   CU_ASSERT_EQUAL(gen->invoke, nmeaGeneratorInvokeStatic);
+  CU_ASSERT_EQUAL(gen->invokeBatch, nmeaGeneratorInvokeBatchStatic);
   CU_ASSERT_EQUAL(gen->reset, nmeaGeneratorResetStatic);
   CU_ASSERT_PTR_NULL(gen->next);
   nmeaGeneratorDestroy(gen);
@@ -879,6 +897,7 @@ static void test_nmeaGeneratorCreate(void) {
   CU_ASSERT_PTR_NOT_NULL_FATAL(gen);
   CU_ASSERT_EQUAL(gen->init, nmeaGeneratorInitStatic);
   CU_ASSERT_EQUAL(gen->invoke, nmeaGeneratorInvokeStatic);
+  CU_ASSERT_EQUAL(gen->invokeBatch, nmeaGeneratorInvokeBatchStatic);
   CU_ASSERT_EQUAL(gen->reset, nmeaGeneratorResetStatic);
   CU_ASSERT_PTR_NULL(gen->next);
   nmeaGeneratorDestroy(gen);
@@ -889,6 +908,7 @@ static void test_nmeaGeneratorCreate(void) {
   CU_ASSERT_PTR_NOT_NULL_FATAL(gen);
   CU_ASSERT_EQUAL(gen->init, nmeaGeneratorInitRotate);
   CU_ASSERT_EQUAL(gen->invoke, nmeaGeneratorInvokeRotate);
+  CU_ASSERT_EQUAL(gen->invokeBatch, nmeaGeneratorInvokeBatchRotate);
   CU_ASSERT_EQUAL(gen->reset, nmeaGeneratorResetRotate);
   CU_ASSERT_PTR_NULL(gen->next);
   nmeaGeneratorDestroy(gen);
@@ -899,6 +919,7 @@ static void test_nmeaGeneratorCreate(void) {
   CU_ASSERT_PTR_NOT_NULL_FATAL(gen);
   CU_ASSERT_EQUAL(gen->init, nmeaGeneratorInitRandomMove);
   CU_ASSERT_EQUAL(gen->invoke, nmeaGeneratorInvokeRandomMove);
+  CU_ASSERT_EQUAL(gen->invokeBatch, nmeaGeneratorInvokeBatchRandomMove);
   CU_ASSERT_PTR_NULL(gen->reset);
   CU_ASSERT_PTR_NULL(gen->next);
   nmeaGeneratorDestroy(gen);
@@ -909,6 +930,7 @@ static void test_nmeaGeneratorCreate(void) {
   CU_ASSERT_PTR_NOT_NULL_FATAL(gen);
   CU_ASSERT_EQUAL(gen->init, nmeaGeneratorInitRotate);
   CU_ASSERT_EQUAL(gen->invoke, nmeaGeneratorInvokeRotate);
+  CU_ASSERT_EQUAL(gen->invokeBatch, nmeaGeneratorInvokeBatchRotate);
   CU_ASSERT_EQUAL(gen->reset, nmeaGeneratorResetRotate);
   CU_ASSERT_PTR_NOT_NULL(gen->next);
   CU_ASSERT_EQUAL(gen->next->init, nmeaGeneratorInitRandomMove);
@@ -1029,6 +1051,148 @@ static void test_nmeaGeneratorInvoke(void) {
   nmeaGeneratorDestroy(gen);
 }
 
+static void test_nmeaGeneratorInvokeBatch(void) {
+  NmeaInfo infos[8];
+  NmeaInfo single[8];
+  NmeaInfo info;
+  NmeaGenerator *gen;
+  size_t i;
+  bool r;
+
+  memset(infos, 0, sizeof(infos));
+
+  gen = nmeaGeneratorCreate(NMEALIB_GENERATOR_STATIC, &info);
+  CU_ASSERT_PTR_NOT_NULL_FATAL(gen);
+
+  /* invalid inputs */
+
+  r = nmeaGeneratorInvokeBatch(NULL, infos, 8);
+  CU_ASSERT_EQUAL(r, false);
+
+  r = nmeaGeneratorInvokeBatch(gen, NULL, 8);
+  CU_ASSERT_EQUAL(r, false);
+
+  r = nmeaGeneratorInvokeBatchNoise(gen, NULL, 8);
+  CU_ASSERT_EQUAL(r, false);
+
+  r = nmeaGeneratorInvokeBatchStatic(gen, NULL, 8);
+  CU_ASSERT_EQUAL(r, false);
+
+  r = nmeaGeneratorInvokeBatchRotate(gen, NULL, 8);
+  CU_ASSERT_EQUAL(r, false);
+
+  r = nmeaGeneratorInvokeBatchRandomMove(gen, NULL, 8);
+  CU_ASSERT_EQUAL(r, false);
+
+  /* empty */
+
+  r = nmeaGeneratorInvokeBatch(gen, infos, 0);
+  CU_ASSERT_EQUAL(r, true);
+  CU_ASSERT_EQUAL(infos[0].present, 0);
+
+  /* static: all get the same time */
+
+  r = nmeaGeneratorInvokeBatch(gen, infos, 8);
+  CU_ASSERT_EQUAL(r, true);
+  for (i = 0; i < 8; i++) {
+    CU_ASSERT_EQUAL(infos[i].present, NMEALIB_PRESENT_UTCDATE | NMEALIB_PRESENT_UTCTIME);
+    CU_ASSERT_EQUAL(memcmp(&infos[i].utc, &infos[0].utc, sizeof(infos[0].utc)), 0);
+  }
+  CU_ASSERT_NOT_EQUAL(infos[0].utc.year, 0);
+
+  nmeaGeneratorDestroy(gen);
+
+  /* noise */
+
+  gen = nmeaGeneratorCreate(NMEALIB_GENERATOR_NOISE, &info);
+  CU_ASSERT_PTR_NOT_NULL_FATAL(gen);
+
+  memset(infos, 0, sizeof(infos));
+  r = nmeaGeneratorInvokeBatch(gen, infos, 8);
+  CU_ASSERT_EQUAL(r, true);
+  for (i = 0; i < 8; i++) {
+    CU_ASSERT_EQUAL(nmeaInfoIsPresentAll(infos[i].present, NMEALIB_PRESENT_LAT | NMEALIB_PRESENT_SATINVIEW), true);
+  }
+
+  nmeaGeneratorDestroy(gen);
+
+  /* rotate sat */
+
+  gen = nmeaGeneratorCreate(NMEALIB_GENERATOR_SAT_ROTATE, &info);
+  CU_ASSERT_PTR_NOT_NULL_FATAL(gen);
+
+  for (i = 0; i < 8; i++) {
+    infos[i] = info;
+  }
+  r = nmeaGeneratorInvokeBatch(gen, infos, 8);
+  CU_ASSERT_EQUAL(r, true);
+  for (i = 0; i < 8; i++) {
+    CU_ASSERT_EQUAL(infos[i].satellites.inView[0].azimuth, 5);
+    CU_ASSERT_EQUAL(infos[i].satellites.inView[1].azimuth, 50);
+  }
+
+  nmeaGeneratorDestroy(gen);
+
+  /* random move: the same as invoking every info in turn */
+
+  gen = nmeaGeneratorCreate(NMEALIB_GENERATOR_POS_RANDMOVE, &info);
+  CU_ASSERT_PTR_NOT_NULL_FATAL(gen);
+
+  for (i = 0; i < 8; i++) {
+    infos[i] = info;
+    infos[i].latitude = 5000.0 + (double) i;
+    infos[i].longitude = -400.0 * (double) i;
+    if (i == 7) {
+      nmeaInfoUnsetPresent(&infos[i].present, NMEALIB_PRESENT_LAT | NMEALIB_PRESENT_LON);
+    }
+    single[i] = infos[i];
+  }
+
+  nmeaRandomSeedThread(42);
+  r = nmeaGeneratorInvokeBatch(gen, infos, 8);
+  CU_ASSERT_EQUAL(r, true);
+
+  nmeaRandomSeedThread(42);
+  for (i = 0; i < 8; i++) {
+    r = nmeaGeneratorInvoke(gen, &single[i]);
+    CU_ASSERT_EQUAL(r, true);
+  }
+
+  nmeaRandomSeedThread(0);
+
+  for (i = 0; i < 8; i++) {
+    CU_ASSERT_EQUAL(infos[i].present, single[i].present);
+    CU_ASSERT_DOUBLE_EQUAL(infos[i].latitude, single[i].latitude, 1E-9);
+    CU_ASSERT_DOUBLE_EQUAL(infos[i].longitude, single[i].longitude, 1E-9);
+    CU_ASSERT_DOUBLE_EQUAL(infos[i].speed, single[i].speed, DBL_EPSILON);
+    CU_ASSERT_DOUBLE_EQUAL(infos[i].track, single[i].track, DBL_EPSILON);
+    CU_ASSERT_DOUBLE_EQUAL(infos[i].mtrack, single[i].mtrack, DBL_EPSILON);
+    CU_ASSERT_DOUBLE_EQUAL(infos[i].magvar, single[i].magvar, DBL_EPSILON);
+  }
+
+  nmeaGeneratorDestroy(gen);
+
+  /* generators without a batch invoke function, failed invoke */
+
+  gen = nmeaGeneratorCreate(NMEALIB_GENERATOR_ROTATE, &info);
+  CU_ASSERT_PTR_NOT_NULL_FATAL(gen);
+
+  gen->invokeBatch = NULL;
+  gen->next->invokeBatch = NULL;
+  r = nmeaGeneratorInvokeBatch(gen, infos, 8);
+  CU_ASSERT_EQUAL(r, true);
+
+  gen->invoke = failInvoke;
+  r = nmeaGeneratorInvokeBatch(gen, infos, 8);
+  CU_ASSERT_EQUAL(r, false);
+
+  gen->invokeBatch = failInvokeBatch;
+  r = nmeaGeneratorInvokeBatch(gen, infos, 8);
+  CU_ASSERT_EQUAL(r, false);
+
+  nmeaGeneratorDestroy(gen);
+}
+
 static void test_nmeaGeneratorAppend(void) {
   NmeaInfo info;
   NmeaGenerator *gen = nmeaGeneratorCreate(NMEALIB_GENERATOR_STATIC, &info);
@@ -1137,6 +1301,210 @@ static void test_nmeaGeneratorGenerateFrom(void) {
   nmeaGeneratorDestroy(gen);
 }
 
+static void test_nmeaGeneratorCreateReplay(void) {
+  NmeaGeneratorReplayConfig config;
+  NmeaGenerator *gen;
+  NmeaInfo epochs[3];
+  NmeaInfo info;
+  struct timespec before;
+  struct timespec after;
+  long long elapsed;
+  size_t i;
+  bool r;
+
+  memset(&config, 0, sizeof(config));
+  memset(epochs, 0, sizeof(epochs));
+  for (i = 0; i < 3; i++) {
+    epochs[i].utc.year = 2024;
+    epochs[i].utc.mon = 12;
+    epochs[i].utc.day = 31;
+    epochs[i].utc.hour = 23;
+    epochs[i].utc.min = 59;
+    epochs[i].utc.sec = (unsigned int) (58 + i);
+    epochs[i].latitude = (double) i;
+    nmeaInfoSetPresent(&epochs[i].present, NMEALIB_PRESENT_UTCDATE | NMEALIB_PRESENT_UTCTIME | NMEALIB_PRESENT_LAT);
+  }
+
+  /* invalid inputs */
+
+  gen = nmeaGeneratorCreateReplay(NULL, 3, &config, &info);
+  CU_ASSERT_PTR_NULL(gen);
+
+  gen = nmeaGeneratorCreateReplay(epochs, 0, &config, &info);
+  CU_ASSERT_PTR_NULL(gen);
+
+  gen = nmeaGeneratorCreateReplay(epochs, 3, &config, NULL);
+  CU_ASSERT_PTR_NULL(gen);
+
+  config.speed = -1.0;
+  gen = nmeaGeneratorCreateReplay(epochs, 3, &config, &info);
+  CU_ASSERT_PTR_NULL(gen);
+  config.speed = 0.0;
+
+  config.jitter = -1.0;
+  gen = nmeaGeneratorCreateReplay(epochs, 3, &config, &info);
+  CU_ASSERT_PTR_NULL(gen);
+  config.jitter = 0.0;
+
+  gen = nmeaGeneratorCreate(NMEALIB_GENERATOR_REPLAY, &info);
+  CU_ASSERT_PTR_NULL(gen);
+
+  gen = nmeaGeneratorCreateReplay(epochs, 3, NULL, &info);
+  CU_ASSERT_PTR_NOT_NULL_FATAL(gen);
+  CU_ASSERT_PTR_NULL(gen->init);
+  CU_ASSERT_EQUAL(gen->invoke, nmeaGeneratorInvokeReplay);
+  CU_ASSERT_EQUAL(gen->reset, nmeaGeneratorResetReplay);
+  CU_ASSERT_PTR_NULL(gen->next);
+  nmeaGeneratorDestroy(gen);
+
+  /* as fast as possible, re-stamped from the start time */
+
+  config.start.tv_sec = 1000000000; /* 2001-09-09 01:46:40 */
+  config.start.tv_usec = 500000;
+
+  gen = nmeaGeneratorCreateReplay(epochs, 3, &config, &info);
+  CU_ASSERT_PTR_NOT_NULL_FATAL(gen);
+
+  for (i = 0; i < 3; i++) {
+    memset(&info, 0xaa, sizeof(info));
+    r = nmeaGeneratorInvoke(gen, &info);
+    CU_ASSERT_EQUAL(r, true);
+    CU_ASSERT_DOUBLE_EQUAL(info.latitude, (double) i, DBL_EPSILON);
+    CU_ASSERT_EQUAL(info.utc.year, 2001);
+    CU_ASSERT_EQUAL(info.utc.mon, 9);
+    CU_ASSERT_EQUAL(info.utc.day, 9);
+    CU_ASSERT_EQUAL(info.utc.hour, 1);
+    CU_ASSERT_EQUAL(info.utc.min, 46);
+    CU_ASSERT_EQUAL(info.utc.sec, 40 + i);
+    CU_ASSERT_EQUAL(info.utc.hsec, 50);
+  }
+
+  r = nmeaGeneratorInvoke(gen, &info);
+  CU_ASSERT_EQUAL(r, false);
+
+  /* reset */
+
+  r = nmeaGeneratorReset(gen, &info);
+  CU_ASSERT_EQUAL(r, true);
+
+  r = nmeaGeneratorInvoke(gen, &info);
+  CU_ASSERT_EQUAL(r, true);
+  CU_ASSERT_DOUBLE_EQUAL(info.latitude, 0.0, DBL_EPSILON);
+  CU_ASSERT_EQUAL(info.utc.sec, 40);
+
+  nmeaGeneratorDestroy(gen);
+
+  /* loop */
+
+  config.loop = true;
+
+  gen = nmeaGeneratorCreateReplay(epochs, 3, &config, &info);
+  CU_ASSERT_PTR_NOT_NULL_FATAL(gen);
+
+  for (i = 0; i < 7; i++) {
+    r = nmeaGeneratorInvoke(gen, &info);
+    CU_ASSERT_EQUAL(r, true);
+    CU_ASSERT_DOUBLE_EQUAL(info.latitude, (double) (i % 3), DBL_EPSILON);
+    CU_ASSERT_EQUAL(info.utc.sec, 40 + i);
+  }
+
+  nmeaGeneratorDestroy(gen);
+
+  /* time warp */
+
+  config.loop = false;
+  config.speed = 100.0;
+  config.jitter = 0.001;
+
+  gen = nmeaGeneratorCreateReplay(epochs, 3, &config, &info);
+  CU_ASSERT_PTR_NOT_NULL_FATAL(gen);
+
+  clock_gettime(CLOCK_MONOTONIC, &before);
+  for (i = 0; i < 3; i++) {
+    r = nmeaGeneratorInvoke(gen, &info);
+    CU_ASSERT_EQUAL(r, true);
+    CU_ASSERT_EQUAL(info.utc.sec, 40);
+    CU_ASSERT_EQUAL(info.utc.hsec, 50 + i);
+  }
+  clock_gettime(CLOCK_MONOTONIC, &after);
+
+  elapsed = ((long long) (after.tv_sec - before.tv_sec) * 1000000000LL) + (after.tv_nsec - before.tv_nsec);
+  CU_ASSERT(elapsed >= 19000000LL);
+  CU_ASSERT(elapsed < 1000000000LL);
+
+  nmeaGeneratorDestroy(gen);
+
+  validateContext(0, 0);
+}
+
+static void test_nmeaGeneratorCreateReplayLog(void) {
+  const char *log = //
+      "$GPGSV,1,1,01,01,50,000,99*4C\r\n" //
+      "$GPGGA,235958.00,5000.000,N,00400.000,E,1,04,1.0,10.0,M,0.0,M,,*69\r\n" //
+      "$GPRMC,235958.00,A,5000.000,N,00400.000,E,10.0,90.0,311224,,*3D\r\n" //
+      "$GPGGA,235959.00,5000.001,N,00400.000,E,1,04,1.0,10.0,M,0.0,M,,*69\r\n" //
+      "$GPRMC,235959.00,A,5000.001,N,00400.000,E,10.0,90.0,311224,,*3D\r\n" //
+      "$GPGGA,000000.00,5000.002,N,00400.000,E,1,04,1.0,10.0,M,0.0,M,,*6B\r\n";
+  NmeaGeneratorReplayConfig config;
+  NmeaGenerator *gen;
+  NmeaInfo info;
+  bool r;
+
+  memset(&config, 0, sizeof(config));
+  config.start.tv_sec = 1000000000;
+
+  /* invalid inputs */
+
+  gen = nmeaGeneratorCreateReplayLog(NULL, strlen(log), &config, &info);
+  CU_ASSERT_PTR_NULL(gen);
+
+  gen = nmeaGeneratorCreateReplayLog(log, 0, &config, &info);
+  CU_ASSERT_PTR_NULL(gen);
+
+  gen = nmeaGeneratorCreateReplayLog(log, strlen(log), &config, NULL);
+  CU_ASSERT_PTR_NULL(gen);
+
+  config.speed = -1.0;
+  gen = nmeaGeneratorCreateReplayLog(log, strlen(log), &config, &info);
+  CU_ASSERT_PTR_NULL(gen);
+  config.speed = 0.0;
+
+  /* no epochs */
+
+  gen = nmeaGeneratorCreateReplayLog(log, 32, &config, &info);
+  CU_ASSERT_PTR_NULL(gen);
+
+  /* success */
+
+  gen = nmeaGeneratorCreateReplayLog(log, strlen(log), &config, &info);
+  CU_ASSERT_PTR_NOT_NULL_FATAL(gen);
+
+  r = nmeaGeneratorInvoke(gen, &info);
+  CU_ASSERT_EQUAL(r, true);
+  CU_ASSERT_DOUBLE_EQUAL(info.latitude, 5000.0, 1E-9);
+  CU_ASSERT_DOUBLE_EQUAL(info.track, 90.0, 1E-9);
+  CU_ASSERT_EQUAL(nmeaInfoIsPresentAll(info.present, NMEALIB_PRESENT_SATINVIEW), true);
+  CU_ASSERT_EQUAL(info.utc.sec, 40);
+
+  r = nmeaGeneratorInvoke(gen, &info);
+  CU_ASSERT_EQUAL(r, true);
+  CU_ASSERT_DOUBLE_EQUAL(info.latitude, 5000.001, 1E-9);
+  CU_ASSERT_EQUAL(info.utc.sec, 41);
+
+  /* over midnight, with the date of the previous epoch */
+  r = nmeaGeneratorInvoke(gen, &info);
+  CU_ASSERT_EQUAL(r, true);
+  CU_ASSERT_DOUBLE_EQUAL(info.latitude, 5000.002, 1E-9);
+  CU_ASSERT_EQUAL(info.utc.sec, 42);
+
+  r = nmeaGeneratorInvoke(gen, &info);
+  CU_ASSERT_EQUAL(r, false);
+
+  nmeaGeneratorDestroy(gen);
+
+  validateContext(7, 0);
+}
+
 /*
  * Setup
  */
@@ -1162,8 +1530,11 @@ int generatorSuiteSetup(void) {
       || (!CU_add_test(pSuite, "nmeaGeneratorReset", test_nmeaGeneratorReset)) //
       || (!CU_add_test(pSuite, "nmeaGeneratorDestroy", test_nmeaGeneratorDestroy)) //
       || (!CU_add_test(pSuite, "nmeaGeneratorInvoke", test_nmeaGeneratorInvoke)) //
+      || (!CU_add_test(pSuite, "nmeaGeneratorInvokeBatch", test_nmeaGeneratorInvokeBatch)) //
       || (!CU_add_test(pSuite, "nmeaGeneratorAppend", test_nmeaGeneratorAppend)) //
       || (!CU_add_test(pSuite, "nmeaGeneratorGenerateFrom", test_nmeaGeneratorGenerateFrom)) //
+      || (!CU_add_test(pSuite, "nmeaGeneratorCreateReplay", test_nmeaGeneratorCreateReplay)) //
+      || (!CU_add_test(pSuite, "nmeaGeneratorCreateReplayLog", test_nmeaGeneratorCreateReplayLog)) //
       ) {
     return CU_get_error();
   }
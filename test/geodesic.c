@@ -0,0 +1,235 @@
+/*
+ * This file is part of nmealib.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "testHelpers.h"
+
+#include <nmealib/geodesic.h>
+#include <nmealib/nmath.h>
+#include <nmealib/util.h>
+#include <CUnit/Basic.h>
+#include <math.h>
+
+int geodesicSuiteSetup(void);
+
+/** The ratio of the WGS84 equatorial radius and the radius that nmeaMathDistanceEllipsoid uses */
+#define GEODESIC_TEST_VINCENTY_SCALE ((double) NMEALIB_EARTHRADIUS_M / NMEALIB_EARTH_SEMIMAJORAXIS_M)
+
+/*
+ * Tests
+ */
+
+static void test_nmeaGeodesicInverse(void) {
+  NmeaPosition from;
+  NmeaPosition to;
+  double fromAzimuth;
+  double toAzimuth;
+  double r;
+  size_t i;
+
+  /* invalid inputs */
+
+  from.lat = 0.0;
+  from.lon = 0.0;
+  to = from;
+  r = nmeaGeodesicInverse(NULL, &to, NULL, NULL);
+  CU_ASSERT_EQUAL(isNaN(r), true);
+  r = nmeaGeodesicInverse(&from, NULL, NULL, NULL);
+  CU_ASSERT_EQUAL(isNaN(r), true);
+
+  to.lat = NaN;
+  fromAzimuth = 0.0;
+  toAzimuth = 0.0;
+  r = nmeaGeodesicInverse(&from, &to, &fromAzimuth, &toAzimuth);
+  CU_ASSERT_EQUAL(isNaN(r), true);
+  CU_ASSERT_EQUAL(isNaN(fromAzimuth), true);
+  CU_ASSERT_EQUAL(isNaN(toAzimuth), true);
+
+  to.lat = 2.0;
+  r = nmeaGeodesicInverse(&from, &to, NULL, NULL);
+  CU_ASSERT_EQUAL(isNaN(r), true);
+
+  /* same pos */
+
+  from.lat = nmeaMathDegreeToRadian(52.0);
+  from.lon = nmeaMathDegreeToRadian(5.0);
+  to = from;
+  r = nmeaGeodesicInverse(&from, &to, &fromAzimuth, &toAzimuth);
+  CU_ASSERT_EQUAL(r, 0.0);
+
+  /* a quarter meridian */
+
+  from.lat = 0.0;
+  from.lon = 0.0;
+  to.lat = NMEALIB_PI / 2;
+  to.lon = 0.0;
+  r = nmeaGeodesicInverse(&from, &to, &fromAzimuth, &toAzimuth);
+  CU_ASSERT_DOUBLE_EQUAL(r, 10001965.7293127, 1e-6);
+  CU_ASSERT_DOUBLE_EQUAL(fromAzimuth, 0.0, 1e-15);
+  CU_ASSERT_DOUBLE_EQUAL(toAzimuth, 0.0, 1e-15);
+
+  /* along the equator */
+
+  to.lat = 0.0;
+  to.lon = -1.0;
+  r = nmeaGeodesicInverse(&from, &to, &fromAzimuth, &toAzimuth);
+  CU_ASSERT_DOUBLE_EQUAL(r, NMEALIB_EARTHRADIUS_M, 1e-6);
+  CU_ASSERT_DOUBLE_EQUAL(fromAzimuth, -NMEALIB_PI / 2, 1e-15);
+  CU_ASSERT_DOUBLE_EQUAL(toAzimuth, -NMEALIB_PI / 2, 1e-15);
+
+  /* antipodal on the equator: over a pole, half a meridian */
+
+  to.lat = 0.0;
+  to.lon = NMEALIB_PI;
+  r = nmeaGeodesicInverse(&from, &to, &fromAzimuth, &toAzimuth);
+  CU_ASSERT_DOUBLE_EQUAL(r, 2 * 10001965.7293127, 2e-6);
+  CU_ASSERT_DOUBLE_EQUAL(fabs(fromAzimuth) + fabs(toAzimuth), NMEALIB_PI, 1e-12);
+
+  /* nearly antipodal, the example of Karney (2013) */
+
+  from.lat = nmeaMathDegreeToRadian(-30.0);
+  from.lon = 0.0;
+  to.lat = nmeaMathDegreeToRadian(29.9);
+  to.lon = nmeaMathDegreeToRadian(179.8);
+  r = nmeaGeodesicInverse(&from, &to, &fromAzimuth, &toAzimuth);
+  CU_ASSERT_DOUBLE_EQUAL(r, 19989832.82761, 1e-5);
+  CU_ASSERT_DOUBLE_EQUAL(nmeaMathRadianToDegree(fromAzimuth), 161.890524736, 1e-9);
+  CU_ASSERT_DOUBLE_EQUAL(nmeaMathRadianToDegree(toAzimuth), 18.090737246, 1e-9);
+
+  /* the reverse direction */
+
+  r = nmeaGeodesicInverse(&to, &from, &fromAzimuth, &toAzimuth);
+  CU_ASSERT_DOUBLE_EQUAL(r, 19989832.82761, 1e-5);
+  CU_ASSERT_DOUBLE_EQUAL(nmeaMathRadianToDegree(fromAzimuth), 18.090737246 - 180.0, 1e-9);
+  CU_ASSERT_DOUBLE_EQUAL(nmeaMathRadianToDegree(toAzimuth), 161.890524736 - 180.0, 1e-9);
+
+  /* the same as Vincenty (on a scaled ellipsoid) where Vincenty converges */
+
+  nmeaRandomSeedThread(49);
+
+  for (i = 0; i < 1000; i++) {
+    from.lat = nmeaRandom(-1.5, 1.5);
+    from.lon = nmeaRandom(-NMEALIB_PI, NMEALIB_PI);
+    to.lat = from.lat + nmeaRandom(-0.1, 0.1);
+    to.lon = from.lon + nmeaRandom(-0.1, 0.1);
+
+    r = nmeaGeodesicInverse(&from, &to, NULL, NULL);
+    CU_ASSERT_DOUBLE_EQUAL(r, GEODESIC_TEST_VINCENTY_SCALE * nmeaMathDistanceEllipsoid(&from, &to, NULL, NULL),
+        1e-4);
+  }
+
+  validateContext(0, 0);
+}
+
+static void test_nmeaGeodesicDirect(void) {
+  NmeaPosition from;
+  NmeaPosition to;
+  NmeaPosition back;
+  double fromAzimuth;
+  double toAzimuth;
+  double azimuth;
+  double distance;
+  bool r;
+  size_t i;
+
+  /* invalid inputs */
+
+  from.lat = 0.0;
+  from.lon = 0.0;
+  r = nmeaGeodesicDirect(NULL, &to, 0.0, 1.0, NULL);
+  CU_ASSERT_EQUAL(r, false);
+  r = nmeaGeodesicDirect(&from, NULL, 0.0, 1.0, NULL);
+  CU_ASSERT_EQUAL(r, false);
+
+  from.lon = NaN;
+  toAzimuth = 0.0;
+  r = nmeaGeodesicDirect(&from, &to, 0.0, 1.0, &toAzimuth);
+  CU_ASSERT_EQUAL(r, false);
+  CU_ASSERT_EQUAL(isNaN(to.lat), true);
+  CU_ASSERT_EQUAL(isNaN(to.lon), true);
+  CU_ASSERT_EQUAL(isNaN(toAzimuth), true);
+
+  /* no move */
+
+  from.lat = nmeaMathDegreeToRadian(52.0);
+  from.lon = nmeaMathDegreeToRadian(5.0);
+  r = nmeaGeodesicDirect(&from, &to, 1.0, 0.0, &toAzimuth);
+  CU_ASSERT_EQUAL(r, true);
+  CU_ASSERT_DOUBLE_EQUAL(to.lat, from.lat, 1e-15);
+  CU_ASSERT_DOUBLE_EQUAL(to.lon, from.lon, 1e-15);
+  CU_ASSERT_DOUBLE_EQUAL(toAzimuth, 1.0, 1e-15);
+
+  /* the example of Karney (2013) */
+
+  from.lat = nmeaMathDegreeToRadian(-30.0);
+  from.lon = 0.0;
+  r = nmeaGeodesicDirect(&from, &to, nmeaMathDegreeToRadian(161.890524736), 19989832.82761, &toAzimuth);
+  CU_ASSERT_EQUAL(r, true);
+  CU_ASSERT_DOUBLE_EQUAL(nmeaMathRadianToDegree(to.lat), 29.9, 1e-8);
+  CU_ASSERT_DOUBLE_EQUAL(nmeaMathRadianToDegree(to.lon), 179.8, 1e-8);
+  CU_ASSERT_DOUBLE_EQUAL(nmeaMathRadianToDegree(toAzimuth), 18.090737246, 1e-8);
+
+  /* across the antimeridian */
+
+  from.lat = 0.0;
+  from.lon = NMEALIB_PI - 1e-6;
+  r = nmeaGeodesicDirect(&from, &to, NMEALIB_PI / 2, 100.0, NULL);
+  CU_ASSERT_EQUAL(r, true);
+  CU_ASSERT(to.lon < 0.0);
+
+  /* round trips, including nearly antipodal pairs */
+
+  nmeaRandomSeedThread(49);
+
+  for (i = 0; i < 1000; i++) {
+    from.lat = nmeaRandom(-NMEALIB_PI / 2, NMEALIB_PI / 2);
+    from.lon = nmeaRandom(-NMEALIB_PI, NMEALIB_PI);
+    azimuth = nmeaRandom(-NMEALIB_PI, NMEALIB_PI);
+    distance = (i & 1) ?
+        nmeaRandom(0.0, 20000000.0) :
+        nmeaRandom(19990000.0, 20003000.0);
+
+    r = nmeaGeodesicDirect(&from, &to, azimuth, distance, NULL);
+    CU_ASSERT_EQUAL(r, true);
+
+    nmeaGeodesicInverse(&from, &to, &fromAzimuth, NULL);
+    r = nmeaGeodesicDirect(&from, &back, fromAzimuth, nmeaGeodesicInverse(&from, &to, NULL, NULL), NULL);
+    CU_ASSERT_EQUAL(r, true);
+    CU_ASSERT_DOUBLE_EQUAL(nmeaGeodesicInverse(&to, &back, NULL, NULL), 0.0, 1e-6);
+  }
+
+  validateContext(0, 0);
+}
+
+/*
+ * Setup
+ */
+
+int geodesicSuiteSetup(void) {
+  CU_pSuite pSuite = CU_add_suite("geodesic", mockContextSuiteInit, mockContextSuiteClean);
+  if (!pSuite) {
+    return CU_get_error();
+  }
+
+  if ( //
+      (!CU_add_test(pSuite, "nmeaGeodesicInverse", test_nmeaGeodesicInverse)) //
+      || (!CU_add_test(pSuite, "nmeaGeodesicDirect", test_nmeaGeodesicDirect)) //
+      ) {
+    return CU_get_error();
+  }
+
+  return CUE_SUCCESS;
+}
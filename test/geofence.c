@@ -0,0 +1,420 @@
+/*
+ * This file is part of nmealib.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "testHelpers.h"
+
+#include <nmealib/geodesic.h>
+#include <nmealib/geofence.h>
+#include <nmealib/nmath.h>
+#include <CUnit/Basic.h>
+#include <stddef.h>
+#include <string.h>
+
+int geofenceSuiteSetup(void);
+
+typedef struct _GeofenceTestEvent {
+  size_t device;
+  uint32_t id;
+  NmeaGeofenceEvent event;
+} GeofenceTestEvent;
+
+typedef struct _GeofenceTestState {
+  size_t count;
+  GeofenceTestEvent events[8];
+} GeofenceTestState;
+
+static void geofenceTestHandler(void *user, size_t device, uint32_t id, NmeaGeofenceEvent event) {
+  GeofenceTestState *state = (GeofenceTestState *) user;
+
+  if (state->count < (sizeof(state->events) / sizeof(state->events[0]))) {
+    state->events[state->count].device = device;
+    state->events[state->count].id = id;
+    state->events[state->count].event = event;
+  }
+  state->count++;
+}
+
+static void geofenceTestPosition(NmeaPosition *pos, double lat, double lon) {
+  pos->lat = nmeaMathDegreeToRadian(lat);
+  pos->lon = nmeaMathDegreeToRadian(lon);
+}
+
+static size_t geofenceTestUpdate(NmeaGeofences *geofences, GeofenceTestState *state, size_t device, double lat,
+    double lon) {
+  NmeaPosition pos;
+
+  memset(state, 0, sizeof(*state));
+  geofenceTestPosition(&pos, lat, lon);
+
+  return nmeaGeofencesUpdate(geofences, device, &pos);
+}
+
+/*
+ * Tests
+ */
+
+static void test_nmeaGeofencesCreate(void) {
+  NmeaGeofenceConfig config;
+  NmeaGeofences *geofences;
+  NmeaPosition vertices[4];
+  NmeaPosition pos;
+  bool r;
+
+  memset(&config, 0, sizeof(config));
+
+  /* invalid inputs */
+
+  geofences = nmeaGeofencesCreate(NULL);
+  CU_ASSERT_PTR_NULL(geofences);
+
+  geofences = nmeaGeofencesCreate(&config);
+  CU_ASSERT_PTR_NULL(geofences);
+
+  config.devices = 1;
+  config.cellSize = -1.0;
+  geofences = nmeaGeofencesCreate(&config);
+  CU_ASSERT_PTR_NULL(geofences);
+
+  config.cellSize = NaN;
+  geofences = nmeaGeofencesCreate(&config);
+  CU_ASSERT_PTR_NULL(geofences);
+
+  config.cellSize = 0.0001;
+  geofences = nmeaGeofencesCreate(&config);
+  CU_ASSERT_PTR_NULL(geofences);
+
+  config.cellSize = 181.0;
+  geofences = nmeaGeofencesCreate(&config);
+  CU_ASSERT_PTR_NULL(geofences);
+
+  CU_ASSERT_EQUAL(nmeaGeofencesCount(NULL), 0);
+  nmeaGeofencesDestroy(NULL);
+
+  /* normal */
+
+  config.cellSize = 0.0;
+  geofences = nmeaGeofencesCreate(&config);
+  CU_ASSERT_PTR_NOT_NULL_FATAL(geofences);
+  CU_ASSERT_EQUAL(nmeaGeofencesCount(geofences), 0);
+
+  /* no fences */
+
+  geofenceTestPosition(&pos, 52.0, 5.0);
+  CU_ASSERT_EQUAL(nmeaGeofencesUpdate(geofences, 0, &pos), 0);
+
+  /* invalid fences */
+
+
+  r = nmeaGeofencesAddCircle(NULL, 1, &pos, 100.0);
+  CU_ASSERT_EQUAL(r, false);
+
+  r = nmeaGeofencesAddCircle(geofences, 1, NULL, 100.0);
+  CU_ASSERT_EQUAL(r, false);
+
+  r = nmeaGeofencesAddCircle(geofences, 1, &pos, 0.0);
+  CU_ASSERT_EQUAL(r, false);
+
+  r = nmeaGeofencesAddCircle(geofences, 1, &pos, NaN);
+  CU_ASSERT_EQUAL(r, false);
+
+  geofenceTestPosition(&pos, 91.0, 5.0);
+  r = nmeaGeofencesAddCircle(geofences, 1, &pos, 100.0);
+  CU_ASSERT_EQUAL(r, false);
+
+  geofenceTestPosition(&vertices[0], 10.0, 0.0);
+  geofenceTestPosition(&vertices[1], 10.0, 100.0);
+  geofenceTestPosition(&vertices[2], 20.0, -100.0);
+  geofenceTestPosition(&vertices[3], 20.0, 0.0);
+
+  r = nmeaGeofencesAddPolygon(NULL, 2, vertices, 3);
+  CU_ASSERT_EQUAL(r, false);
+
+  r = nmeaGeofencesAddPolygon(geofences, 2, NULL, 3);
+  CU_ASSERT_EQUAL(r, false);
+
+  r = nmeaGeofencesAddPolygon(geofences, 2, vertices, 2);
+  CU_ASSERT_EQUAL(r, false);
+
+  /* spans 200 degrees of longitude */
+  r = nmeaGeofencesAddPolygon(geofences, 2, vertices, 4);
+  CU_ASSERT_EQUAL(r, false);
+
+  vertices[1].lat = NaN;
+  r = nmeaGeofencesAddPolygon(geofences, 2, vertices, 3);
+  CU_ASSERT_EQUAL(r, false);
+
+  CU_ASSERT_EQUAL(nmeaGeofencesCount(geofences), 0);
+
+  /* valid fences */
+
+  geofenceTestPosition(&pos, 52.0, 5.0);
+  r = nmeaGeofencesAddCircle(geofences, 1, &pos, 100.0);
+  CU_ASSERT_EQUAL(r, true);
+
+  geofenceTestPosition(&vertices[1], 10.0, 10.0);
+  r = nmeaGeofencesAddPolygon(geofences, 2, vertices, 3);
+  CU_ASSERT_EQUAL(r, true);
+
+  CU_ASSERT_EQUAL(nmeaGeofencesCount(geofences), 2);
+
+  nmeaGeofencesDestroy(geofences);
+
+  validateContext(0, 0);
+}
+
+static void test_nmeaGeofencesUpdate(void) {
+  NmeaGeofenceConfig config;
+  GeofenceTestState state;
+  NmeaGeofences *geofences;
+  NmeaPosition vertices[4];
+  NmeaPosition pos;
+  NmeaInfo info;
+  size_t r;
+
+  memset(&config, 0, sizeof(config));
+  config.devices = 2;
+  config.handler = geofenceTestHandler;
+  config.user = &state;
+
+  geofences = nmeaGeofencesCreate(&config);
+  CU_ASSERT_PTR_NOT_NULL_FATAL(geofences);
+
+  /* a circle, a square, a square across the antimeridian, a circle around a pole */
+
+  geofenceTestPosition(&pos, 52.0, 5.0);
+  nmeaGeofencesAddCircle(geofences, 1, &pos, 1000.0);
+
+  geofenceTestPosition(&vertices[0], 53.0, 6.0);
+  geofenceTestPosition(&vertices[1], 53.0, 6.1);
+  geofenceTestPosition(&vertices[2], 53.1, 6.1);
+  geofenceTestPosition(&vertices[3], 53.1, 6.0);
+  nmeaGeofencesAddPolygon(geofences, 2, vertices, 4);
+
+  geofenceTestPosition(&vertices[0], -10.0, 179.0);
+  geofenceTestPosition(&vertices[1], -10.0, -179.0);
+  geofenceTestPosition(&vertices[2], 10.0, -179.0);
+  geofenceTestPosition(&vertices[3], 10.0, 179.0);
+  nmeaGeofencesAddPolygon(geofences, 3, vertices, 4);
+
+  geofenceTestPosition(&pos, 89.99, 0.0);
+  nmeaGeofencesAddCircle(geofences, 4, &pos, 5000.0);
+
+  /* invalid inputs */
+
+  r = geofenceTestUpdate(NULL, &state, 0, 52.0, 5.0);
+  CU_ASSERT_EQUAL(r, 0);
+
+  r = geofenceTestUpdate(geofences, &state, 2, 52.0, 5.0);
+  CU_ASSERT_EQUAL(r, 0);
+
+  r = geofenceTestUpdate(geofences, &state, 0, NaN, 5.0);
+  CU_ASSERT_EQUAL(r, 0);
+
+  r = nmeaGeofencesUpdate(geofences, 0, NULL);
+  CU_ASSERT_EQUAL(r, 0);
+
+  CU_ASSERT_EQUAL(nmeaGeofencesInside(NULL, 0, 1), false);
+  CU_ASSERT_EQUAL(nmeaGeofencesInside(geofences, 2, 1), false);
+
+  /* enter and stay in the circle */
+
+  r = geofenceTestUpdate(geofences, &state, 0, 52.0, 5.0);
+  CU_ASSERT_EQUAL(r, 1);
+  CU_ASSERT_EQUAL(state.count, 1);
+  CU_ASSERT_EQUAL(state.events[0].device, 0);
+  CU_ASSERT_EQUAL(state.events[0].id, 1);
+  CU_ASSERT_EQUAL(state.events[0].event, NMEALIB_GEOFENCE_ENTER);
+  CU_ASSERT_EQUAL(nmeaGeofencesInside(geofences, 0, 1), true);
+  CU_ASSERT_EQUAL(nmeaGeofencesInside(geofences, 1, 1), false);
+
+  r = geofenceTestUpdate(geofences, &state, 0, 52.0, 5.01);
+  CU_ASSERT_EQUAL(r, 0);
+  CU_ASSERT_EQUAL(state.count, 0);
+
+  /* leave the circle, enter the square: exit first */
+
+  r = geofenceTestUpdate(geofences, &state, 0, 53.05, 6.05);
+  CU_ASSERT_EQUAL(r, 2);
+  CU_ASSERT_EQUAL(state.count, 2);
+  CU_ASSERT_EQUAL(state.events[0].id, 1);
+  CU_ASSERT_EQUAL(state.events[0].event, NMEALIB_GEOFENCE_EXIT);
+  CU_ASSERT_EQUAL(state.events[1].id, 2);
+  CU_ASSERT_EQUAL(state.events[1].event, NMEALIB_GEOFENCE_ENTER);
+  CU_ASSERT_EQUAL(nmeaGeofencesInside(geofences, 0, 1), false);
+  CU_ASSERT_EQUAL(nmeaGeofencesInside(geofences, 0, 2), true);
+
+  /* the other device is independent */
+
+  r = geofenceTestUpdate(geofences, &state, 1, 52.0, 4.999);
+  CU_ASSERT_EQUAL(r, 1);
+  CU_ASSERT_EQUAL(state.events[0].device, 1);
+  CU_ASSERT_EQUAL(state.events[0].id, 1);
+  CU_ASSERT_EQUAL(nmeaGeofencesInside(geofences, 0, 2), true);
+
+  /* just outside the circle */
+
+  r = geofenceTestUpdate(geofences, &state, 1, 52.0, 5.0 + (1010.0 / 68700.0));
+  CU_ASSERT_EQUAL(r, 1);
+  CU_ASSERT_EQUAL(state.events[0].event, NMEALIB_GEOFENCE_EXIT);
+
+  /* across the antimeridian */
+
+  r = geofenceTestUpdate(geofences, &state, 0, 0.0, 180.0);
+  CU_ASSERT_EQUAL(r, 2);
+  CU_ASSERT_EQUAL(state.events[0].id, 2);
+  CU_ASSERT_EQUAL(state.events[0].event, NMEALIB_GEOFENCE_EXIT);
+  CU_ASSERT_EQUAL(state.events[1].id, 3);
+  CU_ASSERT_EQUAL(state.events[1].event, NMEALIB_GEOFENCE_ENTER);
+
+  r = geofenceTestUpdate(geofences, &state, 0, 5.0, -179.5);
+  CU_ASSERT_EQUAL(r, 0);
+
+  r = geofenceTestUpdate(geofences, &state, 0, 5.0, 179.5);
+  CU_ASSERT_EQUAL(r, 0);
+
+  r = geofenceTestUpdate(geofences, &state, 0, 5.0, -178.5);
+  CU_ASSERT_EQUAL(r, 1);
+  CU_ASSERT_EQUAL(state.events[0].id, 3);
+  CU_ASSERT_EQUAL(state.events[0].event, NMEALIB_GEOFENCE_EXIT);
+
+  /* around the pole */
+
+  r = geofenceTestUpdate(geofences, &state, 0, 89.99, 180.0);
+  CU_ASSERT_EQUAL(r, 1);
+  CU_ASSERT_EQUAL(state.events[0].id, 4);
+  CU_ASSERT_EQUAL(state.events[0].event, NMEALIB_GEOFENCE_ENTER);
+
+  r = geofenceTestUpdate(geofences, &state, 0, 89.9, 180.0);
+  CU_ASSERT_EQUAL(r, 1);
+  CU_ASSERT_EQUAL(state.events[0].event, NMEALIB_GEOFENCE_EXIT);
+
+  /* fences that are added later are used */
+
+  geofenceTestPosition(&pos, 89.9, 180.0);
+  nmeaGeofencesAddCircle(geofences, 5, &pos, 10.0);
+
+  r = geofenceTestUpdate(geofences, &state, 0, 89.9, -180.0);
+  CU_ASSERT_EQUAL(r, 1);
+  CU_ASSERT_EQUAL(state.events[0].id, 5);
+
+  /* info structures */
+
+  memset(&info, 0, sizeof(info));
+  memset(&state, 0, sizeof(state));
+
+  r = nmeaGeofencesUpdateInfo(geofences, 0, NULL);
+  CU_ASSERT_EQUAL(r, 0);
+
+  info.latitude = 5200.0;
+  info.longitude = 500.0;
+  r = nmeaGeofencesUpdateInfo(geofences, 0, &info);
+  CU_ASSERT_EQUAL(r, 0);
+
+  nmeaInfoSetPresent(&info.present, NMEALIB_PRESENT_LAT | NMEALIB_PRESENT_LON);
+  r = nmeaGeofencesUpdateInfo(geofences, 0, &info);
+  CU_ASSERT_EQUAL(r, 2);
+  CU_ASSERT_EQUAL(state.events[0].id, 5);
+  CU_ASSERT_EQUAL(state.events[0].event, NMEALIB_GEOFENCE_EXIT);
+  CU_ASSERT_EQUAL(state.events[1].id, 1);
+  CU_ASSERT_EQUAL(state.events[1].event, NMEALIB_GEOFENCE_ENTER);
+
+  nmeaGeofencesDestroy(geofences);
+
+  /* a large cell size and a fence that spans many cells, without handler */
+
+  config.handler = NULL;
+  config.cellSize = 20.0;
+  geofences = nmeaGeofencesCreate(&config);
+  CU_ASSERT_PTR_NOT_NULL_FATAL(geofences);
+
+  geofenceTestPosition(&pos, 0.0, 0.0);
+  nmeaGeofencesAddCircle(geofences, 1, &pos, 5000000.0);
+
+  r = geofenceTestUpdate(geofences, &state, 0, 30.0, 30.0);
+  CU_ASSERT_EQUAL(r, 1);
+  CU_ASSERT_EQUAL(state.count, 0);
+  CU_ASSERT_EQUAL(nmeaGeofencesInside(geofences, 0, 1), true);
+
+  r = geofenceTestUpdate(geofences, &state, 0, 0.0, 60.0);
+  CU_ASSERT_EQUAL(r, 1);
+  CU_ASSERT_EQUAL(nmeaGeofencesInside(geofences, 0, 1), false);
+
+  nmeaGeofencesDestroy(geofences);
+
+  validateContext(0, 0);
+}
+
+static void test_nmeaGeofencesCircleBoundary(void) {
+  static const double radii[] = { 1000.0, 50000.0 };
+  NmeaGeofenceConfig config;
+  NmeaGeofences *geofences;
+  NmeaPosition centre;
+  NmeaPosition pos;
+  size_t i;
+  int azimuth;
+  bool r;
+
+  memset(&config, 0, sizeof(config));
+  config.devices = 1;
+
+  for (i = 0; i < (sizeof(radii) / sizeof(radii[0])); i++) {
+    geofences = nmeaGeofencesCreate(&config);
+    CU_ASSERT_PTR_NOT_NULL_FATAL(geofences);
+
+    geofenceTestPosition(&centre, 52.0, 5.0);
+    nmeaGeofencesAddCircle(geofences, 1, &centre, radii[i]);
+
+    /* the boundary is accurate to 1 m on the WGS84 ellipsoid */
+
+    for (azimuth = 0; azimuth < 360; azimuth += 45) {
+      r = nmeaGeodesicDirect(&centre, &pos, nmeaMathDegreeToRadian(azimuth), radii[i] - 1.0, NULL);
+      CU_ASSERT_EQUAL_FATAL(r, true);
+      nmeaGeofencesUpdate(geofences, 0, &pos);
+      CU_ASSERT_EQUAL(nmeaGeofencesInside(geofences, 0, 1), true);
+
+      r = nmeaGeodesicDirect(&centre, &pos, nmeaMathDegreeToRadian(azimuth), radii[i] + 1.0, NULL);
+      CU_ASSERT_EQUAL_FATAL(r, true);
+      nmeaGeofencesUpdate(geofences, 0, &pos);
+      CU_ASSERT_EQUAL(nmeaGeofencesInside(geofences, 0, 1), false);
+    }
+
+    nmeaGeofencesDestroy(geofences);
+  }
+
+  validateContext(0, 0);
+}
+
+/*
+ * Setup
+ */
+
+int geofenceSuiteSetup(void) {
+  CU_pSuite pSuite = CU_add_suite("geofence", mockContextSuiteInit, mockContextSuiteClean);
+  if (!pSuite) {
+    return CU_get_error();
+  }
+
+  if ( //
+      (!CU_add_test(pSuite, "nmeaGeofencesCreate", test_nmeaGeofencesCreate)) //
+      || (!CU_add_test(pSuite, "nmeaGeofencesUpdate", test_nmeaGeofencesUpdate)) //
+      || (!CU_add_test(pSuite, "nmeaGeofencesCircleBoundary", test_nmeaGeofencesCircleBoundary)) //
+      ) {
+    return CU_get_error();
+  }
+
+  return CUE_SUCCESS;
+}
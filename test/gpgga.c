@@ -195,6 +195,7 @@ static void test_nmeaGPGGAToInfo(void) {
   NmeaGPGGA pack;
   NmeaInfo infoEmpty;
   NmeaInfo info;
+  NmeaSatellite inView[NMEALIB_MAX_SATELLITES];
 
   memset(&pack, 0, sizeof(pack));
   memset(&infoEmpty, 0, sizeof(infoEmpty));
@@ -363,6 +364,12 @@ static void test_nmeaGPGGAToInfo(void) {
   CU_ASSERT_EQUAL(info.present, NMEALIB_PRESENT_SMASK | NMEALIB_PRESENT_SATINVIEWCOUNT);
   CU_ASSERT_EQUAL(info.smask, NMEALIB_SENTENCE_GPGGA);
   CU_ASSERT_EQUAL(info.satellites.inViewCount, 42);
+  CU_ASSERT_EQUAL(nmeaInfoSatellitesInViewSnapshot(&info, inView, NULL), 2);
+
+  /* the count is published under the sequence counter, only when it changes */
+
+  nmeaGPGGAToInfo(&pack, &info);
+  CU_ASSERT_EQUAL(nmeaInfoSatellitesInViewSnapshot(&info, inView, NULL), 2);
   memset(&pack, 0, sizeof(pack));
   memset(&info, 0, sizeof(info));
 
@@ -183,19 +183,22 @@ static void test_nmeaGPGSVToInfo(void) {
   NmeaGPGSV pack;
   NmeaInfo infoEmpty;
   NmeaInfo info;
+  NmeaGPGSVStaging staging;
+  uint32_t changed;
 
   memset(&pack, 0, sizeof(pack));
   memset(&infoEmpty, 0, sizeof(infoEmpty));
   memset(&info, 0, sizeof(info));
+  memset(&staging, 0, sizeof(staging));
 
   /* invalid inputs */
 
-  nmeaGPGSVToInfo(NULL, &info);
+  nmeaGPGSVToInfo(NULL, &info, &staging);
   validatePackToInfo(&info, 0, 0, true);
   memset(&pack, 0, sizeof(pack));
   memset(&info, 0, sizeof(info));
 
-  nmeaGPGSVToInfo(&pack, NULL);
+  nmeaGPGSVToInfo(&pack, NULL, &staging);
   validatePackToInfo(&info, 0, 0, true);
   memset(&pack, 0, sizeof(pack));
   memset(&info, 0, sizeof(info));
@@ -205,7 +208,7 @@ static void test_nmeaGPGSVToInfo(void) {
   pack.inViewCount = NMEALIB_MAX_SATELLITES + 1;
   nmeaInfoSetPresent(&pack.present, NMEALIB_PRESENT_SATINVIEWCOUNT);
 
-  nmeaGPGSVToInfo(&pack, &info);
+  nmeaGPGSVToInfo(&pack, &info, &staging);
   validatePackToInfo(&info, 0, 1, true);
   memset(&pack, 0, sizeof(pack));
   memset(&info, 0, sizeof(info));
@@ -213,7 +216,7 @@ static void test_nmeaGPGSVToInfo(void) {
   pack.inViewCount = NMEALIB_MAX_SATELLITES + 1;
   nmeaInfoSetPresent(&pack.present, NMEALIB_PRESENT_SATINVIEW);
 
-  nmeaGPGSVToInfo(&pack, &info);
+  nmeaGPGSVToInfo(&pack, &info, &staging);
   validatePackToInfo(&info, 0, 1, true);
   memset(&pack, 0, sizeof(pack));
   memset(&info, 0, sizeof(info));
@@ -221,7 +224,7 @@ static void test_nmeaGPGSVToInfo(void) {
   pack.inViewCount = NMEALIB_MAX_SATELLITES + 1;
   nmeaInfoSetPresent(&pack.present, NMEALIB_PRESENT_SATINVIEWCOUNT | NMEALIB_PRESENT_SATINVIEW);
 
-  nmeaGPGSVToInfo(&pack, &info);
+  nmeaGPGSVToInfo(&pack, &info, &staging);
   validatePackToInfo(&info, 0, 1, true);
   memset(&pack, 0, sizeof(pack));
   memset(&info, 0, sizeof(info));
@@ -231,7 +234,7 @@ static void test_nmeaGPGSVToInfo(void) {
   pack.sentenceCount = 0;
   nmeaInfoSetPresent(&pack.present, NMEALIB_PRESENT_SATINVIEW);
 
-  nmeaGPGSVToInfo(&pack, &info);
+  nmeaGPGSVToInfo(&pack, &info, &staging);
   validatePackToInfo(&info, 0, 1, true);
   memset(&pack, 0, sizeof(pack));
   memset(&info, 0, sizeof(info));
@@ -239,7 +242,7 @@ static void test_nmeaGPGSVToInfo(void) {
   pack.sentenceCount = NMEALIB_GPGSV_MAX_SENTENCES + 1;
   nmeaInfoSetPresent(&pack.present, NMEALIB_PRESENT_SATINVIEW);
 
-  nmeaGPGSVToInfo(&pack, &info);
+  nmeaGPGSVToInfo(&pack, &info, &staging);
   validatePackToInfo(&info, 0, 1, true);
   memset(&pack, 0, sizeof(pack));
   memset(&info, 0, sizeof(info));
@@ -248,7 +251,7 @@ static void test_nmeaGPGSVToInfo(void) {
   pack.inViewCount = 10;
   nmeaInfoSetPresent(&pack.present, NMEALIB_PRESENT_SATINVIEW);
 
-  nmeaGPGSVToInfo(&pack, &info);
+  nmeaGPGSVToInfo(&pack, &info, &staging);
   validatePackToInfo(&info, 0, 1, true);
   memset(&pack, 0, sizeof(pack));
   memset(&info, 0, sizeof(info));
@@ -260,7 +263,7 @@ static void test_nmeaGPGSVToInfo(void) {
   pack.inViewCount = 10;
   nmeaInfoSetPresent(&pack.present, NMEALIB_PRESENT_SATINVIEW);
 
-  nmeaGPGSVToInfo(&pack, &info);
+  nmeaGPGSVToInfo(&pack, &info, &staging);
   validatePackToInfo(&info, 0, 1, true);
   memset(&pack, 0, sizeof(pack));
   memset(&info, 0, sizeof(info));
@@ -270,7 +273,7 @@ static void test_nmeaGPGSVToInfo(void) {
   pack.inViewCount = 10;
   nmeaInfoSetPresent(&pack.present, NMEALIB_PRESENT_SATINVIEW);
 
-  nmeaGPGSVToInfo(&pack, &info);
+  nmeaGPGSVToInfo(&pack, &info, &staging);
   validatePackToInfo(&info, 0, 1, true);
   memset(&pack, 0, sizeof(pack));
   memset(&info, 0, sizeof(info));
@@ -279,7 +282,7 @@ static void test_nmeaGPGSVToInfo(void) {
 
   memset(info.satellites.inView, 0xaa, sizeof(info.satellites.inView));
 
-  nmeaGPGSVToInfo(&pack, &info);
+  nmeaGPGSVToInfo(&pack, &info, &staging);
   validatePackToInfo(&info, 0, 0, false);
   CU_ASSERT_EQUAL(info.present, NMEALIB_PRESENT_SMASK);
   CU_ASSERT_EQUAL(info.smask, NMEALIB_SENTENCE_GPGSV);
@@ -295,7 +298,7 @@ static void test_nmeaGPGSVToInfo(void) {
   nmeaInfoSetPresent(&pack.present, NMEALIB_PRESENT_SATINVIEWCOUNT);
   memset(info.satellites.inView, 0xaa, sizeof(info.satellites.inView));
 
-  nmeaGPGSVToInfo(&pack, &info);
+  nmeaGPGSVToInfo(&pack, &info, &staging);
   validatePackToInfo(&info, 0, 0, false);
   CU_ASSERT_EQUAL(info.present, NMEALIB_PRESENT_SMASK | NMEALIB_PRESENT_SATINVIEWCOUNT);
   CU_ASSERT_EQUAL(info.smask, NMEALIB_SENTENCE_GPGSV);
@@ -317,7 +320,7 @@ static void test_nmeaGPGSVToInfo(void) {
   nmeaInfoSetPresent(&pack.present, NMEALIB_PRESENT_SATINVIEW);
   memset(info.satellites.inView, 0xaa, sizeof(info.satellites.inView));
 
-  nmeaGPGSVToInfo(&pack, &info);
+  nmeaGPGSVToInfo(&pack, &info, &staging);
   validatePackToInfo(&info, 0, 0, false);
   CU_ASSERT_EQUAL(info.present, NMEALIB_PRESENT_SMASK | NMEALIB_PRESENT_SATINVIEW);
   CU_ASSERT_EQUAL(info.smask, NMEALIB_SENTENCE_GPGSV);
@@ -347,7 +350,7 @@ static void test_nmeaGPGSVToInfo(void) {
   nmeaInfoSetPresent(&pack.present, NMEALIB_PRESENT_SATINVIEW);
   memset(info.satellites.inView, 0xaa, sizeof(info.satellites.inView));
 
-  nmeaGPGSVToInfo(&pack, &info);
+  nmeaGPGSVToInfo(&pack, &info, &staging);
   validatePackToInfo(&info, 0, 0, false);
   CU_ASSERT_EQUAL(info.present, NMEALIB_PRESENT_SMASK | NMEALIB_PRESENT_SATINVIEW);
   CU_ASSERT_EQUAL(info.smask, NMEALIB_SENTENCE_GPGSV);
@@ -366,7 +369,7 @@ static void test_nmeaGPGSVToInfo(void) {
   memset(&pack, 0, sizeof(pack));
   memset(&info, 0, sizeof(info));
 
-  /* only satellites, first sentence and sparse input */
+  /* only satellites, first sentence and sparse input: not published */
 
   pack.sentence = 1;
   pack.sentenceCount = 2;
@@ -378,22 +381,121 @@ static void test_nmeaGPGSVToInfo(void) {
   nmeaInfoSetPresent(&pack.present, NMEALIB_PRESENT_SATINVIEW);
   memset(info.satellites.inView, 0xaa, sizeof(info.satellites.inView));
 
-  nmeaGPGSVToInfo(&pack, &info);
+  changed = nmeaGPGSVToInfo(&pack, &info, &staging);
   validatePackToInfo(&info, 0, 0, false);
-  CU_ASSERT_EQUAL(info.present, NMEALIB_PRESENT_SMASK | NMEALIB_PRESENT_SATINVIEW);
+  CU_ASSERT_EQUAL(changed, NMEALIB_PRESENT_SMASK);
+  CU_ASSERT_EQUAL(info.present, NMEALIB_PRESENT_SMASK);
   CU_ASSERT_EQUAL(info.smask, NMEALIB_SENTENCE_GPGSV);
   CU_ASSERT_EQUAL(info.progress.gpgsvInProgress, true);
+  CU_ASSERT_EQUAL(info.progress.gpgsvSentence, 1);
+  CU_ASSERT_EQUAL(info.progress.gpgsvSequence, 0);
   CU_ASSERT_EQUAL(info.satellites.inViewCount, 0);
+  checkSatellitesEmpty(info.satellites.inView, 0, NMEALIB_MAX_SATELLITES - 1, 0xaaaaaaaa);
+  checkSatellitesEmpty(staging.inView, 0, 1, 0);
+  CU_ASSERT_EQUAL(staging.inView[2].prn, 11);
+  checkSatellitesEmpty(staging.inView, 3, NMEALIB_MAX_SATELLITES - 1, 0);
+
+  /* only satellites, last sentence and sparse input: published */
+
+  memset(&pack, 0, sizeof(pack));
+  pack.sentence = 2;
+  pack.sentenceCount = 2;
+  pack.inViewCount = 7;
+  pack.inView[0].prn = 12;
+  pack.inView[0].elevation = 16;
+  pack.inView[0].azimuth = 31;
+  pack.inView[0].snr = 46;
+  nmeaInfoSetPresent(&pack.present, NMEALIB_PRESENT_SATINVIEW);
+
+  changed = nmeaGPGSVToInfo(&pack, &info, &staging);
+  validatePackToInfo(&info, 0, 0, false);
+  CU_ASSERT_EQUAL(changed, NMEALIB_PRESENT_SATINVIEW);
+  CU_ASSERT_EQUAL(info.present, NMEALIB_PRESENT_SMASK | NMEALIB_PRESENT_SATINVIEW);
+  CU_ASSERT_EQUAL(info.progress.gpgsvInProgress, false);
+  CU_ASSERT_EQUAL(info.progress.gpgsvSentence, 0);
+  CU_ASSERT_EQUAL(info.progress.gpgsvSequence, 2);
   checkSatellitesEmpty(info.satellites.inView, 0, 1, 0);
   CU_ASSERT_EQUAL(info.satellites.inView[2].prn, 11);
   CU_ASSERT_EQUAL(info.satellites.inView[2].elevation, 15);
   CU_ASSERT_EQUAL(info.satellites.inView[2].azimuth, 30);
   CU_ASSERT_EQUAL(info.satellites.inView[2].snr, 45);
-  checkSatellitesEmpty(info.satellites.inView, 3, NMEALIB_MAX_SATELLITES - 1, 0);
+  checkSatellitesEmpty(info.satellites.inView, 3, 3, 0);
+  CU_ASSERT_EQUAL(info.satellites.inView[4].prn, 12);
+  CU_ASSERT_EQUAL(info.satellites.inView[4].elevation, 16);
+  CU_ASSERT_EQUAL(info.satellites.inView[4].azimuth, 31);
+  CU_ASSERT_EQUAL(info.satellites.inView[4].snr, 46);
+  checkSatellitesEmpty(info.satellites.inView, 5, NMEALIB_MAX_SATELLITES - 1, 0);
+
+  /* the same sequence again: published, but not changed */
+
+  memset(&pack, 0, sizeof(pack));
+  pack.sentence = 1;
+  pack.sentenceCount = 2;
+  pack.inViewCount = 7;
+  pack.inView[2].prn = 11;
+  pack.inView[2].elevation = 15;
+  pack.inView[2].azimuth = 30;
+  pack.inView[2].snr = 45;
+  nmeaInfoSetPresent(&pack.present, NMEALIB_PRESENT_SATINVIEW);
+
+  changed = nmeaGPGSVToInfo(&pack, &info, &staging);
+  CU_ASSERT_EQUAL(changed, 0);
+  CU_ASSERT_EQUAL(info.progress.gpgsvInProgress, true);
+  CU_ASSERT_EQUAL(info.satellites.inView[4].prn, 12);
+
+  memset(&pack, 0, sizeof(pack));
+  pack.sentence = 2;
+  pack.sentenceCount = 2;
+  pack.inViewCount = 7;
+  pack.inView[0].prn = 12;
+  pack.inView[0].elevation = 16;
+  pack.inView[0].azimuth = 31;
+  pack.inView[0].snr = 46;
+  nmeaInfoSetPresent(&pack.present, NMEALIB_PRESENT_SATINVIEW);
+
+  changed = nmeaGPGSVToInfo(&pack, &info, &staging);
+  validatePackToInfo(&info, 0, 0, false);
+  CU_ASSERT_EQUAL(changed, 0);
+  CU_ASSERT_EQUAL(info.progress.gpgsvInProgress, false);
+  CU_ASSERT_EQUAL(info.progress.gpgsvSequence, 2);
+  CU_ASSERT_EQUAL(info.satellites.inView[2].prn, 11);
+  CU_ASSERT_EQUAL(info.satellites.inView[4].prn, 12);
   memset(&pack, 0, sizeof(pack));
   memset(&info, 0, sizeof(info));
 
-  /* only satellites, middle sentence and sparse input */
+  /* satellites and count: the count is published with the satellites */
+
+  memset(&pack, 0, sizeof(pack));
+  pack.sentence = 1;
+  pack.sentenceCount = 2;
+  pack.inViewCount = 5;
+  pack.inView[0].prn = 13;
+  nmeaInfoSetPresent(&pack.present, NMEALIB_PRESENT_SATINVIEWCOUNT | NMEALIB_PRESENT_SATINVIEW);
+
+  changed = nmeaGPGSVToInfo(&pack, &info, &staging);
+  CU_ASSERT_EQUAL(changed, NMEALIB_PRESENT_SMASK);
+  CU_ASSERT_EQUAL(info.progress.gpgsvInProgress, true);
+  CU_ASSERT_EQUAL(staging.inViewCount, 5);
+  CU_ASSERT_EQUAL(info.satellites.inViewCount, 0);
+  CU_ASSERT_EQUAL(nmeaInfoIsPresentAll(info.present, NMEALIB_PRESENT_SATINVIEWCOUNT), false);
+
+  memset(&pack.inView, 0, sizeof(pack.inView));
+  pack.sentence = 2;
+  pack.inView[0].prn = 14;
+
+  changed = nmeaGPGSVToInfo(&pack, &info, &staging);
+  CU_ASSERT_EQUAL(changed, NMEALIB_PRESENT_SATINVIEWCOUNT | NMEALIB_PRESENT_SATINVIEW);
+  CU_ASSERT_EQUAL(info.progress.gpgsvInProgress, false);
+  CU_ASSERT_EQUAL(info.progress.gpgsvSequence, 2);
+  CU_ASSERT_EQUAL(info.satellites.inViewCount, 5);
+  CU_ASSERT_EQUAL(info.satellites.inView[0].prn, 13);
+  CU_ASSERT_EQUAL(info.satellites.inView[4].prn, 14);
+  CU_ASSERT_EQUAL(nmeaInfoIsPresentAll(info.present, NMEALIB_PRESENT_SATINVIEWCOUNT), true);
+  memset(&pack, 0, sizeof(pack));
+  memset(&info, 0, sizeof(info));
+  memset(&staging, 0, sizeof(staging));
+
+  /* only satellites, middle sentence without a sequence in progress: dropped */
 
   pack.sentence = 2;
   pack.sentenceCount = 3;
@@ -405,23 +507,18 @@ static void test_nmeaGPGSVToInfo(void) {
   nmeaInfoSetPresent(&pack.present, NMEALIB_PRESENT_SATINVIEW);
   memset(info.satellites.inView, 0xaa, sizeof(info.satellites.inView));
 
-  nmeaGPGSVToInfo(&pack, &info);
+  nmeaGPGSVToInfo(&pack, &info, &staging);
   validatePackToInfo(&info, 0, 0, false);
-  CU_ASSERT_EQUAL(info.present, NMEALIB_PRESENT_SMASK | NMEALIB_PRESENT_SATINVIEW);
+  CU_ASSERT_EQUAL(info.present, NMEALIB_PRESENT_SMASK);
   CU_ASSERT_EQUAL(info.smask, NMEALIB_SENTENCE_GPGSV);
-  CU_ASSERT_EQUAL(info.progress.gpgsvInProgress, true);
+  CU_ASSERT_EQUAL(info.progress.gpgsvInProgress, false);
   CU_ASSERT_EQUAL(info.satellites.inViewCount, 0);
-  checkSatellitesEmpty(info.satellites.inView, 0, 3, 0xaaaaaaaa);
-  checkSatellitesEmpty(info.satellites.inView, 4, 5, 0);
-  CU_ASSERT_EQUAL(info.satellites.inView[6].prn, 11);
-  CU_ASSERT_EQUAL(info.satellites.inView[6].elevation, 15);
-  CU_ASSERT_EQUAL(info.satellites.inView[6].azimuth, 30);
-  CU_ASSERT_EQUAL(info.satellites.inView[6].snr, 45);
-  checkSatellitesEmpty(info.satellites.inView, 7, NMEALIB_MAX_SATELLITES - 1, 0);
+  checkSatellitesEmpty(info.satellites.inView, 0, NMEALIB_MAX_SATELLITES - 1, 0xaaaaaaaa);
+  checkSatellitesEmpty(staging.inView, 0, NMEALIB_MAX_SATELLITES - 1, 0);
   memset(&pack, 0, sizeof(pack));
   memset(&info, 0, sizeof(info));
 
-  /* only satellites, last sentence and sparse input */
+  /* only satellites, last sentence without a sequence in progress: dropped */
 
   pack.sentence = 3;
   pack.sentenceCount = 3;
@@ -433,44 +530,59 @@ static void test_nmeaGPGSVToInfo(void) {
   nmeaInfoSetPresent(&pack.present, NMEALIB_PRESENT_SATINVIEW);
   memset(info.satellites.inView, 0xaa, sizeof(info.satellites.inView));
 
-  nmeaGPGSVToInfo(&pack, &info);
+  nmeaGPGSVToInfo(&pack, &info, &staging);
   validatePackToInfo(&info, 0, 0, false);
-  CU_ASSERT_EQUAL(info.present, NMEALIB_PRESENT_SMASK | NMEALIB_PRESENT_SATINVIEW);
-  CU_ASSERT_EQUAL(info.smask, NMEALIB_SENTENCE_GPGSV);
+  CU_ASSERT_EQUAL(info.present, NMEALIB_PRESENT_SMASK);
   CU_ASSERT_EQUAL(info.progress.gpgsvInProgress, false);
-  CU_ASSERT_EQUAL(info.satellites.inViewCount, 0);
-  checkSatellitesEmpty(info.satellites.inView, 0, 7, 0xaaaaaaaa);
-  checkSatellitesEmpty(info.satellites.inView, 8, 9, 0);
-  CU_ASSERT_EQUAL(info.satellites.inView[10].prn, 11);
-  CU_ASSERT_EQUAL(info.satellites.inView[10].elevation, 15);
-  CU_ASSERT_EQUAL(info.satellites.inView[10].azimuth, 30);
-  CU_ASSERT_EQUAL(info.satellites.inView[10].snr, 45);
-  checkSatellitesEmpty(info.satellites.inView, 11, NMEALIB_MAX_SATELLITES - 1, 0);
+  checkSatellitesEmpty(info.satellites.inView, 0, NMEALIB_MAX_SATELLITES - 1, 0xaaaaaaaa);
   memset(&pack, 0, sizeof(pack));
   memset(&info, 0, sizeof(info));
 
-  /* only satellites, last sentence and sparse input at last possible sentence */
+  /* only satellites, skipped sentence: dropped */
+
+  pack.sentence = 1;
+  pack.sentenceCount = 3;
+  pack.inViewCount = 10;
+  pack.inView[2].prn = 11;
+  nmeaInfoSetPresent(&pack.present, NMEALIB_PRESENT_SATINVIEW);
+  memset(info.satellites.inView, 0xaa, sizeof(info.satellites.inView));
+
+  nmeaGPGSVToInfo(&pack, &info, &staging);
+  CU_ASSERT_EQUAL(info.progress.gpgsvInProgress, true);
+
+  pack.sentence = 3;
+  nmeaGPGSVToInfo(&pack, &info, &staging);
+  validatePackToInfo(&info, 0, 0, false);
+  CU_ASSERT_EQUAL(info.present, NMEALIB_PRESENT_SMASK);
+  CU_ASSERT_EQUAL(info.progress.gpgsvInProgress, false);
+  CU_ASSERT_EQUAL(info.progress.gpgsvSentence, 0);
+  checkSatellitesEmpty(info.satellites.inView, 0, NMEALIB_MAX_SATELLITES - 1, 0xaaaaaaaa);
+  memset(&pack, 0, sizeof(pack));
+  memset(&info, 0, sizeof(info));
+
+  /* only satellites, sparse input at last possible sentence */
+
+  memset(info.satellites.inView, 0xaa, sizeof(info.satellites.inView));
 
-  pack.sentence = NMEALIB_GPGSV_MAX_SENTENCES;
   pack.sentenceCount = NMEALIB_GPGSV_MAX_SENTENCES;
   pack.inViewCount = NMEALIB_MAX_SATELLITES;
+  nmeaInfoSetPresent(&pack.present, NMEALIB_PRESENT_SATINVIEW);
+  for (pack.sentence = 1; pack.sentence < NMEALIB_GPGSV_MAX_SENTENCES; pack.sentence++) {
+    nmeaGPGSVToInfo(&pack, &info, &staging);
+  }
+
   pack.inView[2].prn = 11;
   pack.inView[2].elevation = 15;
   pack.inView[2].azimuth = 30;
   pack.inView[2].snr = 45;
-  nmeaInfoSetPresent(&pack.present, NMEALIB_PRESENT_SATINVIEW);
-  memset(info.satellites.inView, 0xaa, sizeof(info.satellites.inView));
 
-  nmeaGPGSVToInfo(&pack, &info);
+  nmeaGPGSVToInfo(&pack, &info, &staging);
   validatePackToInfo(&info, 0, 0, false);
   CU_ASSERT_EQUAL(info.present, NMEALIB_PRESENT_SMASK | NMEALIB_PRESENT_SATINVIEW);
   CU_ASSERT_EQUAL(info.smask, NMEALIB_SENTENCE_GPGSV);
   CU_ASSERT_EQUAL(info.progress.gpgsvInProgress, false);
   CU_ASSERT_EQUAL(info.satellites.inViewCount, 0);
-  checkSatellitesEmpty(info.satellites.inView, 0, NMEALIB_MAX_SATELLITES - NMEALIB_GPGSV_MAX_SATS_PER_SENTENCE - 1,
-      0xaaaaaaaa);
-  checkSatellitesEmpty(info.satellites.inView, NMEALIB_MAX_SATELLITES - NMEALIB_GPGSV_MAX_SATS_PER_SENTENCE,
-      NMEALIB_MAX_SATELLITES - NMEALIB_GPGSV_MAX_SATS_PER_SENTENCE + 1, 0);
+  checkSatellitesEmpty(info.satellites.inView, 0, NMEALIB_MAX_SATELLITES - NMEALIB_GPGSV_MAX_SATS_PER_SENTENCE + 1, 0);
   CU_ASSERT_EQUAL(info.satellites.inView[NMEALIB_MAX_SATELLITES - NMEALIB_GPGSV_MAX_SATS_PER_SENTENCE + 2].prn, 11);
   CU_ASSERT_EQUAL(info.satellites.inView[NMEALIB_MAX_SATELLITES - NMEALIB_GPGSV_MAX_SATS_PER_SENTENCE + 2].elevation,
       15);
@@ -480,6 +592,41 @@ static void test_nmeaGPGSVToInfo(void) {
       NMEALIB_MAX_SATELLITES - 1, 0);
   memset(&pack, 0, sizeof(pack));
   memset(&info, 0, sizeof(info));
+
+  /* without staging: every sentence is published */
+
+  pack.sentence = 1;
+  pack.sentenceCount = 2;
+  pack.inViewCount = 5;
+  pack.inView[0].prn = 13;
+  nmeaInfoSetPresent(&pack.present, NMEALIB_PRESENT_SATINVIEWCOUNT | NMEALIB_PRESENT_SATINVIEW);
+  memset(info.satellites.inView, 0xaa, sizeof(info.satellites.inView));
+
+  changed = nmeaGPGSVToInfo(&pack, &info, NULL);
+  CU_ASSERT_EQUAL(changed, NMEALIB_PRESENT_SMASK | NMEALIB_PRESENT_SATINVIEWCOUNT | NMEALIB_PRESENT_SATINVIEW);
+  CU_ASSERT_EQUAL(info.progress.gpgsvInProgress, true);
+  CU_ASSERT_EQUAL(info.progress.gpgsvSentence, 1);
+  CU_ASSERT_EQUAL(info.progress.gpgsvSequence, 2);
+  CU_ASSERT_EQUAL(info.satellites.inViewCount, 5);
+  CU_ASSERT_EQUAL(info.satellites.inView[0].prn, 13);
+  checkSatellitesEmpty(info.satellites.inView, 1, NMEALIB_MAX_SATELLITES - 1, 0);
+
+  memset(&pack.inView, 0, sizeof(pack.inView));
+  pack.sentence = 2;
+  pack.inView[0].prn = 14;
+
+  changed = nmeaGPGSVToInfo(&pack, &info, NULL);
+  CU_ASSERT_EQUAL(changed, NMEALIB_PRESENT_SATINVIEW);
+  CU_ASSERT_EQUAL(info.progress.gpgsvInProgress, false);
+  CU_ASSERT_EQUAL(info.progress.gpgsvSentence, 0);
+  CU_ASSERT_EQUAL(info.progress.gpgsvSequence, 4);
+  CU_ASSERT_EQUAL(info.satellites.inViewCount, 5);
+  CU_ASSERT_EQUAL(info.satellites.inView[0].prn, 13);
+  checkSatellitesEmpty(info.satellites.inView, 1, 3, 0);
+  CU_ASSERT_EQUAL(info.satellites.inView[4].prn, 14);
+  checkSatellitesEmpty(info.satellites.inView, 5, NMEALIB_MAX_SATELLITES - 1, 0);
+  memset(&pack, 0, sizeof(pack));
+  memset(&info, 0, sizeof(info));
 }
 
 static void test_nmeaGPGSVFromInfo(void) {
@@ -22,12 +22,64 @@
 #include <nmealib/sentence.h>
 #include <CUnit/Basic.h>
 #include <float.h>
+#include <pthread.h>
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
 
 int infoSuiteSetup(void);
 
+static void infoTestClock(struct timeval *tv) {
+  tv->tv_sec = 1482000000; /* 2016-12-17 18:40:00 */
+  tv->tv_usec = 250000;
+}
+
+#define INFO_TEST_BATCH (100u)
+
+#define INFO_TEST_SNAPSHOT_READERS (4u)
+#define INFO_TEST_SNAPSHOT_UPDATES (5000u)
+#define INFO_TEST_SNAPSHOT_SATELLITES (NMEALIB_MAX_SATELLITES / 2)
+
+typedef struct _InfoTestSnapshotState {
+  NmeaInfo info;
+  NmeaSatellite raw[NMEALIB_MAX_SATELLITES];
+  NmeaSatellite sanitised[NMEALIB_MAX_SATELLITES];
+  NmeaSatellite empty[NMEALIB_MAX_SATELLITES];
+  bool done;
+  uint64_t snapshots;
+  uint64_t torn;
+} InfoTestSnapshotState;
+
+static void infoTestBatchFill(NmeaInfo *infos, size_t count) {
+  static const double values[] = {
+      0.0, -0.0, 1.5, -1.5, 359.999, 360.0, -360.0, 725.25, -725.25, 5230.5678, -5230.5678, 9000.0, 9500.0,
+      -9500.0, 18000.0, 18000.5, -18000.5, 40000.0, -40000.0, 80000.0, -110000.0, 1e9 };
+  uint32_t state = 1;
+  size_t i;
+
+  memset(infos, 0, count * sizeof(infos[0]));
+
+  for (i = 0; i < count; i++) {
+    NmeaInfo *info = &infos[i];
+    double *fields[] = {
+        &info->pdop, &info->hdop, &info->vdop, &info->latitude, &info->longitude, &info->speed, &info->track,
+        &info->mtrack, &info->magvar, &info->dgpsAge };
+    size_t j;
+
+    for (j = 0; j < (sizeof(fields) / sizeof(fields[0])); j++) {
+      state = (state * 1103515245u) + 12345u;
+      *fields[j] = values[(state >> 16) % (sizeof(values) / sizeof(values[0]))];
+    }
+
+    state = (state * 1103515245u) + 12345u;
+    info->present = (state | NMEALIB_PRESENT_UTCDATE | NMEALIB_PRESENT_UTCTIME) & NMEALIB_INFO_PRESENT_MASK;
+    info->utc.year = 2016;
+    info->utc.mon = 12;
+    info->utc.day = 17;
+    info->metric = !!(i & 1);
+  }
+}
+
 /*
  * Tests
  */
@@ -420,6 +472,40 @@ static void test_nmeaTimeParseTime(void) {
   r = nmeaTimeParseTime(time, &t);
   CU_ASSERT_EQUAL(r, false);
   validateContext(0, 0);
+
+  /* every character must be a digit */
+
+  memset(&t, 0xff, sizeof(t));
+  time = "1q3456.78";
+  r = nmeaTimeParseTime(time, &t);
+  CU_ASSERT_EQUAL(r, false);
+  validateContext(0, 1);
+
+  memset(&t, 0xff, sizeof(t));
+  time = "123456.7q";
+  r = nmeaTimeParseTime(time, &t);
+  CU_ASSERT_EQUAL(r, false);
+  validateContext(0, 1);
+
+  /* no decimal point */
+
+  memset(&t, 0xff, sizeof(t));
+  time = "123456,78";
+  r = nmeaTimeParseTime(time, &t);
+  CU_ASSERT_EQUAL(r, false);
+  validateContext(0, 0);
+
+  /* other external whitespace */
+
+  memset(&t, 0xff, sizeof(t));
+  time = "\t235959.99\r\n";
+  r = nmeaTimeParseTime(time, &t);
+  CU_ASSERT_EQUAL(r, true);
+  validateContext(0, 0);
+  CU_ASSERT_EQUAL(t.hour, 23);
+  CU_ASSERT_EQUAL(t.min, 59);
+  CU_ASSERT_EQUAL(t.sec, 59);
+  CU_ASSERT_EQUAL(t.hsec, 99);
 }
 
 static void test_nmeaTimeParseDate(void) {
@@ -479,6 +565,139 @@ static void test_nmeaTimeParseDate(void) {
   r = nmeaTimeParseDate(date, &d);
   CU_ASSERT_EQUAL(r, false);
   validateContext(0, 1);
+
+  memset(&d, 0xff, sizeof(d));
+  date = "12345q";
+  r = nmeaTimeParseDate(date, &d);
+  CU_ASSERT_EQUAL(r, false);
+  validateContext(0, 1);
+}
+
+static void test_nmeaTimeToEpoch(void) {
+  NmeaTime utc;
+  NmeaTime back;
+  struct tm tt;
+  time_t t;
+  int64_t days;
+
+  /* invalid inputs */
+
+  CU_ASSERT_EQUAL(nmeaTimeToEpochSeconds(NULL), 0);
+  CU_ASSERT_EQUAL(nmeaTimeToEpochNs(NULL), 0);
+  CU_ASSERT_EQUAL(nmeaTimeToEpochUs(NULL), 0);
+  nmeaTimeFromEpochSeconds(0, 0, NULL);
+  nmeaTimeFromEpochNs(0, NULL);
+  nmeaTimeFromEpochUs(0, NULL);
+
+  /* year expansion */
+
+  CU_ASSERT_EQUAL(nmeaTimeYearExpand(0), 2000);
+  CU_ASSERT_EQUAL(nmeaTimeYearExpand(90), 2090);
+  CU_ASSERT_EQUAL(nmeaTimeYearExpand(91), 1991);
+  CU_ASSERT_EQUAL(nmeaTimeYearExpand(99), 1999);
+  CU_ASSERT_EQUAL(nmeaTimeYearExpand(100), 100);
+  CU_ASSERT_EQUAL(nmeaTimeYearExpand(2016), 2016);
+
+  /* the epoch */
+
+  memset(&utc, 0, sizeof(utc));
+  utc.year = 1970;
+  utc.mon = 1;
+  utc.day = 1;
+  CU_ASSERT_EQUAL(nmeaTimeToEpochNs(&utc), 0);
+  CU_ASSERT_EQUAL(nmeaTimeToEpochUs(&utc), 0);
+
+  /* normal */
+
+  utc.year = 2016;
+  utc.mon = 12;
+  utc.day = 17;
+  utc.hour = 18;
+  utc.min = 40;
+  utc.sec = 1;
+  utc.hsec = 25;
+  CU_ASSERT_EQUAL(nmeaTimeToEpochNs(&utc), 1482000001250000000LL);
+  CU_ASSERT_EQUAL(nmeaTimeToEpochUs(&utc), 1482000001250000LL);
+
+  memset(&back, 0xff, sizeof(back));
+  nmeaTimeFromEpochNs(1482000001259999999LL, &back);
+  CU_ASSERT_EQUAL(memcmp(&back, &utc, sizeof(back)), 0);
+  memset(&back, 0xff, sizeof(back));
+  nmeaTimeFromEpochUs(1482000001250000LL, &back);
+  CU_ASSERT_EQUAL(memcmp(&back, &utc, sizeof(back)), 0);
+
+  CU_ASSERT_EQUAL(nmeaTimeToEpochSeconds(&utc), 1482000001LL);
+  memset(&back, 0xff, sizeof(back));
+  nmeaTimeFromEpochSeconds(1482000001LL, 25, &back);
+  CU_ASSERT_EQUAL(memcmp(&back, &utc, sizeof(back)), 0);
+
+  /* 2-digit year */
+
+  utc.year = 16;
+  CU_ASSERT_EQUAL(nmeaTimeToEpochNs(&utc), 1482000001250000000LL);
+
+  /* beyond the range of nanoseconds: saturated, seconds still fit */
+
+  memset(&utc, 0, sizeof(utc));
+  utc.year = 2262;
+  utc.mon = 4;
+  utc.day = 11;
+  CU_ASSERT_EQUAL(nmeaTimeToEpochNs(&utc), 9223286400000000000LL);
+  utc.day = 12;
+  CU_ASSERT_EQUAL(nmeaTimeToEpochNs(&utc), INT64_MAX);
+  utc.year = 2300;
+  CU_ASSERT_EQUAL(nmeaTimeToEpochNs(&utc), INT64_MAX);
+  CU_ASSERT_EQUAL(nmeaTimeToEpochUs(&utc), 10422518400000000LL);
+  CU_ASSERT_EQUAL(nmeaTimeToEpochSeconds(&utc), 10422518400LL);
+  nmeaTimeFromEpochSeconds(nmeaTimeToEpochSeconds(&utc), 0, &back);
+  CU_ASSERT_EQUAL(memcmp(&back, &utc, sizeof(back)), 0);
+  utc.year = 1600;
+  CU_ASSERT_EQUAL(nmeaTimeToEpochNs(&utc), INT64_MIN);
+  utc.year = UINT32_MAX;
+  CU_ASSERT_EQUAL(nmeaTimeToEpochUs(&utc), INT64_MAX);
+  nmeaTimeFromEpochSeconds(nmeaTimeToEpochSeconds(&utc), 0, &back);
+  CU_ASSERT_EQUAL(memcmp(&back, &utc, sizeof(back)), 0);
+
+  /* before the epoch */
+
+  nmeaTimeFromEpochNs(-1, &back);
+  CU_ASSERT_EQUAL(back.year, 1969);
+  CU_ASSERT_EQUAL(back.mon, 12);
+  CU_ASSERT_EQUAL(back.day, 31);
+  CU_ASSERT_EQUAL(back.hour, 23);
+  CU_ASSERT_EQUAL(back.min, 59);
+  CU_ASSERT_EQUAL(back.sec, 59);
+  CU_ASSERT_EQUAL(back.hsec, 99);
+  CU_ASSERT_EQUAL(nmeaTimeToEpochUs(&back), -10000);
+
+  /* leap days */
+
+  memset(&utc, 0, sizeof(utc));
+  utc.year = 2000;
+  utc.mon = 2;
+  utc.day = 29;
+  CU_ASSERT_EQUAL(nmeaTimeToEpochUs(&utc), 951782400LL * 1000000);
+  utc.year = 2100;
+  utc.mon = 3;
+  utc.day = 1;
+  nmeaTimeFromEpochUs(nmeaTimeToEpochUs(&utc) - 1, &back);
+  CU_ASSERT_EQUAL(back.mon, 2);
+  CU_ASSERT_EQUAL(back.day, 28);
+
+  /* against the c-library, every 7 days and some hours from 1901 to 2100 */
+
+  for (days = -25000; days < 47000; days += 7) {
+    t = (time_t) ((days * 86400) + ((days % 24) * 3600) + 61);
+    gmtime_r(&t, &tt);
+    nmeaTimeFromEpochNs((int64_t) t * 1000000000, &back);
+    CU_ASSERT_EQUAL(back.year, (unsigned int) tt.tm_year + 1900);
+    CU_ASSERT_EQUAL(back.mon, (unsigned int) tt.tm_mon + 1);
+    CU_ASSERT_EQUAL(back.day, (unsigned int) tt.tm_mday);
+    CU_ASSERT_EQUAL(back.hour, (unsigned int) tt.tm_hour);
+    CU_ASSERT_EQUAL(back.min, (unsigned int) tt.tm_min);
+    CU_ASSERT_EQUAL(back.sec, (unsigned int) tt.tm_sec);
+    CU_ASSERT_EQUAL(nmeaTimeToEpochNs(&back), (int64_t) t * 1000000000);
+  }
 }
 
 static void test_nmeaTimeSet(void) {
@@ -577,6 +796,36 @@ static void test_nmeaTimeSet(void) {
   CU_ASSERT_EQUAL(present, NMEALIB_PRESENT_UTCDATE | NMEALIB_PRESENT_UTCTIME);
 }
 
+static void test_nmeaTimeSetClock(void) {
+  NmeaTimeClockFunction r;
+  NmeaTime utc;
+  uint32_t present = 0;
+
+  r = nmeaTimeSetClock(infoTestClock);
+  CU_ASSERT_PTR_NULL(r);
+
+  memset(&utc, 0, sizeof(utc));
+  nmeaTimeSet(&utc, &present, NULL);
+  CU_ASSERT_EQUAL(present, NMEALIB_PRESENT_UTCDATE | NMEALIB_PRESENT_UTCTIME);
+  CU_ASSERT_EQUAL(utc.year, 2016);
+  CU_ASSERT_EQUAL(utc.mon, 12);
+  CU_ASSERT_EQUAL(utc.day, 17);
+  CU_ASSERT_EQUAL(utc.hour, 18);
+  CU_ASSERT_EQUAL(utc.min, 40);
+  CU_ASSERT_EQUAL(utc.sec, 0);
+  CU_ASSERT_EQUAL(utc.hsec, 25);
+
+  /* again */
+
+  memset(&utc, 0, sizeof(utc));
+  nmeaTimeSet(&utc, NULL, NULL);
+  CU_ASSERT_EQUAL(utc.day, 17);
+  CU_ASSERT_EQUAL(utc.hour, 18);
+
+  r = nmeaTimeSetClock(NULL);
+  CU_ASSERT_PTR_EQUAL(r, infoTestClock);
+}
+
 static void test_nmeaInfoClear(void) {
   NmeaInfo info;
   NmeaInfo infoExpected;
@@ -1101,6 +1350,252 @@ static void test_nmeaInfoSanitise(void) {
   CU_ASSERT_EQUAL(info.satellites.inView[0].snr, 99);
 }
 
+static void test_nmeaInfoSanitiseChanged(void) {
+  NmeaInfo info;
+
+  /* invalid input */
+
+  nmeaInfoSanitiseChanged(NULL, NMEALIB_INFO_PRESENT_MASK);
+
+  /* only the changed fields */
+
+  memset(&info, 0, sizeof(info));
+  info.pdop = -1.0;
+  info.hdop = -2.0;
+  info.vdop = -3.0;
+  nmeaInfoSetPresent(&info.present, NMEALIB_PRESENT_PDOP | NMEALIB_PRESENT_HDOP);
+
+  nmeaInfoSanitiseChanged(&info, NMEALIB_PRESENT_PDOP | NMEALIB_PRESENT_VDOP);
+  CU_ASSERT_DOUBLE_EQUAL(info.pdop, 1.0, DBL_EPSILON);
+  CU_ASSERT_DOUBLE_EQUAL(info.hdop, -2.0, DBL_EPSILON);
+  CU_ASSERT_DOUBLE_EQUAL(info.vdop, 0.0, DBL_EPSILON);
+
+  /* fields that are sanitised together */
+
+  memset(&info, 0, sizeof(info));
+  info.latitude = 9500.0;
+  info.longitude = 100.0;
+  info.speed = -10.0;
+  info.track = 10.0;
+  info.mtrack = 20.0;
+  nmeaInfoSetPresent(&info.present, NMEALIB_PRESENT_LAT | NMEALIB_PRESENT_LON | NMEALIB_PRESENT_SPEED //
+      | NMEALIB_PRESENT_TRACK | NMEALIB_PRESENT_MTRACK);
+
+  nmeaInfoSanitiseChanged(&info, NMEALIB_PRESENT_LAT | NMEALIB_PRESENT_SPEED);
+  CU_ASSERT_DOUBLE_EQUAL(info.latitude, 8500.0, DBL_EPSILON);
+  CU_ASSERT_DOUBLE_EQUAL(info.longitude, -17900.0, DBL_EPSILON);
+  CU_ASSERT_DOUBLE_EQUAL(info.speed, 10.0, DBL_EPSILON);
+  CU_ASSERT_DOUBLE_EQUAL(info.track, 190.0, DBL_EPSILON);
+  CU_ASSERT_DOUBLE_EQUAL(info.mtrack, 200.0, DBL_EPSILON);
+
+  /* missing date and time from the clock */
+
+  memset(&info, 0, sizeof(info));
+  info.utc.hour = 12;
+  nmeaInfoSetPresent(&info.present, NMEALIB_PRESENT_UTCTIME);
+  nmeaTimeSetClock(infoTestClock);
+
+  nmeaInfoSanitiseChanged(&info, NMEALIB_PRESENT_UTCTIME);
+  CU_ASSERT_EQUAL(info.utc.year, 2016);
+  CU_ASSERT_EQUAL(info.utc.mon, 12);
+  CU_ASSERT_EQUAL(info.utc.day, 17);
+  CU_ASSERT_EQUAL(info.utc.hour, 12);
+
+  nmeaTimeSetClock(NULL);
+}
+
+static void test_nmeaInfoSanitiseBatch(void) {
+  NmeaInfo infos[INFO_TEST_BATCH];
+  NmeaInfo infosExpected[INFO_TEST_BATCH];
+  size_t i;
+
+  /* invalid input */
+
+  nmeaInfoSanitiseBatch(NULL, INFO_TEST_BATCH);
+
+  /* the same as sanitising the info structures one by one */
+
+  nmeaTimeSetClock(infoTestClock);
+
+  infoTestBatchFill(infos, INFO_TEST_BATCH);
+  infoTestBatchFill(infosExpected, INFO_TEST_BATCH);
+
+  for (i = 0; i < INFO_TEST_BATCH; i++) {
+    nmeaInfoSanitise(&infosExpected[i]);
+  }
+
+  nmeaInfoSanitiseBatch(infos, 0);
+  nmeaInfoSanitiseBatch(infos, INFO_TEST_BATCH);
+
+  for (i = 0; i < INFO_TEST_BATCH; i++) {
+    CU_ASSERT_EQUAL(memcmp(&infos[i], &infosExpected[i], sizeof(infos[i])), 0);
+  }
+
+  nmeaTimeSetClock(NULL);
+}
+
+static void test_nmeaInfoSatellitesInViewPublish(void) {
+  NmeaInfo info;
+  NmeaSatellite inView[NMEALIB_MAX_SATELLITES];
+  bool r;
+
+  memset(&info, 0, sizeof(info));
+  memset(inView, 0, sizeof(inView));
+
+  /* invalid inputs */
+
+  r = nmeaInfoSatellitesInViewPublish(NULL, inView, 1);
+  CU_ASSERT_EQUAL(r, false);
+
+  /* unchanged */
+
+  r = nmeaInfoSatellitesInViewPublish(&info, inView, 0);
+  CU_ASSERT_EQUAL(r, false);
+  CU_ASSERT_EQUAL(info.progress.gpgsvSequence, 0);
+
+  r = nmeaInfoSatellitesInViewPublish(&info, NULL, 0);
+  CU_ASSERT_EQUAL(r, false);
+  CU_ASSERT_EQUAL(info.progress.gpgsvSequence, 0);
+
+  /* changed */
+
+  inView[1].prn = 7;
+  r = nmeaInfoSatellitesInViewPublish(&info, inView, 0);
+  CU_ASSERT_EQUAL(r, true);
+  CU_ASSERT_EQUAL(info.progress.gpgsvSequence, 2);
+  CU_ASSERT_EQUAL(info.satellites.inView[1].prn, 7);
+
+  r = nmeaInfoSatellitesInViewPublish(&info, info.satellites.inView, 3);
+  CU_ASSERT_EQUAL(r, true);
+  CU_ASSERT_EQUAL(info.progress.gpgsvSequence, 4);
+  CU_ASSERT_EQUAL(info.satellites.inViewCount, 3);
+  CU_ASSERT_EQUAL(info.satellites.inView[1].prn, 7);
+
+  r = nmeaInfoSatellitesInViewPublish(&info, NULL, 3);
+  CU_ASSERT_EQUAL(r, true);
+  CU_ASSERT_EQUAL(info.progress.gpgsvSequence, 6);
+  CU_ASSERT_EQUAL(info.satellites.inView[1].prn, 0);
+
+  /* sanitising publishes the satellites too */
+
+  info.satellites.inView[1].prn = 7;
+  nmeaInfoSetPresent(&info.present, NMEALIB_PRESENT_SATINVIEWCOUNT | NMEALIB_PRESENT_SATINVIEW);
+  nmeaInfoSanitise(&info);
+  CU_ASSERT_EQUAL(info.progress.gpgsvSequence, 8);
+  CU_ASSERT_EQUAL(info.satellites.inView[0].prn, 7);
+  CU_ASSERT_EQUAL(info.satellites.inView[1].prn, 0);
+
+  nmeaInfoSanitise(&info);
+  CU_ASSERT_EQUAL(info.progress.gpgsvSequence, 8);
+
+  nmeaInfoUnsetPresent(&info.present, NMEALIB_PRESENT_SATINVIEWCOUNT | NMEALIB_PRESENT_SATINVIEW);
+  nmeaInfoSanitise(&info);
+  CU_ASSERT_EQUAL(info.progress.gpgsvSequence, 10);
+  CU_ASSERT_EQUAL(info.satellites.inViewCount, 0);
+  CU_ASSERT_EQUAL(info.satellites.inView[0].prn, 0);
+}
+
+static void test_nmeaInfoSatellitesInViewSnapshot(void) {
+  NmeaInfo info;
+  NmeaSatellite inView[NMEALIB_MAX_SATELLITES];
+  unsigned int inViewCount = 0;
+  uint32_t r;
+
+  memset(&info, 0, sizeof(info));
+  memset(inView, 0xaa, sizeof(inView));
+
+  /* invalid inputs */
+
+  r = nmeaInfoSatellitesInViewSnapshot(NULL, inView, &inViewCount);
+  CU_ASSERT_EQUAL(r, 0);
+
+  r = nmeaInfoSatellitesInViewSnapshot(&info, NULL, &inViewCount);
+  CU_ASSERT_EQUAL(r, 0);
+
+  /* normal */
+
+  info.satellites.inViewCount = 12;
+  info.satellites.inView[0].prn = 3;
+  info.satellites.inView[NMEALIB_MAX_SATELLITES - 1].snr = 42;
+  info.progress.gpgsvSequence = 4;
+
+  r = nmeaInfoSatellitesInViewSnapshot(&info, inView, &inViewCount);
+  CU_ASSERT_EQUAL(r, 4);
+  CU_ASSERT_EQUAL(inViewCount, 12);
+  CU_ASSERT_EQUAL(memcmp(inView, info.satellites.inView, sizeof(inView)), 0);
+
+  r = nmeaInfoSatellitesInViewSnapshot(&info, inView, NULL);
+  CU_ASSERT_EQUAL(r, 4);
+}
+
+static void *infoTestSnapshotReader(void *arg) {
+  InfoTestSnapshotState *state = (InfoTestSnapshotState *) arg;
+  NmeaSatellite inView[NMEALIB_MAX_SATELLITES];
+  unsigned int inViewCount;
+
+  while (!__atomic_load_n(&state->done, __ATOMIC_ACQUIRE)) {
+    nmeaInfoSatellitesInViewSnapshot(&state->info, inView, &inViewCount);
+
+    /* the writer only publishes the raw, the sanitised and the empty table */
+    if (!((inViewCount == INFO_TEST_SNAPSHOT_SATELLITES) //
+        && !memcmp(inView, state->raw, sizeof(inView))) //
+        && !((inViewCount == INFO_TEST_SNAPSHOT_SATELLITES) //
+            && !memcmp(inView, state->sanitised, sizeof(inView))) //
+        && !(!inViewCount //
+            && !memcmp(inView, state->empty, sizeof(inView)))) {
+      __atomic_add_fetch(&state->torn, 1, __ATOMIC_RELAXED);
+    }
+    __atomic_add_fetch(&state->snapshots, 1, __ATOMIC_RELAXED);
+  }
+
+  return NULL;
+}
+
+static void test_nmeaInfoSatellitesInViewSnapshotConcurrent(void) {
+  static InfoTestSnapshotState state;
+  pthread_t readers[INFO_TEST_SNAPSHOT_READERS];
+  size_t i;
+
+  memset(&state, 0, sizeof(state));
+
+  /* sparse and out of range: sanitising compacts and normalises */
+  for (i = 0; i < INFO_TEST_SNAPSHOT_SATELLITES; i++) {
+    NmeaSatellite *sat = &state.raw[(2 * i) + 1];
+
+    sat->prn = (unsigned int) i + 1;
+    sat->elevation = 100;
+    sat->azimuth = 10;
+    sat->snr = 120;
+
+    state.sanitised[i].prn = (unsigned int) i + 1;
+    state.sanitised[i].elevation = 80;
+    state.sanitised[i].azimuth = 190;
+    state.sanitised[i].snr = 99;
+  }
+
+  nmeaInfoSetPresent(&state.info.present, NMEALIB_PRESENT_SATINVIEWCOUNT | NMEALIB_PRESENT_SATINVIEW);
+
+  for (i = 0; i < INFO_TEST_SNAPSHOT_READERS; i++) {
+    CU_ASSERT_EQUAL_FATAL(pthread_create(&readers[i], NULL, infoTestSnapshotReader, &state), 0);
+  }
+
+  for (i = 0; i < INFO_TEST_SNAPSHOT_UPDATES; i++) {
+    nmeaInfoSatellitesInViewPublish(&state.info, state.raw, INFO_TEST_SNAPSHOT_SATELLITES);
+    nmeaInfoSanitise(&state.info);
+    nmeaInfoSatellitesInViewPublish(&state.info, NULL, 0);
+  }
+
+  __atomic_store_n(&state.done, true, __ATOMIC_RELEASE);
+
+  for (i = 0; i < INFO_TEST_SNAPSHOT_READERS; i++) {
+    pthread_join(readers[i], NULL);
+  }
+
+  CU_ASSERT_EQUAL(state.info.progress.gpgsvSequence, 6 * INFO_TEST_SNAPSHOT_UPDATES);
+  CU_ASSERT_EQUAL(memcmp(state.info.satellites.inView, state.empty, sizeof(state.empty)), 0);
+  CU_ASSERT_EQUAL(state.torn, 0);
+}
+
 static void test_nmeaInfoUnitConversion(void) {
   NmeaInfo info;
   NmeaInfo infoClean;
@@ -1198,6 +1693,41 @@ static void test_nmeaInfoUnitConversion(void) {
   CU_ASSERT_EQUAL(memcmp(&info, &infoExpected, sizeof(info)), 0);
 }
 
+static void test_nmeaInfoUnitConversionBatch(void) {
+  NmeaInfo infos[INFO_TEST_BATCH];
+  NmeaInfo infosExpected[INFO_TEST_BATCH];
+  size_t i;
+
+  /* invalid input */
+
+  nmeaInfoUnitConversionBatch(NULL, INFO_TEST_BATCH, true);
+
+  /* the same as converting the info structures one by one */
+
+  infoTestBatchFill(infos, INFO_TEST_BATCH);
+  infoTestBatchFill(infosExpected, INFO_TEST_BATCH);
+
+  for (i = 0; i < INFO_TEST_BATCH; i++) {
+    nmeaInfoUnitConversion(&infosExpected[i], true);
+  }
+
+  nmeaInfoUnitConversionBatch(infos, INFO_TEST_BATCH, true);
+
+  for (i = 0; i < INFO_TEST_BATCH; i++) {
+    CU_ASSERT_EQUAL(memcmp(&infos[i], &infosExpected[i], sizeof(infos[i])), 0);
+  }
+
+  for (i = 0; i < INFO_TEST_BATCH; i++) {
+    nmeaInfoUnitConversion(&infosExpected[i], false);
+  }
+
+  nmeaInfoUnitConversionBatch(infos, INFO_TEST_BATCH, false);
+
+  for (i = 0; i < INFO_TEST_BATCH; i++) {
+    CU_ASSERT_EQUAL(memcmp(&infos[i], &infosExpected[i], sizeof(infos[i])), 0);
+  }
+}
+
 static void test_nmeaQsortPRNCompare(void) {
   unsigned int prn1;
   unsigned int prn2;
@@ -1656,10 +2186,18 @@ int infoSuiteSetup(void) {
       || (!CU_add_test(pSuite, "nmeaInfoUnsetPresent", test_nmeaInfoUnsetPresent)) //
       || (!CU_add_test(pSuite, "nmeaTimeParseTime", test_nmeaTimeParseTime)) //
       || (!CU_add_test(pSuite, "nmeaTimeParseDate", test_nmeaTimeParseDate)) //
+      || (!CU_add_test(pSuite, "nmeaTimeToEpoch", test_nmeaTimeToEpoch)) //
       || (!CU_add_test(pSuite, "nmeaTimeSet", test_nmeaTimeSet)) //
+      || (!CU_add_test(pSuite, "nmeaTimeSetClock", test_nmeaTimeSetClock)) //
       || (!CU_add_test(pSuite, "nmeaInfoClear", test_nmeaInfoClear)) //
       || (!CU_add_test(pSuite, "nmeaInfoSanitise", test_nmeaInfoSanitise)) //
+      || (!CU_add_test(pSuite, "nmeaInfoSanitiseChanged", test_nmeaInfoSanitiseChanged)) //
+      || (!CU_add_test(pSuite, "nmeaInfoSanitiseBatch", test_nmeaInfoSanitiseBatch)) //
+      || (!CU_add_test(pSuite, "nmeaInfoSatellitesInViewPublish", test_nmeaInfoSatellitesInViewPublish)) //
+      || (!CU_add_test(pSuite, "nmeaInfoSatellitesInViewSnapshot", test_nmeaInfoSatellitesInViewSnapshot)) //
+      || (!CU_add_test(pSuite, "nmeaInfoSatellitesInViewSnapshotConcurrent", test_nmeaInfoSatellitesInViewSnapshotConcurrent)) //
       || (!CU_add_test(pSuite, "nmeaInfoUnitConversion", test_nmeaInfoUnitConversion)) //
+      || (!CU_add_test(pSuite, "nmeaInfoUnitConversionBatch", test_nmeaInfoUnitConversionBatch)) //
       || (!CU_add_test(pSuite, "nmeaQsortPRNCompare", test_nmeaQsortPRNCompare)) //
       || (!CU_add_test(pSuite, "nmeaQsortPRNCompact", test_nmeaQsortPRNCompact)) //
       || (!CU_add_test(pSuite, "nmeaQsortSatelliteCompare", test_nmeaQsortSatelliteCompare)) //
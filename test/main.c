@@ -19,8 +19,14 @@
 #include <CUnit/Basic.h>
 #include <stdlib.h>
 
+extern int boardSuiteSetup(void);
+extern int compactSuiteSetup(void);
 extern int contextSuiteSetup(void);
+extern int epochSuiteSetup(void);
+extern int fleetSuiteSetup(void);
 extern int generatorSuiteSetup(void);
+extern int geodesicSuiteSetup(void);
+extern int geofenceSuiteSetup(void);
 extern int gpggaSuiteSetup(void);
 extern int gpgsaSuiteSetup(void);
 extern int gpgsvSuiteSetup(void);
@@ -29,7 +35,13 @@ extern int gpvtgSuiteSetup(void);
 extern int infoSuiteSetup(void);
 extern int nmathSuiteSetup(void);
 extern int parserSuiteSetup(void);
+extern int publisherSuiteSetup(void);
+extern int recordSuiteSetup(void);
+extern int satelliteSuiteSetup(void);
 extern int sentenceSuiteSetup(void);
+extern int timeindexSuiteSetup(void);
+extern int trackSuiteSetup(void);
+extern int trackcodecSuiteSetup(void);
 extern int utilSuiteSetup(void);
 extern int validateSuiteSetup(void);
 
@@ -41,8 +53,14 @@ int main(void) {
   }
 
   if ( //
-      (contextSuiteSetup() != CUE_SUCCESS) //
+      (boardSuiteSetup() != CUE_SUCCESS) //
+      || (compactSuiteSetup() != CUE_SUCCESS) //
+      || (contextSuiteSetup() != CUE_SUCCESS) //
+      || (epochSuiteSetup() != CUE_SUCCESS) //
+      || (fleetSuiteSetup() != CUE_SUCCESS) //
       || (generatorSuiteSetup() != CUE_SUCCESS) //
+      || (geodesicSuiteSetup() != CUE_SUCCESS) //
+      || (geofenceSuiteSetup() != CUE_SUCCESS) //
       || (gpggaSuiteSetup() != CUE_SUCCESS) //
       || (gpgsaSuiteSetup() != CUE_SUCCESS) //
       || (gpgsvSuiteSetup() != CUE_SUCCESS) //
@@ -51,7 +69,13 @@ int main(void) {
       || (infoSuiteSetup() != CUE_SUCCESS) //
       || (nmathSuiteSetup() != CUE_SUCCESS) //
       || (parserSuiteSetup() != CUE_SUCCESS) //
+      || (publisherSuiteSetup() != CUE_SUCCESS) //
+      || (recordSuiteSetup() != CUE_SUCCESS) //
+      || (satelliteSuiteSetup() != CUE_SUCCESS) //
       || (sentenceSuiteSetup() != CUE_SUCCESS) //
+      || (timeindexSuiteSetup() != CUE_SUCCESS) //
+      || (trackSuiteSetup() != CUE_SUCCESS) //
+      || (trackcodecSuiteSetup() != CUE_SUCCESS) //
       || (utilSuiteSetup() != CUE_SUCCESS) //
       || (validateSuiteSetup() != CUE_SUCCESS) //
       ) {
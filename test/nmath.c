@@ -17,6 +17,7 @@
 
 #include "testHelpers.h"
 
+#include <nmealib/geodesic.h>
 #include <nmealib/nmath.h>
 #include <nmealib/util.h>
 #include <CUnit/Basic.h>
@@ -362,6 +363,270 @@ static void test_nmeaMathDistanceEllipsoid(void) {
   CU_ASSERT_DOUBLE_EQUAL(toAzimuth, 0.80490629162972171517509423210867680609226226806640625, FLT_EPSILON);
 }
 
+static void test_nmeaMathDistanceEllipsoidBatch(void) {
+  NmeaPosition from[75];
+  NmeaPosition to[75];
+  double distances[75];
+  double fromAzimuths[75];
+  double toAzimuths[75];
+  size_t count = sizeof(from) / sizeof(from[0]);
+  size_t i;
+
+  nmeaRandomSeedThread(46);
+
+  for (i = 0; i < count; i++) {
+    from[i].lat = nmeaRandom(-NMEALIB_PI / 2.0, NMEALIB_PI / 2.0);
+    from[i].lon = nmeaRandom(-NMEALIB_PI, NMEALIB_PI);
+    to[i].lat = nmeaRandom(-NMEALIB_PI / 2.0, NMEALIB_PI / 2.0);
+    to[i].lon = nmeaRandom(-NMEALIB_PI, NMEALIB_PI);
+  }
+
+  /* same pos, short, (nearly) antipodal and NaN pairs */
+  to[3] = from[3];
+  to[40] = from[40];
+  to[5].lat = from[5].lat + 1e-9;
+  to[5].lon = from[5].lon;
+  to[7].lat = -from[7].lat;
+  to[7].lon = from[7].lon + NMEALIB_PI;
+  to[8].lat = 0.0;
+  to[8].lon = NMEALIB_PI - 1e-3;
+  from[8].lat = 0.0;
+  from[8].lon = 0.0;
+  from[9].lat = NaN;
+
+  /* invalid inputs */
+
+  memset(distances, 0, sizeof(distances));
+  nmeaMathDistanceEllipsoidBatch(NULL, to, count, distances, NULL, NULL);
+  nmeaMathDistanceEllipsoidBatch(from, NULL, count, distances, NULL, NULL);
+  nmeaMathDistanceEllipsoidBatch(from, to, count, NULL, fromAzimuths, toAzimuths);
+  nmeaMathDistanceEllipsoidBatch(from, to, 0, distances, NULL, NULL);
+  for (i = 0; i < count; i++) {
+    CU_ASSERT_EQUAL(distances[i], 0.0);
+  }
+
+  /* without azimuths */
+
+  nmeaMathDistanceEllipsoidBatch(from, to, count, distances, NULL, NULL);
+  for (i = 0; i < count; i++) {
+    double r = nmeaMathDistanceEllipsoid(&from[i], &to[i], NULL, NULL);
+    if (isNaN(r)) {
+      CU_ASSERT_EQUAL(isNaN(distances[i]), true);
+    } else {
+      CU_ASSERT_EQUAL(distances[i], r);
+    }
+  }
+  CU_ASSERT_EQUAL(distances[3], 0.0);
+  CU_ASSERT_EQUAL(isNaN(distances[9]), true);
+
+  /* with azimuths */
+
+  for (i = 0; i < count; i++) {
+    fromAzimuths[i] = INFINITY;
+    toAzimuths[i] = INFINITY;
+  }
+  nmeaMathDistanceEllipsoidBatch(from, to, count, distances, fromAzimuths, toAzimuths);
+  for (i = 0; i < count; i++) {
+    double fromAzimuth = INFINITY;
+    double toAzimuth = INFINITY;
+    double r = nmeaMathDistanceEllipsoid(&from[i], &to[i], &fromAzimuth, &toAzimuth);
+    if (i == 9) {
+      continue;
+    }
+    CU_ASSERT_EQUAL(distances[i], r);
+    CU_ASSERT_EQUAL(fromAzimuths[i], fromAzimuth);
+    CU_ASSERT_EQUAL(toAzimuths[i], toAzimuth);
+  }
+  CU_ASSERT_EQUAL(fromAzimuths[40], 0.0);
+  CU_ASSERT_EQUAL(toAzimuths[40], 0.0);
+
+  /* only the from azimuths */
+
+  for (i = 0; i < count; i++) {
+    fromAzimuths[i] = INFINITY;
+  }
+  nmeaMathDistanceEllipsoidBatch(&from[33], &to[33], 1, distances, fromAzimuths, NULL);
+  CU_ASSERT_EQUAL(distances[0], nmeaMathDistanceEllipsoid(&from[33], &to[33], NULL, NULL));
+  CU_ASSERT_EQUAL(isinf(fromAzimuths[1]), true);
+  CU_ASSERT_EQUAL(isinf(fromAzimuths[0]), false);
+}
+
+static void test_nmeaMathDistanceApproximations(void) {
+  NmeaPosition from;
+  NmeaPosition to;
+  double ref;
+  double r;
+  int mode;
+
+  /* invalid inputs */
+
+  memset(&from, 0, sizeof(from));
+  memset(&to, 0, sizeof(to));
+  CU_ASSERT_EQUAL(isNaN(nmeaMathDistanceEquirectangular(NULL, &to)), true);
+  CU_ASSERT_EQUAL(isNaN(nmeaMathDistanceEquirectangular(&from, NULL)), true);
+  CU_ASSERT_EQUAL(isNaN(nmeaMathDistanceHaversine(NULL, &to)), true);
+  CU_ASSERT_EQUAL(isNaN(nmeaMathDistanceHaversine(&from, NULL)), true);
+  CU_ASSERT_EQUAL(isNaN(nmeaMathDistanceHaversineCached(NULL, 1.0, &to, 1.0)), true);
+  CU_ASSERT_EQUAL(isNaN(nmeaMathDistanceHaversineCached(&from, 1.0, NULL, 1.0)), true);
+  CU_ASSERT_EQUAL(isNaN(nmeaMathDistanceTangentPlane(NULL, &to)), true);
+  CU_ASSERT_EQUAL(isNaN(nmeaMathDistanceTangentPlane(&from, NULL)), true);
+  CU_ASSERT_EQUAL(isNaN(nmeaMathDistanceWithMode(NULL, &to, NMEALIB_MATH_DISTANCE_TANGENTPLANE)), true);
+
+  /* same pos */
+
+  CU_ASSERT_DOUBLE_EQUAL(nmeaMathDistanceEquirectangular(&from, &to), 0.0, FLT_EPSILON);
+  CU_ASSERT_DOUBLE_EQUAL(nmeaMathDistanceHaversine(&from, &to), 0.0, FLT_EPSILON);
+  CU_ASSERT_DOUBLE_EQUAL(nmeaMathDistanceTangentPlane(&from, &to), 0.0, FLT_EPSILON);
+
+  /* short distance: within the documented bounds */
+
+  from.lat = nmeaMathDegreeToRadian(52.0);
+  from.lon = nmeaMathDegreeToRadian(5.0);
+  to.lat = nmeaMathDegreeToRadian(52.005);
+  to.lon = nmeaMathDegreeToRadian(5.008);
+  ref = nmeaGeodesicInverse(&from, &to, NULL, NULL);
+  CU_ASSERT_DOUBLE_EQUAL(nmeaMathDistanceEquirectangular(&from, &to), ref, ref * 0.006);
+  CU_ASSERT_DOUBLE_EQUAL(nmeaMathDistanceHaversine(&from, &to), ref, ref * 0.006);
+  CU_ASSERT_DOUBLE_EQUAL(nmeaMathDistanceTangentPlane(&from, &to), ref, ref * 4e-8);
+  CU_ASSERT_DOUBLE_EQUAL(nmeaMathDistanceEllipsoid(&from, &to, NULL, NULL), ref, ref * 0.0034);
+
+  r = nmeaMathDistanceHaversineCached(&from, cos(from.lat), &to, cos(to.lat));
+  CU_ASSERT_EQUAL(r, nmeaMathDistanceHaversine(&from, &to));
+
+  /* modes */
+
+  CU_ASSERT_EQUAL(nmeaMathDistanceWithMode(&from, &to, NMEALIB_MATH_DISTANCE_EQUIRECTANGULAR),
+      nmeaMathDistanceEquirectangular(&from, &to));
+  CU_ASSERT_EQUAL(nmeaMathDistanceWithMode(&from, &to, NMEALIB_MATH_DISTANCE_TANGENTPLANE),
+      nmeaMathDistanceTangentPlane(&from, &to));
+  CU_ASSERT_EQUAL(nmeaMathDistanceWithMode(&from, &to, NMEALIB_MATH_DISTANCE_HAVERSINE),
+      nmeaMathDistanceHaversine(&from, &to));
+  CU_ASSERT_EQUAL(nmeaMathDistanceWithMode(&from, &to, NMEALIB_MATH_DISTANCE_GREATCIRCLE),
+      nmeaMathDistance(&from, &to));
+  CU_ASSERT_EQUAL(nmeaMathDistanceWithMode(&from, &to, NMEALIB_MATH_DISTANCE_ELLIPSOID),
+      nmeaMathDistanceEllipsoid(&from, &to, NULL, NULL));
+  CU_ASSERT_EQUAL(nmeaMathDistanceWithMode(&from, &to, NMEALIB_MATH_DISTANCE_GEODESIC), ref);
+
+  /* across the antimeridian */
+
+  from.lat = 0.0;
+  from.lon = NMEALIB_PI - 1e-5;
+  to.lat = 0.0;
+  to.lon = -NMEALIB_PI + 1e-5;
+  ref = nmeaGeodesicInverse(&from, &to, NULL, NULL);
+  for (mode = NMEALIB_MATH_DISTANCE_EQUIRECTANGULAR; mode <= NMEALIB_MATH_DISTANCE_HAVERSINE; mode++) {
+    r = nmeaMathDistanceWithMode(&from, &to, (NmeaMathDistanceMode) mode);
+    CU_ASSERT_DOUBLE_EQUAL(r, ref, ref * 0.006);
+  }
+
+  /* mode selection */
+
+  CU_ASSERT_EQUAL(nmeaMathDistanceModeSelect(50.0, 0.01), NMEALIB_MATH_DISTANCE_EQUIRECTANGULAR);
+  CU_ASSERT_EQUAL(nmeaMathDistanceModeSelect(50.0, 1e-4), NMEALIB_MATH_DISTANCE_TANGENTPLANE);
+  CU_ASSERT_EQUAL(nmeaMathDistanceModeSelect(50000.0, 1e-3), NMEALIB_MATH_DISTANCE_TANGENTPLANE);
+  CU_ASSERT_EQUAL(nmeaMathDistanceModeSelect(500000.0, 0.01), NMEALIB_MATH_DISTANCE_HAVERSINE);
+  CU_ASSERT_EQUAL(nmeaMathDistanceModeSelect(500000.0, 0.005), NMEALIB_MATH_DISTANCE_ELLIPSOID);
+  CU_ASSERT_EQUAL(nmeaMathDistanceModeSelect(500000.0, 1e-3), NMEALIB_MATH_DISTANCE_GEODESIC);
+  CU_ASSERT_EQUAL(nmeaMathDistanceModeSelect(1e7, 0.5), NMEALIB_MATH_DISTANCE_GEODESIC);
+  CU_ASSERT_EQUAL(nmeaMathDistanceModeSelect(50.0, 0.0), NMEALIB_MATH_DISTANCE_GEODESIC);
+}
+
+static void test_nmeaMathPrepared(void) {
+  NmeaPosition from;
+  NmeaPosition to;
+  NmeaPositionPrepared fromPrepared;
+  NmeaPositionPrepared toPrepared;
+  NmeaPosition moved;
+  NmeaPosition movedPrepared;
+  double fromAzimuth;
+  double toAzimuth;
+  double fromAzimuthPrepared;
+  double toAzimuthPrepared;
+  size_t i;
+
+  /* invalid inputs */
+
+  memset(&from, 0, sizeof(from));
+  memset(&fromPrepared, 0xaa, sizeof(fromPrepared));
+  nmeaMathPositionPrepare(NULL, &fromPrepared);
+  CU_ASSERT_EQUAL(fromPrepared.pos.lat, fromPrepared.pos.lon);
+  nmeaMathPositionPrepare(&from, NULL);
+
+  nmeaMathPositionPrepare(&from, &fromPrepared);
+  CU_ASSERT_EQUAL(fromPrepared.pos.lat, 0.0);
+  CU_ASSERT_EQUAL(fromPrepared.pos.lon, 0.0);
+  CU_ASSERT_EQUAL(fromPrepared.sinLat, 0.0);
+  CU_ASSERT_EQUAL(fromPrepared.cosLat, 1.0);
+  CU_ASSERT_EQUAL(fromPrepared.tanU, 0.0);
+  CU_ASSERT_EQUAL(fromPrepared.sinU, 0.0);
+  CU_ASSERT_EQUAL(fromPrepared.cosU, 1.0);
+
+  CU_ASSERT_EQUAL(isNaN(nmeaMathDistancePrepared(NULL, &fromPrepared)), true);
+  CU_ASSERT_EQUAL(isNaN(nmeaMathDistancePrepared(&fromPrepared, NULL)), true);
+  CU_ASSERT_EQUAL(isNaN(nmeaMathDistanceEllipsoidPrepared(NULL, &fromPrepared, NULL, NULL)), true);
+  CU_ASSERT_EQUAL(isNaN(nmeaMathDistanceEllipsoidPrepared(&fromPrepared, NULL, NULL, NULL)), true);
+  CU_ASSERT_EQUAL(isNaN(nmeaMathDistanceHaversinePrepared(NULL, &fromPrepared)), true);
+  CU_ASSERT_EQUAL(isNaN(nmeaMathDistanceHaversinePrepared(&fromPrepared, NULL)), true);
+  CU_ASSERT_EQUAL(nmeaMathMoveFlatPrepared(NULL, &moved, 0.0, 1.0), false);
+  CU_ASSERT_EQUAL(nmeaMathMoveFlatPrepared(&fromPrepared, NULL, 0.0, 1.0), false);
+  CU_ASSERT_EQUAL(nmeaMathMoveFlatEllipsoidPrepared(NULL, &moved, 0.0, 1.0, NULL), false);
+  CU_ASSERT_EQUAL(nmeaMathMoveFlatEllipsoidPrepared(&fromPrepared, NULL, 0.0, 1.0, NULL), false);
+
+  /* same pos */
+
+  fromAzimuth = INFINITY;
+  toAzimuth = INFINITY;
+  CU_ASSERT_EQUAL(nmeaMathDistancePrepared(&fromPrepared, &fromPrepared), 0.0);
+  CU_ASSERT_EQUAL(nmeaMathDistanceEllipsoidPrepared(&fromPrepared, &fromPrepared, &fromAzimuth, &toAzimuth), 0.0);
+  CU_ASSERT_EQUAL(fromAzimuth, 0.0);
+  CU_ASSERT_EQUAL(toAzimuth, 0.0);
+
+  /* NaN */
+
+  from.lat = NaN;
+  nmeaMathPositionPrepare(&from, &fromPrepared);
+  CU_ASSERT_EQUAL(nmeaMathMoveFlatPrepared(&fromPrepared, &moved, 0.0, 1.0), false);
+  CU_ASSERT_EQUAL(isNaN(moved.lat), true);
+  CU_ASSERT_EQUAL(nmeaMathMoveFlatEllipsoidPrepared(&fromPrepared, &moved, 0.0, 1.0, NULL), false);
+  CU_ASSERT_EQUAL(isNaN(moved.lat), true);
+
+  /* the same results as with plain positions */
+
+  nmeaRandomSeedThread(48);
+
+  for (i = 0; i < 100; i++) {
+    double azimuth = nmeaRandom(0.0, 2.0 * NMEALIB_PI);
+    double distance = nmeaRandom(0.0, 1000.0);
+
+    from.lat = nmeaRandom(-NMEALIB_PI / 2.0, NMEALIB_PI / 2.0);
+    from.lon = nmeaRandom(-NMEALIB_PI, NMEALIB_PI);
+    to.lat = nmeaRandom(-NMEALIB_PI / 2.0, NMEALIB_PI / 2.0);
+    to.lon = nmeaRandom(-NMEALIB_PI, NMEALIB_PI);
+    nmeaMathPositionPrepare(&from, &fromPrepared);
+    nmeaMathPositionPrepare(&to, &toPrepared);
+
+    CU_ASSERT_EQUAL(nmeaMathDistancePrepared(&fromPrepared, &toPrepared), nmeaMathDistance(&from, &to));
+    CU_ASSERT_EQUAL(nmeaMathDistanceHaversinePrepared(&fromPrepared, &toPrepared),
+        nmeaMathDistanceHaversine(&from, &to));
+    CU_ASSERT_EQUAL(nmeaMathDistanceEllipsoidPrepared(&fromPrepared, &toPrepared, &fromAzimuthPrepared,
+        &toAzimuthPrepared), nmeaMathDistanceEllipsoid(&from, &to, &fromAzimuth, &toAzimuth));
+    CU_ASSERT_EQUAL(fromAzimuthPrepared, fromAzimuth);
+    CU_ASSERT_EQUAL(toAzimuthPrepared, toAzimuth);
+
+    CU_ASSERT_EQUAL(nmeaMathMoveFlatPrepared(&fromPrepared, &movedPrepared, azimuth, distance), true);
+    CU_ASSERT_EQUAL(nmeaMathMoveFlat(&from, &moved, azimuth, distance), true);
+    CU_ASSERT_EQUAL(movedPrepared.lat, moved.lat);
+    CU_ASSERT_EQUAL(movedPrepared.lon, moved.lon);
+
+    CU_ASSERT_EQUAL(nmeaMathMoveFlatEllipsoidPrepared(&fromPrepared, &movedPrepared, azimuth, distance,
+        &toAzimuthPrepared), true);
+    CU_ASSERT_EQUAL(nmeaMathMoveFlatEllipsoid(&from, &moved, azimuth, distance, &toAzimuth), true);
+    CU_ASSERT_EQUAL(movedPrepared.lat, moved.lat);
+    CU_ASSERT_EQUAL(movedPrepared.lon, moved.lon);
+    CU_ASSERT_EQUAL(toAzimuthPrepared, toAzimuth);
+  }
+}
+
 static void test_nmeaMathMoveFlat(void) {
   NmeaPosition from;
   NmeaPosition to;
@@ -538,6 +803,9 @@ int nmathSuiteSetup(void) {
       || (!CU_add_test(pSuite, "nmeaMathDistance", test_nmeaMathDistance)) //
       || (!CU_add_test(pSuite, "nmeaMathDistanceEllipsoid", test_nmeaMathDistanceEllipsoid)) //
       || (!CU_add_test(pSuite, "nmeaMathDistanceEllipsoid", test_nmeaMathDistanceEllipsoid)) //
+      || (!CU_add_test(pSuite, "nmeaMathDistanceEllipsoidBatch", test_nmeaMathDistanceEllipsoidBatch)) //
+      || (!CU_add_test(pSuite, "nmeaMathDistanceApproximations", test_nmeaMathDistanceApproximations)) //
+      || (!CU_add_test(pSuite, "nmeaMathPrepared", test_nmeaMathPrepared)) //
       || (!CU_add_test(pSuite, "nmeaMathMoveFlat", test_nmeaMathMoveFlat)) //
       || (!CU_add_test(pSuite, "nmeaMathMoveFlatEllipsoid", test_nmeaMathMoveFlatEllipsoid)) //
       ) {
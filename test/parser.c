@@ -26,7 +26,6 @@ int parserSuiteSetup(void);
 
 extern void nmeaParserReset(NmeaParser * parser, NmeaParserSentenceState new_state);
 extern bool nmeaParserIsHexCharacter(char c);
-extern bool nmeaParserProcessCharacter(NmeaParser *parser, const char * c);
 
 /*
  * Tests
@@ -507,24 +506,25 @@ static void test_nmeaParserParse(void) {
   NmeaInfo info;
   const char *s = "$GPGGA,,,,,,,,,,,,,,*56\r\n";
   size_t r;
+  uint32_t changed;
 
   memset(&parser, 0, sizeof(parser));
 
   /* invalid inputs */
 
-  r = nmeaParserParse(NULL, s, strlen(s), &info);
+  r = nmeaParserParse(NULL, s, strlen(s), &info, NULL);
   CU_ASSERT_EQUAL(r, 0);
 
-  r = nmeaParserParse(&parser, NULL, strlen(s), &info);
+  r = nmeaParserParse(&parser, NULL, strlen(s), &info, NULL);
   CU_ASSERT_EQUAL(r, 0);
 
-  r = nmeaParserParse(&parser, s, 0, &info);
+  r = nmeaParserParse(&parser, s, 0, &info, NULL);
   CU_ASSERT_EQUAL(r, 0);
 
-  r = nmeaParserParse(&parser, s, strlen(s), NULL);
+  r = nmeaParserParse(&parser, s, strlen(s), NULL, NULL);
   CU_ASSERT_EQUAL(r, 0);
 
-  r = nmeaParserParse(&parser, s, strlen(s), &info);
+  r = nmeaParserParse(&parser, s, strlen(s), &info, NULL);
   CU_ASSERT_EQUAL(r, 0);
 
   nmeaParserInit(&parser, 0);
@@ -532,21 +532,74 @@ static void test_nmeaParserParse(void) {
   /* parse */
 
   s = "$GPGGA,,,,,,,,,,,,,,*00\r\n";
-  r = nmeaParserParse(&parser, s, strlen(s), &info);
+  r = nmeaParserParse(&parser, s, strlen(s), &info, NULL);
   CU_ASSERT_EQUAL(r, 0);
 
   s = "$GPGGA,,,,,,,,,,,,,,*56\r\n";
-  r = nmeaParserParse(&parser, s, strlen(s), &info);
+  r = nmeaParserParse(&parser, s, strlen(s), &info, NULL);
   CU_ASSERT_EQUAL(r, 1);
 
   s = "$GPGGA,,,,,,,,,,,,,,*56\r\n$GPGGA,,,,,,,,,,,,,,*56\r\n$GPGGA,,,,,,,,,,,,,,*56\r\n";
-  r = nmeaParserParse(&parser, s, strlen(s), &info);
+  r = nmeaParserParse(&parser, s, strlen(s), &info, NULL);
   CU_ASSERT_EQUAL(r, 3);
 
   s = "$GPGGA,,,,,,,,,,,,,,*56\r\n$GPGGA,,,,,,$,,,,,,,,*56\r\n$GPGGA,,,,,,,,,,,,,,*56\r\n";
-  r = nmeaParserParse(&parser, s, strlen(s), &info);
+  r = nmeaParserParse(&parser, s, strlen(s), &info, NULL);
   CU_ASSERT_EQUAL(r, 2);
 
+  /* changed fields */
+
+  memset(&info, 0, sizeof(info));
+
+  s = "$GPGGA,123456.78,5000.000,N,00400.000,E,1,04,1.5,10.0,M,20.0,M,,*56\r\n";
+  r = nmeaParserParse(&parser, s, strlen(s), &info, &changed);
+  CU_ASSERT_EQUAL(r, 1);
+  CU_ASSERT_EQUAL(changed,
+      NMEALIB_PRESENT_SMASK | NMEALIB_PRESENT_UTCTIME | NMEALIB_PRESENT_LAT | NMEALIB_PRESENT_LON | NMEALIB_PRESENT_SIG
+      | NMEALIB_PRESENT_SATINVIEWCOUNT | NMEALIB_PRESENT_HDOP | NMEALIB_PRESENT_ELV | NMEALIB_PRESENT_HEIGHT);
+
+  r = nmeaParserParse(&parser, s, strlen(s), &info, &changed);
+  CU_ASSERT_EQUAL(r, 1);
+  CU_ASSERT_EQUAL(changed, 0);
+
+  s = "$GPGGA,123456.78,5000.001,N,00400.000,E,1,04,1.5,10.0,M,20.0,M,,*57\r\n";
+  r = nmeaParserParse(&parser, s, strlen(s), &info, &changed);
+  CU_ASSERT_EQUAL(r, 1);
+  CU_ASSERT_EQUAL(changed, NMEALIB_PRESENT_LAT);
+
+  s = "$GPGSV,1,1,02,01,50,000,99,02,40,090,80*78\r\n";
+  r = nmeaParserParse(&parser, s, strlen(s), &info, &changed);
+  CU_ASSERT_EQUAL(r, 1);
+  CU_ASSERT_EQUAL(changed, NMEALIB_PRESENT_SMASK | NMEALIB_PRESENT_SATINVIEWCOUNT | NMEALIB_PRESENT_SATINVIEW);
+
+  s = "$GPGSV,1,1,02,01,50,000,99,02,40,095,80*7D\r\n";
+  r = nmeaParserParse(&parser, s, strlen(s), &info, &changed);
+  CU_ASSERT_EQUAL(r, 1);
+  CU_ASSERT_EQUAL(changed, NMEALIB_PRESENT_SATINVIEW);
+
+  /* a gpgsv sequence is staged in the parser until it is complete */
+
+  s = "$GPGSV,2,1,05,01,50,000,99,02,40,095,80,03,30,180,70,04,20,270,60*72\r\n";
+  r = nmeaParserParse(&parser, s, strlen(s), &info, &changed);
+  CU_ASSERT_EQUAL(r, 1);
+  CU_ASSERT_EQUAL(changed, 0);
+  CU_ASSERT_EQUAL(info.satellites.inViewCount, 2);
+  CU_ASSERT_EQUAL(info.satellites.inView[2].prn, 0);
+  CU_ASSERT_EQUAL(parser.gpgsv.inView[2].prn, 3);
+
+  s = "$GPGSV,2,2,05,05,10,045,50*4C\r\n";
+  r = nmeaParserParse(&parser, s, strlen(s), &info, &changed);
+  CU_ASSERT_EQUAL(r, 1);
+  CU_ASSERT_EQUAL(changed, NMEALIB_PRESENT_SATINVIEWCOUNT | NMEALIB_PRESENT_SATINVIEW);
+  CU_ASSERT_EQUAL(info.satellites.inViewCount, 5);
+  CU_ASSERT_EQUAL(info.satellites.inView[2].prn, 3);
+  CU_ASSERT_EQUAL(info.satellites.inView[4].prn, 5);
+
+  s = "$GPGGA,,,,,,,,,,,,,,*56\r\n";
+  r = nmeaParserParse(NULL, s, strlen(s), &info, &changed);
+  CU_ASSERT_EQUAL(r, 0);
+  CU_ASSERT_EQUAL(changed, 0);
+
   nmeaParserDestroy(&parser);
 }
 
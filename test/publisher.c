@@ -0,0 +1,223 @@
+/*
+ * This file is part of nmealib.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "testHelpers.h"
+
+#include <nmealib/publisher.h>
+#include <CUnit/Basic.h>
+#include <float.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <string.h>
+
+int publisherSuiteSetup(void);
+
+#define PUBLISHER_TEST_READERS (4u)
+#define PUBLISHER_TEST_UPDATES (20000u)
+
+typedef struct _PublisherTestState {
+  NmeaInfoPublisher publisher;
+  uint32_t started;
+  bool done;
+  uint64_t snapshots;
+  uint64_t torn;
+} PublisherTestState;
+
+static void *publisherTestReader(void *arg) {
+  PublisherTestState *state = (PublisherTestState *) arg;
+  NmeaInfo info;
+
+  __atomic_add_fetch(&state->started, 1, __ATOMIC_RELEASE);
+
+  do {
+    nmeaInfoPublisherSnapshot(&state->publisher, &info);
+
+    /* the writer always publishes infos in which these fields are equal */
+    if ((info.latitude != info.longitude) //
+        || (info.latitude != info.elevation) //
+        || (info.dgpsSid != info.satellites.inView[NMEALIB_MAX_SATELLITES - 1].prn)) {
+      __atomic_add_fetch(&state->torn, 1, __ATOMIC_RELAXED);
+    }
+    __atomic_add_fetch(&state->snapshots, 1, __ATOMIC_RELAXED);
+  } while (!__atomic_load_n(&state->done, __ATOMIC_ACQUIRE));
+
+  return NULL;
+}
+
+/*
+ * Tests
+ */
+
+static void test_nmeaInfoPublisherPublish(void) {
+  NmeaInfoPublisher publisher;
+  NmeaInfo info;
+  NmeaInfo snapshot;
+  uint32_t r;
+
+  memset(&info, 0, sizeof(info));
+  memset(&snapshot, 0xaa, sizeof(snapshot));
+
+  /* invalid inputs */
+
+  nmeaInfoPublisherInit(NULL);
+  nmeaInfoPublisherPublish(NULL, &info);
+
+  r = nmeaInfoPublisherSequence(NULL);
+  CU_ASSERT_EQUAL(r, 0);
+
+  r = nmeaInfoPublisherSnapshot(NULL, &snapshot);
+  CU_ASSERT_EQUAL(r, 0);
+
+  nmeaInfoPublisherInit(&publisher);
+
+  r = nmeaInfoPublisherSnapshot(&publisher, NULL);
+  CU_ASSERT_EQUAL(r, 0);
+
+  nmeaInfoPublisherPublish(&publisher, NULL);
+  CU_ASSERT_EQUAL(nmeaInfoPublisherSequence(&publisher), 0);
+
+  /* normal */
+
+  r = nmeaInfoPublisherSnapshot(&publisher, &snapshot);
+  CU_ASSERT_EQUAL(r, 0);
+  CU_ASSERT_EQUAL(snapshot.present, NMEALIB_PRESENT_SIG | NMEALIB_PRESENT_FIX);
+  CU_ASSERT_EQUAL(snapshot.sig, NMEALIB_SIG_INVALID);
+
+  info.latitude = 5000.0;
+  nmeaInfoSetPresent(&info.present, NMEALIB_PRESENT_LAT);
+  nmeaInfoPublisherPublish(&publisher, &info);
+  CU_ASSERT_EQUAL(nmeaInfoPublisherSequence(&publisher), 2);
+
+  r = nmeaInfoPublisherSnapshot(&publisher, &snapshot);
+  CU_ASSERT_EQUAL(r, 2);
+  CU_ASSERT_EQUAL(memcmp(&snapshot, &info, sizeof(info)), 0);
+
+  validateContext(0, 0);
+}
+
+static void test_nmeaInfoPublisherTrySnapshot(void) {
+  NmeaInfoPublisher publisher;
+  NmeaInfo info;
+  NmeaInfo snapshot;
+  uint32_t sequence;
+  bool r;
+
+  memset(&info, 0, sizeof(info));
+  memset(&snapshot, 0xaa, sizeof(snapshot));
+
+  nmeaInfoPublisherInit(&publisher);
+
+  /* invalid inputs */
+
+  r = nmeaInfoPublisherTrySnapshot(NULL, &snapshot, 1, NULL);
+  CU_ASSERT_EQUAL(r, false);
+
+  r = nmeaInfoPublisherTrySnapshot(&publisher, NULL, 1, NULL);
+  CU_ASSERT_EQUAL(r, false);
+
+  r = nmeaInfoPublisherTrySnapshot(&publisher, &snapshot, 0, NULL);
+  CU_ASSERT_EQUAL(r, false);
+
+  /* normal */
+
+  info.latitude = 5000.0;
+  nmeaInfoSetPresent(&info.present, NMEALIB_PRESENT_LAT);
+  nmeaInfoPublisherPublish(&publisher, &info);
+
+  sequence = 0;
+  r = nmeaInfoPublisherTrySnapshot(&publisher, &snapshot, 1, &sequence);
+  CU_ASSERT_EQUAL(r, true);
+  CU_ASSERT_EQUAL(sequence, 2);
+  CU_ASSERT_EQUAL(memcmp(&snapshot, &info, sizeof(info)), 0);
+
+  r = nmeaInfoPublisherTrySnapshot(&publisher, &snapshot, 1, NULL);
+  CU_ASSERT_EQUAL(r, true);
+
+  /* the writer stopped halfway through a publish */
+
+  publisher.sequence = 3;
+  sequence = 42;
+  r = nmeaInfoPublisherTrySnapshot(&publisher, &snapshot, 1000, &sequence);
+  CU_ASSERT_EQUAL(r, false);
+  CU_ASSERT_EQUAL(sequence, 42);
+
+  validateContext(0, 0);
+}
+
+static void test_nmeaInfoPublisherConcurrent(void) {
+  static PublisherTestState state;
+  pthread_t readers[PUBLISHER_TEST_READERS];
+  NmeaInfo info;
+  size_t i;
+
+  memset(&state, 0, sizeof(state));
+  memset(&info, 0, sizeof(info));
+  nmeaInfoPublisherInit(&state.publisher);
+  nmeaInfoPublisherPublish(&state.publisher, &info);
+
+  for (i = 0; i < PUBLISHER_TEST_READERS; i++) {
+    CU_ASSERT_EQUAL_FATAL(pthread_create(&readers[i], NULL, publisherTestReader, &state), 0);
+  }
+
+  /* let the readers overlap with the writer */
+  while (__atomic_load_n(&state.started, __ATOMIC_ACQUIRE) < PUBLISHER_TEST_READERS) {
+    sched_yield();
+  }
+
+  for (i = 1; i <= PUBLISHER_TEST_UPDATES; i++) {
+    info.latitude = (double) i;
+    info.longitude = (double) i;
+    info.elevation = (double) i;
+    info.dgpsSid = (unsigned int) i;
+    info.satellites.inView[NMEALIB_MAX_SATELLITES - 1].prn = (unsigned int) i;
+    nmeaInfoPublisherPublish(&state.publisher, &info);
+  }
+
+  __atomic_store_n(&state.done, true, __ATOMIC_RELEASE);
+
+  for (i = 0; i < PUBLISHER_TEST_READERS; i++) {
+    pthread_join(readers[i], NULL);
+  }
+
+  CU_ASSERT_EQUAL(nmeaInfoPublisherSequence(&state.publisher), 2 * (PUBLISHER_TEST_UPDATES + 1));
+  CU_ASSERT_EQUAL(state.torn, 0);
+  CU_ASSERT_NOT_EQUAL(state.snapshots, 0);
+
+  validateContext(0, 0);
+}
+
+/*
+ * Setup
+ */
+
+int publisherSuiteSetup(void) {
+  CU_pSuite pSuite = CU_add_suite("publisher", mockContextSuiteInit, mockContextSuiteClean);
+  if (!pSuite) {
+    return CU_get_error();
+  }
+
+  if ( //
+      (!CU_add_test(pSuite, "nmeaInfoPublisherPublish", test_nmeaInfoPublisherPublish)) //
+      || (!CU_add_test(pSuite, "nmeaInfoPublisherTrySnapshot", test_nmeaInfoPublisherTrySnapshot)) //
+      || (!CU_add_test(pSuite, "nmeaInfoPublisherConcurrent", test_nmeaInfoPublisherConcurrent)) //
+      ) {
+    return CU_get_error();
+  }
+
+  return CUE_SUCCESS;
+}
@@ -0,0 +1,351 @@
+/*
+ * This file is part of nmealib.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "testHelpers.h"
+
+#include <nmealib/record.h>
+#include <CUnit/Basic.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+int recordSuiteSetup(void);
+
+#define RECORD_TEST_RECORDS (150u)
+
+/**
+ * Build a temporary file name for a test
+ *
+ * @param path The buffer for the file name
+ * @param sz The size of the buffer
+ * @param name The name of the test
+ */
+static void recordTestPath(char *path, size_t sz, const char *name) {
+  snprintf(path, sz, "/tmp/nmealib-record-%ld-%s.bin", (long) getpid(), name);
+  unlink(path);
+}
+
+/**
+ * Fill an info structure with a fix
+ *
+ * @param info The info structure
+ * @param i The index of the fix
+ */
+static void recordTestInfo(NmeaInfo *info, size_t i) {
+  memset(info, 0, sizeof(*info));
+  info->utc.year = 116;
+  info->utc.mon = 12;
+  info->utc.day = 17;
+  info->utc.hour = 18;
+  info->utc.min = 40;
+  info->utc.sec = (unsigned int) (i % 60);
+  info->utc.hsec = 25;
+  info->sig = NMEALIB_SIG_FIX;
+  info->fix = NMEALIB_FIX_3D;
+  info->pdop = 2.5;
+  info->hdop = 1.5;
+  info->vdop = 2.0;
+  info->latitude = 5130.5 + (double) i / 100.0;
+  info->longitude = -130.25;
+  info->elevation = 42.5 + (double) i;
+  info->height = -3.125;
+  info->speed = 12.5;
+  info->track = 359.99;
+  info->mtrack = 12.34;
+  info->magvar = 2.5;
+  info->dgpsAge = 1.5;
+  info->dgpsSid = 7;
+  info->satellites.inUseCount = 9;
+  info->satellites.inViewCount = 12;
+  info->smask = NMEALIB_SENTENCE_GPGGA | NMEALIB_SENTENCE_GPRMC;
+  info->present = NMEALIB_INFO_PRESENT_MASK & ~(uint32_t) (NMEALIB_PRESENT_SATINUSE | NMEALIB_PRESENT_SATINVIEW);
+}
+
+/**
+ * Compare an info structure that went through a record with the original
+ *
+ * @param out The info structure that went through a record
+ * @param in The original info structure
+ */
+static void recordTestCompare(const NmeaInfo *out, const NmeaInfo *in) {
+  CU_ASSERT_EQUAL(out->present, in->present);
+  CU_ASSERT_EQUAL(out->smask, in->smask);
+  CU_ASSERT_EQUAL(memcmp(&out->utc, &in->utc, sizeof(out->utc)), 0);
+  CU_ASSERT_EQUAL(out->sig, in->sig);
+  CU_ASSERT_EQUAL(out->fix, in->fix);
+  CU_ASSERT_DOUBLE_EQUAL(out->pdop, in->pdop, 0.005);
+  CU_ASSERT_DOUBLE_EQUAL(out->hdop, in->hdop, 0.005);
+  CU_ASSERT_DOUBLE_EQUAL(out->vdop, in->vdop, 0.005);
+  CU_ASSERT_DOUBLE_EQUAL(out->latitude, in->latitude, 1e-5);
+  CU_ASSERT_DOUBLE_EQUAL(out->longitude, in->longitude, 1e-5);
+  CU_ASSERT_DOUBLE_EQUAL(out->elevation, in->elevation, 0.0005);
+  CU_ASSERT_DOUBLE_EQUAL(out->height, in->height, 0.0005);
+  CU_ASSERT_DOUBLE_EQUAL(out->speed, in->speed, 0.0005);
+  CU_ASSERT_DOUBLE_EQUAL(out->track, in->track, 0.005);
+  CU_ASSERT_DOUBLE_EQUAL(out->mtrack, in->mtrack, 0.005);
+  CU_ASSERT_DOUBLE_EQUAL(out->magvar, in->magvar, 0.005);
+  CU_ASSERT_DOUBLE_EQUAL(out->dgpsAge, in->dgpsAge, 0.05);
+  CU_ASSERT_EQUAL(out->dgpsSid, in->dgpsSid);
+  CU_ASSERT_EQUAL(out->satellites.inUseCount, in->satellites.inUseCount);
+  CU_ASSERT_EQUAL(out->satellites.inViewCount, in->satellites.inViewCount);
+}
+
+/*
+ * Tests
+ */
+
+static void test_nmeaRecordFromInfo(void) {
+  NmeaRecord record;
+  NmeaRecord decoded;
+  NmeaInfo info;
+  NmeaInfo out;
+  NmeaInfo metric;
+  uint8_t buf[NMEALIB_RECORD_SIZE];
+
+  /* invalid inputs */
+
+  memset(&info, 0, sizeof(info));
+  memset(&record, 0, sizeof(record));
+  memset(buf, 0, sizeof(buf));
+  nmeaRecordFromInfo(&info, NULL);
+  nmeaRecordToInfo(&record, NULL);
+  nmeaRecordEncode(NULL, buf);
+  nmeaRecordEncode(&record, NULL);
+  nmeaRecordDecode(NULL, &record);
+  nmeaRecordDecode(buf, NULL);
+
+  memset(&record, 0xaa, sizeof(record));
+  nmeaRecordFromInfo(NULL, &record);
+  CU_ASSERT_EQUAL(record.present, 0);
+  CU_ASSERT_EQUAL(record.latitude, 0);
+
+  memset(&info, 0xaa, sizeof(info));
+  nmeaRecordToInfo(NULL, &info);
+  CU_ASSERT_EQUAL(info.present, 0);
+
+  /* the layout has no padding */
+
+  CU_ASSERT_EQUAL(sizeof(NmeaRecord), NMEALIB_RECORD_SIZE);
+
+  /* nothing present */
+
+  memset(&info, 0, sizeof(info));
+  info.latitude = 5130.0;
+  nmeaRecordFromInfo(&info, &record);
+  CU_ASSERT_EQUAL(record.present, 0);
+  CU_ASSERT_EQUAL(record.latitude, 0);
+
+  /* normal */
+
+  recordTestInfo(&info, 0);
+  nmeaRecordFromInfo(&info, &record);
+  CU_ASSERT_EQUAL(record.latitude, 515083333);
+  CU_ASSERT_EQUAL(record.longitude, -15041667);
+  CU_ASSERT_EQUAL(record.elevation, 42500);
+  CU_ASSERT_EQUAL(record.height, -3125);
+  CU_ASSERT_EQUAL(record.speed, 12500);
+  CU_ASSERT_EQUAL(record.track, 35999);
+  CU_ASSERT_EQUAL(record.hdop, 150);
+
+  nmeaRecordEncode(&record, buf);
+  CU_ASSERT_EQUAL(buf[0], 116);
+  CU_ASSERT_EQUAL(buf[1], 0);
+  nmeaRecordDecode(buf, &decoded);
+  CU_ASSERT_EQUAL(memcmp(&record, &decoded, sizeof(record)), 0);
+
+  nmeaRecordToInfo(&decoded, &out);
+  recordTestCompare(&out, &info);
+
+  /* metric */
+
+  metric = info;
+  nmeaInfoUnitConversion(&metric, true);
+  nmeaRecordFromInfo(&metric, &decoded);
+  CU_ASSERT_EQUAL(memcmp(&record, &decoded, sizeof(record)), 0);
+
+  /* clamping */
+
+  info.speed = 1e12;
+  info.elevation = -1e12;
+  info.track = -1.0;
+  info.dgpsSid = 100000;
+  nmeaRecordFromInfo(&info, &record);
+  CU_ASSERT_EQUAL(record.speed, UINT32_MAX);
+  CU_ASSERT_EQUAL(record.elevation, INT32_MIN);
+  CU_ASSERT_EQUAL(record.track, 0);
+  CU_ASSERT_EQUAL(record.dgpsSid, UINT16_MAX);
+
+  validateContext(0, 0);
+}
+
+static void test_nmeaRecordWriter(void) {
+  char path[256];
+  NmeaRecordWriter *writer;
+  NmeaRecordFile *file;
+  NmeaRecord record;
+  NmeaInfo info;
+  NmeaInfo out;
+  NmeaEpoch epoch;
+  bool r;
+  size_t i;
+  int fd;
+
+  recordTestPath(path, sizeof(path), "writer");
+  memset(&info, 0, sizeof(info));
+
+  /* invalid inputs */
+
+  writer = nmeaRecordWriterOpen(NULL);
+  CU_ASSERT_PTR_NULL(writer);
+  r = nmeaRecordWriterAppend(NULL, &info);
+  CU_ASSERT_EQUAL(r, false);
+  r = nmeaRecordWriterFlush(NULL);
+  CU_ASSERT_EQUAL(r, false);
+  r = nmeaRecordWriterClose(NULL);
+  CU_ASSERT_EQUAL(r, false);
+  file = nmeaRecordFileOpen(NULL);
+  CU_ASSERT_PTR_NULL(file);
+  nmeaRecordFileClose(NULL);
+  CU_ASSERT_EQUAL(nmeaRecordFileCount(NULL), 0);
+  r = nmeaRecordFileGet(NULL, 0, &record);
+  CU_ASSERT_EQUAL(r, false);
+
+  writer = nmeaRecordWriterOpen("/nonexistent/directory/file");
+  CU_ASSERT_PTR_NULL(writer);
+  file = nmeaRecordFileOpen(path);
+  CU_ASSERT_PTR_NULL(file);
+  validateContext(0, 2);
+
+  /* empty file */
+
+  writer = nmeaRecordWriterOpen(path);
+  CU_ASSERT_PTR_NOT_NULL_FATAL(writer);
+  r = nmeaRecordWriterAppend(writer, NULL);
+  CU_ASSERT_EQUAL(r, false);
+  r = nmeaRecordWriterClose(writer);
+  CU_ASSERT_EQUAL(r, true);
+
+  file = nmeaRecordFileOpen(path);
+  CU_ASSERT_PTR_NOT_NULL_FATAL(file);
+  CU_ASSERT_EQUAL(nmeaRecordFileCount(file), 0);
+  r = nmeaRecordFileGet(file, 0, &record);
+  CU_ASSERT_EQUAL(r, false);
+  nmeaRecordFileClose(file);
+
+  /* write more records than the writer buffers, then append */
+
+  writer = nmeaRecordWriterOpen(path);
+  CU_ASSERT_PTR_NOT_NULL_FATAL(writer);
+  for (i = 0; i < (RECORD_TEST_RECORDS - 1); i++) {
+    recordTestInfo(&info, i);
+    r = nmeaRecordWriterAppend(writer, &info);
+    CU_ASSERT_EQUAL(r, true);
+  }
+  r = nmeaRecordWriterClose(writer);
+  CU_ASSERT_EQUAL(r, true);
+
+  /* a partially written record */
+
+  fd = open(path, O_WRONLY | O_APPEND);
+  CU_ASSERT_FATAL(fd >= 0);
+  CU_ASSERT_EQUAL(write(fd, "partial", 7), 7);
+  close(fd);
+
+  file = nmeaRecordFileOpen(path);
+  CU_ASSERT_PTR_NOT_NULL_FATAL(file);
+  CU_ASSERT_EQUAL(nmeaRecordFileCount(file), RECORD_TEST_RECORDS - 1);
+  nmeaRecordFileClose(file);
+
+  writer = nmeaRecordWriterOpen(path);
+  CU_ASSERT_PTR_NOT_NULL_FATAL(writer);
+  memset(&epoch, 0, sizeof(epoch));
+  recordTestInfo(&epoch.info, RECORD_TEST_RECORDS - 1);
+  nmeaRecordWriterEpochHandler(writer, NULL);
+  nmeaRecordWriterEpochHandler(writer, &epoch);
+  r = nmeaRecordWriterFlush(writer);
+  CU_ASSERT_EQUAL(r, true);
+  r = nmeaRecordWriterClose(writer);
+  CU_ASSERT_EQUAL(r, true);
+
+  /* read back */
+
+  file = nmeaRecordFileOpen(path);
+  CU_ASSERT_PTR_NOT_NULL_FATAL(file);
+  CU_ASSERT_EQUAL(nmeaRecordFileCount(file), RECORD_TEST_RECORDS);
+  r = nmeaRecordFileGet(file, 0, NULL);
+  CU_ASSERT_EQUAL(r, false);
+  r = nmeaRecordFileGet(file, RECORD_TEST_RECORDS, &record);
+  CU_ASSERT_EQUAL(r, false);
+
+  for (i = 0; i < RECORD_TEST_RECORDS; i++) {
+    r = nmeaRecordFileGet(file, i, &record);
+    CU_ASSERT_EQUAL(r, true);
+    nmeaRecordToInfo(&record, &out);
+    recordTestInfo(&info, i);
+    recordTestCompare(&out, &info);
+  }
+
+  nmeaRecordFileClose(file);
+
+  /* not a record file */
+
+  fd = open(path, O_WRONLY | O_TRUNC);
+  CU_ASSERT_FATAL(fd >= 0);
+  CU_ASSERT_EQUAL(write(fd, "$GPGGA,not a record file\r\n", 26), 26);
+  close(fd);
+
+  writer = nmeaRecordWriterOpen(path);
+  CU_ASSERT_PTR_NULL(writer);
+  file = nmeaRecordFileOpen(path);
+  CU_ASSERT_PTR_NULL(file);
+
+  fd = open(path, O_WRONLY | O_TRUNC);
+  CU_ASSERT_FATAL(fd >= 0);
+  CU_ASSERT_EQUAL(write(fd, "short", 5), 5);
+  close(fd);
+
+  writer = nmeaRecordWriterOpen(path);
+  CU_ASSERT_PTR_NULL(writer);
+  file = nmeaRecordFileOpen(path);
+  CU_ASSERT_PTR_NULL(file);
+
+  unlink(path);
+
+  validateContext(0, 4);
+}
+
+/*
+ * Setup
+ */
+
+int recordSuiteSetup(void) {
+  CU_pSuite pSuite = CU_add_suite("record", mockContextSuiteInit, mockContextSuiteClean);
+  if (!pSuite) {
+    return CU_get_error();
+  }
+
+  if ( //
+      (!CU_add_test(pSuite, "nmeaRecordFromInfo", test_nmeaRecordFromInfo)) //
+      || (!CU_add_test(pSuite, "nmeaRecordWriter", test_nmeaRecordWriter)) //
+      ) {
+    return CU_get_error();
+  }
+
+  return CUE_SUCCESS;
+}
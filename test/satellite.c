@@ -0,0 +1,308 @@
+/*
+ * This file is part of nmealib.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "testHelpers.h"
+
+#include <nmealib/satellite.h>
+#include <CUnit/Basic.h>
+#include <stddef.h>
+#include <string.h>
+
+int satelliteSuiteSetup(void);
+
+/*
+ * Tests
+ */
+
+static void test_nmeaSatelliteNmeaPrn(void) {
+  NmeaConstellation constellation;
+  unsigned int prn;
+  bool r;
+
+  /* invalid inputs */
+
+  r = nmeaSatelliteFromNmeaPrn(1, NULL, &prn);
+  CU_ASSERT_EQUAL(r, false);
+  r = nmeaSatelliteFromNmeaPrn(1, &constellation, NULL);
+  CU_ASSERT_EQUAL(r, false);
+  r = nmeaSatelliteFromNmeaPrn(0, &constellation, &prn);
+  CU_ASSERT_EQUAL(r, false);
+  r = nmeaSatelliteFromNmeaPrn(97, &constellation, &prn);
+  CU_ASSERT_EQUAL(r, false);
+  r = nmeaSatelliteFromNmeaPrn(203, &constellation, &prn);
+  CU_ASSERT_EQUAL(r, false);
+
+  CU_ASSERT_EQUAL(nmeaSatelliteToNmeaPrn(NMEALIB_CONSTELLATION_GPS, 0), 0);
+  CU_ASSERT_EQUAL(nmeaSatelliteToNmeaPrn(NMEALIB_CONSTELLATION_GPS, 33), 0);
+  CU_ASSERT_EQUAL(nmeaSatelliteToNmeaPrn(NMEALIB_CONSTELLATION_QZSS, 11), 0);
+  CU_ASSERT_EQUAL(nmeaSatelliteToNmeaPrn((NmeaConstellation) NMEALIB_CONSTELLATIONS, 1), 0);
+
+  /* normal */
+
+  r = nmeaSatelliteFromNmeaPrn(32, &constellation, &prn);
+  CU_ASSERT_EQUAL(r, true);
+  CU_ASSERT_EQUAL(constellation, NMEALIB_CONSTELLATION_GPS);
+  CU_ASSERT_EQUAL(prn, 32);
+
+  r = nmeaSatelliteFromNmeaPrn(33, &constellation, &prn);
+  CU_ASSERT_EQUAL(r, true);
+  CU_ASSERT_EQUAL(constellation, NMEALIB_CONSTELLATION_SBAS);
+  CU_ASSERT_EQUAL(prn, 1);
+
+  r = nmeaSatelliteFromNmeaPrn(70, &constellation, &prn);
+  CU_ASSERT_EQUAL(r, true);
+  CU_ASSERT_EQUAL(constellation, NMEALIB_CONSTELLATION_GLONASS);
+  CU_ASSERT_EQUAL(prn, 6);
+
+  r = nmeaSatelliteFromNmeaPrn(464, &constellation, &prn);
+  CU_ASSERT_EQUAL(r, true);
+  CU_ASSERT_EQUAL(constellation, NMEALIB_CONSTELLATION_BEIDOU);
+  CU_ASSERT_EQUAL(prn, 64);
+
+  for (prn = 1; prn <= 500; prn++) {
+    unsigned int p;
+
+    if (nmeaSatelliteFromNmeaPrn(prn, &constellation, &p)) {
+      CU_ASSERT_EQUAL(nmeaSatelliteToNmeaPrn(constellation, p), prn);
+    }
+  }
+
+  validateContext(0, 0);
+}
+
+static void test_nmeaSatelliteStore(void) {
+  NmeaSatelliteStore store;
+  NmeaSatellite sat;
+  const NmeaSatellite *got;
+  NmeaConstellation constellation;
+  unsigned int prn;
+  bool r;
+
+  memset(&store, 0xaa, sizeof(store));
+  memset(&sat, 0, sizeof(sat));
+
+  /* invalid inputs */
+
+  nmeaSatelliteStoreClear(NULL);
+  nmeaSatelliteStoreClear(&store);
+  CU_ASSERT_EQUAL(nmeaSatelliteStoreCount(NULL), 0);
+  CU_ASSERT_EQUAL(nmeaSatelliteStoreCount(&store), 0);
+
+  r = nmeaSatelliteStoreSet(NULL, NMEALIB_CONSTELLATION_GPS, 1, &sat);
+  CU_ASSERT_EQUAL(r, false);
+  r = nmeaSatelliteStoreSet(&store, NMEALIB_CONSTELLATION_GPS, 1, NULL);
+  CU_ASSERT_EQUAL(r, false);
+  r = nmeaSatelliteStoreSet(&store, NMEALIB_CONSTELLATION_GPS, 0, &sat);
+  CU_ASSERT_EQUAL(r, false);
+  r = nmeaSatelliteStoreSet(&store, NMEALIB_CONSTELLATION_GPS, NMEALIB_SATELLITE_STORE_PRNS + 1, &sat);
+  CU_ASSERT_EQUAL(r, false);
+  r = nmeaSatelliteStoreSet(&store, (NmeaConstellation) NMEALIB_CONSTELLATIONS, 1, &sat);
+  CU_ASSERT_EQUAL(r, false);
+
+  CU_ASSERT_PTR_NULL(nmeaSatelliteStoreGet(NULL, NMEALIB_CONSTELLATION_GPS, 1));
+  CU_ASSERT_PTR_NULL(nmeaSatelliteStoreGet(&store, NMEALIB_CONSTELLATION_GPS, 1));
+  CU_ASSERT_EQUAL(nmeaSatelliteStoreRemove(NULL, NMEALIB_CONSTELLATION_GPS, 1), false);
+  CU_ASSERT_EQUAL(nmeaSatelliteStoreRemove(&store, NMEALIB_CONSTELLATION_GPS, 1), false);
+  CU_ASSERT_EQUAL(nmeaSatelliteStoreSetInUse(NULL, NMEALIB_CONSTELLATION_GPS, 1, true), false);
+  CU_ASSERT_EQUAL(nmeaSatelliteStoreIsInUse(NULL, NMEALIB_CONSTELLATION_GPS, 1), false);
+
+  constellation = NMEALIB_CONSTELLATION_FIRST;
+  prn = 0;
+  CU_ASSERT_PTR_NULL(nmeaSatelliteStoreNext(NULL, &constellation, &prn));
+  CU_ASSERT_PTR_NULL(nmeaSatelliteStoreNext(&store, NULL, &prn));
+  CU_ASSERT_PTR_NULL(nmeaSatelliteStoreNext(&store, &constellation, NULL));
+  CU_ASSERT_PTR_NULL(nmeaSatelliteStoreNext(&store, &constellation, &prn));
+
+  /* normal, inserted out of order */
+
+  sat.prn = 999;
+  sat.elevation = 45;
+  sat.azimuth = 180;
+  sat.snr = 40;
+  r = nmeaSatelliteStoreSet(&store, NMEALIB_CONSTELLATION_GALILEO, 64, &sat);
+  CU_ASSERT_EQUAL(r, true);
+  sat.snr = 41;
+  r = nmeaSatelliteStoreSet(&store, NMEALIB_CONSTELLATION_GPS, 12, &sat);
+  CU_ASSERT_EQUAL(r, true);
+  sat.snr = 42;
+  r = nmeaSatelliteStoreSet(&store, NMEALIB_CONSTELLATION_GPS, 1, &sat);
+  CU_ASSERT_EQUAL(r, true);
+  sat.snr = 43;
+  r = nmeaSatelliteStoreSet(&store, NMEALIB_CONSTELLATION_GLONASS, 3, &sat);
+  CU_ASSERT_EQUAL(r, true);
+  CU_ASSERT_EQUAL(nmeaSatelliteStoreCount(&store), 4);
+
+  /* update */
+  sat.snr = 44;
+  r = nmeaSatelliteStoreSet(&store, NMEALIB_CONSTELLATION_GPS, 12, &sat);
+  CU_ASSERT_EQUAL(r, true);
+  CU_ASSERT_EQUAL(nmeaSatelliteStoreCount(&store), 4);
+
+  got = nmeaSatelliteStoreGet(&store, NMEALIB_CONSTELLATION_GPS, 12);
+  CU_ASSERT_PTR_NOT_NULL_FATAL(got);
+  CU_ASSERT_EQUAL(got->prn, 12);
+  CU_ASSERT_EQUAL(got->elevation, 45);
+  CU_ASSERT_EQUAL(got->azimuth, 180);
+  CU_ASSERT_EQUAL(got->snr, 44);
+  CU_ASSERT_PTR_NULL(nmeaSatelliteStoreGet(&store, NMEALIB_CONSTELLATION_SBAS, 12));
+
+  /* iteration is sorted */
+
+  constellation = NMEALIB_CONSTELLATION_FIRST;
+  prn = 0;
+  got = nmeaSatelliteStoreNext(&store, &constellation, &prn);
+  CU_ASSERT_PTR_NOT_NULL(got);
+  CU_ASSERT_EQUAL(constellation, NMEALIB_CONSTELLATION_GPS);
+  CU_ASSERT_EQUAL(prn, 1);
+  got = nmeaSatelliteStoreNext(&store, &constellation, &prn);
+  CU_ASSERT_PTR_NOT_NULL(got);
+  CU_ASSERT_EQUAL(constellation, NMEALIB_CONSTELLATION_GPS);
+  CU_ASSERT_EQUAL(prn, 12);
+  got = nmeaSatelliteStoreNext(&store, &constellation, &prn);
+  CU_ASSERT_PTR_NOT_NULL(got);
+  CU_ASSERT_EQUAL(constellation, NMEALIB_CONSTELLATION_GLONASS);
+  CU_ASSERT_EQUAL(prn, 3);
+  got = nmeaSatelliteStoreNext(&store, &constellation, &prn);
+  CU_ASSERT_PTR_NOT_NULL(got);
+  CU_ASSERT_EQUAL(constellation, NMEALIB_CONSTELLATION_GALILEO);
+  CU_ASSERT_EQUAL(prn, 64);
+  got = nmeaSatelliteStoreNext(&store, &constellation, &prn);
+  CU_ASSERT_PTR_NULL(got);
+
+  /* in use */
+
+  r = nmeaSatelliteStoreSetInUse(&store, NMEALIB_CONSTELLATION_GPS, 12, true);
+  CU_ASSERT_EQUAL(r, true);
+  CU_ASSERT_EQUAL(nmeaSatelliteStoreIsInUse(&store, NMEALIB_CONSTELLATION_GPS, 12), true);
+  CU_ASSERT_EQUAL(nmeaSatelliteStoreIsInUse(&store, NMEALIB_CONSTELLATION_GPS, 1), false);
+  r = nmeaSatelliteStoreSetInUse(&store, NMEALIB_CONSTELLATION_GPS, 12, false);
+  CU_ASSERT_EQUAL(r, true);
+  CU_ASSERT_EQUAL(nmeaSatelliteStoreIsInUse(&store, NMEALIB_CONSTELLATION_GPS, 12), false);
+
+  /* remove */
+
+  r = nmeaSatelliteStoreSetInUse(&store, NMEALIB_CONSTELLATION_GPS, 12, true);
+  CU_ASSERT_EQUAL(r, true);
+  r = nmeaSatelliteStoreRemove(&store, NMEALIB_CONSTELLATION_GPS, 12);
+  CU_ASSERT_EQUAL(r, true);
+  CU_ASSERT_EQUAL(nmeaSatelliteStoreIsInUse(&store, NMEALIB_CONSTELLATION_GPS, 12), false);
+  CU_ASSERT_PTR_NULL(nmeaSatelliteStoreGet(&store, NMEALIB_CONSTELLATION_GPS, 12));
+  CU_ASSERT_EQUAL(nmeaSatelliteStoreCount(&store), 3);
+  r = nmeaSatelliteStoreRemove(&store, NMEALIB_CONSTELLATION_GPS, 12);
+  CU_ASSERT_EQUAL(r, false);
+
+  validateContext(0, 0);
+}
+
+static void test_nmeaSatelliteStoreInfo(void) {
+  NmeaSatelliteStore store;
+  NmeaSatellite snapshot[NMEALIB_MAX_SATELLITES];
+  NmeaInfo info;
+  unsigned int count;
+  uint32_t sequence;
+  size_t r;
+
+  memset(&store, 0, sizeof(store));
+  memset(&info, 0, sizeof(info));
+
+  /* invalid inputs */
+
+  r = nmeaSatelliteStoreFromInfo(NULL, &info);
+  CU_ASSERT_EQUAL(r, 0);
+  r = nmeaSatelliteStoreFromInfo(&store, NULL);
+  CU_ASSERT_EQUAL(r, 0);
+  nmeaSatelliteStoreToInfo(NULL, &info);
+  nmeaSatelliteStoreToInfo(&store, NULL);
+  CU_ASSERT_EQUAL(info.present, 0);
+
+  /* nothing present */
+
+  info.satellites.inView[0].prn = 5;
+  info.satellites.inUse[0] = 5;
+  r = nmeaSatelliteStoreFromInfo(&store, &info);
+  CU_ASSERT_EQUAL(r, 0);
+  CU_ASSERT_EQUAL(nmeaSatelliteStoreCount(&store), 0);
+
+  /* normal, with gaps, unsorted and with an unmapped PRN */
+
+  memset(&info, 0, sizeof(info));
+  nmeaInfoSetPresent(&info.present, NMEALIB_PRESENT_SATINVIEW);
+  nmeaInfoSetPresent(&info.present, NMEALIB_PRESENT_SATINUSE);
+  info.satellites.inView[0].prn = 301;
+  info.satellites.inView[0].snr = 30;
+  info.satellites.inView[2].prn = 65;
+  info.satellites.inView[2].snr = 31;
+  info.satellites.inView[3].prn = 150;
+  info.satellites.inView[5].prn = 7;
+  info.satellites.inView[5].elevation = 12;
+  info.satellites.inView[5].azimuth = 123;
+  info.satellites.inView[5].snr = 32;
+  info.satellites.inUse[1] = 301;
+  info.satellites.inUse[4] = 7;
+  info.satellites.inUse[6] = 1000;
+
+  r = nmeaSatelliteStoreFromInfo(&store, &info);
+  CU_ASSERT_EQUAL(r, 2);
+  CU_ASSERT_EQUAL(nmeaSatelliteStoreCount(&store), 3);
+  CU_ASSERT_EQUAL(nmeaSatelliteStoreIsInUse(&store, NMEALIB_CONSTELLATION_GPS, 7), true);
+  CU_ASSERT_EQUAL(nmeaSatelliteStoreIsInUse(&store, NMEALIB_CONSTELLATION_GALILEO, 1), true);
+  CU_ASSERT_EQUAL(nmeaSatelliteStoreIsInUse(&store, NMEALIB_CONSTELLATION_GLONASS, 1), false);
+
+  memset(&info, 0xaa, sizeof(info));
+  info.present = 0;
+  sequence = nmeaInfoSatellitesInViewSnapshot(&info, snapshot, NULL);
+  nmeaSatelliteStoreToInfo(&store, &info);
+  CU_ASSERT_EQUAL(info.present, NMEALIB_PRESENT_SATINVIEW | NMEALIB_PRESENT_SATINUSE);
+  CU_ASSERT_EQUAL(nmeaInfoSatellitesInViewSnapshot(&info, snapshot, &count), sequence + 2);
+  CU_ASSERT_EQUAL(count, 0xaaaaaaaa);
+  CU_ASSERT_EQUAL(memcmp(snapshot, info.satellites.inView, sizeof(snapshot)), 0);
+  CU_ASSERT_EQUAL(info.satellites.inView[0].prn, 7);
+  CU_ASSERT_EQUAL(info.satellites.inView[0].elevation, 12);
+  CU_ASSERT_EQUAL(info.satellites.inView[0].azimuth, 123);
+  CU_ASSERT_EQUAL(info.satellites.inView[0].snr, 32);
+  CU_ASSERT_EQUAL(info.satellites.inView[1].prn, 65);
+  CU_ASSERT_EQUAL(info.satellites.inView[1].snr, 31);
+  CU_ASSERT_EQUAL(info.satellites.inView[2].prn, 301);
+  CU_ASSERT_EQUAL(info.satellites.inView[2].snr, 30);
+  CU_ASSERT_EQUAL(info.satellites.inView[3].prn, 0);
+  CU_ASSERT_EQUAL(info.satellites.inUse[0], 7);
+  CU_ASSERT_EQUAL(info.satellites.inUse[1], 301);
+  CU_ASSERT_EQUAL(info.satellites.inUse[2], 0);
+
+  validateContext(0, 0);
+}
+
+/*
+ * Setup
+ */
+
+int satelliteSuiteSetup(void) {
+  CU_pSuite pSuite = CU_add_suite("satellite", mockContextSuiteInit, mockContextSuiteClean);
+  if (!pSuite) {
+    return CU_get_error();
+  }
+
+  if ( //
+      (!CU_add_test(pSuite, "nmeaSatelliteNmeaPrn", test_nmeaSatelliteNmeaPrn)) //
+      || (!CU_add_test(pSuite, "nmeaSatelliteStore", test_nmeaSatelliteStore)) //
+      || (!CU_add_test(pSuite, "nmeaSatelliteStoreInfo", test_nmeaSatelliteStoreInfo)) //
+      ) {
+    return CU_get_error();
+  }
+
+  return CUE_SUCCESS;
+}
@@ -20,7 +20,9 @@
 #include <nmealib/sentence.h>
 #include <CUnit/Basic.h>
 #include <float.h>
+#include <limits.h>
 #include <stdlib.h>
+#include <string.h>
 
 int sentenceSuiteSetup(void);
 
@@ -133,7 +135,7 @@ static void test_nmeaSentenceToInfo(void) {
 
   /* NULL sentence */
 
-  r = nmeaSentenceToInfo(NULL, 1, &info);
+  r = nmeaSentenceToInfo(NULL, 1, &info, NULL);
   CU_ASSERT_EQUAL(r, false);
   validatePackToInfo(&info, 0, 0, true);
   memset(&info, 0, sizeof(info));
@@ -141,7 +143,7 @@ static void test_nmeaSentenceToInfo(void) {
   /* invalid sentence */
 
   s = "$GPXXX,blah";
-  r = nmeaSentenceToInfo(s, strlen(s), &info);
+  r = nmeaSentenceToInfo(s, strlen(s), &info, NULL);
   CU_ASSERT_EQUAL(r, false);
   validatePackToInfo(&info, 0, 0, true);
   memset(&info, 0, sizeof(info));
@@ -149,13 +151,13 @@ static void test_nmeaSentenceToInfo(void) {
   /* GPGGA */
 
   s = "$GPGGA,invalid";
-  r = nmeaSentenceToInfo(s, strlen(s), &info);
+  r = nmeaSentenceToInfo(s, strlen(s), &info, NULL);
   CU_ASSERT_EQUAL(r, false);
   validatePackToInfo(&info, 1, 1, true);
   memset(&info, 0, sizeof(info));
 
   s = "$GPGGA,104559.64,,,,,,,,,,,,,";
-  r = nmeaSentenceToInfo(s, strlen(s), &info);
+  r = nmeaSentenceToInfo(s, strlen(s), &info, NULL);
   CU_ASSERT_EQUAL(r, true);
   validatePackToInfo(&info, 1, 0, false);
   CU_ASSERT_EQUAL(info.present, NMEALIB_PRESENT_UTCTIME | NMEALIB_PRESENT_SMASK);
@@ -169,13 +171,13 @@ static void test_nmeaSentenceToInfo(void) {
   /* GPGSA */
 
   s = "$GPGSA,invalid";
-  r = nmeaSentenceToInfo(s, strlen(s), &info);
+  r = nmeaSentenceToInfo(s, strlen(s), &info, NULL);
   CU_ASSERT_EQUAL(r, false);
   validatePackToInfo(&info, 1, 1, true);
   memset(&info, 0, sizeof(info));
 
   s = "$GPGSA,,3,,,,,,,,,,,,,,,";
-  r = nmeaSentenceToInfo(s, strlen(s), &info);
+  r = nmeaSentenceToInfo(s, strlen(s), &info, NULL);
   CU_ASSERT_EQUAL(r, true);
   validatePackToInfo(&info, 1, 0, false);
   CU_ASSERT_EQUAL(info.present, NMEALIB_PRESENT_FIX | NMEALIB_PRESENT_SMASK);
@@ -186,13 +188,13 @@ static void test_nmeaSentenceToInfo(void) {
   /* GPGSV */
 
   s = "$GPGSV,invalid";
-  r = nmeaSentenceToInfo(s, strlen(s), &info);
+  r = nmeaSentenceToInfo(s, strlen(s), &info, NULL);
   CU_ASSERT_EQUAL(r, false);
   validatePackToInfo(&info, 1, 1, true);
   memset(&info, 0, sizeof(info));
 
   s = "$GPGSV,1,1,4,11,,,45,,,,,12,13,,,,,,";
-  r = nmeaSentenceToInfo(s, strlen(s), &info);
+  r = nmeaSentenceToInfo(s, strlen(s), &info, NULL);
   CU_ASSERT_EQUAL(r, true);
   validatePackToInfo(&info, 1, 0, false);
   CU_ASSERT_EQUAL(info.present, NMEALIB_PRESENT_SATINVIEWCOUNT | NMEALIB_PRESENT_SATINVIEW | NMEALIB_PRESENT_SMASK);
@@ -213,13 +215,13 @@ static void test_nmeaSentenceToInfo(void) {
   /* GPRMC */
 
   s = "$GPRMC,invalid";
-  r = nmeaSentenceToInfo(s, strlen(s), &info);
+  r = nmeaSentenceToInfo(s, strlen(s), &info, NULL);
   CU_ASSERT_EQUAL(r, false);
   validatePackToInfo(&info, 1, 1, true);
   memset(&info, 0, sizeof(info));
 
   s = "$GPRMC,104559.64,,,,,,,,,,,";
-  r = nmeaSentenceToInfo(s, strlen(s), &info);
+  r = nmeaSentenceToInfo(s, strlen(s), &info, NULL);
   CU_ASSERT_EQUAL(r, true);
   validatePackToInfo(&info, 1, 0, false);
   CU_ASSERT_EQUAL(info.present, NMEALIB_PRESENT_UTCTIME | NMEALIB_PRESENT_SMASK);
@@ -233,13 +235,13 @@ static void test_nmeaSentenceToInfo(void) {
   /* GPVTG */
 
   s = "$GPVTG,1,q";
-  r = nmeaSentenceToInfo(s, strlen(s), &info);
+  r = nmeaSentenceToInfo(s, strlen(s), &info, NULL);
   CU_ASSERT_EQUAL(r, false);
   validatePackToInfo(&info, 1, 1, true);
   memset(&info, 0, sizeof(info));
 
   s = "$GPVTG,,,,,,,4.25,k";
-  r = nmeaSentenceToInfo(s, strlen(s), &info);
+  r = nmeaSentenceToInfo(s, strlen(s), &info, NULL);
   CU_ASSERT_EQUAL(r, true);
   validatePackToInfo(&info, 1, 0, false);
   CU_ASSERT_EQUAL(info.present, NMEALIB_PRESENT_SPEED | NMEALIB_PRESENT_SMASK);
@@ -248,6 +250,77 @@ static void test_nmeaSentenceToInfo(void) {
   memset(&info, 0, sizeof(info));
 }
 
+static void test_nmeaSentenceParse(void) {
+  NmeaSentencePack pack;
+  NmeaInfo info;
+  NmeaTime utc;
+  const char *s;
+  bool dated;
+  bool r;
+
+  memset(&pack, 0xaa, sizeof(pack));
+  memset(&info, 0, sizeof(info));
+
+  /* invalid inputs */
+
+  s = "$GPRMC,104559.64,,,,,,,,,,,";
+  r = nmeaSentenceParse(s, strlen(s), NULL);
+  CU_ASSERT_EQUAL(r, false);
+  CU_ASSERT_EQUAL(nmeaSentencePackUtc(NULL, &utc, NULL), false);
+  CU_ASSERT_EQUAL(nmeaSentencePackUtc(&pack, NULL, NULL), false);
+  CU_ASSERT_EQUAL(nmeaSentencePackToInfo(NULL, &info, NULL), 0);
+
+  s = "$GPXXX,blah";
+  r = nmeaSentenceParse(s, strlen(s), &pack);
+  CU_ASSERT_EQUAL(r, false);
+  CU_ASSERT_EQUAL(pack.sentence, NMEALIB_SENTENCE_GPNON);
+  CU_ASSERT_EQUAL(nmeaSentencePackUtc(&pack, &utc, NULL), false);
+  CU_ASSERT_EQUAL(nmeaSentencePackToInfo(&pack, &info, NULL), 0);
+
+  s = "$GPGGA,invalid";
+  r = nmeaSentenceParse(s, strlen(s), &pack);
+  CU_ASSERT_EQUAL(r, false);
+  CU_ASSERT_EQUAL(pack.sentence, NMEALIB_SENTENCE_GPNON);
+  validateContext(1, 1);
+
+  /* a sentence without UTC */
+
+  s = "$GPGSA,,3,,,,,,,,,,,,,,,";
+  r = nmeaSentenceParse(s, strlen(s), &pack);
+  CU_ASSERT_EQUAL(r, true);
+  CU_ASSERT_EQUAL(pack.sentence, NMEALIB_SENTENCE_GPGSA);
+  CU_ASSERT_EQUAL(nmeaSentencePackUtc(&pack, &utc, NULL), false);
+
+  /* UTC time without and with date */
+
+  s = "$GPGGA,104559.64,,,,,,,,,,,,,";
+  r = nmeaSentenceParse(s, strlen(s), &pack);
+  CU_ASSERT_EQUAL(r, true);
+  CU_ASSERT_EQUAL(pack.sentence, NMEALIB_SENTENCE_GPGGA);
+  dated = true;
+  CU_ASSERT_EQUAL(nmeaSentencePackUtc(&pack, &utc, &dated), true);
+  CU_ASSERT_EQUAL(dated, false);
+  CU_ASSERT_EQUAL(utc.hour, 10);
+  CU_ASSERT_EQUAL(utc.hsec, 64);
+
+  s = "$GPRMC,104559.64,A,,,,,,,150317,,";
+  r = nmeaSentenceParse(s, strlen(s), &pack);
+  CU_ASSERT_EQUAL(r, true);
+  CU_ASSERT_EQUAL(pack.sentence, NMEALIB_SENTENCE_GPRMC);
+  CU_ASSERT_EQUAL(nmeaSentencePackUtc(&pack, &utc, &dated), true);
+  CU_ASSERT_EQUAL(dated, true);
+  CU_ASSERT_EQUAL(utc.year, 2017);
+  CU_ASSERT_EQUAL(utc.sec, 59);
+
+  /* to info */
+
+  r = nmeaSentencePackToInfo(&pack, &info, NULL) != 0;
+  CU_ASSERT_EQUAL(r, true);
+  CU_ASSERT_EQUAL(info.smask, NMEALIB_SENTENCE_GPRMC);
+  CU_ASSERT_EQUAL(info.utc.year, 2017);
+  validateContext(3, 0);
+}
+
 static void test_nmeaSentenceFromInfo(void) {
   size_t r;
   NmeaInfo infoEmpty;
@@ -401,6 +474,263 @@ static void test_nmeaSentenceFromInfo(void) {
   buf.bufferSize = 0;
 }
 
+static void test_nmeaSentenceFromInfoLengthMax(void) {
+  size_t r;
+  size_t i;
+  NmeaInfo info;
+  NmeaMallocedBuffer buf;
+
+  memset(&info, 0, sizeof(info));
+
+  /* invalid inputs */
+
+  r = nmeaSentenceFromInfoLengthMax(NULL, NMEALIB_SENTENCE_GPGGA);
+  CU_ASSERT_EQUAL(r, 0);
+
+  r = nmeaSentenceFromInfoLengthMax(&info, 0);
+  CU_ASSERT_EQUAL(r, 0);
+
+  r = nmeaSentenceFromInfoLengthMax(&info, NMEALIB_SENTENCE_LAST << 1);
+  CU_ASSERT_EQUAL(r, 0);
+
+  /* per sentence */
+
+  r = nmeaSentenceFromInfoLengthMax(&info, NMEALIB_SENTENCE_GPGGA);
+  CU_ASSERT_EQUAL(r, NMEALIB_GPGGA_GENERATE_LENGTH_MAX);
+
+  r = nmeaSentenceFromInfoLengthMax(&info, NMEALIB_SENTENCE_GPGSA);
+  CU_ASSERT_EQUAL(r, NMEALIB_GPGSA_GENERATE_LENGTH_MAX);
+
+  r = nmeaSentenceFromInfoLengthMax(&info, NMEALIB_SENTENCE_GPGSV);
+  CU_ASSERT_EQUAL(r, NMEALIB_GPGSV_GENERATE_LENGTH_MAX);
+
+  r = nmeaSentenceFromInfoLengthMax(&info, NMEALIB_SENTENCE_GPRMC);
+  CU_ASSERT_EQUAL(r, NMEALIB_GPRMC_GENERATE_LENGTH_MAX);
+
+  r = nmeaSentenceFromInfoLengthMax(&info, NMEALIB_SENTENCE_GPVTG);
+  CU_ASSERT_EQUAL(r, NMEALIB_GPVTG_GENERATE_LENGTH_MAX);
+
+  /* GPGSV depends on the number of satellites in view */
+
+  info.satellites.inViewCount = 9;
+  r = nmeaSentenceFromInfoLengthMax(&info, NMEALIB_SENTENCE_GPGSV);
+  CU_ASSERT_EQUAL(r, NMEALIB_GPGSV_GENERATE_LENGTH_MAX);
+
+  nmeaInfoSetPresent(&info.present, NMEALIB_PRESENT_SATINVIEWCOUNT);
+  r = nmeaSentenceFromInfoLengthMax(&info, NMEALIB_SENTENCE_GPGSV);
+  CU_ASSERT_EQUAL(r, 3 * NMEALIB_GPGSV_GENERATE_LENGTH_MAX);
+
+  r = nmeaSentenceFromInfoLengthMax(&info, NMEALIB_SENTENCE_MASK);
+  CU_ASSERT_EQUAL(r, NMEALIB_GPGGA_GENERATE_LENGTH_MAX //
+      + NMEALIB_GPGSA_GENERATE_LENGTH_MAX //
+      + (3 * NMEALIB_GPGSV_GENERATE_LENGTH_MAX) //
+      + NMEALIB_GPRMC_GENERATE_LENGTH_MAX //
+      + NMEALIB_GPVTG_GENERATE_LENGTH_MAX);
+
+  /* the bound holds for extreme values */
+
+  memset(&info, 0, sizeof(info));
+  info.present = NMEALIB_INFO_PRESENT_MASK;
+  info.smask = NMEALIB_SENTENCE_MASK;
+  info.utc.year = UINT_MAX;
+  info.utc.mon = UINT_MAX;
+  info.utc.day = UINT_MAX;
+  info.utc.hour = UINT_MAX;
+  info.utc.min = UINT_MAX;
+  info.utc.sec = UINT_MAX;
+  info.utc.hsec = UINT_MAX;
+  info.sig = NMEALIB_SIG_LAST;
+  info.fix = INT_MIN;
+  info.pdop = -DBL_MAX;
+  info.hdop = -DBL_MAX;
+  info.vdop = -DBL_MAX;
+  info.latitude = -DBL_MAX;
+  info.longitude = -DBL_MAX;
+  info.elevation = -DBL_MAX;
+  info.height = -DBL_MAX;
+  info.speed = -DBL_MAX;
+  info.track = -DBL_MAX;
+  info.mtrack = -DBL_MAX;
+  info.magvar = -DBL_MAX;
+  info.dgpsAge = -DBL_MAX;
+  info.dgpsSid = UINT_MAX;
+  info.satellites.inUseCount = NMEALIB_MAX_SATELLITES;
+  info.satellites.inViewCount = NMEALIB_MAX_SATELLITES;
+  for (i = 0; i < NMEALIB_MAX_SATELLITES; i++) {
+    info.satellites.inUse[i] = UINT_MAX;
+    info.satellites.inView[i].prn = UINT_MAX;
+    info.satellites.inView[i].elevation = INT_MIN;
+    info.satellites.inView[i].azimuth = UINT_MAX;
+    info.satellites.inView[i].snr = UINT_MAX;
+  }
+
+  buf.buffer = NULL;
+  buf.bufferSize = 0;
+  r = nmeaSentenceFromInfo(&buf, &info, NMEALIB_SENTENCE_MASK);
+  CU_ASSERT_PTR_NOT_NULL_FATAL(buf.buffer);
+  CU_ASSERT_NOT_EQUAL(r, 0);
+  CU_ASSERT_EQUAL(r, strlen(buf.buffer));
+  CU_ASSERT(r <= nmeaSentenceFromInfoLengthMax(&info, NMEALIB_SENTENCE_MASK));
+  CU_ASSERT(buf.bufferSize > nmeaSentenceFromInfoLengthMax(&info, NMEALIB_SENTENCE_MASK));
+  CU_ASSERT_EQUAL(buf.bufferSize % NMEALIB_BUFFER_CHUNK_SIZE, 0);
+  validateContext(0, 0);
+
+  free(buf.buffer);
+}
+
+static void test_nmeaSentenceFromInfoFixed(void) {
+  size_t r;
+  NmeaInfo info;
+  char buf[128];
+
+  memset(&info, 0, sizeof(info));
+
+  /* invalid inputs */
+
+  r = nmeaSentenceFromInfoFixed(NULL, sizeof(buf), &info, NMEALIB_SENTENCE_GPGGA);
+  CU_ASSERT_EQUAL(r, 0);
+  validateContext(0, 0);
+
+  r = nmeaSentenceFromInfoFixed(buf, 0, &info, NMEALIB_SENTENCE_GPGGA);
+  CU_ASSERT_EQUAL(r, 0);
+  validateContext(0, 0);
+
+  r = nmeaSentenceFromInfoFixed(buf, sizeof(buf), NULL, NMEALIB_SENTENCE_GPGGA);
+  CU_ASSERT_EQUAL(r, 0);
+  validateContext(0, 0);
+
+  r = nmeaSentenceFromInfoFixed(buf, sizeof(buf), &info, 0);
+  CU_ASSERT_EQUAL(r, 0);
+  validateContext(0, 0);
+
+  /* all sentences fit */
+
+  info.utc.hour = 12;
+  info.utc.min = 22;
+  info.utc.sec = 32;
+  info.utc.hsec = 42;
+  info.speed = 42.43;
+  nmeaInfoSetPresent(&info.present, NMEALIB_PRESENT_UTCTIME | NMEALIB_PRESENT_SPEED);
+  r = nmeaSentenceFromInfoFixed(buf, sizeof(buf), &info, NMEALIB_SENTENCE_GPGGA | NMEALIB_SENTENCE_GPVTG);
+  CU_ASSERT_EQUAL(r, 63);
+  CU_ASSERT_STRING_EQUAL(buf, "$GPGGA,122232.42,,,,,,,,,,,,,*7C\r\n$GPVTG,,,,,22.9,N,42.4,K*5C\r\n");
+  validateContext(0, 0);
+
+  /* exact fit (including the null-terminator) */
+
+  r = nmeaSentenceFromInfoFixed(buf, 64, &info, NMEALIB_SENTENCE_GPGGA | NMEALIB_SENTENCE_GPVTG);
+  CU_ASSERT_EQUAL(r, 63);
+  CU_ASSERT_STRING_EQUAL(buf, "$GPGGA,122232.42,,,,,,,,,,,,,*7C\r\n$GPVTG,,,,,22.9,N,42.4,K*5C\r\n");
+  validateContext(0, 0);
+
+  /* the last sentence does not fit */
+
+  r = nmeaSentenceFromInfoFixed(buf, 63, &info, NMEALIB_SENTENCE_GPGGA | NMEALIB_SENTENCE_GPVTG);
+  CU_ASSERT_EQUAL(r, 34);
+  CU_ASSERT_STRING_EQUAL(buf, "$GPGGA,122232.42,,,,,,,,,,,,,*7C\r\n");
+  validateContext(0, 0);
+
+  /* no sentence fits */
+
+  r = nmeaSentenceFromInfoFixed(buf, 10, &info, NMEALIB_SENTENCE_GPGGA | NMEALIB_SENTENCE_GPVTG);
+  CU_ASSERT_EQUAL(r, 0);
+  CU_ASSERT_STRING_EQUAL(buf, "");
+  validateContext(0, 0);
+
+  /* invalid mask */
+
+  r = nmeaSentenceFromInfoFixed(buf, sizeof(buf), &info, NMEALIB_SENTENCE_LAST << 1);
+  CU_ASSERT_EQUAL(r, 0);
+  CU_ASSERT_STRING_EQUAL(buf, "");
+  validateContext(0, 0);
+}
+
+static void test_nmeaSentenceFromInfoVector(void) {
+  size_t r;
+  NmeaInfo info;
+  char buf[256];
+  struct iovec iov[4];
+
+  memset(&info, 0, sizeof(info));
+  memset(iov, 0, sizeof(iov));
+
+  /* invalid inputs */
+
+  r = nmeaSentenceFromInfoVector(NULL, sizeof(buf), iov, 4, &info, NMEALIB_SENTENCE_GPGGA);
+  CU_ASSERT_EQUAL(r, 0);
+  validateContext(0, 0);
+
+  r = nmeaSentenceFromInfoVector(buf, 0, iov, 4, &info, NMEALIB_SENTENCE_GPGGA);
+  CU_ASSERT_EQUAL(r, 0);
+  validateContext(0, 0);
+
+  r = nmeaSentenceFromInfoVector(buf, sizeof(buf), NULL, 4, &info, NMEALIB_SENTENCE_GPGGA);
+  CU_ASSERT_EQUAL(r, 0);
+  validateContext(0, 0);
+
+  r = nmeaSentenceFromInfoVector(buf, sizeof(buf), iov, 0, &info, NMEALIB_SENTENCE_GPGGA);
+  CU_ASSERT_EQUAL(r, 0);
+  validateContext(0, 0);
+
+  r = nmeaSentenceFromInfoVector(buf, sizeof(buf), iov, 4, NULL, NMEALIB_SENTENCE_GPGGA);
+  CU_ASSERT_EQUAL(r, 0);
+  validateContext(0, 0);
+
+  r = nmeaSentenceFromInfoVector(buf, sizeof(buf), iov, 4, &info, 0);
+  CU_ASSERT_EQUAL(r, 0);
+  validateContext(0, 0);
+
+  /* one entry per sentence, GPGSV generates 2 sentences */
+
+  info.utc.hour = 12;
+  info.utc.min = 22;
+  info.utc.sec = 32;
+  info.utc.hsec = 42;
+  info.speed = 42.43;
+  info.satellites.inViewCount = 5;
+  nmeaInfoSetPresent(&info.present, NMEALIB_PRESENT_UTCTIME | NMEALIB_PRESENT_SPEED);
+  nmeaInfoSetPresent(&info.present, NMEALIB_PRESENT_SATINVIEWCOUNT | NMEALIB_PRESENT_SATINVIEW);
+  r = nmeaSentenceFromInfoVector(buf, sizeof(buf), iov, 4, &info,
+      NMEALIB_SENTENCE_GPGGA | NMEALIB_SENTENCE_GPGSV | NMEALIB_SENTENCE_GPVTG);
+  CU_ASSERT_EQUAL(r, 4);
+  CU_ASSERT_PTR_EQUAL(iov[0].iov_base, &buf[0]);
+  CU_ASSERT_EQUAL(iov[0].iov_len, 36);
+  CU_ASSERT_PTR_EQUAL(iov[1].iov_base, &buf[36]);
+  CU_ASSERT_EQUAL(iov[1].iov_len, 33);
+  CU_ASSERT_PTR_EQUAL(iov[2].iov_base, &buf[69]);
+  CU_ASSERT_EQUAL(iov[2].iov_len, 21);
+  CU_ASSERT_PTR_EQUAL(iov[3].iov_base, &buf[90]);
+  CU_ASSERT_EQUAL(iov[3].iov_len, 29);
+  CU_ASSERT_EQUAL(strncmp(iov[0].iov_base, "$GPGGA,122232.42,,,,,,05,,,,,,,*79\r\n", iov[0].iov_len), 0);
+  CU_ASSERT_EQUAL(strncmp(iov[1].iov_base, "$GPGSV,2,1,5,,,,,,,,,,,,,,,,*4F\r\n", iov[1].iov_len), 0);
+  CU_ASSERT_EQUAL(strncmp(iov[2].iov_base, "$GPGSV,2,2,5,,,,*4C\r\n", iov[2].iov_len), 0);
+  CU_ASSERT_EQUAL(strncmp(iov[3].iov_base, "$GPVTG,,,,,22.9,N,42.4,K*5C\r\n", iov[3].iov_len), 0);
+  validateContext(0, 0);
+
+  /* not enough entries */
+
+  memset(iov, 0, sizeof(iov));
+  r = nmeaSentenceFromInfoVector(buf, sizeof(buf), iov, 2, &info,
+      NMEALIB_SENTENCE_GPGGA | NMEALIB_SENTENCE_GPGSV | NMEALIB_SENTENCE_GPVTG);
+  CU_ASSERT_EQUAL(r, 2);
+  CU_ASSERT_EQUAL(iov[0].iov_len, 36);
+  CU_ASSERT_EQUAL(iov[1].iov_len, 33);
+  CU_ASSERT_PTR_NULL(iov[2].iov_base);
+  CU_ASSERT_STRING_EQUAL(buf, "$GPGGA,122232.42,,,,,,05,,,,,,,*79\r\n$GPGSV,2,1,5,,,,,,,,,,,,,,,,*4F\r\n");
+  validateContext(0, 0);
+
+  /* buffer too small */
+
+  memset(iov, 0, sizeof(iov));
+  r = nmeaSentenceFromInfoVector(buf, 40, iov, 4, &info,
+      NMEALIB_SENTENCE_GPGGA | NMEALIB_SENTENCE_GPGSV | NMEALIB_SENTENCE_GPVTG);
+  CU_ASSERT_EQUAL(r, 1);
+  CU_ASSERT_EQUAL(iov[0].iov_len, 36);
+  CU_ASSERT_PTR_NULL(iov[1].iov_base);
+  CU_ASSERT_STRING_EQUAL(buf, "$GPGGA,122232.42,,,,,,05,,,,,,,*79\r\n");
+  validateContext(0, 0);
+}
+
 /*
  * Setup
  */
@@ -415,7 +745,11 @@ int sentenceSuiteSetup(void) {
       (!CU_add_test(pSuite, "nmeaSentenceToPrefix", test_nmeaSentenceToPrefix)) //
       || (!CU_add_test(pSuite, "nmeaSentenceFromPrefix", test_nmeaSentenceFromPrefix)) //
       || (!CU_add_test(pSuite, "nmeaSentenceToInfo", test_nmeaSentenceToInfo)) //
+      || (!CU_add_test(pSuite, "nmeaSentenceParse", test_nmeaSentenceParse)) //
+      || (!CU_add_test(pSuite, "nmeaSentenceFromInfoLengthMax", test_nmeaSentenceFromInfoLengthMax)) //
       || (!CU_add_test(pSuite, "nmeaSentenceFromInfo", test_nmeaSentenceFromInfo)) //
+      || (!CU_add_test(pSuite, "nmeaSentenceFromInfoFixed", test_nmeaSentenceFromInfoFixed)) //
+      || (!CU_add_test(pSuite, "nmeaSentenceFromInfoVector", test_nmeaSentenceFromInfoVector)) //
       ) {
     return CU_get_error();
   }
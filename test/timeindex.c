@@ -0,0 +1,236 @@
+/*
+ * This file is part of nmealib.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "testHelpers.h"
+
+#include <nmealib/sentence.h>
+#include <nmealib/timeindex.h>
+#include <CUnit/Basic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+int timeindexSuiteSetup(void);
+
+/** 2016-12-31 00:00:00 UTC */
+#define TIMEINDEX_TEST_DAY (1483142400LL)
+
+/**
+ * Build a temporary file name for a test
+ *
+ * @param path The buffer for the file name
+ * @param sz The size of the buffer
+ * @param name The name of the file
+ */
+static void timeindexTestPath(char *path, size_t sz, const char *name) {
+  snprintf(path, sz, "/tmp/nmealib-timeindex-%ld-%s", (long) getpid(), name);
+  unlink(path);
+}
+
+/**
+ * Write the sentences of an epoch to a log
+ *
+ * @param file The log
+ * @param day The day of the epoch, 31 or 1 (January 2017)
+ * @param second The second of the day of the epoch
+ * @param mask The sentences to write
+ * @return The offset of the epoch in the log
+ */
+static uint64_t timeindexTestEpoch(FILE *file, unsigned int day, unsigned int second, NmeaSentence mask) {
+  char buf[1024];
+  NmeaInfo info;
+  uint64_t offset = (uint64_t) ftell(file);
+  size_t len;
+
+  memset(&info, 0, sizeof(info));
+  info.utc.year = (day == 31) ?
+      2016 :
+      2017;
+  info.utc.mon = (day == 31) ?
+      12 :
+      1;
+  info.utc.day = day;
+  info.utc.hour = second / 3600;
+  info.utc.min = (second / 60) % 60;
+  info.utc.sec = second % 60;
+  nmeaInfoSetPresent(&info.present, NMEALIB_PRESENT_UTCDATE);
+  nmeaInfoSetPresent(&info.present, NMEALIB_PRESENT_UTCTIME);
+
+  len = nmeaSentenceFromInfoFixed(buf, sizeof(buf), &info, mask);
+  fwrite(buf, 1, len, file);
+
+  return offset;
+}
+
+/*
+ * Tests
+ */
+
+static void test_nmeaTimeIndexBuild(void) {
+  const NmeaSentence all = NMEALIB_SENTENCE_GPGGA | NMEALIB_SENTENCE_GPGSA | NMEALIB_SENTENCE_GPRMC;
+  char logPath[256];
+  char indexPath[256];
+  char line[256];
+  uint64_t offsets[6];
+  NmeaTimeIndex index;
+  NmeaTimeIndex readBack;
+  FILE *file;
+  bool r;
+  size_t i;
+
+  timeindexTestPath(logPath, sizeof(logPath), "log.nmea");
+  timeindexTestPath(indexPath, sizeof(indexPath), "log.idx");
+
+  nmeaTimeIndexInit(&index);
+  nmeaTimeIndexInit(&readBack);
+
+  /* invalid inputs */
+
+  nmeaTimeIndexInit(NULL);
+  nmeaTimeIndexDestroy(NULL);
+  r = nmeaTimeIndexBuild(NULL, stdin);
+  CU_ASSERT_EQUAL(r, false);
+  r = nmeaTimeIndexBuild(&index, NULL);
+  CU_ASSERT_EQUAL(r, false);
+  r = nmeaTimeIndexWrite(NULL, indexPath);
+  CU_ASSERT_EQUAL(r, false);
+  r = nmeaTimeIndexWrite(&index, NULL);
+  CU_ASSERT_EQUAL(r, false);
+  r = nmeaTimeIndexRead(NULL, indexPath);
+  CU_ASSERT_EQUAL(r, false);
+  r = nmeaTimeIndexRead(&index, NULL);
+  CU_ASSERT_EQUAL(r, false);
+  CU_ASSERT_EQUAL(nmeaTimeIndexFind(NULL, 0), 0);
+  r = nmeaParserSeekTime(NULL, &index, 0);
+  CU_ASSERT_EQUAL(r, false);
+  r = nmeaParserSeekTime(stdin, NULL, 0);
+  CU_ASSERT_EQUAL(r, false);
+
+  r = nmeaTimeIndexRead(&index, indexPath);
+  CU_ASSERT_EQUAL(r, false);
+  validateContext(0, 1);
+
+  /*
+   * a log that starts with garbage and with epochs without a date before
+   * midnight, and that passes midnight again without (an updated) date
+   */
+
+  file = fopen(logPath, "w+b");
+  CU_ASSERT_PTR_NOT_NULL_FATAL(file);
+  fputs("garbage\r\n$GPGGA,garbage*00\r\n", file);
+  offsets[0] = timeindexTestEpoch(file, 31, 86398, NMEALIB_SENTENCE_GPGGA | NMEALIB_SENTENCE_GPGSA);
+  offsets[1] = timeindexTestEpoch(file, 31, 86399, NMEALIB_SENTENCE_GPGGA | NMEALIB_SENTENCE_GPGSA);
+  offsets[2] = timeindexTestEpoch(file, 1, 0, all);
+  offsets[3] = timeindexTestEpoch(file, 1, 1, all);
+  offsets[4] = timeindexTestEpoch(file, 1, 86399, NMEALIB_SENTENCE_GPGGA);
+  offsets[5] = timeindexTestEpoch(file, 1, 0, NMEALIB_SENTENCE_GPGGA);
+
+  r = nmeaTimeIndexBuild(&index, file);
+  CU_ASSERT_EQUAL(r, true);
+  validateContext(8, 0);
+  CU_ASSERT_EQUAL_FATAL(index.count, 6);
+  CU_ASSERT_EQUAL(index.entries[0].time, TIMEINDEX_TEST_DAY + 86398);
+  CU_ASSERT_EQUAL(index.entries[1].time, TIMEINDEX_TEST_DAY + 86399);
+  CU_ASSERT_EQUAL(index.entries[2].time, TIMEINDEX_TEST_DAY + 86400);
+  CU_ASSERT_EQUAL(index.entries[3].time, TIMEINDEX_TEST_DAY + 86401);
+  CU_ASSERT_EQUAL(index.entries[4].time, TIMEINDEX_TEST_DAY + 86400 + 86399);
+  CU_ASSERT_EQUAL(index.entries[5].time, TIMEINDEX_TEST_DAY + 86400 + 86400);
+  for (i = 0; i < index.count; i++) {
+    CU_ASSERT_EQUAL(index.entries[i].offset, offsets[i]);
+  }
+
+  /* find */
+
+  CU_ASSERT_EQUAL(nmeaTimeIndexFind(&index, 0), 0);
+  CU_ASSERT_EQUAL(nmeaTimeIndexFind(&index, TIMEINDEX_TEST_DAY + 86399), 1);
+  CU_ASSERT_EQUAL(nmeaTimeIndexFind(&index, TIMEINDEX_TEST_DAY + 86402), 4);
+  CU_ASSERT_EQUAL(nmeaTimeIndexFind(&index, TIMEINDEX_TEST_DAY + 86400 + 86401), 6);
+
+  /* seek */
+
+  r = nmeaParserSeekTime(file, &index, TIMEINDEX_TEST_DAY + 86400 + 86401);
+  CU_ASSERT_EQUAL(r, false);
+
+  r = nmeaParserSeekTime(file, &index, TIMEINDEX_TEST_DAY + 86400);
+  CU_ASSERT_EQUAL(r, true);
+  CU_ASSERT_PTR_NOT_NULL(fgets(line, sizeof(line), file));
+  CU_ASSERT_EQUAL(strncmp(line, "$GPGGA,000000.00,", 17), 0);
+
+  /* sidecar file */
+
+  r = nmeaTimeIndexWrite(&index, indexPath);
+  CU_ASSERT_EQUAL(r, true);
+  r = nmeaTimeIndexRead(&readBack, indexPath);
+  CU_ASSERT_EQUAL(r, true);
+  CU_ASSERT_EQUAL_FATAL(readBack.count, index.count);
+  CU_ASSERT_EQUAL(memcmp(readBack.entries, index.entries, index.count * sizeof(index.entries[0])), 0);
+
+  /* a log that is not a sidecar file */
+
+  r = nmeaTimeIndexRead(&readBack, logPath);
+  CU_ASSERT_EQUAL(r, false);
+  validateContext(0, 1);
+
+  /* out of order epochs, without dates */
+
+  fclose(file);
+  file = fopen(logPath, "w+b");
+  CU_ASSERT_PTR_NOT_NULL_FATAL(file);
+  offsets[0] = timeindexTestEpoch(file, 31, 10, NMEALIB_SENTENCE_GPGGA);
+  offsets[1] = timeindexTestEpoch(file, 31, 5, NMEALIB_SENTENCE_GPGGA);
+  offsets[2] = timeindexTestEpoch(file, 31, 10, NMEALIB_SENTENCE_GPGGA);
+
+  r = nmeaTimeIndexBuild(&index, file);
+  CU_ASSERT_EQUAL(r, true);
+  validateContext(3, 0);
+  CU_ASSERT_EQUAL_FATAL(index.count, 3);
+  CU_ASSERT_EQUAL(index.entries[0].time, 5);
+  CU_ASSERT_EQUAL(index.entries[0].offset, offsets[1]);
+  CU_ASSERT_EQUAL(index.entries[1].time, 10);
+  CU_ASSERT_EQUAL(index.entries[1].offset, offsets[0]);
+  CU_ASSERT_EQUAL(index.entries[2].offset, offsets[2]);
+
+  fclose(file);
+  unlink(logPath);
+  unlink(indexPath);
+
+  nmeaTimeIndexDestroy(&index);
+  nmeaTimeIndexDestroy(&readBack);
+  CU_ASSERT_PTR_NULL(index.entries);
+
+  validateContext(0, 0);
+}
+
+/*
+ * Setup
+ */
+
+int timeindexSuiteSetup(void) {
+  CU_pSuite pSuite = CU_add_suite("timeindex", mockContextSuiteInit, mockContextSuiteClean);
+  if (!pSuite) {
+    return CU_get_error();
+  }
+
+  if ( //
+      (!CU_add_test(pSuite, "nmeaTimeIndexBuild", test_nmeaTimeIndexBuild)) //
+      ) {
+    return CU_get_error();
+  }
+
+  return CUE_SUCCESS;
+}
@@ -0,0 +1,273 @@
+/*
+ * This file is part of nmealib.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "testHelpers.h"
+
+#include <nmealib/nmath.h>
+#include <nmealib/track.h>
+#include <CUnit/Basic.h>
+#include <float.h>
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+int trackSuiteSetup(void);
+
+#define TRACK_TEST_FIXES (200u)
+
+/*
+ * Tests
+ */
+
+static void test_nmeaTrackInit(void) {
+  NmeaTrack track;
+  bool r;
+
+  /* invalid inputs */
+
+  r = nmeaTrackInit(NULL, 10);
+  CU_ASSERT_EQUAL(r, false);
+  nmeaTrackDestroy(NULL);
+  nmeaTrackClear(NULL);
+  r = nmeaTrackReserve(NULL, 10);
+  CU_ASSERT_EQUAL(r, false);
+
+  /* empty */
+
+  memset(&track, 0xaa, sizeof(track));
+  r = nmeaTrackInit(&track, 0);
+  CU_ASSERT_EQUAL(r, true);
+  CU_ASSERT_EQUAL(track.count, 0);
+  CU_ASSERT_EQUAL(track.capacity, 0);
+  CU_ASSERT_PTR_NULL(track.lat);
+  nmeaTrackDestroy(&track);
+
+  /* with capacity */
+
+  r = nmeaTrackInit(&track, 10);
+  CU_ASSERT_EQUAL(r, true);
+  CU_ASSERT_EQUAL(track.count, 0);
+  CU_ASSERT_EQUAL(track.capacity, 10);
+  CU_ASSERT_PTR_NOT_NULL(track.present);
+  CU_ASSERT_PTR_NOT_NULL(track.fix);
+
+  r = nmeaTrackReserve(&track, 5);
+  CU_ASSERT_EQUAL(r, true);
+  CU_ASSERT_EQUAL(track.capacity, 10);
+  r = nmeaTrackReserve(&track, 100);
+  CU_ASSERT_EQUAL(r, true);
+  CU_ASSERT_EQUAL(track.capacity, 100);
+
+  nmeaTrackDestroy(&track);
+  CU_ASSERT_EQUAL(track.capacity, 0);
+  CU_ASSERT_PTR_NULL(track.lat);
+
+  validateContext(0, 0);
+}
+
+static void test_nmeaTrackAppend(void) {
+  NmeaTrack track;
+  NmeaInfo info;
+  NmeaInfo infos[TRACK_TEST_FIXES];
+  NmeaEpoch epoch;
+  NmeaPosition pos;
+  bool r;
+  size_t i;
+
+  nmeaTrackInit(&track, 0);
+
+  /* invalid inputs */
+
+  memset(&info, 0, sizeof(info));
+  r = nmeaTrackAppend(NULL, &info);
+  CU_ASSERT_EQUAL(r, false);
+  r = nmeaTrackAppend(&track, NULL);
+  CU_ASSERT_EQUAL(r, false);
+  r = nmeaTrackPosition(NULL, 0, &pos);
+  CU_ASSERT_EQUAL(r, false);
+  r = nmeaTrackPosition(&track, 0, &pos);
+  CU_ASSERT_EQUAL(r, false);
+  nmeaTrackEpochHandler(&track, NULL);
+  CU_ASSERT_EQUAL(track.count, 0);
+
+  /* nothing present */
+
+  r = nmeaTrackAppend(&track, &info);
+  CU_ASSERT_EQUAL(r, true);
+  CU_ASSERT_EQUAL(track.count, 1);
+  CU_ASSERT(track.capacity >= 1);
+  CU_ASSERT_EQUAL(track.present[0], 0);
+  CU_ASSERT_EQUAL(track.time[0], 0);
+  CU_ASSERT(isnan(track.lat[0]));
+  CU_ASSERT(isnan(track.lon[0]));
+  CU_ASSERT(isnan(track.elevation[0]));
+  CU_ASSERT(isnan(track.speed[0]));
+  CU_ASSERT(isnan(track.track[0]));
+  CU_ASSERT(isnan(track.hdop[0]));
+  CU_ASSERT_EQUAL(track.sig[0], NMEALIB_SIG_INVALID);
+  CU_ASSERT_EQUAL(track.fix[0], NMEALIB_FIX_BAD);
+
+  /* non-metric */
+
+  info.utc.year = 2016;
+  info.utc.mon = 12;
+  info.utc.day = 17;
+  info.utc.hour = 18;
+  info.utc.min = 40;
+  info.utc.sec = 1;
+  info.utc.hsec = 25;
+  info.latitude = 5130.0;
+  info.longitude = -130.0;
+  info.elevation = 42.5;
+  info.speed = 12.5;
+  info.track = 90.0;
+  info.hdop = 1.5;
+  info.sig = NMEALIB_SIG_FIX;
+  info.fix = NMEALIB_FIX_3D;
+  info.present = NMEALIB_PRESENT_UTCDATE | NMEALIB_PRESENT_UTCTIME | NMEALIB_PRESENT_LAT | NMEALIB_PRESENT_LON
+      | NMEALIB_PRESENT_ELV | NMEALIB_PRESENT_SPEED | NMEALIB_PRESENT_TRACK | NMEALIB_PRESENT_HDOP
+      | NMEALIB_PRESENT_SIG | NMEALIB_PRESENT_FIX;
+
+  r = nmeaTrackAppend(&track, &info);
+  CU_ASSERT_EQUAL(r, true);
+  CU_ASSERT_EQUAL(track.count, 2);
+  CU_ASSERT_EQUAL(track.present[1], info.present);
+  CU_ASSERT_EQUAL(track.time[1], 1482000001250000000LL);
+  CU_ASSERT_DOUBLE_EQUAL(track.lat[1], nmeaMathDegreeToRadian(51.5), DBL_EPSILON);
+  CU_ASSERT_DOUBLE_EQUAL(track.lon[1], nmeaMathDegreeToRadian(-1.5), DBL_EPSILON);
+  CU_ASSERT_DOUBLE_EQUAL(track.elevation[1], 42.5, DBL_EPSILON);
+  CU_ASSERT_DOUBLE_EQUAL(track.speed[1], 12.5, DBL_EPSILON);
+  CU_ASSERT_DOUBLE_EQUAL(track.track[1], 90.0, DBL_EPSILON);
+  CU_ASSERT_DOUBLE_EQUAL(track.hdop[1], 1.5, DBL_EPSILON);
+  CU_ASSERT_EQUAL(track.sig[1], NMEALIB_SIG_FIX);
+  CU_ASSERT_EQUAL(track.fix[1], NMEALIB_FIX_3D);
+
+  r = nmeaTrackPosition(&track, 1, &pos);
+  CU_ASSERT_EQUAL(r, true);
+  CU_ASSERT_DOUBLE_EQUAL(pos.lat, track.lat[1], DBL_EPSILON);
+  CU_ASSERT_DOUBLE_EQUAL(pos.lon, track.lon[1], DBL_EPSILON);
+
+  /* metric, time without a date */
+
+  nmeaInfoUnitConversion(&info, true);
+  nmeaInfoUnsetPresent(&info.present, NMEALIB_PRESENT_UTCDATE);
+  memset(&epoch, 0, sizeof(epoch));
+  epoch.info = info;
+  nmeaTrackEpochHandler(&track, &epoch);
+  CU_ASSERT_EQUAL(track.count, 3);
+  CU_ASSERT_EQUAL(track.time[2], 67201250000000LL);
+  CU_ASSERT_DOUBLE_EQUAL(track.lat[2], track.lat[1], 1e-12);
+  CU_ASSERT_DOUBLE_EQUAL(track.lon[2], track.lon[1], 1e-12);
+  CU_ASSERT_DOUBLE_EQUAL(track.hdop[2], 1.5, 1e-12);
+
+  /* clear */
+
+  nmeaTrackClear(&track);
+  CU_ASSERT_EQUAL(track.count, 0);
+
+  /* growth */
+
+  for (i = 0; i < TRACK_TEST_FIXES; i++) {
+    memset(&infos[i], 0, sizeof(infos[i]));
+    infos[i].elevation = (double) i;
+    nmeaInfoSetPresent(&infos[i].present, NMEALIB_PRESENT_ELV);
+  }
+
+  r = nmeaTrackAppendInfos(&track, infos, TRACK_TEST_FIXES);
+  CU_ASSERT_EQUAL(r, true);
+  r = nmeaTrackAppendInfos(&track, infos, TRACK_TEST_FIXES);
+  CU_ASSERT_EQUAL(r, true);
+  CU_ASSERT_EQUAL(track.count, 2 * TRACK_TEST_FIXES);
+  CU_ASSERT(track.capacity >= track.count);
+  for (i = 0; i < track.count; i++) {
+    CU_ASSERT_DOUBLE_EQUAL(track.elevation[i], (double) (i % TRACK_TEST_FIXES), DBL_EPSILON);
+  }
+
+  nmeaTrackDestroy(&track);
+
+  validateContext(0, 0);
+}
+
+static void test_nmeaTrackDistances(void) {
+  NmeaTrack track;
+  NmeaInfo info;
+  NmeaPosition from;
+  NmeaPosition to;
+  double distances[4];
+  double total;
+
+  nmeaTrackInit(&track, 4);
+
+  /* invalid inputs */
+
+  total = nmeaTrackDistances(NULL, distances);
+  CU_ASSERT_DOUBLE_EQUAL(total, 0.0, DBL_EPSILON);
+  total = nmeaTrackDistances(&track, NULL);
+  CU_ASSERT_DOUBLE_EQUAL(total, 0.0, DBL_EPSILON);
+  total = nmeaTrackDistances(&track, distances);
+  CU_ASSERT_DOUBLE_EQUAL(total, 0.0, DBL_EPSILON);
+
+  /* normal, with a fix without a position */
+
+  memset(&info, 0, sizeof(info));
+  info.latitude = 5000.0;
+  info.longitude = 500.0;
+  nmeaInfoSetPresent(&info.present, NMEALIB_PRESENT_LAT);
+  nmeaInfoSetPresent(&info.present, NMEALIB_PRESENT_LON);
+  nmeaTrackAppend(&track, &info);
+
+  info.latitude = 5001.0;
+  nmeaTrackAppend(&track, &info);
+
+  memset(&info, 0, sizeof(info));
+  nmeaTrackAppend(&track, &info);
+
+  total = nmeaTrackDistances(&track, distances);
+
+  nmeaTrackPosition(&track, 0, &from);
+  nmeaTrackPosition(&track, 1, &to);
+  CU_ASSERT_DOUBLE_EQUAL(distances[0], 0.0, DBL_EPSILON);
+  CU_ASSERT_DOUBLE_EQUAL(distances[1], nmeaMathDistance(&from, &to), DBL_EPSILON);
+  CU_ASSERT_DOUBLE_EQUAL(distances[1], 1853.0, 5.0);
+  CU_ASSERT(isnan(distances[2]));
+  CU_ASSERT_DOUBLE_EQUAL(total, distances[1], DBL_EPSILON);
+
+  nmeaTrackDestroy(&track);
+
+  validateContext(0, 0);
+}
+
+/*
+ * Setup
+ */
+
+int trackSuiteSetup(void) {
+  CU_pSuite pSuite = CU_add_suite("track", mockContextSuiteInit, mockContextSuiteClean);
+  if (!pSuite) {
+    return CU_get_error();
+  }
+
+  if ( //
+      (!CU_add_test(pSuite, "nmeaTrackInit", test_nmeaTrackInit)) //
+      || (!CU_add_test(pSuite, "nmeaTrackAppend", test_nmeaTrackAppend)) //
+      || (!CU_add_test(pSuite, "nmeaTrackDistances", test_nmeaTrackDistances)) //
+      ) {
+    return CU_get_error();
+  }
+
+  return CUE_SUCCESS;
+}
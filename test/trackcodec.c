@@ -0,0 +1,260 @@
+/*
+ * This file is part of nmealib.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "testHelpers.h"
+
+#include <nmealib/trackcodec.h>
+#include <CUnit/Basic.h>
+#include <stdint.h>
+#include <string.h>
+
+int trackcodecSuiteSetup(void);
+
+#define TRACKCODEC_TEST_RECORDS (600u)
+#define TRACKCODEC_TEST_BLOCK   (64u)
+#define TRACKCODEC_TEST_BLOCKS  ((TRACKCODEC_TEST_RECORDS + TRACKCODEC_TEST_BLOCK - 1) / TRACKCODEC_TEST_BLOCK)
+
+/**
+ * Fill records with a 1 Hz vehicle track
+ *
+ * @param records The records
+ * @param count The number of records
+ */
+static void trackcodecTestRecords(NmeaRecord *records, size_t count) {
+  NmeaInfo info;
+  size_t i;
+
+  memset(&info, 0, sizeof(info));
+  info.utc.year = 2016;
+  info.utc.mon = 12;
+  info.utc.day = 31;
+  info.utc.hour = 23;
+  info.utc.min = 50;
+  info.sig = NMEALIB_SIG_FIX;
+  info.fix = NMEALIB_FIX_3D;
+  info.pdop = 2.1;
+  info.hdop = 1.2;
+  info.vdop = 1.7;
+  info.latitude = 5130.0;
+  info.longitude = -130.0;
+  info.elevation = 42.0;
+  info.height = 47.5;
+  info.speed = 50.0;
+  info.track = 45.0;
+  info.satellites.inUseCount = 8;
+  info.satellites.inViewCount = 11;
+  info.smask = NMEALIB_SENTENCE_GPGGA | NMEALIB_SENTENCE_GPRMC;
+  info.present = NMEALIB_PRESENT_UTCDATE | NMEALIB_PRESENT_UTCTIME | NMEALIB_PRESENT_SIG | NMEALIB_PRESENT_FIX
+      | NMEALIB_PRESENT_PDOP | NMEALIB_PRESENT_HDOP | NMEALIB_PRESENT_VDOP | NMEALIB_PRESENT_LAT | NMEALIB_PRESENT_LON
+      | NMEALIB_PRESENT_ELV | NMEALIB_PRESENT_HEIGHT | NMEALIB_PRESENT_SPEED | NMEALIB_PRESENT_TRACK
+      | NMEALIB_PRESENT_SATINUSECOUNT | NMEALIB_PRESENT_SATINVIEWCOUNT;
+
+  for (i = 0; i < count; i++) {
+    nmeaRecordFromInfo(&info, &records[i]);
+
+    /* one second and about 14 meters later, passing midnight */
+    nmeaTimeFromEpochNs(nmeaTimeToEpochNs(&info.utc) + 1000000000LL + (int64_t) (i % 3) * 10000000LL, &info.utc);
+    info.latitude += 0.0054 + ((double) (i % 7) * 0.0001);
+    info.longitude += 0.0087 - ((double) (i % 5) * 0.0001);
+    info.elevation += ((i % 10) < 5) ?
+        0.25 :
+        -0.25;
+    info.speed = 50.0 + (double) (i % 4);
+    if (!(i % 30)) {
+      info.satellites.inUseCount = 8 + (unsigned int) ((i / 30) % 3);
+      info.hdop = 1.2 + ((double) ((i / 30) % 3) * 0.1);
+    }
+  }
+
+  /* a fix without a time */
+  nmeaInfoUnsetPresent(&records[100].present, NMEALIB_PRESENT_UTCTIME);
+  memset(&records[100].utc.hour, 0, 4);
+
+  /* a leap second and an invalid date */
+  records[200].utc.sec = 60;
+  records[300].utc.mon = 13;
+}
+
+/*
+ * Tests
+ */
+
+static void test_nmeaTrackCodecEncode(void) {
+  static NmeaRecord records[TRACKCODEC_TEST_RECORDS];
+  static uint8_t buf[TRACKCODEC_TEST_RECORDS * NMEALIB_TRACKCODEC_RECORD_MAX];
+  size_t blocks[TRACKCODEC_TEST_BLOCKS];
+  NmeaTrackCodec codec;
+  NmeaRecord record;
+  size_t len = 0;
+  size_t block = 0;
+  size_t r;
+  size_t i;
+
+  /* invalid inputs */
+
+  memset(&record, 0, sizeof(record));
+  nmeaTrackCodecInit(NULL, 0);
+  nmeaTrackCodecReset(NULL);
+  CU_ASSERT_EQUAL(nmeaTrackCodecIsBlockStart(NULL), false);
+  nmeaTrackCodecInit(&codec, 0);
+  CU_ASSERT_EQUAL(nmeaTrackCodecEncode(NULL, &record, buf), 0);
+  CU_ASSERT_EQUAL(nmeaTrackCodecEncode(&codec, NULL, buf), 0);
+  CU_ASSERT_EQUAL(nmeaTrackCodecEncode(&codec, &record, NULL), 0);
+  CU_ASSERT_EQUAL(nmeaTrackCodecDecode(NULL, buf, 1, &record), 0);
+  CU_ASSERT_EQUAL(nmeaTrackCodecDecode(&codec, NULL, 1, &record), 0);
+  CU_ASSERT_EQUAL(nmeaTrackCodecDecode(&codec, buf, 0, &record), 0);
+  CU_ASSERT_EQUAL(nmeaTrackCodecDecode(&codec, buf, 1, NULL), 0);
+
+  /* an empty record */
+
+  r = nmeaTrackCodecEncode(&codec, &record, buf);
+  CU_ASSERT_EQUAL(r, 6);
+  nmeaTrackCodecReset(&codec);
+  memset(&record, 0xaa, sizeof(record));
+  CU_ASSERT_EQUAL(nmeaTrackCodecDecode(&codec, buf, 6, &record), 6);
+  CU_ASSERT_EQUAL(record.present, 0);
+  CU_ASSERT_EQUAL(record.utc.year, 0);
+
+  /* encode */
+
+  trackcodecTestRecords(records, TRACKCODEC_TEST_RECORDS);
+  nmeaTrackCodecInit(&codec, TRACKCODEC_TEST_BLOCK);
+
+  for (i = 0; i < TRACKCODEC_TEST_RECORDS; i++) {
+    if (nmeaTrackCodecIsBlockStart(&codec)) {
+      CU_ASSERT_EQUAL(i % TRACKCODEC_TEST_BLOCK, 0);
+      blocks[block++] = len;
+    }
+
+    r = nmeaTrackCodecEncode(&codec, &records[i], &buf[len]);
+    CU_ASSERT(r > 0);
+    CU_ASSERT(r <= NMEALIB_TRACKCODEC_RECORD_MAX);
+    len += r;
+  }
+
+  CU_ASSERT_EQUAL(block, TRACKCODEC_TEST_BLOCKS);
+
+  /* a 1 Hz track compresses well */
+
+  CU_ASSERT((len * 5) < (TRACKCODEC_TEST_RECORDS * NMEALIB_RECORD_SIZE));
+
+  /* decode */
+
+  nmeaTrackCodecInit(&codec, TRACKCODEC_TEST_BLOCK);
+
+  for (i = 0, r = 0; i < TRACKCODEC_TEST_RECORDS; i++) {
+    size_t dr = nmeaTrackCodecDecode(&codec, &buf[r], len - r, &record);
+    CU_ASSERT_FATAL(dr > 0);
+    CU_ASSERT_EQUAL(memcmp(&record, &records[i], sizeof(record)), 0);
+    r += dr;
+  }
+
+  CU_ASSERT_EQUAL(r, len);
+
+  /* random access */
+
+  for (i = 0; i < TRACKCODEC_TEST_RECORDS; i += 37) {
+    size_t offset = blocks[i / TRACKCODEC_TEST_BLOCK];
+    size_t j;
+
+    nmeaTrackCodecReset(&codec);
+    for (j = 0; j <= (i % TRACKCODEC_TEST_BLOCK); j++) {
+      offset += nmeaTrackCodecDecode(&codec, &buf[offset], len - offset, &record);
+    }
+
+    CU_ASSERT_EQUAL(memcmp(&record, &records[i], sizeof(record)), 0);
+  }
+
+  /* truncated and invalid */
+
+  nmeaTrackCodecReset(&codec);
+  r = nmeaTrackCodecEncode(&codec, &records[0], buf);
+  for (i = 1; i < r; i++) {
+    nmeaTrackCodecReset(&codec);
+    CU_ASSERT_EQUAL(nmeaTrackCodecDecode(&codec, buf, i, &record), 0);
+  }
+
+  buf[0] |= 0x80;
+  nmeaTrackCodecReset(&codec);
+  CU_ASSERT_EQUAL(nmeaTrackCodecDecode(&codec, buf, r, &record), 0);
+
+  /* corrupt: a time far beyond the last year */
+
+  memset(buf, 0, 16);
+  buf[1] = 0xfe;
+  memset(&buf[2], 0xff, 8);
+  buf[10] = 0x01;
+  nmeaTrackCodecReset(&codec);
+  CU_ASSERT_EQUAL(nmeaTrackCodecDecode(&codec, buf, 16, &record), 0);
+
+  /* corrupt: a huge latitude difference wraps around */
+
+  memmove(&buf[2], &buf[1], 10);
+  buf[1] = 0x00;
+  nmeaTrackCodecReset(&codec);
+  CU_ASSERT_EQUAL(nmeaTrackCodecDecode(&codec, buf, 16, &record), 15);
+
+  /* times beyond the range of nanoseconds since the epoch */
+
+  nmeaTrackCodecReset(&codec);
+  for (i = 0; i < 4; i++) {
+    static const uint16_t years[] = {
+        100, 1600, 2300, 65535 };
+
+    records[i] = records[1];
+    records[i].utc.year = years[i];
+    r = nmeaTrackCodecEncode(&codec, &records[i], buf);
+    CU_ASSERT(r > 0);
+
+    /* encoded as a time, not as is */
+    CU_ASSERT_EQUAL(buf[0] & 0x40, 0);
+  }
+
+  nmeaTrackCodecReset(&codec);
+  for (i = 0, len = 0; i < 4; i++) {
+    len += nmeaTrackCodecEncode(&codec, &records[i], &buf[len]);
+  }
+
+  nmeaTrackCodecReset(&codec);
+  for (i = 0, r = 0; i < 4; i++) {
+    size_t dr = nmeaTrackCodecDecode(&codec, &buf[r], len - r, &record);
+    CU_ASSERT_FATAL(dr > 0);
+    CU_ASSERT_EQUAL(memcmp(&record, &records[i], sizeof(record)), 0);
+    r += dr;
+  }
+
+  validateContext(0, 0);
+}
+
+/*
+ * Setup
+ */
+
+int trackcodecSuiteSetup(void) {
+  CU_pSuite pSuite = CU_add_suite("trackcodec", mockContextSuiteInit, mockContextSuiteClean);
+  if (!pSuite) {
+    return CU_get_error();
+  }
+
+  if ( //
+      (!CU_add_test(pSuite, "nmeaTrackCodecEncode", test_nmeaTrackCodecEncode)) //
+      ) {
+    return CU_get_error();
+  }
+
+  return CUE_SUCCESS;
+}
@@ -34,10 +34,31 @@ static void test_nmeaRandomInit(void) {
 
 static void test_nmeaRandom(void) {
   double r;
+  double r1;
+  size_t i;
 
   r = nmeaRandom(10.0, 20.0);
   CU_ASSERT_EQUAL(r >= 10.0, true);
   CU_ASSERT_EQUAL(r <= 20.0, true);
+
+  /* seeded thread */
+
+  nmeaRandomSeedThread(42);
+  r1 = nmeaRandom(10.0, 20.0);
+  for (i = 0; i < 1000; i++) {
+    r = nmeaRandom(10.0, 20.0);
+    CU_ASSERT_EQUAL(r >= 10.0, true);
+    CU_ASSERT_EQUAL(r <= 20.0, true);
+  }
+
+  nmeaRandomSeedThread(42);
+  r = nmeaRandom(10.0, 20.0);
+  CU_ASSERT_DOUBLE_EQUAL(r, r1, 0.0);
+
+  nmeaRandomSeedThread(0);
+  r = nmeaRandom(10.0, 20.0);
+  CU_ASSERT_EQUAL(r >= 10.0, true);
+  CU_ASSERT_EQUAL(r <= 20.0, true);
 }
 
 static void test_Min(void) {